@@ -66,6 +66,10 @@ function(build_papi)
        # Dependencies
        add_dependencies(papi papi)
 
+       # Used by CMakeLists.txt to compile and link the counter sources
+       set(PAPI_INCLUDE_DIR ${PAPI_INCLUDE_DIR} PARENT_SCOPE)
+       set(PAPI_LIBRARY_PATH ${PAPI_LIBRARY_PATH} PARENT_SCOPE)
+
 endfunction()
 
 # Call the function we just wrote to get CMakePP
@@ -0,0 +1,413 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <memory>
+#include <parallelzone/hardware/cpu/hardware_counters.hpp>
+#include <vector>
+
+namespace parallelzone::hardware {
+
+namespace detail_ {
+struct CPUPIMPL;
+}
+
+/** @brief Provides a runtime API for querying the processor(s).
+ *
+ *  The CPU class describes the processors the current process runs on: how
+ *  many sockets, physical cores, and hardware threads (logical CPUs) there
+ *  are, how big the caches are, and which logical CPUs the calling thread is
+ *  allowed to run on. The information is discovered from the Linux sysfs
+ *  (`/sys/devices/system/cpu`) and `sched_getaffinity`, i.e., without any
+ *  additional dependencies.
+ *
+ *  Logical CPUs are identified by the id the operating system uses for them
+ *  (the `N` in `/sys/devices/system/cpu/cpuN`). Since CPUs may be offline, the
+ *  ids need not be contiguous.
+ *
+ *  The CPU class also provides the ability to pin the calling thread, which
+ *  is useful for keeping a thread (and the data in its caches) on one socket.
+ */
+class CPU {
+public:
+    /// Unsigned integral type used for offsets and counting
+    using size_type = std::size_t;
+
+    /// Type used to hold a set of logical CPU ids
+    using id_container = std::vector<size_type>;
+
+    /// Type of the object implementing the CPU class
+    using pimpl_type = detail_::CPUPIMPL;
+
+    /// Type of the pointer holding the PIMPL
+    using pimpl_pointer = std::unique_ptr<pimpl_type>;
+
+    // -------------------------------------------------------------------------
+    // -- Ctors, Assignment, Dtor
+    // -------------------------------------------------------------------------
+
+    /** @brief Creates a new CPU instance with no processors
+     *
+     *  @throw None No throw guarantee
+     */
+    CPU() noexcept;
+
+    /** @brief Creates a new CPU instance with the provided state.
+     *
+     *  CPU instances are usually created by ResourceSet instances when the
+     *  ResourceSet is being populated.
+     *
+     *  @param[in] pimpl The state for the new CPU instance.
+     *
+     *  @throw None No throw guarantee.
+     */
+    explicit CPU(pimpl_pointer pimpl) noexcept;
+
+    /** @brief Makes a deep copy of @p other
+     *
+     *  @param[in] other The CPU instance being deep copied.
+     */
+    CPU(const CPU& other);
+
+    /** @brief Creates a new CPU instance by taking ownership of @p other 's
+     *         state.
+     *
+     *  @param[in,out] other The instance whose state is being taken. After this
+     *                       operation @p other is in a state consistent with
+     *                       default initialization.
+     *
+     *  @throw None No throw guarantee.
+     */
+    CPU(CPU&& other) noexcept;
+
+    /** @brief Overwrites the state in *this with a deep copy of @p rhs.
+     *
+     *  @param[in] rhs The object whose state is being copied.
+     *
+     *  @return The current instance, after overwriting its state with a deep
+     *          copy of the state in @p rhs.
+     *
+     *  @throw std::bad_alloc if there's a problem copying @p rhs's state.
+     *                        Strong throw guarantee.
+     */
+    CPU& operator=(const CPU& rhs);
+
+    /** @brief Overwrites the state in *this with the state in @p rhs.
+     *
+     *  @param[in,out] rhs The object whose state is being taken. After this
+     *                     operation @p rhs is in a state consistent with
+     *                     default initialization.
+     *
+     *  @return The current instance, after overwriting its state with the
+     *          state in @p rhs.
+     *
+     *  @throw None No throw guarantee.
+     */
+    CPU& operator=(CPU&& rhs) noexcept;
+
+    /// Default no throw dtor
+    ~CPU() noexcept;
+
+    // -------------------------------------------------------------------------
+    // -- Topology
+    // -------------------------------------------------------------------------
+
+    /** @brief The number of physical packages (sockets).
+     *
+     *  @return The number of sockets. Empty instances have 0 sockets.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type n_sockets() const noexcept;
+
+    /** @brief The number of physical cores, summed over all sockets.
+     *
+     *  @return The number of physical cores. Empty instances have 0 cores.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type n_cores() const noexcept;
+
+    /** @brief The number of hardware threads (online logical CPUs).
+     *
+     *  This will be larger than n_cores() if simultaneous multithreading
+     *  (e.g., hyper-threading) is enabled.
+     *
+     *  @return The number of hardware threads. Empty instances have 0.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type n_hardware_threads() const noexcept;
+
+    /** @brief The ids of the online logical CPUs, in increasing order.
+     *
+     *  @return The ids of all hardware threads.
+     *
+     *  @throw std::bad_alloc if there is a problem copying the ids. Strong
+     *                        throw guarantee.
+     */
+    id_container hardware_threads() const;
+
+    /** @brief The socket the logical CPU @p cpu belongs to.
+     *
+     *  Sockets are numbered 0 to n_sockets() - 1.
+     *
+     *  @param[in] cpu The id of an online logical CPU.
+     *
+     *  @return The socket index of @p cpu.
+     *
+     *  @throw std::out_of_range if @p cpu is not an online logical CPU. Strong
+     *                           throw guarantee.
+     */
+    size_type socket_of(size_type cpu) const;
+
+    /** @brief The physical core the logical CPU @p cpu belongs to.
+     *
+     *  Cores are numbered 0 to n_cores() - 1, with the cores of socket 0
+     *  first.
+     *
+     *  @param[in] cpu The id of an online logical CPU.
+     *
+     *  @return The core index of @p cpu.
+     *
+     *  @throw std::out_of_range if @p cpu is not an online logical CPU. Strong
+     *                           throw guarantee.
+     */
+    size_type core_of(size_type cpu) const;
+
+    /** @brief The logical CPUs on socket @p socket.
+     *
+     *  @param[in] socket The index of the socket. Must be in the range
+     *                    [0, n_sockets()).
+     *
+     *  @return The ids of the logical CPUs on @p socket in increasing order.
+     *
+     *  @throw std::out_of_range if @p socket is not a valid socket index.
+     *                           Strong throw guarantee.
+     */
+    id_container hardware_threads_on_socket(size_type socket) const;
+
+    /** @brief The number of NUMA nodes which have logical CPUs.
+     *
+     *  Single-socket machines usually have one NUMA node. Multi-socket
+     *  machines have (at least) one per socket.
+     *
+     *  @return The number of NUMA nodes. Empty instances have 0.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type n_numa_nodes() const noexcept;
+
+    /** @brief The ids of the NUMA nodes which have logical CPUs.
+     *
+     *  NUMA nodes are identified by the id the operating system uses for them
+     *  (the `N` in `/sys/devices/system/node/nodeN`), which is also the id
+     *  used for NUMA placement policies (see NUMAPolicy).
+     *
+     *  @return The ids of the NUMA nodes in increasing order.
+     *
+     *  @throw std::bad_alloc if there is a problem copying the ids. Strong
+     *                        throw guarantee.
+     */
+    id_container numa_nodes() const;
+
+    /** @brief The NUMA node the logical CPU @p cpu belongs to.
+     *
+     *  Memory on this node is "local" to @p cpu. Combined with
+     *  NUMAPolicy::bind this is how memory is placed next to the CPU which
+     *  will use it.
+     *
+     *  @param[in] cpu The id of an online logical CPU.
+     *
+     *  @return The id of the NUMA node of @p cpu.
+     *
+     *  @throw std::out_of_range if @p cpu is not an online logical CPU. Strong
+     *                           throw guarantee.
+     */
+    size_type numa_node_of(size_type cpu) const;
+
+    /** @brief The logical CPUs on NUMA node @p node.
+     *
+     *  @param[in] node The id of a NUMA node, i.e., a member of numa_nodes().
+     *
+     *  @return The ids of the logical CPUs on @p node in increasing order.
+     *
+     *  @throw std::out_of_range if @p node is not a NUMA node with CPUs.
+     *                           Strong throw guarantee.
+     */
+    id_container hardware_threads_on_numa_node(size_type node) const;
+
+    // -------------------------------------------------------------------------
+    // -- Caches
+    // -------------------------------------------------------------------------
+
+    /** @brief The size of the data (or unified) cache at level @p level.
+     *
+     *  Sizes are those seen by a single core, e.g., for a shared L3 this is
+     *  the size of the whole L3 slice the core can use.
+     *
+     *  @param[in] level The cache level (1 for L1, 2 for L2, etc.).
+     *
+     *  @return The size of the cache in bytes, or 0 if there is no such cache
+     *          (or it could not be determined).
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type cache_size(size_type level) const noexcept;
+
+    /** @brief The size of a cache line.
+     *
+     *  @return The coherency line size of the L1 data cache in bytes, or 0 if
+     *          it could not be determined.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type cache_line_size() const noexcept;
+
+    /** @brief The number of cache levels.
+     *
+     *  @return The highest cache level which was found (0 if none were).
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type n_cache_levels() const noexcept;
+
+    // -------------------------------------------------------------------------
+    // -- Affinity
+    // -------------------------------------------------------------------------
+
+    /** @brief The logical CPUs the calling thread may run on.
+     *
+     *  The affinity mask is a property of the calling thread, not of *this,
+     *  so the value is looked up each time this method is called.
+     *
+     *  @return The ids of the logical CPUs in the calling thread's affinity
+     *          mask, in increasing order.
+     *
+     *  @throw std::runtime_error if *this is empty or if the mask can not be
+     *                            retrieved. Strong throw guarantee.
+     */
+    id_container affinity() const;
+
+    /** @brief Restricts the calling thread to the logical CPUs in @p cpus.
+     *
+     *  @param[in] cpus The ids of the logical CPUs the calling thread may run
+     *                  on. Must be non-empty and contain only online CPUs.
+     *
+     *  @throw std::out_of_range if @p cpus contains an id which is not an
+     *                           online logical CPU. Strong throw guarantee.
+     *  @throw std::runtime_error if *this is empty, if @p cpus is empty, or if
+     *                            the operating system refuses the request.
+     *                            Strong throw guarantee.
+     */
+    void set_affinity(const id_container& cpus) const;
+
+    /** @brief Pins the calling thread to the logical CPU @p cpu.
+     *
+     *  This is shorthand for `set_affinity({cpu})`.
+     *
+     *  @param[in] cpu The id of the logical CPU to pin to.
+     *
+     *  @throw std::out_of_range if @p cpu is not an online logical CPU. Strong
+     *                           throw guarantee.
+     *  @throw std::runtime_error if *this is empty or if the operating system
+     *                            refuses the request. Strong throw guarantee.
+     */
+    void pin_thread(size_type cpu) const;
+
+    // -------------------------------------------------------------------------
+    // -- Hardware counters
+    // -------------------------------------------------------------------------
+
+    /** @brief Starts counting @p events for the calling thread.
+     *
+     *  This is a convenience for making a HardwareCounters object from the
+     *  CPU of a ResourceSet, e.g., `rs.cpu().counters({event::cycles})`. See
+     *  HardwareCounters for where the counts come from.
+     *
+     *  @param[in] events The events to count.
+     *
+     *  @return An object counting @p events for the calling thread.
+     *
+     *  @throw std::runtime_error if *this is empty. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the counters.
+     *                        Strong throw guarantee.
+     */
+    HardwareCounters counters(HardwareCounters::event_container events) const;
+
+    // -------------------------------------------------------------------------
+    // -- Utility methods
+    // -------------------------------------------------------------------------
+
+    /** @brief Determines if *this has processors.
+     *
+     *  @return True if n_hardware_threads() == 0 and false otherwise.
+     *
+     *  @throw None No throw guarantee
+     */
+    bool empty() const noexcept;
+
+    /** @brief Exchanges the state in *this with that in @p other
+     *
+     *  @param[in,out] other The CPU object we are exchanging state with. After
+     *                       this method @p other will contain the state which
+     *                       was previously in *this.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void swap(CPU& other) noexcept;
+
+    /** @brief Determines if *this is value equal to @p rhs
+     *
+     *  Two CPU instances are value equal if they describe the same topology,
+     *  i.e., the same logical CPUs on the same cores, sockets, and NUMA nodes,
+     *  with the same caches.
+     *
+     *  @param[in] rhs The CPU instance we are comparing to.
+     *
+     *  @return True if *this is value equal to @p rhs and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool operator==(const CPU& rhs) const noexcept;
+
+private:
+    /// Code factorization for checking if the PIMPL is non-null
+    bool has_pimpl_() const noexcept;
+
+    /// Code factorization for asserting that *this is not empty
+    void assert_non_empty_() const;
+
+    /// The object actually implementing *this
+    pimpl_pointer m_pimpl_;
+};
+
+/** @brief Determines if two CPU instances are different.
+ *  @relates CPU
+ *
+ *  Two CPU objects are different if they are not value equal. See the
+ *  documentation for CPU::operator== for the definition of value equal.
+ *
+ *  @param[in] lhs The CPU object on the left side of the operator
+ *  @param[in] rhs The CPU object on the right side of the operator
+ *
+ *  @return False if @p lhs and @p rhs are value equal. True otherwise.
+ *
+ *  @throw None No throw guarantee.
+ */
+inline bool operator!=(const CPU& lhs, const CPU& rhs) { return !(lhs == rhs); }
+
+} // namespace parallelzone::hardware
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace parallelzone::hardware {
+
+namespace detail_ {
+class HardwareCountersPIMPL;
+}
+
+/** @brief Counts hardware events (cycles, cache misses, etc.) for a thread.
+ *
+ *  A HardwareCounters object counts a set of events for the thread which
+ *  created it, starting from when it was created. The events are read from
+ *  the best source available for each of them, in order of preference:
+ *
+ *  - PAPI, if ParallelZone was built with BUILD_PAPI_BINDINGS,
+ *  - the Linux perf_event_open(2) system call, which requires
+ *    `/proc/sys/kernel/perf_event_paranoid` to allow user-space counting,
+ *  - getrusage(2), which only provides the software events (page faults and
+ *    context switches).
+ *
+ *  Events no source can count are unsupported and always read as 0. In
+ *  particular, floating-point operations are only counted by PAPI since the
+ *  hardware events for them differ from processor to processor.
+ *
+ *  Since the counts are those of the creating thread, read must be called
+ *  from that thread.
+ */
+class HardwareCounters {
+public:
+    /// The events which can be counted
+    enum class event {
+        cycles,
+        instructions,
+        cache_references,
+        cache_misses,
+        branch_misses,
+        flops,
+        page_faults,
+        context_switches
+    };
+
+    /// Where the count of an event comes from
+    enum class source { none, papi, perf_event, rusage };
+
+    /// Type of a list of events
+    using event_container = std::vector<event>;
+
+    /// Type of the count of an event
+    using value_type = std::uint64_t;
+
+    /// Type of the counts of the events, in the order of events()
+    using value_container = std::vector<value_type>;
+
+    /// Type of the object implementing *this
+    using pimpl_type = detail_::HardwareCountersPIMPL;
+
+    /// Type of a pointer to the PIMPL
+    using pimpl_pointer = std::unique_ptr<pimpl_type>;
+
+    /** @brief Creates an object which counts no events.
+     *
+     *  @throw None No throw guarantee.
+     */
+    HardwareCounters() noexcept;
+
+    /** @brief Starts counting @p events for the calling thread.
+     *
+     *  Failing to count an event is not an error, the event is simply
+     *  unsupported (see source_of).
+     *
+     *  @param[in] events The events to count. Repeats are allowed.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the state.
+     *                        Strong throw guarantee.
+     */
+    explicit HardwareCounters(event_container events);
+
+    /// Deleted, the counters belong to one thread
+    HardwareCounters(const HardwareCounters&) = delete;
+
+    /// Deleted, the counters belong to one thread
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    /** @brief Takes ownership of the counters of @p other.
+     *
+     *  @param[in,out] other The object whose counters are taken. After this
+     *                       call @p other counts no events.
+     *
+     *  @throw None No throw guarantee.
+     */
+    HardwareCounters(HardwareCounters&& other) noexcept;
+
+    /** @brief Releases the counters of *this and takes those of @p rhs.
+     *
+     *  @param[in,out] rhs The object whose counters are taken. After this
+     *                     call @p rhs counts no events.
+     *
+     *  @return *this after taking the counters of @p rhs.
+     *
+     *  @throw None No throw guarantee.
+     */
+    HardwareCounters& operator=(HardwareCounters&& rhs) noexcept;
+
+    /// Stops counting and releases the counters
+    ~HardwareCounters() noexcept;
+
+    /** @brief The events *this counts.
+     *
+     *  @return The events passed to the ctor (empty for a default constructed
+     *          object).
+     *
+     *  @throw std::bad_alloc if there is a problem copying the events. Strong
+     *                        throw guarantee.
+     */
+    event_container events() const;
+
+    /** @brief Where the count of @p e comes from.
+     *
+     *  @param[in] e The event of interest.
+     *
+     *  @return The source counting @p e, or source::none if @p e is not
+     *          counted by *this (or can not be counted at all).
+     *
+     *  @throw None No throw guarantee.
+     */
+    source source_of(event e) const noexcept;
+
+    /** @brief Can *this count @p e?
+     *
+     *  @param[in] e The event of interest.
+     *
+     *  @return True if `source_of(e) != source::none` and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool supported(event e) const noexcept {
+        return source_of(e) != source::none;
+    }
+
+    /** @brief The counts of the events since *this was created.
+     *
+     *  Must be called from the thread which created *this.
+     *
+     *  @return One count per event, in the order of events(). Unsupported
+     *          events are 0.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the result.
+     *                        Strong throw guarantee.
+     */
+    value_container read() const;
+
+    /** @brief Was ParallelZone built with PAPI?
+     *
+     *  @return True if ParallelZone was built with BUILD_PAPI_BINDINGS.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static bool have_papi() noexcept;
+
+    /** @brief A short name for @p e, e.g., "cache_misses".
+     *
+     *  @param[in] e The event to name.
+     *
+     *  @return The name of the enumerator.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the name.
+     *                        Strong throw guarantee.
+     */
+    static std::string name(event e);
+
+private:
+    /// The state of *this (null if *this counts nothing)
+    pimpl_pointer m_pimpl_;
+};
+
+} // namespace parallelzone::hardware
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+namespace parallelzone::hardware {
+
+/** @brief Thread-safe counters describing the allocations made through a
+ *         RAM instance's allocators.
+ *
+ *  Every RAM instance owns one AllocationTracker (shared by copies of the RAM
+ *  instance). Allocators obtained from RAM::allocator report each allocation
+ *  and deallocation to the tracker. The counters are atomics, so allocators
+ *  may be used from any number of threads.
+ *
+ *  The tracker can optionally be given a soft limit. Allocations which push
+ *  live_bytes() from below the limit to at or above it invoke a callback.
+ *  The allocation itself still succeeds (hence "soft"); the callback is meant
+ *  for logging/diagnosing who is using the memory. The callback is invoked
+ *  once per crossing, i.e., it is re-armed when live_bytes() drops back below
+ *  the limit.
+ */
+class AllocationTracker {
+public:
+    /// Unsigned integral type used for counting bytes and allocations
+    using size_type = std::size_t;
+
+    /// Type of the callback invoked when the soft limit is crossed. The
+    /// arguments are the live bytes (after the allocation) and the limit.
+    using callback_type = std::function<void(size_type, size_type)>;
+
+    /// Makes a tracker with all counters zeroed and no soft limit
+    AllocationTracker() noexcept = default;
+
+    /// Not copyable, allocators hold pointers to the tracker
+    AllocationTracker(const AllocationTracker&) = delete;
+
+    /// Not copyable, allocators hold pointers to the tracker
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+    /** @brief Records that @p n_bytes were allocated.
+     *
+     *  If this allocation crosses the soft limit the callback is invoked
+     *  from the calling thread before this method returns.
+     *
+     *  @param[in] n_bytes The number of bytes which were allocated.
+     *
+     *  @throw ??? Throws if the soft limit callback throws. The counters are
+     *             updated regardless.
+     */
+    void record_allocation(size_type n_bytes) {
+        const auto live = m_live_.fetch_add(n_bytes) + n_bytes;
+        m_n_allocations_.fetch_add(1, std::memory_order_relaxed);
+
+        auto peak = m_peak_.load(std::memory_order_relaxed);
+        while(live > peak && !m_peak_.compare_exchange_weak(peak, live)) {}
+
+        const auto limit = m_limit_.load(std::memory_order_relaxed);
+        if(limit && live >= limit && live - n_bytes < limit) notify_(live);
+    }
+
+    /** @brief Records that @p n_bytes were released.
+     *
+     *  @param[in] n_bytes The number of bytes which were released.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void record_deallocation(size_type n_bytes) noexcept {
+        m_live_.fetch_sub(n_bytes);
+        m_n_deallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// The number of bytes currently allocated
+    size_type live_bytes() const noexcept { return m_live_.load(); }
+
+    /// The largest value live_bytes() has had (since the last reset_peak)
+    size_type peak_bytes() const noexcept { return m_peak_.load(); }
+
+    /// The number of allocations made
+    size_type n_allocations() const noexcept {
+        return m_n_allocations_.load();
+    }
+
+    /// The number of deallocations made
+    size_type n_deallocations() const noexcept {
+        return m_n_deallocations_.load();
+    }
+
+    /// Sets peak_bytes() to the current value of live_bytes()
+    void reset_peak() noexcept { m_peak_.store(m_live_.load()); }
+
+    /** @brief Sets a soft limit and the callback to invoke when it is crossed
+     *
+     *  @param[in] limit    The limit in bytes. A limit of 0 disables the soft
+     *                      limit.
+     *  @param[in] callback The function to call when an allocation makes
+     *                      live_bytes() reach or exceed @p limit.
+     *
+     *  @throw std::bad_alloc if copying the callback fails. Strong throw
+     *                        guarantee.
+     */
+    void set_soft_limit(size_type limit, callback_type callback) {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_callback_ = std::move(callback);
+        m_limit_.store(limit);
+    }
+
+    /// Removes the soft limit
+    void clear_soft_limit() noexcept { m_limit_.store(0); }
+
+    /// The soft limit in bytes (0 if there is none)
+    size_type soft_limit() const noexcept { return m_limit_.load(); }
+
+private:
+    /// Invokes the callback (if any) for the given live bytes
+    void notify_(size_type live) {
+        callback_type callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_);
+            callback = m_callback_;
+        }
+        if(callback) callback(live, m_limit_.load());
+    }
+
+    /// Bytes currently allocated
+    std::atomic<size_type> m_live_{0};
+
+    /// Largest value of m_live_
+    std::atomic<size_type> m_peak_{0};
+
+    /// Number of allocations
+    std::atomic<size_type> m_n_allocations_{0};
+
+    /// Number of deallocations
+    std::atomic<size_type> m_n_deallocations_{0};
+
+    /// The soft limit, 0 means none
+    std::atomic<size_type> m_limit_{0};
+
+    /// Guards m_callback_
+    std::mutex m_mutex_;
+
+    /// Called when the soft limit is crossed
+    callback_type m_callback_;
+};
+
+} // namespace parallelzone::hardware
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace parallelzone::hardware {
+
+/** @brief Describes where on a NUMA machine memory should be placed.
+ *
+ *  On multi-socket machines each socket has its own memory (its own NUMA
+ *  node). Memory on another socket's node can be used, but is slower to
+ *  access. By default Linux places a page on the node of the thread which
+ *  first touches it ("first touch"), which goes badly when one thread
+ *  initializes data which other threads then work on. NUMAPolicy describes
+ *  one of three placement policies:
+ *
+ *  - local: the kernel's default, pages go on the node of the thread which
+ *    first touches them.
+ *  - interleave: pages are spread round-robin over a set of nodes (all
+ *    nodes by default), which evens out bandwidth for shared data.
+ *  - bind: pages are placed on a given node (or set of nodes), e.g., the
+ *    node of the CPU which will use them (see CPU::numa_node_of).
+ *
+ *  Policies are applied to allocations made through allocators obtained with
+ *  `RAM::allocator<T>(policy)`, or to every allocation of a thread with
+ *  apply_to_thread(). Placement uses the `mbind`/`set_mempolicy` system
+ *  calls directly (i.e., libnuma is not needed). On machines with a single
+ *  NUMA node, or where the system calls are not available, policies are
+ *  silently ignored and memory is allocated normally.
+ *
+ *  Only whole pages can be placed, so allocations smaller than a page (or
+ *  needing more than page alignment) always use the local policy, as do all
+ *  allocations on machines with a single NUMA node (see is_placed).
+ *  Allocations which are placed are mapped directly from the operating
+ *  system, so policies are meant for large, long-lived buffers.
+ */
+class NUMAPolicy {
+public:
+    /// Unsigned integral type used for sizes and node ids
+    using size_type = std::size_t;
+
+    /// Type used to hold a set of NUMA node ids
+    using node_container = std::vector<size_type>;
+
+    /// The placement policies
+    enum class kind_type { local, interleave, bind };
+
+    /// Node ids must be less than this
+    static constexpr size_type max_nodes = 64;
+
+    /** @brief Creates the local policy.
+     *
+     *  @throw None No throw guarantee.
+     */
+    NUMAPolicy() noexcept = default;
+
+    /// Same as the default ctor, provided for readability
+    static NUMAPolicy local() noexcept { return NUMAPolicy(); }
+
+    /** @brief Creates a policy interleaving pages over all NUMA nodes.
+     *
+     *  The nodes are those online when the memory is allocated.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static NUMAPolicy interleave() noexcept;
+
+    /** @brief Creates a policy interleaving pages over @p nodes.
+     *
+     *  @param[in] nodes The ids of the NUMA nodes to use. Must be non-empty.
+     *
+     *  @throw std::out_of_range if a node id is not less than max_nodes.
+     *                           Strong throw guarantee.
+     *  @throw std::runtime_error if @p nodes is empty. Strong throw guarantee.
+     */
+    static NUMAPolicy interleave(const node_container& nodes);
+
+    /** @brief Creates a policy placing pages on NUMA node @p node.
+     *
+     *  @param[in] node The id of the NUMA node, e.g., as returned by
+     *                  CPU::numa_node_of.
+     *
+     *  @throw std::out_of_range if @p node is not less than max_nodes. Strong
+     *                           throw guarantee.
+     */
+    static NUMAPolicy bind(size_type node);
+
+    /** @brief Creates a policy restricting pages to the NUMA nodes @p nodes.
+     *
+     *  @param[in] nodes The ids of the NUMA nodes to use. Must be non-empty.
+     *
+     *  @throw std::out_of_range if a node id is not less than max_nodes.
+     *                           Strong throw guarantee.
+     *  @throw std::runtime_error if @p nodes is empty. Strong throw guarantee.
+     */
+    static NUMAPolicy bind(const node_container& nodes);
+
+    /// Which placement policy *this is
+    kind_type kind() const noexcept { return m_kind_; }
+
+    /** @brief The nodes the policy applies to.
+     *
+     *  @return The node ids in increasing order. The result is empty for the
+     *          local policy and for interleave() (meaning all nodes).
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the result.
+     *                        Strong throw guarantee.
+     */
+    node_container nodes() const;
+
+    /** @brief Allocates @p n_bytes of memory placed according to *this.
+     *
+     *  @param[in] n_bytes   The number of bytes to allocate.
+     *  @param[in] alignment The required alignment (a power of two).
+     *
+     *  @return A pointer to the (uninitialized) memory. It must be released
+     *          with deallocate, passing the same sizes.
+     *
+     *  @throw std::bad_alloc if the memory can not be allocated. Strong throw
+     *                        guarantee.
+     */
+    void* allocate(size_type n_bytes, size_type alignment) const {
+        if(is_placed(n_bytes, alignment)) return map_(n_bytes);
+        if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(n_bytes, std::align_val_t(alignment));
+        return ::operator new(n_bytes);
+    }
+
+    /** @brief Releases memory obtained from allocate.
+     *
+     *  @param[in] p         The pointer returned by allocate.
+     *  @param[in] n_bytes   The value passed to allocate.
+     *  @param[in] alignment The value passed to allocate.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void deallocate(void* p, size_type n_bytes,
+                    size_type alignment) const noexcept {
+        if(is_placed(n_bytes, alignment)) return unmap_(p, n_bytes);
+        if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(p, n_bytes, std::align_val_t(alignment));
+        else
+            ::operator delete(p, n_bytes);
+    }
+
+    /** @brief Will an allocation with the given sizes be placed?
+     *
+     *  Placed allocations are mapped from the operating system and have *this
+     *  applied to them. The others come from operator new. Only allocations
+     *  of at least a page, needing at most page alignment, made under a
+     *  policy other than local, on a machine with more than one NUMA node are
+     *  placed.
+     *
+     *  @param[in] n_bytes   The number of bytes to allocate.
+     *  @param[in] alignment The required alignment.
+     *
+     *  @return True if allocate would place the allocation and false
+     *          otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool is_placed(size_type n_bytes, size_type alignment) const noexcept {
+        return m_kind_ != kind_type::local && n_bytes >= page_size() &&
+               alignment <= page_size() && multi_node_();
+    }
+
+    /** @brief Makes *this the policy for all allocations of the calling
+     *         thread.
+     *
+     *  This affects every allocation the calling thread makes from now on
+     *  (pages are placed when they are first touched), including those not
+     *  made through RAM allocators. Applying the local policy restores the
+     *  kernel's default.
+     *
+     *  @return True if the policy was applied, false if it was ignored (a
+     *          single NUMA node, or the system call is unavailable).
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool apply_to_thread() const noexcept;
+
+    /** @brief The size of a page, i.e., the granularity of placement.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static size_type page_size() noexcept;
+
+    /// Policies are equal if they are of the same kind with the same nodes
+    bool operator==(const NUMAPolicy& rhs) const noexcept {
+        return m_kind_ == rhs.m_kind_ && m_mask_ == rhs.m_mask_;
+    }
+
+    /// Negation of operator==
+    bool operator!=(const NUMAPolicy& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    /// Type of the bit mask of nodes
+    using mask_type = std::uint64_t;
+
+    /// Used by the factories
+    NUMAPolicy(kind_type kind, mask_type mask) noexcept :
+      m_kind_(kind), m_mask_(mask) {}
+
+    /// Converts @p nodes to a mask, throwing if it is empty or out of range
+    static mask_type make_mask_(const node_container& nodes);
+
+    /// True if there is more than one NUMA node online
+    static bool multi_node_() noexcept;
+
+    /// Maps @p n_bytes from the OS and applies *this to them
+    void* map_(size_type n_bytes) const;
+
+    /// Returns memory obtained from map_
+    static void unmap_(void* p, size_type n_bytes) noexcept;
+
+    /// The policy
+    kind_type m_kind_ = kind_type::local;
+
+    /// Bit i is set if node i is used, 0 means all nodes
+    mask_type m_mask_ = 0;
+};
+
+} // namespace parallelzone::hardware
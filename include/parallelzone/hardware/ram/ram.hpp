@@ -17,6 +17,9 @@
 #pragma once
 #include <memory>
 #include <optional>
+#include <parallelzone/hardware/ram/numa_policy.hpp>
+#include <parallelzone/hardware/ram/tracking_allocator.hpp>
+#include <parallelzone/mpi_helpers/binary_buffer/buffer_pool.hpp>
 #include <parallelzone/mpi_helpers/binary_buffer/binary_view.hpp>
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
 #include <vector>
@@ -34,9 +37,10 @@ struct RAMPIMPL;
  *  usage, and for facilitating getting/setting data from/to remote RAM objects
  *  (i.e., RAM-based one-to-one-, one-to-all, and all-to-one MPI calls).
  *
- *  With regards to tracking memory, Version 1.0 of the RAM class is only
- *  capable of telling the user how much RAM the current process has direct
- *  access to. Better memory tracking requires writing allocators which update
+ *  With regards to tracking memory, the RAM class can tell the user how much
+ *  RAM the current process has direct access to, how much of it is free, and
+ *  how much the current process is using. These values come from the
+ *  operating system. Finer grained tracking requires allocators which update
  *  the RAM instance when memory is freed (and having the downstream classes
  *  use the allocators).
  *
@@ -55,6 +59,28 @@ public:
     ///
     using const_binary_reference = mpi_helpers::BinaryView;
 
+    /// Type of the object tracking allocations made through *this
+    using tracker_type = AllocationTracker;
+
+    /// Type of a reference to the tracker
+    using tracker_reference = tracker_type&;
+
+    /// Type of the pool temporary communication buffers are drawn from
+    using buffer_pool_type = mpi_helpers::BufferPool;
+
+    /// Type of a reference to the buffer pool
+    using buffer_pool_reference = buffer_pool_type&;
+
+    /// Type of the allocators handed out by *this
+    template<typename T>
+    using allocator_type = TrackingAllocator<T>;
+
+    /// Type describing where on a NUMA machine memory is placed
+    using numa_policy_type = NUMAPolicy;
+
+    /// Type used to hold a set of NUMA node ids
+    using numa_node_container = numa_policy_type::node_container;
+
     // -------------------------------------------------------------------------
     // -- Ctors, Assignment, Dtor
     // -------------------------------------------------------------------------
@@ -130,17 +156,211 @@ public:
     /** @brief How much memory is managed by *this.
      *
      *  This method returns the total amount of memory managed by *this. The
-     *  returned value does not account for memory currently in use. The
-     *  exact definition of the returned value is XXX. TODO: specify once
-     *  implemented, I'm assuming it'll either be what the vendor says it is or
-     *  it'll be the amount of the memory the OS can actually use.
+     *  returned value does not account for memory currently in use. It is the
+     *  physical memory of the node (as reported by sysconf), capped by the
+     *  memory limit of the process's cgroup (if there is one). Since all
+     *  processes on a node share the node's memory, the value is the same for
+     *  all processes on the node.
      *
+     *  @return The total amount of memory managed by *this, in bytes. Empty
+     *          instances return 0.
      *
-     *  @return The total amount of memory managed by *this. Existing
-     *           allocations
+     *  @throw None No throw guarantee.
      */
     size_type total_space() const noexcept;
 
+    /** @brief The node *this is on.
+     *
+     *  Nodes are numbered by the RuntimeView *this was obtained from, see
+     *  RuntimeView::node_of. RAM on different nodes is never the same RAM.
+     *
+     *  @return The index of the node *this is on. Empty instances return 0.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type node() const noexcept;
+
+    /** @brief How much of the memory can still be allocated.
+     *
+     *  The value is re-queried on each call (from /proc/meminfo and the
+     *  cgroup memory controller), so it reflects allocations made by any
+     *  process on the node since the last call. It is the memory which can be
+     *  allocated without swapping (MemAvailable), capped by the head room left
+     *  in the process's cgroup. Like total_space(), the value is for the whole
+     *  node, i.e., processes sharing the node compete for it.
+     *
+     *  @return The free memory in bytes. Empty instances return 0.
+     *
+     *  @throw std::runtime_error if *this does not belong to the current
+     *                            process. Strong throw guarantee.
+     */
+    size_type free_space() const;
+
+    /** @brief How much memory the current process is using.
+     *
+     *  This is the resident set size of the process, re-queried on each call.
+     *
+     *  @return The memory used by the process which owns *this, in bytes.
+     *          Empty instances return 0.
+     *
+     *  @throw std::runtime_error if *this does not belong to the current
+     *                            process. Strong throw guarantee.
+     */
+    size_type used_space() const;
+
+    /** @brief The most memory the current process has used at once.
+     *
+     *  This is the peak resident set size of the process, re-queried on each
+     *  call.
+     *
+     *  @return The peak memory used by the process which owns *this, in
+     *          bytes. Empty instances return 0.
+     *
+     *  @throw std::runtime_error if *this does not belong to the current
+     *                            process. Strong throw guarantee.
+     */
+    size_type high_water_mark() const;
+
+    // -------------------------------------------------------------------------
+    // -- NUMA topology
+    // -------------------------------------------------------------------------
+
+    /** @brief The NUMA nodes the memory is divided into.
+     *
+     *  @return The ids of the online NUMA nodes, in increasing order. Machines
+     *          without NUMA support report a single node, 0. Empty instances
+     *          return an empty container.
+     *
+     *  @throw std::runtime_error if *this does not belong to the current
+     *                            process. Strong throw guarantee.
+     */
+    numa_node_container numa_nodes() const;
+
+    /** @brief The amount of memory installed on NUMA node @p node.
+     *
+     *  @param[in] node The id of a NUMA node, i.e., a member of numa_nodes().
+     *
+     *  @return The size of the node's memory in bytes. If the size can not be
+     *          determined and there is only one node, total_space() is
+     *          returned.
+     *
+     *  @throw std::out_of_range if @p node is not a member of numa_nodes().
+     *                           Strong throw guarantee.
+     *  @throw std::runtime_error if *this is empty, or does not belong to the
+     *                            current process. Strong throw guarantee.
+     */
+    size_type numa_node_space(size_type node) const;
+
+    /** @brief The NUMA node which holds the memory at @p p.
+     *
+     *  This can be used to verify where memory actually ended up. If the page
+     *  containing @p p has not been touched yet, it is faulted in (i.e.,
+     *  placed according to the policy in effect).
+     *
+     *  @param[in] p An address in memory allocated by the current process.
+     *
+     *  @return The id of the node, or std::nullopt if the operating system
+     *          can not tell.
+     *
+     *  @throw std::runtime_error if *this is empty, or does not belong to the
+     *                            current process. Strong throw guarantee.
+     */
+    std::optional<size_type> numa_node_of(const void* p) const;
+
+    // -------------------------------------------------------------------------
+    // -- Allocation tracking
+    // -------------------------------------------------------------------------
+
+    /** @brief Returns an allocator which tracks its allocations with *this.
+     *
+     *  The returned allocator satisfies the standard library's Allocator
+     *  requirements, so it can be used with any standard container, e.g.:
+     *
+     *  @code
+     *  const auto& ram = rt.my_resource_set().ram();
+     *  std::vector<double, RAM::allocator_type<double>> v(ram.allocator<double>());
+     *  @endcode
+     *
+     *  All allocators obtained from *this (and from copies of *this) report
+     *  to the same tracker, see tracker().
+     *
+     *  @tparam T The type of the objects to allocate.
+     *
+     *  @return An allocator reporting to tracker().
+     *
+     *  @throw std::runtime_error if *this is empty. Strong throw guarantee.
+     */
+    template<typename T>
+    allocator_type<T> allocator() const {
+        return allocator_type<T>(tracker_pointer_());
+    }
+
+    /** @brief Returns an allocator which tracks its allocations with *this
+     *         and places them according to @p policy.
+     *
+     *  This is the same as allocator(), except that large allocations made
+     *  through the returned allocator are placed on the NUMA node(s) called
+     *  for by @p policy, e.g., to put a thread's working set on the thread's
+     *  NUMA node:
+     *
+     *  @code
+     *  const auto& cpu = rt.my_resource_set().cpu();
+     *  auto node       = cpu.numa_node_of(my_cpu);
+     *  auto alloc      = ram.allocator<double>(NUMAPolicy::bind(node));
+     *  @endcode
+     *
+     *  On machines with a single NUMA node the policy has no effect.
+     *
+     *  @tparam T The type of the objects to allocate.
+     *
+     *  @param[in] policy Where to place the memory.
+     *
+     *  @return An allocator reporting to tracker() and using @p policy.
+     *
+     *  @throw std::runtime_error if *this is empty. Strong throw guarantee.
+     */
+    template<typename T>
+    allocator_type<T> allocator(numa_policy_type policy) const {
+        return allocator_type<T>(tracker_pointer_(), policy);
+    }
+
+    /** @brief The counters for allocations made through allocator().
+     *
+     *  The tracker holds the live bytes, peak bytes, and allocation counts of
+     *  every allocator handed out by *this. It can also be given a soft limit
+     *  which triggers a callback. The tracker is shared by copies of *this.
+     *
+     *  @return A reference to the tracker.
+     *
+     *  @throw std::runtime_error if *this is empty. Strong throw guarantee.
+     */
+    tracker_reference tracker() const;
+
+    /** @brief The pool communication buffers of this process are drawn from.
+     *
+     *  BinaryBuffer instances, and the temporaries CommPP needs for
+     *  collectives, get their memory from a size-class pool so that
+     *  iterative communication does not repeatedly go to the system
+     *  allocator. This method exposes that pool, e.g., to inspect its
+     *  statistics, to install a hook which fires when the pool has to go to
+     *  the system allocator, or to trim it:
+     *
+     *  @code
+     *  auto& pool = rt.my_resource_set().ram().buffer_pool();
+     *  pool.reset_stats();
+     *  do_iteration();
+     *  assert(pool.stats().n_misses == 0);
+     *  @endcode
+     *
+     *  All RAM instances describing the current process share the pool.
+     *
+     *  @return A reference to the pool.
+     *
+     *  @throw std::runtime_error if *this is empty or does not belong to the
+     *                            current process. Strong throw guarantee.
+     */
+    buffer_pool_reference buffer_pool() const;
+
     // -------------------------------------------------------------------------
     // -- MPI all-to-one operations
     // -------------------------------------------------------------------------
@@ -209,8 +429,9 @@ public:
     /** @brief Determines if *this is value equal to @p rhs
      *
      *  Two RAM instances are value equal if they represent the same physical
-     *  RAM. In practice this means that the RAM instances belong to the same
-     *  ResourceSet and have the same total amount of space.
+     *  RAM. In practice this means that the RAM instances are on the same node
+     *  and have the same total amount of space. Hence, the RAM of ResourceSets
+     *  whose ranks share a node compare equal.
      *
      *  @param[in] rhs The RAM instance we are comparing to.
      *
@@ -239,6 +460,15 @@ private:
     /// Code factorization for asserting that the PIMPL is non-null
     void assert_pimpl_() const;
 
+    /// Code factorization for asserting that *this belongs to this process
+    void assert_local_() const;
+
+    /// Code factorization for asserting that *this is non-empty and local
+    void assert_non_empty_local_() const;
+
+    /// Returns the pointer to the tracker, throws if *this is empty
+    std::shared_ptr<tracker_type> tracker_pointer_() const;
+
     /// The object actually implementing *this
     pimpl_pointer m_pimpl_;
 };
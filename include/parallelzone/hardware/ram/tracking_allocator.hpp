@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <memory>
+#include <new>
+#include <parallelzone/hardware/ram/allocation_tracker.hpp>
+#include <parallelzone/hardware/ram/numa_policy.hpp>
+#include <stdexcept>
+
+namespace parallelzone::hardware {
+
+/** @brief A standard library compatible allocator which reports to an
+ *         AllocationTracker.
+ *
+ *  TrackingAllocator instances are obtained from RAM::allocator. Memory is
+ *  obtained from the global `operator new`; the allocator simply records how
+ *  much memory was requested/released with the tracker of the RAM instance it
+ *  came from. The allocator can therefore be used with any standard container
+ *  (e.g., `std::vector<double, TrackingAllocator<double>>`).
+ *
+ *  The allocator may also carry a NUMAPolicy, in which case large
+ *  allocations are placed on the NUMA node(s) the policy calls for (see
+ *  NUMAPolicy for details).
+ *
+ *  Two TrackingAllocators compare equal if they report to the same tracker
+ *  and have the same NUMA policy; memory allocated by one can be released by
+ *  the other.
+ *
+ *  @tparam T The type of the objects being allocated.
+ */
+template<typename T>
+class TrackingAllocator {
+public:
+    /// Type of the objects being allocated
+    using value_type = T;
+
+    /// Unsigned integral type used for counting
+    using size_type = std::size_t;
+
+    /// Type of a pointer to the tracker
+    using tracker_pointer = std::shared_ptr<AllocationTracker>;
+
+    /// Type describing where the memory is placed
+    using policy_type = NUMAPolicy;
+
+    /// Propagate on copy/move/swap so containers keep reporting to one tracker
+    using propagate_on_container_copy_assignment = std::true_type;
+
+    /// Propagate on copy/move/swap so containers keep reporting to one tracker
+    using propagate_on_container_move_assignment = std::true_type;
+
+    /// Propagate on copy/move/swap so containers keep reporting to one tracker
+    using propagate_on_container_swap = std::true_type;
+
+    /** @brief Makes an allocator which reports to @p tracker.
+     *
+     *  @param[in] tracker The tracker to report to. Must be non-null.
+     *  @param[in] policy  Where to place the memory. Defaults to the local
+     *                     (i.e., the kernel's default) policy.
+     *
+     *  @throw std::runtime_error if @p tracker is null. Strong throw
+     *                            guarantee.
+     */
+    explicit TrackingAllocator(tracker_pointer tracker,
+                               policy_type policy = policy_type{}) :
+      m_tracker_(std::move(tracker)), m_policy_(policy) {
+        if(!m_tracker_)
+            throw std::runtime_error("TrackingAllocator requires a tracker");
+    }
+
+    /// Rebinding ctor, required by the Allocator named requirement
+    template<typename U>
+    TrackingAllocator(const TrackingAllocator<U>& other) noexcept :
+      m_tracker_(other.tracker()), m_policy_(other.policy()) {}
+
+    /** @brief Allocates space for @p n objects of type T.
+     *
+     *  @param[in] n The number of objects.
+     *
+     *  @return A pointer to uninitialized storage for @p n objects.
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     *  @throw ??? If the tracker's soft limit callback throws. The memory is
+     *             released (and the release recorded) before the exception
+     *             propagates.
+     */
+    T* allocate(size_type n) {
+        if(n > std::allocator_traits<std::allocator<T>>::max_size(
+                 std::allocator<T>{}))
+            throw std::bad_array_new_length();
+        const auto n_bytes = n * sizeof(T);
+        T* p = static_cast<T*>(m_policy_.allocate(n_bytes, alignof(T)));
+        try {
+            m_tracker_->record_allocation(n_bytes);
+        } catch(...) {
+            deallocate(p, n);
+            throw;
+        }
+        return p;
+    }
+
+    /** @brief Releases storage obtained from allocate.
+     *
+     *  @param[in] p The pointer returned by allocate.
+     *  @param[in] n The value passed to allocate.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void deallocate(T* p, size_type n) noexcept {
+        const auto n_bytes = n * sizeof(T);
+        m_policy_.deallocate(p, n_bytes, alignof(T));
+        m_tracker_->record_deallocation(n_bytes);
+    }
+
+    /// The tracker *this reports to
+    const tracker_pointer& tracker() const noexcept { return m_tracker_; }
+
+    /// Where *this places memory
+    const policy_type& policy() const noexcept { return m_policy_; }
+
+private:
+    /// The tracker to report to
+    tracker_pointer m_tracker_;
+
+    /// Where to place the memory
+    policy_type m_policy_;
+};
+
+/** @brief Determines if two TrackingAllocators report to the same tracker
+ *         and place memory the same way.
+ *  @relates TrackingAllocator
+ *
+ *  @return True if memory allocated by @p lhs can be released by @p rhs.
+ *
+ *  @throw None No throw guarantee.
+ */
+template<typename T, typename U>
+bool operator==(const TrackingAllocator<T>& lhs,
+                const TrackingAllocator<U>& rhs) noexcept {
+    return lhs.tracker() == rhs.tracker() && lhs.policy() == rhs.policy();
+}
+
+/** @brief Determines if two TrackingAllocators report to different trackers.
+ *  @relates TrackingAllocator
+ *
+ *  @return The negation of operator==.
+ *
+ *  @throw None No throw guarantee.
+ */
+template<typename T, typename U>
+bool operator!=(const TrackingAllocator<T>& lhs,
+                const TrackingAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+} // namespace parallelzone::hardware
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+
+/** @file binary_log.hpp
+ *
+ *  Tools for reading the binary logs written by the loggers made with
+ *  LoggerFactory::binary_file_logger.
+ */
+
+namespace parallelzone {
+
+/** @brief How decode_binary_logs prints records.
+ *
+ *  - text: One line per record, "[time] [Rank r] [severity] message", with
+ *          the time in UTC.
+ *  - json: One JSON object per line (i.e., JSON Lines) with the members
+ *          "time_ns" (nanoseconds since the system epoch), "rank",
+ *          "severity", and "message". Records which were logged with a
+ *          template also have "template" and "args" members.
+ */
+enum class binary_log_format { text, json };
+
+/** @brief Merges binary logs and prints their records.
+ *
+ *  The records of all of @p files are printed to @p os in time stamp order.
+ *  Records are read one at a time, so the files need not fit in memory. A
+ *  file which ends part way through a record (e.g., because the program
+ *  crashed while writing it) is treated as if it ended just before that
+ *  record.
+ *
+ *  The files must have been written by a machine with the same byte order
+ *  as the current one.
+ *
+ *  @param[in] files The binary logs to merge, usually one per rank.
+ *  @param[in] os Where the records are printed.
+ *  @param[in] format How the records are printed. Defaults to
+ *                    binary_log_format::text.
+ *
+ *  @throw std::runtime_error if a file can not be opened, is not a binary
+ *                            log, or is corrupted. Records printed before
+ *                            the error was found remain in @p os.
+ */
+void decode_binary_logs(const std::vector<std::string>& files,
+                        std::ostream& os,
+                        binary_log_format format = binary_log_format::text);
+
+} // namespace parallelzone
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace parallelzone::detail_ {
+
+/** @brief The arguments of a log message, packed into a byte buffer.
+ *
+ *  Logger::log(severity, fmt, args...) packs its arguments into a PackedArgs
+ *  object instead of formatting them. Backends which only deal in text call
+ *  format to get the message, but structured backends can store the
+ *  arguments as is and defer the formatting (possibly to a different
+ *  program).
+ *
+ *  Each argument is stored as a one byte tag followed by its value:
+ *
+ *  - Signed integers: tag_type::int64, then an std::int64_t.
+ *  - Unsigned integers: tag_type::uint64, then an std::uint64_t.
+ *  - Floating-point values: tag_type::float64, then a double.
+ *  - bool: tag_type::boolean, then one byte (0 or 1).
+ *  - Characters: tag_type::character, then the character.
+ *  - Strings: tag_type::string, then the length as an std::uint32_t, then
+ *    the characters.
+ *
+ *  Values are stored in the byte order of the machine which packed them.
+ *  Arguments of any other type are printed with their operator<< and stored
+ *  as strings.
+ */
+class PackedArgs {
+public:
+    /// Type of a byte in the buffer
+    using byte_type = std::byte;
+
+    /// Type of the buffer
+    using buffer_type = std::vector<byte_type>;
+
+    /// Unsigned type used for sizes
+    using size_type = std::size_t;
+
+    /// Identifies the type of a packed argument
+    enum class tag_type : std::uint8_t {
+        int64,
+        uint64,
+        float64,
+        boolean,
+        character,
+        string
+    };
+
+    /** @brief Appends @p value to the buffer.
+     *
+     *  @tparam T The type of @p value.
+     *
+     *  @param[in] value The argument to pack.
+     *
+     *  @throw std::bad_alloc if there is a problem growing the buffer. Weak
+     *                        throw guarantee.
+     *  @throw ??? If @p value is printed with its operator<< and that throws.
+     *             Weak throw guarantee.
+     */
+    template<typename T>
+    void push_back(T&& value);
+
+    /// The number of packed arguments
+    size_type size() const noexcept { return m_size_; }
+
+    /// The packed arguments
+    const buffer_type& data() const noexcept { return m_buffer_; }
+
+    /** @brief Makes the message by replacing each "{}" in @p fmt with the
+     *         next argument.
+     *
+     *  The arguments are printed the same way Logger::log(severity, fmt,
+     *  args...) documents, i.e., as if by their operator<<.
+     *
+     *  @param[in] fmt The message template.
+     *
+     *  @return The formatted message.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the message.
+     *                        Strong throw guarantee.
+     */
+    std::string format(std::string_view fmt) const;
+
+    /** @brief Formats @p fmt with arguments packed by a PackedArgs object.
+     *
+     *  This overload is used when the arguments were packed by another
+     *  process and read back as raw bytes.
+     *
+     *  @param[in] fmt The message template.
+     *  @param[in] begin The first byte of the packed arguments.
+     *  @param[in] end One past the last byte of the packed arguments.
+     *
+     *  @return The formatted message.
+     *
+     *  @throw std::runtime_error if the bytes are not valid packed
+     *                            arguments. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the message.
+     *                        Strong throw guarantee.
+     */
+    static std::string format(std::string_view fmt, const byte_type* begin,
+                              const byte_type* end);
+
+    /** @brief Calls @p visitor with each argument in [begin, end).
+     *
+     *  Integers are passed as std::int64_t or std::uint64_t, floating-point
+     *  values as double, bools as bool, characters as char, and strings as
+     *  std::string_view.
+     *
+     *  @param[in] begin The first byte of the packed arguments.
+     *  @param[in] end One past the last byte of the packed arguments.
+     *  @param[in] visitor A callable accepting each of the above types.
+     *
+     *  @throw std::runtime_error if the bytes are not valid packed
+     *                            arguments. Same throw guarantee as
+     *                            @p visitor.
+     */
+    template<typename Visitor>
+    static void visit(const byte_type* begin, const byte_type* end,
+                      Visitor&& visitor);
+
+private:
+    /// Appends the tag @p tag followed by the bytes of @p value
+    template<typename T>
+    void append_(tag_type tag, const T& value);
+
+    /// Appends a string argument
+    void append_string_(std::string_view value);
+
+    /// Throws a std::runtime_error about corrupted arguments
+    [[noreturn]] static void corrupt_();
+
+    /// The number of packed arguments
+    size_type m_size_ = 0;
+
+    /// The packed arguments
+    buffer_type m_buffer_;
+};
+
+// -----------------------------------------------------------------------------
+// -- Inline Implementations
+// -----------------------------------------------------------------------------
+
+template<typename T>
+void PackedArgs::push_back(T&& value) {
+    using clean_type = std::decay_t<T>;
+    if constexpr(std::is_same_v<clean_type, bool>) {
+        append_(tag_type::boolean, std::uint8_t(value));
+    } else if constexpr(std::is_same_v<clean_type, char> ||
+                        std::is_same_v<clean_type, signed char> ||
+                        std::is_same_v<clean_type, unsigned char>) {
+        append_(tag_type::character, char(value));
+    } else if constexpr(std::is_integral_v<clean_type> &&
+                        std::is_signed_v<clean_type>) {
+        append_(tag_type::int64, std::int64_t(value));
+    } else if constexpr(std::is_integral_v<clean_type>) {
+        append_(tag_type::uint64, std::uint64_t(value));
+    } else if constexpr(std::is_floating_point_v<clean_type>) {
+        append_(tag_type::float64, double(value));
+    } else if constexpr(std::is_convertible_v<const clean_type&,
+                                              std::string_view>) {
+        append_string_(std::string_view(value));
+    } else {
+        std::ostringstream ss;
+        ss << value;
+        append_string_(ss.str());
+    }
+    ++m_size_;
+}
+
+template<typename Visitor>
+void PackedArgs::visit(const byte_type* begin, const byte_type* end,
+                       Visitor&& visitor) {
+    // Copies the next sizeof(U) bytes into a U
+    auto read = [&](auto& value) {
+        if(end - begin < std::ptrdiff_t(sizeof(value))) corrupt_();
+        std::memcpy(&value, begin, sizeof(value));
+        begin += sizeof(value);
+    };
+
+    while(begin != end) {
+        std::uint8_t tag;
+        read(tag);
+        switch(tag_type(tag)) {
+            case(tag_type::int64): {
+                std::int64_t value;
+                read(value);
+                visitor(value);
+                break;
+            }
+            case(tag_type::uint64): {
+                std::uint64_t value;
+                read(value);
+                visitor(value);
+                break;
+            }
+            case(tag_type::float64): {
+                double value;
+                read(value);
+                visitor(value);
+                break;
+            }
+            case(tag_type::boolean): {
+                std::uint8_t value;
+                read(value);
+                visitor(value != 0);
+                break;
+            }
+            case(tag_type::character): {
+                char value;
+                read(value);
+                visitor(value);
+                break;
+            }
+            case(tag_type::string): {
+                std::uint32_t n;
+                read(n);
+                if(std::size_t(end - begin) < n) corrupt_();
+                visitor(std::string_view(
+                  reinterpret_cast<const char*>(begin), n));
+                begin += n;
+                break;
+            }
+            default: corrupt_();
+        }
+    }
+}
+
+template<typename T>
+void PackedArgs::append_(tag_type tag, const T& value) {
+    const auto offset = m_buffer_.size();
+    m_buffer_.resize(offset + 1 + sizeof(T));
+    m_buffer_[offset] = byte_type(tag);
+    std::memcpy(m_buffer_.data() + offset + 1, &value, sizeof(T));
+}
+
+} // namespace parallelzone::detail_
@@ -18,11 +18,15 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <string_view>
 
 namespace parallelzone {
 namespace detail_ {
 /// Logger Implementation Class
 class LoggerPIMPL;
+
+/// The arguments of a log message, packed for the backend
+class PackedArgs;
 } // namespace detail_
 
 /** @brief A class to manage various loggers under a unified API
@@ -253,6 +257,53 @@ public:
      */
     Logger& log(severity s, const_string_reference msg);
 
+    /** @brief Formats and logs a message, but only if it would be logged.
+     *
+     *  Building a message (concatenating strings, converting numbers, etc.)
+     *  can cost more than logging it, which is wasted effort if the message
+     *  is then filtered out. This method first checks should_log(s) and only
+     *  if that is true hands @p fmt and the arguments to the backend.
+     *
+     *  The message is @p fmt with each occurrence of "{}" replaced, in
+     *  order, by the next argument, as printed by its `operator<<`. If there
+     *  are more occurrences of "{}" than arguments, the extra occurrences are
+     *  left as is. Arguments without a matching "{}" are not printed. Most
+     *  backends build the message right away, but structured backends may
+     *  store @p fmt and the arguments and defer building the message.
+     *
+     *  @tparam T The type of the first argument.
+     *  @tparam Args The types of the remaining arguments.
+     *
+     *  @param[in] s How important is this message?
+     *  @param[in] fmt The message, with "{}" where the arguments go.
+     *  @param[in] arg0 The argument to print in place of the first "{}".
+     *  @param[in] args The arguments to print in place of the remaining "{}".
+     *
+     *  @return *this after logging the message.
+     *
+     *  @throw std::bad_alloc if there is a problem building the message.
+     *                        Strong throw guarantee.
+     *  @throw ??? Throws if an argument's `operator<<` or the implementation
+     *             throws. Same throw guarantee.
+     */
+    template<typename T, typename... Args>
+    Logger& log(severity s, std::string_view fmt, T&& arg0, Args&&... args);
+
+    /** @brief Determines if a message with severity @p s would be logged.
+     *
+     *  This is a cheap query of the threshold of the backend. It can be used
+     *  to skip the work of building messages which would be discarded. Null
+     *  loggers log nothing, so for them this method always returns false.
+     *
+     *  @param[in] s The severity of the hypothetical message.
+     *
+     *  @return True if a message with severity @p s would be logged and
+     *          false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool should_log(severity s) const noexcept;
+
     /** @brief Logs a message with info severity, but streaming semantics.
      *
      *  For convenience we allow users to stream log messages. At present
@@ -270,6 +321,17 @@ public:
      */
     Logger& operator<<(const_string_reference msg);
 
+    /** @brief Writes out every message logged to *this so far.
+     *
+     *  Backends are free to buffer messages, or to write them from another
+     *  thread. This method blocks until every message which was logged to
+     *  *this before the call has been handed to the sink and the sink has
+     *  been flushed. If *this is a null logger this method is a no-op.
+     *
+     *  @throw ??? Throws if the implementation throws. Same throw guarantee.
+     */
+    void flush();
+
     /** @brief Exchanges the state of two Logger instances.
      *
      *  This method exchanges the state of *this with that in @p other.
@@ -314,11 +376,20 @@ public:
     bool operator!=(const Logger& rhs) const noexcept;
 
 private:
+    /// Makes new loggers by wrapping the PIMPLs of existing ones
+    friend class LoggerFactory;
+
     /// Internal code factorization for checking for a null PIMPL pointer
     bool has_pimpl_() const noexcept;
 
+    /// Hands a message template and its packed arguments to the PIMPL
+    Logger& log_packed_(severity s, std::string_view fmt,
+                        const detail_::PackedArgs& args);
+
     /// Pointer to implementation details
     pimpl_ptr m_pimpl_;
 };
 
 } // namespace parallelzone
+
+#include "logger.ipp"
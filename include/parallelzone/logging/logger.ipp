@@ -0,0 +1,37 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <parallelzone/logging/detail_/packed_args.hpp>
+
+/** @file logger.ipp
+ *
+ *  This file contains the inline definitions for the Logger class. It is not
+ *  meant for inclusion in any other file besides logger.hpp
+ */
+
+namespace parallelzone {
+
+template<typename T, typename... Args>
+Logger& Logger::log(severity s, std::string_view fmt, T&& arg0,
+                    Args&&... args) {
+    if(!should_log(s)) return *this;
+    detail_::PackedArgs packed;
+    packed.push_back(std::forward<T>(arg0));
+    (packed.push_back(std::forward<Args>(args)), ...);
+    return log_packed_(s, fmt, packed);
+}
+
+} // namespace parallelzone
@@ -15,7 +15,10 @@
  */
 
 #pragma once
+#include <chrono>
 #include <parallelzone/logging/logger.hpp>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <vector>
 
 namespace parallelzone {
 
@@ -27,6 +30,67 @@ public:
     /// Type used for logger objects
     using logger_type = Logger;
 
+    /// Unsigned type used for sizes
+    using size_type = std::size_t;
+
+    /// Type of the communicator an aggregating logger gathers over
+    using comm_type = mpi_helpers::CommPP;
+
+    /// Type used for file and directory names
+    using string_type = Logger::string_type;
+
+    /// Type of a read-only reference to a file or directory name
+    using const_string_reference = Logger::const_string_reference;
+
+    /** @brief What an asynchronous logger does when its queue is full.
+     *
+     *  - block: The logging thread waits until there is room in the queue.
+     *           No message is lost, but logging may stall the caller.
+     *  - drop: The new message is discarded.
+     *  - overwrite: The oldest queued message is discarded to make room for
+     *               the new one.
+     */
+    enum class overflow_policy { block, drop, overwrite };
+
+    /** @brief Limits on what a logger made by make_limited writes.
+     *
+     *  The default limits write everything.
+     */
+    struct log_limits {
+        /// The most messages written per call site per interval (0 means
+        /// no limit)
+        size_type max_per_interval = 0;
+
+        /// The length of the interval max_per_interval applies to
+        std::chrono::milliseconds interval = std::chrono::seconds(1);
+
+        /// Only ranks which are multiples of rank_stride write
+        size_type rank_stride = 1;
+
+        /// If not empty, only these ranks write (rank_stride is ignored)
+        std::vector<mpi_rank_type> ranks;
+
+        /// Messages at least this severe are written by every rank, sampled
+        /// or not, so errors are never hidden by rank sampling
+        Logger::severity all_ranks_severity = Logger::severity::error;
+    };
+
+    /// The default number of messages an asynchronous logger can queue
+    static constexpr size_type default_queue_size = 8192;
+
+    /// The default number of messages each thread of a per-thread logger can
+    /// buffer
+    static constexpr size_type default_thread_buffer_size = 1024;
+
+    /// The default size, in bytes, at which per-rank log files are rotated
+    static constexpr size_type default_max_file_size = 16 * 1024 * 1024;
+
+    /// The default number of rotated log files kept (besides the current one)
+    static constexpr size_type default_max_files = 4;
+
+    /// The default number of messages a flight recorder keeps per thread
+    static constexpr size_type default_flight_recorder_size = 1024;
+
     /** @brief Creates the default program-wide logger for a specific process
      *
      *  This method wraps the process of creating the default global logger.
@@ -49,6 +113,302 @@ public:
      *  @return The logger for the requested MPI rank.
      */
     static logger_type default_global_logger(mpi_rank_type rank);
+
+    /** @brief Makes a logger which writes to a file.
+     *
+     *  If the file exists, messages are appended to it. If @p max_size is
+     *  non-zero the file is rotated: when writing a message would make the
+     *  file larger than @p max_size bytes, the file is renamed (for example
+     *  "log.txt" becomes "log.1.txt", and an existing "log.1.txt" becomes
+     *  "log.2.txt") and logging continues in a new "log.txt". At most
+     *  @p max_files rotated files are kept; the oldest is deleted.
+     *
+     *  @param[in] file_name The file to write to. The directory containing
+     *                       it must exist.
+     *  @param[in] max_size The size, in bytes, at which the file is rotated.
+     *                      Defaults to 0, meaning the file is never rotated.
+     *  @param[in] max_files The maximum number of rotated files kept. Only
+     *                       used if @p max_size is non-zero. Defaults to
+     *                       default_max_files.
+     *
+     *  @return A logger whose sink is the file.
+     *
+     *  @throw ??? Throws if the file can not be opened. Strong throw
+     *             guarantee.
+     */
+    static logger_type file_logger(const_string_reference file_name,
+                                   size_type max_size  = 0,
+                                   size_type max_files = default_max_files);
+
+    /** @brief Makes a logger which writes to a file dedicated to @p rank.
+     *
+     *  The file is "<directory>/log.rank<rank>.txt" and it is rotated as
+     *  described in file_logger. Pointing @p directory at node-local
+     *  storage, and bounding the files with @p max_size and @p max_files,
+     *  keeps many ranks from swamping a shared file system. @p directory is
+     *  created if it does not exist.
+     *
+     *  @param[in] rank The rank the file is for.
+     *  @param[in] directory The directory the file is in. Defaults to the
+     *                       current working directory.
+     *  @param[in] max_size The size, in bytes, at which the file is rotated.
+     *                      0 means never. Defaults to default_max_file_size.
+     *  @param[in] max_files The maximum number of rotated files kept.
+     *                       Defaults to default_max_files.
+     *
+     *  @return A logger whose sink is the rank's file.
+     *
+     *  @throw std::filesystem::filesystem_error if @p directory does not
+     *                                           exist and can not be made.
+     *                                           Strong throw guarantee.
+     *  @throw ??? Throws if the file can not be opened. Strong throw
+     *             guarantee.
+     */
+    static logger_type rank_file_logger(
+      mpi_rank_type rank, const_string_reference directory = ".",
+      size_type max_size  = default_max_file_size,
+      size_type max_files = default_max_files);
+
+    /** @brief Makes a logger which writes compact binary records to a file
+     *         dedicated to @p rank.
+     *
+     *  The file is "<directory>/log.rank<rank>.pzlog"; it is overwritten if
+     *  it exists. Messages logged with a template and arguments (see
+     *  Logger::log(severity, fmt, args...)) are stored as a time stamp, the
+     *  severity, an id for the template, and the arguments in binary, so no
+     *  text formatting happens while the program runs. The files of all
+     *  ranks can be merged and turned into text or JSON with
+     *  decode_binary_logs, or the pzlog_decode program.
+     *
+     *  @param[in] rank The rank the file is for.
+     *  @param[in] directory The directory the file is in. Created if it does
+     *                       not exist. Defaults to the current working
+     *                       directory.
+     *
+     *  @return A logger whose sink is the rank's binary file.
+     *
+     *  @throw std::filesystem::filesystem_error if @p directory does not
+     *                                           exist and can not be made.
+     *                                           Strong throw guarantee.
+     *  @throw std::runtime_error if the file can not be opened. Strong throw
+     *                            guarantee.
+     */
+    static logger_type binary_file_logger(
+      mpi_rank_type rank, const_string_reference directory = ".");
+
+    /** @brief Makes an asynchronous logger which writes to the sink of
+     *         @p logger.
+     *
+     *  Logging to the resulting logger only checks the severity and places
+     *  the message in a bounded, lock-free queue. A background thread takes
+     *  messages off of the queue and writes them to the sink of @p logger, so
+     *  the formatting and writing (and the locks they take) are off of the
+     *  calling thread. Copies of the resulting logger share the queue and the
+     *  thread; the thread is stopped, after writing the queued messages, when
+     *  the last copy is destroyed. Use Logger::flush to wait for the messages
+     *  logged so far to be written.
+     *
+     *  Like a newly made logger, the resulting logger starts with a severity
+     *  threshold of severity::info. The threshold is applied before messages
+     *  are queued, so the threshold of @p logger is lowered to
+     *  severity::trace.
+     *
+     *  @param[in] logger The logger whose sink messages are written to. If
+     *                    @p logger is a null logger the result is too.
+     *  @param[in] queue_size The minimum number of messages which can be
+     *                        queued. Defaults to default_queue_size.
+     *  @param[in] policy What to do when the queue is full. Defaults to
+     *                    overflow_policy::block.
+     *
+     *  @return The asynchronous logger.
+     *
+     *  @throw std::out_of_range if @p queue_size is 0. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the queue.
+     *                        Strong throw guarantee.
+     *  @throw std::system_error if the thread can not be started. Strong
+     *                           throw guarantee.
+     */
+    static logger_type make_async(logger_type logger,
+                                  size_type queue_size = default_queue_size,
+                                  overflow_policy policy =
+                                    overflow_policy::block);
+
+    /** @brief Makes a logger whose threads log into their own buffers,
+     *         which a single consumer writes to the sink of @p logger.
+     *
+     *  Each thread which logs to the resulting logger (or a copy of it) gets
+     *  its own lock-free, single-producer/single-consumer buffer. Logging
+     *  copies the message into the calling thread's buffer, so threads in a
+     *  threaded region can log without contending on the sink's mutex. A
+     *  background thread takes the messages out of the buffers, merges them
+     *  by time stamp, and writes them to the sink of @p logger. A thread
+     *  whose buffer is full waits for the background thread. Use
+     *  Logger::flush to write the messages buffered so far.
+     *
+     *  Since the result may be shared by all threads, it can replace
+     *  ResourceSet::logger() or RuntimeView::logger(). Like a newly made
+     *  logger, the result starts with a severity threshold of severity::info
+     *  and the threshold of @p logger is lowered to severity::trace.
+     *
+     *  @param[in] logger The logger whose sink messages are written to. If
+     *                    @p logger is a null logger the result is too.
+     *  @param[in] buffer_size The minimum number of messages each thread can
+     *                         buffer. Defaults to default_thread_buffer_size.
+     *
+     *  @return The per-thread logger.
+     *
+     *  @throw std::out_of_range if @p buffer_size is 0. Strong throw
+     *                           guarantee.
+     *  @throw std::system_error if the background thread can not be started.
+     *                           Strong throw guarantee.
+     */
+    static logger_type make_per_thread(
+      logger_type logger, size_type buffer_size = default_thread_buffer_size);
+
+    /** @brief Makes a logger which gathers the messages of every rank in
+     *         @p comm and writes them from @p root.
+     *
+     *  Logging to the resulting logger time stamps the message and buffers
+     *  it on the current rank. Nothing is written until the logger is
+     *  flushed. Flushing is collective over @p comm: each rank sends its
+     *  buffered messages to @p root (with CommPP::gatherv) and @p root writes
+     *  the messages of all ranks to the sink of @p sink, in time stamp order,
+     *  with each message prefixed by "[Rank r] ". Programs should flush
+     *  periodically (e.g., once per iteration) to bound the size of the
+     *  buffers; RuntimeView also flushes its logger when MPI is finalized.
+     *  Time stamps come from each rank's system clock, so messages from
+     *  different nodes are only ordered as well as the nodes' clocks agree.
+     *
+     *  Every rank of @p comm must call this method with the same @p root, and
+     *  every rank must flush the result the same number of times, from one
+     *  thread at a time. Like a newly made logger, the result starts with a
+     *  severity threshold of severity::info, and the threshold of @p sink is
+     *  lowered to severity::trace.
+     *
+     *  @param[in] comm The ranks whose messages are aggregated.
+     *  @param[in] sink The logger which @p root writes the messages to. Only
+     *                  used on @p root; it is fine to pass a null logger on
+     *                  the other ranks (e.g., the default global logger).
+     *  @param[in] root The rank which writes the messages. Defaults to 0.
+     *
+     *  @return The aggregating logger.
+     *
+     *  @throw std::out_of_range if @p root is not a rank in @p comm. Strong
+     *                           throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the logger.
+     *                        Strong throw guarantee.
+     */
+    static logger_type make_aggregating(comm_type comm, logger_type sink,
+                                        mpi_rank_type root = 0);
+
+    /** @brief Makes a logger which writes at most as many messages as
+     *         @p limits allow.
+     *
+     *  Two limits are applied to each message logged to the result:
+     *
+     *  - Rank sampling. If @p rank is not one of @p limits.ranks (or, if
+     *    that is empty, not a multiple of @p limits.rank_stride) only
+     *    messages with a severity of at least @p limits.all_ranks_severity
+     *    (by default severity::error) are written.
+     *  - Rate limiting. If @p limits.max_per_interval is non-zero, at most
+     *    that many messages from the same call site are written per
+     *    @p limits.interval. Messages logged with a template (see
+     *    Logger::log(severity, fmt, args...)) come from the same call site
+     *    if they have the same template. Messages logged as strings have no
+     *    call site, so only identical messages count as coming from the same
+     *    one.
+     *
+     *  Messages which are not written are counted. When the result is
+     *  flushed, a summary of the counts (e.g., "Suppressed 12 messages like:
+     *  ...") is written, so floods are still visible. Copies of the result
+     *  share the counts. The severity threshold of the result starts out as
+     *  that of @p logger, which is lowered to severity::trace.
+     *
+     *  RuntimeView::limit_logging applies the same limits to the program-wide
+     *  logger and the logger of the current rank's ResourceSet.
+     *
+     *  @param[in] logger The logger messages which pass the limits are
+     *                    written to. If @p logger is a null logger the
+     *                    result is too.
+     *  @param[in] rank The rank the result is for.
+     *  @param[in] limits Which messages to write.
+     *
+     *  @return The limited logger.
+     *
+     *  @throw std::out_of_range if @p limits.rank_stride is 0. Strong throw
+     *                           guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the logger.
+     *                        Strong throw guarantee.
+     */
+    static logger_type make_limited(logger_type logger, mpi_rank_type rank,
+                                    log_limits limits);
+
+    /** @brief Makes a "flight recorder": a logger which keeps the most recent
+     *         messages in memory and writes them only when something goes
+     *         wrong.
+     *
+     *  Each thread logging to the resulting logger gets a ring of
+     *  @p n_records preallocated slots. Logging a message copies it into the
+     *  oldest slot of the thread's ring, so verbose (e.g., severity::trace)
+     *  messages can be kept at little cost and without any I/O. The messages
+     *  of all threads are written to the sink of @p sink, in time stamp order
+     *  and prefixed by "[Flight recorder, thread t] ", and then discarded
+     *  when:
+     *
+     *  - a message with severity @p dump_severity, or greater, is logged,
+     *  - dump_flight_recorders is called, which RuntimeView does if its last
+     *    copy is destroyed while an exception is propagating, or
+     *  - a signal handled with dump_flight_recorders_on is raised.
+     *
+     *  Flushing the result flushes the sink of @p sink, but does not write
+     *  the kept messages, so a clean RuntimeView teardown does not dump.
+     *
+     *  Unlike a newly made logger, the result starts with a severity
+     *  threshold of severity::trace. The threshold of @p sink is lowered to
+     *  severity::trace too. Copies of the result share the rings.
+     *
+     *  @param[in] sink The logger the messages are written to. If @p sink is
+     *                  a null logger, the messages are written to standard
+     *                  error.
+     *  @param[in] n_records The number of messages kept per thread. Defaults
+     *                       to default_flight_recorder_size.
+     *  @param[in] dump_severity The severity of the messages which trigger a
+     *                           dump. Defaults to severity::error.
+     *
+     *  @return The flight recorder.
+     *
+     *  @throw std::out_of_range if @p n_records is 0. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the logger.
+     *                        Strong throw guarantee.
+     */
+    static logger_type make_flight_recorder(
+      logger_type sink, size_type n_records = default_flight_recorder_size,
+      Logger::severity dump_severity = Logger::severity::error);
+
+    /** @brief Writes out the messages kept by every flight recorder.
+     *
+     *  @throw None No throw guarantee. Errors while writing are ignored.
+     */
+    static void dump_flight_recorders() noexcept;
+
+    /** @brief Writes out the messages kept by every flight recorder when
+     *         @p signal_number is raised.
+     *
+     *  Signal handlers can not safely lock, allocate, or call into the
+     *  sinks, so the installed handler is best effort: it writes every
+     *  flight recorder's messages straight to standard error, without
+     *  discarding them, and a message which is being logged at the time may
+     *  come out garbled. If @p signal_number normally ends the program
+     *  (SIGSEGV, SIGBUS, SIGFPE, SIGILL, or SIGABRT) the handler then raises
+     *  it again with its default action, so the program still ends (and
+     *  dumps core) as it would have.
+     *
+     *  @param[in] signal_number The signal to handle, e.g., SIGSEGV.
+     *
+     *  @throw std::runtime_error if the handler can not be installed. Strong
+     *                            throw guarantee.
+     */
+    static void dump_flight_recorders_on(int signal_number);
 };
 
 } // namespace parallelzone
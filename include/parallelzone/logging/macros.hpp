@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <parallelzone/logging/logger.hpp>
+
+/** @file macros.hpp
+ *
+ *  Macros for logging which compile to nothing below a build-time minimum
+ *  severity.
+ *
+ *  Each `PZ_LOG_<SEVERITY>(logger, ...)` macro forwards its arguments to
+ *  `logger.log(severity, ...)`, so it accepts either a single message or a
+ *  format string followed by its arguments. The arguments are only evaluated
+ *  if `logger.should_log(severity)` is true. Macros whose severity is below
+ *  PARALLELZONE_MIN_LOG_LEVEL expand to a no-op and their arguments are never
+ *  evaluated. PARALLELZONE_MIN_LOG_LEVEL defaults to
+ *  PARALLELZONE_LOG_LEVEL_TRACE (everything is compiled in); it is set by the
+ *  PZ_MIN_LOG_LEVEL CMake option. For consistency with
+ *  Logger::set_severity, PZ_LOG_CRITICAL is never compiled away.
+ */
+
+#define PARALLELZONE_LOG_LEVEL_TRACE 0
+#define PARALLELZONE_LOG_LEVEL_DEBUG 1
+#define PARALLELZONE_LOG_LEVEL_INFO 2
+#define PARALLELZONE_LOG_LEVEL_WARN 3
+#define PARALLELZONE_LOG_LEVEL_ERROR 4
+#define PARALLELZONE_LOG_LEVEL_CRITICAL 5
+
+#ifndef PARALLELZONE_MIN_LOG_LEVEL
+#define PARALLELZONE_MIN_LOG_LEVEL PARALLELZONE_LOG_LEVEL_TRACE
+#endif
+
+/// Implementation of the PZ_LOG_* macros which are compiled in, @p level is
+/// the name of a Logger::severity enumerator
+#define PZ_LOG_(logger, level, ...)                                           \
+    do {                                                                      \
+        constexpr auto pz_level_ = ::parallelzone::Logger::severity::level;   \
+        auto& pz_logger_         = (logger);                                  \
+        if(pz_logger_.should_log(pz_level_))                                  \
+            pz_logger_.log(pz_level_, __VA_ARGS__);                           \
+    } while(0)
+
+/// Implementation of the PZ_LOG_* macros which are compiled away
+#define PZ_LOG_DISABLED_(logger, ...) static_cast<void>(0)
+
+#if PARALLELZONE_MIN_LOG_LEVEL <= PARALLELZONE_LOG_LEVEL_TRACE
+#define PZ_LOG_TRACE(logger, ...) PZ_LOG_(logger, trace, __VA_ARGS__)
+#else
+#define PZ_LOG_TRACE(logger, ...) PZ_LOG_DISABLED_(logger, __VA_ARGS__)
+#endif
+
+#if PARALLELZONE_MIN_LOG_LEVEL <= PARALLELZONE_LOG_LEVEL_DEBUG
+#define PZ_LOG_DEBUG(logger, ...) PZ_LOG_(logger, debug, __VA_ARGS__)
+#else
+#define PZ_LOG_DEBUG(logger, ...) PZ_LOG_DISABLED_(logger, __VA_ARGS__)
+#endif
+
+#if PARALLELZONE_MIN_LOG_LEVEL <= PARALLELZONE_LOG_LEVEL_INFO
+#define PZ_LOG_INFO(logger, ...) PZ_LOG_(logger, info, __VA_ARGS__)
+#else
+#define PZ_LOG_INFO(logger, ...) PZ_LOG_DISABLED_(logger, __VA_ARGS__)
+#endif
+
+#if PARALLELZONE_MIN_LOG_LEVEL <= PARALLELZONE_LOG_LEVEL_WARN
+#define PZ_LOG_WARN(logger, ...) PZ_LOG_(logger, warn, __VA_ARGS__)
+#else
+#define PZ_LOG_WARN(logger, ...) PZ_LOG_DISABLED_(logger, __VA_ARGS__)
+#endif
+
+#if PARALLELZONE_MIN_LOG_LEVEL <= PARALLELZONE_LOG_LEVEL_ERROR
+#define PZ_LOG_ERROR(logger, ...) PZ_LOG_(logger, error, __VA_ARGS__)
+#else
+#define PZ_LOG_ERROR(logger, ...) PZ_LOG_DISABLED_(logger, __VA_ARGS__)
+#endif
+
+#define PZ_LOG_CRITICAL(logger, ...) PZ_LOG_(logger, critical, __VA_ARGS__)
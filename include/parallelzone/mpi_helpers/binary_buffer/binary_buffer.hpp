@@ -16,7 +16,9 @@
 
 #pragma once
 #include <parallelzone/mpi_helpers/binary_buffer/binary_view.hpp>
+#include <parallelzone/mpi_helpers/binary_buffer/buffer_pool.hpp>
 #include <parallelzone/mpi_helpers/binary_buffer/detail_/binary_buffer_pimpl.hpp>
+#include <parallelzone/mpi_helpers/binary_buffer/detail_/pooled_buffer.hpp>
 #include <parallelzone/mpi_helpers/traits/traits.hpp>
 #include <parallelzone/serialization.hpp>
 
@@ -76,7 +78,9 @@ public:
     /** @brief Creates a BinaryBuffer capable of holding @p n bytes.
      *
      *  This ctor initializes *this to an @p n byte buffer. Each byte is set
-     *  to 0.
+     *  to 0. The memory comes from BufferPool::default_pool(), so repeatedly
+     *  creating (and destroying) buffers of similar sizes does not go to the
+     *  system allocator.
      *
      *  @param[in] n The size of the buffer.
      *
@@ -31,9 +31,10 @@ namespace parallelzone::mpi_helpers {
 
 inline BinaryBuffer::BinaryBuffer(size_type n) :
   BinaryBuffer([&]() {
-      using internal_buffer = std::vector<value_type>;
+      using internal_buffer = detail_::PooledBuffer;
       using pimpl_type      = detail_::BinaryBufferPIMPL<internal_buffer>;
-      internal_buffer buffer(n);
+      internal_buffer buffer(n, BufferPool::default_pool());
+      if(n) std::memset(buffer.data(), 0, n);
       return std::make_unique<pimpl_type>(std::move(buffer));
   }()) {}
 
@@ -51,14 +52,15 @@ template<typename T>
 BinaryBuffer make_binary_buffer(T&& input) {
     using clean_type = std::decay_t<T>;
     if constexpr(needs_serialized_v<clean_type>) {
-        using pimpl_type = detail_::BinaryBufferPIMPL<std::string>;
-        // TODO: Put directly into a string
-        std::stringstream ss;
+        using pimpl_type = detail_::BinaryBufferPIMPL<detail_::PooledBuffer>;
+        // Serialize straight into pooled memory
+        detail_::PooledStreamBuffer sb(BufferPool::default_pool());
         {
-            cereal::BinaryOutputArchive ar(ss);
+            std::ostream os(&sb);
+            cereal::BinaryOutputArchive ar(os);
             ar << std::forward<T>(input);
         }
-        auto pimpl = std::make_unique<pimpl_type>(ss.str());
+        auto pimpl = std::make_unique<pimpl_type>(sb.release());
         return BinaryBuffer(std::move(pimpl));
     } else {
         using pimpl_type = detail_::BinaryBufferPIMPL<clean_type>;
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace parallelzone::mpi_helpers {
+
+/** @brief A thread-safe, size-class pool of raw memory blocks.
+ *
+ *  Communication is usually iterative: the same gathers, with the same
+ *  buffer sizes, are done over and over. Going to the system allocator for
+ *  every temporary buffer then dominates the cost of small messages. The
+ *  BufferPool keeps freed blocks around so that they can be handed out again.
+ *
+ *  Requests are rounded up to a power of two (with a minimum of
+ *  min_block_size bytes) and blocks of the same size are kept in a free list.
+ *  Once the pool has seen the sizes used by an iteration, subsequent
+ *  iterations are served entirely from the free lists, i.e., without calling
+ *  the system allocator. Requests larger than max_block_size are not pooled.
+ *
+ *  The free lists are shared by all threads and guarded by a mutex. So that
+ *  threads communicating at the same time do not serialize on it, each
+ *  thread also keeps a small cache of free blocks (at most
+ *  thread_cache_depth blocks of each size up to thread_cache_max_block) in
+ *  front of the shared lists. Acquires and releases served by the calling
+ *  thread's cache take no lock. A thread's cached blocks go back to the
+ *  shared lists when the thread exits.
+ *
+ *  To keep memory from being hoarded, the pool holds on to at most
+ *  max_cached_bytes() bytes of free blocks (counting those in the thread
+ *  caches); releases beyond that go back to the system. trim() returns all
+ *  cached blocks.
+ *
+ *  BinaryBuffer (its bytes and its PIMPL) and the scratch space of CommPP's
+ *  collectives draw from default_pool(), so in the steady state they do not
+ *  call the system allocator. The containers a collective returns to its
+ *  caller (e.g., the std::vector of gathered objects, or the per-rank sizes
+ *  returned with a binary gatherv) are not pooled. The pool of the current
+ *  process can also be reached from the local ResourceSet via
+ *  `RAM::buffer_pool()`.
+ */
+class BufferPool {
+public:
+    /// Unsigned integral type used for sizes and counting
+    using size_type = std::size_t;
+
+    /// Type of a pointer to a block
+    using pointer = std::byte*;
+
+    /// Counters describing the pool's activity, see stats()
+    struct Statistics {
+        /// Number of calls to acquire
+        size_type n_acquires = 0;
+
+        /// Number of acquires served from a free list
+        size_type n_hits = 0;
+
+        /// Number of acquires which went to the system allocator
+        size_type n_misses = 0;
+
+        /// Number of calls to release
+        size_type n_releases = 0;
+
+        /// Bytes in blocks which have been acquired, but not released
+        size_type bytes_in_use = 0;
+
+        /// Bytes in blocks sitting in the free lists
+        size_type bytes_cached = 0;
+
+        /// The largest value bytes_in_use has had
+        size_type peak_bytes_in_use = 0;
+    };
+
+    /// Type of the hook invoked on a miss. The argument is the block size.
+    using hook_type = std::function<void(size_type)>;
+
+    /// Requests are rounded up to at least this many bytes
+    static constexpr size_type min_block_size = 64;
+
+    /// Requests larger than this many bytes bypass the free lists
+    static constexpr size_type max_block_size = size_type(1) << 27;
+
+    /// Default value for max_cached_bytes()
+    static constexpr size_type default_max_cached_bytes = size_type(1) << 28;
+
+    /// Only blocks of at most this many bytes are kept in the thread caches
+    static constexpr size_type thread_cache_max_block = size_type(1) << 20;
+
+    /// The most blocks of each size a thread keeps in its cache
+    static constexpr size_type thread_cache_depth = 4;
+
+    /** @brief Creates an empty pool.
+     *
+     *  @param[in] max_cached_bytes The most bytes the pool will keep in its
+     *                              free lists. Defaults to 256 MiB.
+     *
+     *  @throw None No throw guarantee.
+     */
+    explicit BufferPool(
+      size_type max_cached_bytes = default_max_cached_bytes) noexcept;
+
+    /// Not copyable, outstanding blocks refer to the pool
+    BufferPool(const BufferPool&) = delete;
+
+    /// Not copyable, outstanding blocks refer to the pool
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /** @brief Frees the cached blocks.
+     *
+     *  Blocks which are still in use must be released before the pool is
+     *  destroyed. Blocks in the caches of other threads are freed when those
+     *  threads exit (or next start using a pool).
+     */
+    ~BufferPool() noexcept;
+
+    /** @brief The pool used by BinaryBuffer and CommPP.
+     *
+     *  The default pool lives until the program exits (it is never destroyed
+     *  so that buffers with static storage duration may safely release their
+     *  memory to it).
+     *
+     *  @return The process-wide pool.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static BufferPool& default_pool() noexcept;
+
+    /** @brief The size of the block used to satisfy a request for @p n bytes.
+     *
+     *  @param[in] n The number of bytes requested.
+     *
+     *  @return @p n rounded up to a power of two no smaller than
+     *          min_block_size, or @p n itself if @p n > max_block_size.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static size_type block_size(size_type n) noexcept;
+
+    /** @brief Gets a block of at least @p n bytes.
+     *
+     *  The block is suitably aligned for any fundamental type and its
+     *  contents are indeterminate. If no cached block is available, the block
+     *  is obtained from the system and the miss hook (if set) is invoked.
+     *
+     *  @param[in] n The number of bytes needed.
+     *
+     *  @return A pointer to a block of block_size(n) bytes.
+     *
+     *  @throw std::bad_alloc if the system is out of memory. Strong throw
+     *                        guarantee.
+     *  @throw ??? If the miss hook throws. The block is returned to the pool
+     *             before the exception propagates.
+     */
+    pointer acquire(size_type n);
+
+    /** @brief Returns a block to the pool.
+     *
+     *  @param[in] p A pointer previously returned by acquire. May be null, in
+     *               which case this is a no-op.
+     *  @param[in] n Any size with the same block_size as the size @p p was
+     *               acquired with (e.g., the original request).
+     *
+     *  @throw None No throw guarantee.
+     */
+    void release(pointer p, size_type n) noexcept;
+
+    /** @brief Returns all cached blocks to the system.
+     *
+     *  Only the shared free lists and the calling thread's cache are
+     *  emptied, the caches of the other threads can not be reached.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void trim() noexcept;
+
+    /** @brief A snapshot of the pool's counters.
+     *
+     *  The counters are read one at a time, so if other threads are using
+     *  the pool they need not be consistent with each other.
+     *
+     *  @return The counters at the time of the call.
+     *
+     *  @throw None No throw guarantee.
+     */
+    Statistics stats() const noexcept;
+
+    /** @brief Zeros the acquire/hit/miss/release counters and sets the peak
+     *         to the current usage.
+     *
+     *  This is useful for checking that a section of code does not go to the
+     *  system allocator, e.g., that stats().n_misses is still 0 after the
+     *  second iteration of a loop.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void reset_stats() noexcept;
+
+    /** @brief Sets the hook invoked whenever the pool misses.
+     *
+     *  The hook is called (without any of the pool's locks held) from the
+     *  thread which called acquire. Pass an empty function to remove the
+     *  hook.
+     *
+     *  @param[in] hook The function to call on a miss.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void set_miss_hook(hook_type hook) noexcept;
+
+    /// The most bytes the pool will keep in its free lists
+    size_type max_cached_bytes() const noexcept;
+
+    /** @brief Changes the most bytes the pool will keep in its free lists.
+     *
+     *  If the pool currently caches more than @p n bytes, cached blocks are
+     *  freed until it does not (or until only blocks in the caches of other
+     *  threads are left).
+     *
+     *  @param[in] n The new limit.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void set_max_cached_bytes(size_type n) noexcept;
+
+private:
+    /// A free block, the link is stored in the block itself
+    struct FreeBlock {
+        FreeBlock* m_next;
+    };
+
+    /// The blocks one thread keeps for one pool, defined in the source file
+    struct CacheEntry;
+
+    /// All of one thread's CacheEntry objects, defined in the source file
+    struct ThreadCache;
+
+    /// The counters of Statistics, updated without a lock
+    struct Counters {
+        std::atomic<size_type> n_acquires{0};
+        std::atomic<size_type> n_hits{0};
+        std::atomic<size_type> n_misses{0};
+        std::atomic<size_type> n_releases{0};
+        std::atomic<size_type> bytes_in_use{0};
+        std::atomic<size_type> bytes_cached{0};
+        std::atomic<size_type> peak_bytes_in_use{0};
+    };
+
+    /// Number of power-of-two size classes
+    static constexpr size_type n_classes_ = 22;
+
+    /// Maps a block size to its size class
+    static size_type size_class_(size_type block) noexcept;
+
+    /// The calling thread's cache for *this, made if @p create is true
+    CacheEntry* cache_entry_(bool create = true) noexcept;
+
+    /// Moves the blocks of @p entry to the shared free lists
+    void absorb_(CacheEntry& entry) noexcept;
+
+    /// Adds @p block bytes to bytes_in_use, updating the peak
+    void add_in_use_(size_type block) noexcept;
+
+    /// Frees cached blocks until at most @p n bytes are cached, lock held
+    void shrink_to_(size_type n) noexcept;
+
+    /// Distinguishes *this from earlier pools at the same address
+    const std::uint64_t m_id_;
+
+    /// Guards the free lists and the hook
+    mutable std::mutex m_mutex_;
+
+    /// Heads of the shared free lists, one per size class
+    std::array<FreeBlock*, n_classes_> m_free_{};
+
+    /// The most bytes to hold in the free lists
+    std::atomic<size_type> m_max_cached_;
+
+    /// The counters
+    Counters m_stats_;
+
+    /// Called on a miss
+    hook_type m_miss_hook_;
+};
+
+} // namespace parallelzone::mpi_helpers
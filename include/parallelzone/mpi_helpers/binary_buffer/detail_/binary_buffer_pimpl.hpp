@@ -17,6 +17,7 @@
 #pragma once
 #include <cstddef>
 #include <memory>
+#include <parallelzone/mpi_helpers/binary_buffer/buffer_pool.hpp>
 #include <string>
 
 namespace parallelzone::mpi_helpers::detail_ {
@@ -28,6 +29,12 @@ namespace parallelzone::mpi_helpers::detail_ {
  *  API used by BinaryBuffer to interact with the PIMPL. The public facing
  *  methods all call pure virtual methods which must be overridden in the
  *  derived classes.
+ *
+ *  PIMPL objects are created (and destroyed) for every BinaryBuffer, so the
+ *  class-specific allocation functions place them in the default BufferPool.
+ *  The pool's per-thread cache makes this cheaper than the general-purpose
+ *  allocator, and keeps steady-state communication free of system
+ *  allocations.
  */
 class BinaryBufferPIMPLBase {
 public:
@@ -63,6 +70,16 @@ public:
 
     virtual ~BinaryBufferPIMPLBase() noexcept = default;
 
+    /// Allocates PIMPLs (including derived ones) from the default pool
+    static void* operator new(std::size_t n) {
+        return BufferPool::default_pool().acquire(n);
+    }
+
+    /// Returns PIMPLs to the default pool (n is the most derived type's size)
+    static void operator delete(void* p, std::size_t n) noexcept {
+        BufferPool::default_pool().release(static_cast<std::byte*>(p), n);
+    }
+
     /** @brief Makes a deep polymorphic copy of *this.
      *
      *  When invoked this method will have the most derived class make a deep
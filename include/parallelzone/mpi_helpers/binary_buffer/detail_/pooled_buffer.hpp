@@ -0,0 +1,224 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <parallelzone/mpi_helpers/binary_buffer/buffer_pool.hpp>
+#include <streambuf>
+#include <utility>
+
+namespace parallelzone::mpi_helpers::detail_ {
+
+/** @brief A contiguous byte buffer whose memory comes from a BufferPool.
+ *
+ *  PooledBuffer is the InternalBuffer used by BinaryBuffer when BinaryBuffer
+ *  allocates the memory itself. It is a minimal stand-in for
+ *  `std::vector<std::byte>` which acquires its block from a BufferPool and
+ *  releases the block to the same pool when it is destroyed.
+ *
+ *  Unlike `std::vector`, the contents of a newly allocated PooledBuffer are
+ *  not initialized.
+ */
+class PooledBuffer {
+public:
+    /// Type of the elements in the buffer
+    using value_type = std::byte;
+
+    /// Type of a pointer to the data
+    using pointer = value_type*;
+
+    /// Type of a read-only pointer to the data
+    using const_pointer = const value_type*;
+
+    /// Unsigned integral type used for sizes
+    using size_type = BufferPool::size_type;
+
+    /// Creates a buffer with no memory
+    PooledBuffer() noexcept = default;
+
+    /** @brief Creates a buffer of @p n (uninitialized) bytes.
+     *
+     *  @param[in] n The number of bytes in the buffer.
+     *  @param[in] pool The pool to draw the memory from.
+     *
+     *  @throw std::bad_alloc if the pool can not get the memory. Strong throw
+     *                        guarantee.
+     */
+    PooledBuffer(size_type n, BufferPool& pool) : m_pool_(&pool) {
+        if(n == 0) return;
+        m_data_     = pool.acquire(n);
+        m_size_     = n;
+        m_capacity_ = BufferPool::block_size(n);
+    }
+
+    /// Deep copies @p other, using @p other 's pool
+    PooledBuffer(const PooledBuffer& other) :
+      PooledBuffer(other.m_size_, other.pool_()) {
+        if(m_size_) std::memcpy(m_data_, other.m_data_, m_size_);
+    }
+
+    /// Takes the memory of @p other, leaving @p other empty
+    PooledBuffer(PooledBuffer&& other) noexcept { swap(other); }
+
+    /// Copy-and-swap assignment (by-value parameter handles copy and move)
+    PooledBuffer& operator=(PooledBuffer rhs) noexcept {
+        swap(rhs);
+        return *this;
+    }
+
+    /// Returns the memory to the pool
+    ~PooledBuffer() noexcept {
+        if(m_data_) m_pool_->release(m_data_, m_capacity_);
+    }
+
+    /// A pointer to the first byte (null if the buffer has no memory)
+    pointer data() noexcept { return m_data_; }
+
+    /// A read-only pointer to the first byte (null if there is no memory)
+    const_pointer data() const noexcept { return m_data_; }
+
+    /// The number of bytes in the buffer
+    size_type size() const noexcept { return m_size_; }
+
+    /// The number of bytes the buffer can hold without reallocating
+    size_type capacity() const noexcept { return m_capacity_; }
+
+    /** @brief Changes the size of the buffer to @p n bytes.
+     *
+     *  If @p n is larger than capacity(), a new block is acquired and the
+     *  current contents are copied into it. Newly exposed bytes are not
+     *  initialized.
+     *
+     *  @param[in] n The new size.
+     *
+     *  @throw std::bad_alloc if a new block is needed and can not be acquired.
+     *                        Strong throw guarantee.
+     */
+    void resize(size_type n) {
+        if(n <= m_capacity_) {
+            m_size_ = n;
+            return;
+        }
+        PooledBuffer temp(n, pool_());
+        if(m_size_) std::memcpy(temp.m_data_, m_data_, m_size_);
+        swap(temp);
+    }
+
+    /// Exchanges the state of *this with @p other
+    void swap(PooledBuffer& other) noexcept {
+        std::swap(m_pool_, other.m_pool_);
+        std::swap(m_data_, other.m_data_);
+        std::swap(m_size_, other.m_size_);
+        std::swap(m_capacity_, other.m_capacity_);
+    }
+
+private:
+    /// The pool *this draws from, defaulted buffers use the default pool
+    BufferPool& pool_() const noexcept {
+        return m_pool_ ? *m_pool_ : BufferPool::default_pool();
+    }
+
+    /// Where the memory came from
+    BufferPool* m_pool_ = nullptr;
+
+    /// The first byte of the block
+    pointer m_data_ = nullptr;
+
+    /// The number of bytes in use
+    size_type m_size_ = 0;
+
+    /// The size of the block
+    size_type m_capacity_ = 0;
+};
+
+/** @brief A std::streambuf which writes into a PooledBuffer.
+ *
+ *  Serializing an object with cereal requires an std::ostream. This stream
+ *  buffer lets the serialized bytes go straight into pooled memory (as
+ *  opposed to into an std::stringstream, which would then be copied into
+ *  the BinaryBuffer).
+ */
+class PooledStreamBuffer : public std::streambuf {
+public:
+    /// Unsigned integral type used for sizes
+    using size_type = PooledBuffer::size_type;
+
+    /// Creates an empty stream buffer drawing from @p pool
+    explicit PooledStreamBuffer(BufferPool& pool) : m_buffer_(0, pool) {}
+
+    /** @brief Returns the bytes written so far.
+     *
+     *  After this call *this is empty.
+     *
+     *  @return A buffer containing the written bytes.
+     *
+     *  @throw None No throw guarantee.
+     */
+    PooledBuffer release() noexcept {
+        m_buffer_.resize(written_());
+        setp(nullptr, nullptr);
+        return std::move(m_buffer_);
+    }
+
+protected:
+    /// Called when the put area is full
+    int_type overflow(int_type ch) override {
+        if(traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+        reserve_(1);
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+        return ch;
+    }
+
+    /// Writes @p n characters in one go
+    std::streamsize xsputn(const char_type* s, std::streamsize n) override {
+        reserve_(n);
+        std::memcpy(pptr(), s, n);
+        advance_(n);
+        return n;
+    }
+
+private:
+    /// The number of bytes written so far
+    size_type written_() const noexcept { return pptr() - pbase(); }
+
+    /// Moves the put pointer forward by @p n (pbump only takes an int)
+    void advance_(size_type n) {
+        for(; n > INT_MAX; n -= INT_MAX) pbump(INT_MAX);
+        pbump(static_cast<int>(n));
+    }
+
+    /// Ensures there is room for @p n more characters in the put area
+    void reserve_(size_type n) {
+        const auto used = written_();
+        if(used + n <= m_buffer_.size()) return;
+        m_buffer_.resize(used);
+        const auto new_size = std::max(2 * m_buffer_.capacity(), used + n);
+        m_buffer_.resize(new_size);
+        m_buffer_.resize(m_buffer_.capacity());
+        auto* begin = reinterpret_cast<char_type*>(m_buffer_.data());
+        setp(begin, begin + m_buffer_.size());
+        advance_(used);
+    }
+
+    /// Where the bytes go
+    PooledBuffer m_buffer_;
+};
+
+} // namespace parallelzone::mpi_helpers::detail_
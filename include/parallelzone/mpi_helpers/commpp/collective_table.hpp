@@ -0,0 +1,224 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace parallelzone::mpi_helpers {
+class CommPP;
+
+/// The collectives whose implementation can be selected
+enum class collective_type { gather, allgather, allgatherv, allreduce };
+
+/** @brief The implementations a collective can be dispatched to.
+ *
+ *  - vendor: the MPI library's own implementation (the default),
+ *  - ring: blocks travel around a ring, bandwidth optimal,
+ *  - recursive_doubling: partners 1, 2, 4, ... ranks apart exchange
+ *    everything they have, latency optimal, needs a power of two ranks,
+ *  - binomial: data flows along a binomial tree to the root,
+ *  - hierarchical: reduce within each node, then across node leaders.
+ *
+ *  Not every algorithm exists for every collective, see is_applicable.
+ */
+enum class collective_algorithm {
+    vendor,
+    ring,
+    recursive_doubling,
+    binomial,
+    hierarchical
+};
+
+/// The name of @p c, e.g., "allgather"
+std::string to_string(collective_type c);
+
+/// The name of @p a, e.g., "recursive_doubling"
+std::string to_string(collective_algorithm a);
+
+/** @brief Can @p a implement @p c on a communicator of @p comm_size ranks?
+ *
+ *  @param[in] c The collective.
+ *  @param[in] a The candidate algorithm.
+ *  @param[in] comm_size The number of ranks.
+ *
+ *  @return True if @p a can be used for @p c and false otherwise. vendor can
+ *          always be used.
+ *
+ *  @throw None No throw guarantee.
+ */
+bool is_applicable(collective_type c, collective_algorithm a,
+                   std::size_t comm_size) noexcept;
+
+/** @brief Maps (collective, communicator size, message size) to the
+ *         algorithm CommPP should use.
+ *
+ *  Message sizes are grouped into buckets by their base-2 logarithm, see
+ *  bucket. The message size is the number of bytes each rank contributes
+ *  (for allgatherv the average contribution). Entries not in the table use
+ *  the vendor's implementation.
+ *
+ *  CommPP consults default_table() every time it performs a collective.
+ *  Since every rank of a communicator has to run the same algorithm, the
+ *  table must be the same on every rank. Tables made by tune_collectives are;
+ *  tables loaded from a file are if every rank loads the same file.
+ *
+ *  The methods of CollectiveTable are thread-safe.
+ */
+class CollectiveTable {
+public:
+    /// Unsigned integral type used for sizes
+    using size_type = std::size_t;
+
+    /// Type of an entry's key: (collective, communicator size, bucket)
+    using key_type = std::tuple<collective_type, size_type, size_type>;
+
+    /// Makes an empty table, i.e., one where everything uses vendor
+    CollectiveTable() = default;
+
+    /// Copies the entries of @p other
+    CollectiveTable(const CollectiveTable& other);
+
+    /// Replaces the entries of *this with those of @p rhs
+    CollectiveTable& operator=(const CollectiveTable& rhs);
+
+    /** @brief The bucket message sizes of @p n_bytes bytes belong to.
+     *
+     *  @return floor(log2(n_bytes)), with 0 and 1 bytes both in bucket 0.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static size_type bucket(size_type n_bytes) noexcept;
+
+    /** @brief The algorithm to use.
+     *
+     *  @param[in] c The collective being performed.
+     *  @param[in] comm_size The number of ranks in the communicator.
+     *  @param[in] n_bytes The message size.
+     *
+     *  @return The algorithm in the table, or vendor if there is none.
+     *
+     *  @throw None No throw guarantee.
+     */
+    collective_algorithm select(collective_type c, size_type comm_size,
+                                size_type n_bytes) const noexcept;
+
+    /** @brief Sets the algorithm for one bucket.
+     *
+     *  @param[in] c The collective.
+     *  @param[in] comm_size The number of ranks.
+     *  @param[in] bucket The message size bucket.
+     *  @param[in] a The algorithm to use.
+     *
+     *  @throw std::runtime_error if @p a is not applicable. Strong throw
+     *                            guarantee.
+     */
+    void set(collective_type c, size_type comm_size, size_type bucket,
+             collective_algorithm a);
+
+    /// Adds the entries of @p other, replacing those already in *this
+    void merge(const CollectiveTable& other);
+
+    /// The number of entries
+    size_type size() const;
+
+    /// Removes all entries, i.e., makes everything use vendor
+    void clear();
+
+    /** @brief Writes the table to @p path as text.
+     *
+     *  @return True if the file was written and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool save(const std::string& path) const noexcept;
+
+    /** @brief Reads a table written by save.
+     *
+     *  @return The table, or std::nullopt if @p path does not exist or can
+     *          not be parsed.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static std::optional<CollectiveTable> load(
+      const std::string& path) noexcept;
+
+    /** @brief The table CommPP consults.
+     *
+     *  It starts out empty. It is intentionally leaked so it can be used
+     *  during static destruction.
+     */
+    static CollectiveTable& default_table();
+
+    /// Tables are equal if they hold the same entries
+    bool operator==(const CollectiveTable& rhs) const;
+
+    /// Negation of operator==
+    bool operator!=(const CollectiveTable& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    /// Guards m_entries_
+    mutable std::mutex m_mutex_;
+
+    /// The entries
+    std::map<key_type, collective_algorithm> m_entries_;
+};
+
+/// Knobs for tune_collectives
+struct TuneSettings {
+    /// Unsigned integral type used for sizes
+    using size_type = std::size_t;
+
+    /// The largest message size (per rank, in bytes) to tune
+    size_type max_bytes = size_type(1) << 20;
+
+    /// Untimed calls made before timing each algorithm
+    size_type n_warmup = 2;
+
+    /// Timed calls of each algorithm
+    size_type n_iterations = 10;
+};
+
+/** @brief Benchmarks every applicable algorithm of every collective on
+ *         @p comm and picks the fastest for each message-size bucket.
+ *
+ *  Each bucket is timed with a message of exactly `2^bucket` bytes, for
+ *  buckets up to the one holding `settings.max_bytes`. The time of an
+ *  algorithm is the slowest rank's, so every rank picks the same algorithm.
+ *  The result only has entries for `comm.size()` ranks; merge it into
+ *  CollectiveTable::default_table() (and save it) to use it.
+ *
+ *  This function is collective over @p comm.
+ *
+ *  @param[in] comm The communicator to tune.
+ *  @param[in] settings The message sizes and repetition counts.
+ *
+ *  @return The table of fastest algorithms, the same on every rank.
+ *
+ *  @throw std::runtime_error if @p comm is null or is not backed by MPI (see
+ *                            CommPP::make_threaded). Strong throw guarantee.
+ */
+CollectiveTable tune_collectives(const CommPP& comm,
+                                 const TuneSettings& settings = {});
+
+} // namespace parallelzone::mpi_helpers
@@ -16,9 +16,9 @@
 
 #pragma once
 #include <memory>
-#include <mpi.h>
 #include <parallelzone/mpi_helpers/binary_buffer/binary_buffer.hpp>
 #include <parallelzone/mpi_helpers/binary_buffer/binary_view.hpp>
+#include <parallelzone/mpi_helpers/mpi.hpp>
 #include <parallelzone/mpi_helpers/traits/gather.hpp>
 
 namespace parallelzone::mpi_helpers {
@@ -71,6 +71,17 @@ public:
     /// Type returned by the binary version of gatherv
     using binary_gatherv_return = std::optional<gatherv_pair>;
 
+    /** @brief Type of a function which reduces buffers in memory.
+     *
+     *  A function of this type is given @p n_inputs pointers to arrays of
+     *  @p count elements each and must write their element-wise reduction,
+     *  applied in the order the inputs are given, to @p output. Backends which
+     *  do not go through MPI use it in place of an MPI_Op.
+     */
+    using local_reduce_type = void (*)(const void* const* inputs,
+                                       std::size_t n_inputs, void* output,
+                                       std::size_t count);
+
     // -------------------------------------------------------------------------
     // -- CTors, Assignment, and Dtor
     // -------------------------------------------------------------------------
@@ -157,6 +168,34 @@ public:
     /// Default dtor
     ~CommPP() noexcept;
 
+    /** @brief Creates @p n_ranks communicators whose "ranks" are threads.
+     *
+     *  The communicators returned by this function all belong to a single
+     *  team. The i-th communicator has rank i and is meant to be used by the
+     *  i-th of @p n_ranks threads within the current process. Collectives on
+     *  these communicators are implemented with shared memory and barriers,
+     *  so no MPI calls are made and MPI need not be initialized. Like MPI
+     *  collectives, every thread of the team must take part in each
+     *  collective and the collectives must be called in the same order on
+     *  each thread.
+     *
+     *  Since there is no MPI communicator behind the resulting objects, comm()
+     *  will return MPI_COMM_NULL for them. The resulting communicators compare
+     *  equal to each other (and their copies), and not equal to any other
+     *  communicator.
+     *
+     *  @param[in] n_ranks How many threads will make up the team.
+     *
+     *  @return A vector of @p n_ranks communicators, the i-th of which is
+     *          rank i of the team.
+     *
+     *  @throw std::out_of_range if @p n_ranks is not positive. Strong throw
+     *                           guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the state.
+     *                        Strong throw guarantee.
+     */
+    static std::vector<CommPP> make_threaded(size_type n_ranks);
+
     // -------------------------------------------------------------------------
     // -- Accessors
     // -------------------------------------------------------------------------
@@ -233,12 +272,25 @@ public:
      */
     void swap(CommPP& other) noexcept;
 
+    /** @brief Tells the other ranks that this rank failed.
+     *
+     *  For communicators made by make_threaded, this marks the team as
+     *  failed: every rank waiting in a collective, or later starting one,
+     *  throws std::runtime_error instead of waiting for this rank forever.
+     *  Ranks of MPI communicators can not be told about a failure short of
+     *  MPI_Abort, so for them (and for null communicators) this does nothing.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void abort() const noexcept;
+
     /** @brief Determines if *this is value equal to @p rhs.
      *
      *  *this is value equal to @p rhs if both *this and @p rhs are null
      *  communicators, either by being default constructed or by being set to
      *  MPI_COMM_NULL, or if both *this and @p rhs wrap handles to the same
-     *  MPI communicator (as determined by MPI_Comm_compare).
+     *  MPI communicator (as determined by MPI_Comm_compare). Communicators
+     *  made by make_threaded are equal if they belong to the same team.
      *
      *  @param[in] rhs The object being compared to *this.
      *
@@ -548,6 +600,9 @@ public:
     all_reduce_return_type<T> reduce(T&& input, Fxn&& fxn) const;
 
 private:
+    /// Creates a communicator which is implemented by @p pimpl
+    explicit CommPP(pimpl_pointer pimpl) noexcept;
+
     /// Code factorization for determining if m_pimpl_ is not null
     bool has_pimpl_() const noexcept;
 
@@ -576,6 +631,16 @@ private:
     template<typename T>
     gather_return_type<T> gatherv_t_(T&& input, opt_root_t r) const;
 
+    /** @brief The result of gathering @p input on a single-rank communicator.
+     *
+     *  With one rank a gather (or gatherv) is the identity, so no MPI call is
+     *  needed. Objects which would be serialized are instead moved (or
+     *  copied) into a one element std::vector, and all other objects are
+     *  moved (or copied) into the result as is.
+     */
+    template<typename T>
+    static gather_return_type<T> single_rank_gather_(T&& input);
+
     /// Code factorization for the two public template reduce methods
     template<typename T, typename Fxn>
     reduce_return_type<T> reduce_t_(T&& input, Fxn&& fxn,
@@ -597,6 +662,10 @@ private:
     binary_gatherv_return gatherv_(const_binary_reference data,
                                    opt_root_t root) const;
 
+    /// Wraps a call to m_pimpl_->reduce(send, recv, count, type, op, ...)
+    void reduce_(const void* send, void* recv, int count, MPI_Datatype type,
+                 MPI_Op op, local_reduce_type local, opt_root_t root) const;
+
     /// The object actually implementing *this
     pimpl_pointer m_pimpl_;
 };
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <parallelzone/mpi_helpers/traits/mpi_data_type.hpp>
 #include <parallelzone/mpi_helpers/traits/mpi_op.hpp>
 
@@ -74,6 +75,10 @@ typename CommPP::gather_return_type<T> CommPP::gather_t_(
 
     const bool am_i_root = root.has_value() ? me() == *root : true;
 
+    // We are the only rank, no need to call MPI
+    if(size() == 1 && am_i_root)
+        return single_rank_gather_(std::forward<T>(input));
+
     if constexpr(needs_serialized_v<clean_type>) {
         // Do gather in binary
         auto binary    = make_binary_buffer(std::forward<T>(input));
@@ -122,6 +127,11 @@ typename CommPP::gather_return_type<T> CommPP::gatherv_t_(
     using return_type = typename CommPP::gather_return_type<clean_type>;
     using value_type  = typename return_type::value_type;
 
+    // We are the only rank, no need to call MPI
+    const bool am_i_root = root.has_value() ? me() == *root : true;
+    if(size() == 1 && am_i_root)
+        return single_rank_gather_(std::forward<T>(input));
+
     if constexpr(needs_serialized_v<clean_type>) {
         //  Do gather in binary
         auto binary    = make_binary_buffer(std::forward<T>(input));
@@ -163,6 +173,7 @@ typename CommPP::gather_return_type<T> CommPP::gatherv_t_(
         constexpr auto t_size = sizeof(element_type);
 
         value_type vec;
+        vec.reserve(buffer.size() / t_size);
         for(size_type i = 0; i < size_type(buffer.size()); i += t_size) {
             const_binary_reference view(buffer.data() + i, t_size);
             vec.emplace_back(std::move(from_binary_view<element_type>(view)));
@@ -172,6 +183,22 @@ typename CommPP::gather_return_type<T> CommPP::gatherv_t_(
     }
 }
 
+template<typename T>
+typename CommPP::gather_return_type<T> CommPP::single_rank_gather_(T&& input) {
+    using clean_type  = std::decay_t<T>;
+    using return_type = typename CommPP::gather_return_type<clean_type>;
+    using value_type  = typename return_type::value_type;
+
+    if constexpr(needs_serialized_v<clean_type>) {
+        value_type vec;
+        vec.reserve(1);
+        vec.emplace_back(std::forward<T>(input));
+        return return_type(std::move(vec));
+    } else {
+        return return_type(std::in_place, std::forward<T>(input));
+    }
+}
+
 template<typename T, typename Fxn>
 typename CommPP::reduce_return_type<T> CommPP::reduce_t_(
   T&& input, Fxn&& fxn, opt_root_t root) const {
@@ -185,21 +212,32 @@ typename CommPP::reduce_return_type<T> CommPP::reduce_t_(
     static_assert(has_mpi_op_v<clean_fxn>, "Is a recognized MPI Operation?");
 
     const auto am_i_root = root.has_value() ? me() == *root : true;
-    const auto n_elems   = input.size();
-    auto type            = mpi_data_type_v<value_type>;
-    auto op              = mpi_op_v<clean_fxn>;
+
+    // Reducing over one rank leaves the input as is
+    if(size() == 1 && am_i_root)
+        return reduce_return_type<T>(std::forward<T>(input));
+
+    const auto n_elems = input.size();
+    auto type          = mpi_data_type_v<value_type>;
+    auto op            = mpi_op_v<clean_fxn>;
 
     std::vector<value_type> temp;
     if(am_i_root) std::vector<value_type>(n_elems).swap(temp);
 
-    const auto send = input.data();
-    const auto recv = temp.data();
+    // Used by backends which reduce in memory instead of through MPI
+    auto local = [](const void* const* inputs, std::size_t n_inputs,
+                    void* output, std::size_t count) {
+        clean_fxn f{};
+        auto* out = static_cast<value_type*>(output);
+        auto* in0 = static_cast<const value_type*>(inputs[0]);
+        std::copy(in0, in0 + count, out);
+        for(std::size_t i = 1; i < n_inputs; ++i) {
+            auto* in = static_cast<const value_type*>(inputs[i]);
+            for(std::size_t j = 0; j < count; ++j) out[j] = f(out[j], in[j]);
+        }
+    };
 
-    if(root.has_value()) {
-        MPI_Reduce(send, recv, n_elems, type, op, *root, comm());
-    } else {
-        MPI_Allreduce(send, recv, n_elems, type, op, comm());
-    }
+    reduce_(input.data(), temp.data(), n_elems, type, op, local, root);
     reduce_return_type<T> rv;
     if(am_i_root) rv.emplace(std::move(temp));
     return rv;
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/** @file async_ops.hpp
+ *
+ *  Nonblocking counterparts of CommPP's collectives which return awaitables.
+ *  The contents of this file require C++20 coroutine support. When compiled
+ *  under an older standard this file is empty.
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <optional>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <parallelzone/mpi_helpers/coroutine/request_executor.hpp>
+#include <stdexcept>
+
+namespace parallelzone::mpi_helpers::coroutine {
+namespace detail_ {
+
+/// Throws if @p comm has no MPI communicator (e.g., made by make_threaded)
+inline void assert_mpi_backed(const CommPP& comm) {
+    if(comm.comm() == MPI_COMM_NULL)
+        throw std::runtime_error("The async_* operations need a communicator "
+                                 "backed by MPI");
+}
+
+} // namespace detail_
+
+/** @brief Starts a nonblocking barrier on @p comm.
+ *
+ *  This call wraps MPI_Ibarrier.
+ *
+ *  @param[in] comm     The communicator to synchronize.
+ *  @param[in] executor The executor which will resume the awaiting coroutine.
+ *
+ *  @return An awaitable which completes when all ranks have entered the
+ *          barrier.
+ *
+ *  @throw std::runtime_error if @p comm is not backed by MPI (e.g., it was
+ *                            made by CommPP::make_threaded). Strong throw
+ *                            guarantee.
+ */
+inline RequestAwaitable async_barrier(const CommPP& comm,
+                                      RequestExecutor& executor) {
+    detail_::assert_mpi_backed(comm);
+    MPI_Request request;
+    MPI_Ibarrier(comm.comm(), &request);
+    return executor.wait(request);
+}
+
+/** @brief Starts a nonblocking gather of binary data into a provided buffer.
+ *
+ *  This is the nonblocking analog of the binary gather used internally by
+ *  CommPP. Each process contributes `in_data.size()` bytes (which must be the
+ *  same on all processes). If @p root is set this wraps MPI_Igather,
+ *  otherwise it wraps MPI_Iallgather.
+ *
+ *  Neither @p in_data nor @p out_buffer may be modified or released until the
+ *  returned awaitable completes.
+ *
+ *  @param[in] comm       The communicator to gather over.
+ *  @param[in] in_data    The local bytes to send.
+ *  @param[in] out_buffer Buffer of at least `in_data.size() * comm.size()`
+ *                        bytes. Only needs to be allocated on the root process
+ *                        if @p root is set.
+ *  @param[in] executor   The executor which will resume the awaiting
+ *                        coroutine.
+ *  @param[in] root       Rank to gather to. If unset, every rank gets the
+ *                        result.
+ *
+ *  @return An awaitable which completes when the gather is done.
+ *
+ *  @throw std::runtime_error if @p comm is not backed by MPI or if
+ *                            @p out_buffer is too small. Strong throw
+ *                            guarantee.
+ */
+inline RequestAwaitable async_gather(
+  const CommPP& comm, ConstBinaryView in_data, BinaryView out_buffer,
+  RequestExecutor& executor,
+  std::optional<CommPP::size_type> root = std::nullopt) {
+    detail_::assert_mpi_backed(comm);
+    const bool am_i_root = root.has_value() ? comm.me() == *root : true;
+    const int n_in       = in_data.size();
+    if(am_i_root && out_buffer.size() < in_data.size() * comm.size())
+        throw std::runtime_error("The provided buffer is not large enough...");
+
+    MPI_Request request;
+    auto p_in  = in_data.data();
+    auto p_out = out_buffer.data();
+    if(root.has_value()) {
+        MPI_Igather(p_in, n_in, MPI_BYTE, p_out, n_in, MPI_BYTE, *root,
+                    comm.comm(), &request);
+    } else {
+        MPI_Iallgather(p_in, n_in, MPI_BYTE, p_out, n_in, MPI_BYTE,
+                       comm.comm(), &request);
+    }
+    return executor.wait(request);
+}
+
+/** @brief Starts a nonblocking reduction of a contiguous array.
+ *
+ *  This is the nonblocking analog of CommPP::reduce. The result is written
+ *  into @p output, which must have the same number of elements as @p input
+ *  (on the root process if @p root is set). If @p root is set this wraps
+ *  MPI_Ireduce, otherwise it wraps MPI_Iallreduce.
+ *
+ *  Neither @p input nor @p output may be modified or released until the
+ *  returned awaitable completes.
+ *
+ *  @tparam T   A contiguous container whose elements map to an MPI data type.
+ *  @tparam Fxn A standard library functor which maps to an MPI operation.
+ *
+ *  @param[in] comm     The communicator to reduce over.
+ *  @param[in] input    The local contribution.
+ *  @param[out] output  Where the result is written.
+ *  @param[in] fxn      The reduction functor.
+ *  @param[in] executor The executor which will resume the awaiting coroutine.
+ *  @param[in] root     Rank to reduce to. If unset, every rank gets the
+ *                      result.
+ *
+ *  @return An awaitable which completes when the reduction is done.
+ *
+ *  @throw std::runtime_error if @p comm is not backed by MPI or if @p output
+ *                            has fewer elements than @p input on a rank
+ *                            receiving the result. Strong throw guarantee.
+ */
+template<typename T, typename Fxn>
+RequestAwaitable async_reduce(
+  const CommPP& comm, const T& input, T& output, Fxn&& fxn,
+  RequestExecutor& executor,
+  std::optional<CommPP::size_type> root = std::nullopt) {
+    using value_type = typename T::value_type;
+    using clean_fxn  = std::decay_t<Fxn>;
+    static_assert(has_mpi_data_type_v<value_type>, "Is a recognized MPI type?");
+    static_assert(has_mpi_op_v<clean_fxn>, "Is a recognized MPI Operation?");
+    detail_::assert_mpi_backed(comm);
+    const bool am_i_root = root.has_value() ? comm.me() == *root : true;
+    if(am_i_root && output.size() < input.size())
+        throw std::runtime_error("The provided buffer is not large enough...");
+
+    const int n_elems = input.size();
+    auto type         = mpi_data_type_v<value_type>;
+    auto op           = mpi_op_v<clean_fxn>;
+
+    MPI_Request request;
+    if(root.has_value()) {
+        MPI_Ireduce(input.data(), output.data(), n_elems, type, op, *root,
+                    comm.comm(), &request);
+    } else {
+        MPI_Iallreduce(input.data(), output.data(), n_elems, type, op,
+                       comm.comm(), &request);
+    }
+    return executor.wait(request);
+}
+
+} // namespace parallelzone::mpi_helpers::coroutine
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/** @file coroutine.hpp
+ *
+ *  This is a convenience header for including the optional C++20 coroutine
+ *  layer of CommPP. The layer is header-only and is only available when the
+ *  translation unit is compiled with coroutine support (i.e., C++20 or later),
+ *  in which case PARALLELZONE_HAS_COROUTINES is defined. The C++17 library is
+ *  unaffected by this layer.
+ */
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define PARALLELZONE_HAS_COROUTINES
+#endif
+
+#include <parallelzone/mpi_helpers/coroutine/async_ops.hpp>
+#include <parallelzone/mpi_helpers/coroutine/request_executor.hpp>
+#include <parallelzone/mpi_helpers/coroutine/task.hpp>
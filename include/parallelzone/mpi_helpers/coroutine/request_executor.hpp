@@ -0,0 +1,264 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/** @file request_executor.hpp
+ *
+ *  The contents of this file require C++20 coroutine support. When compiled
+ *  under an older standard this file is empty.
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <parallelzone/mpi_helpers/mpi.hpp>
+#include <vector>
+
+namespace parallelzone::mpi_helpers::coroutine {
+
+class RequestExecutor;
+
+/** @brief Allows a coroutine to co_await the completion of an MPI request.
+ *
+ *  Instances of this class are returned by RequestExecutor::wait and by the
+ *  asynchronous operations in async_ops.hpp. When awaited, the request is
+ *  tested once; if it has already completed the coroutine continues without
+ *  suspending. Otherwise the coroutine is suspended and the request is handed
+ *  to the RequestExecutor, which resumes the coroutine once the request
+ *  completes.
+ *
+ *  The result of `co_await` is the MPI_Status of the completed request.
+ */
+class RequestAwaitable {
+public:
+    /// Type of an MPI request handle
+    using request_type = MPI_Request;
+
+    /// Type of the status returned when the request completes
+    using status_type = MPI_Status;
+
+    /** @brief Wraps @p request so that it is progressed by @p executor.
+     *
+     *  @param[in] executor The executor which will resume the awaiting
+     *                      coroutine. @p executor must outlive the
+     *                      co_await expression.
+     *  @param[in] request  An active MPI request. *this takes ownership of
+     *                      the request; callers should not wait on or free
+     *                      it themselves.
+     *
+     *  @throw None No throw guarantee.
+     */
+    RequestAwaitable(RequestExecutor& executor, request_type request) noexcept :
+      m_executor_(&executor), m_request_(request), m_status_() {}
+
+    /// Tests the request, true if it has already completed
+    bool await_ready() noexcept {
+        int flag = 0;
+        MPI_Test(&m_request_, &flag, &m_status_);
+        return flag != 0;
+    }
+
+    /// Registers @p h with the executor so it is resumed on completion
+    void await_suspend(std::coroutine_handle<> h);
+
+    /// Returns the status of the completed request
+    status_type await_resume() const noexcept { return m_status_; }
+
+private:
+    /// The executor responsible for resuming the awaiting coroutine
+    RequestExecutor* m_executor_;
+
+    /// The request being awaited
+    request_type m_request_;
+
+    /// Where the status of the completed request is written
+    status_type m_status_;
+};
+
+/** @brief Resumes suspended coroutines when their MPI requests complete.
+ *
+ *  The RequestExecutor is a small, single-threaded event loop. Coroutines
+ *  which co_await a RequestAwaitable register their MPI request with the
+ *  executor and suspend. Each call to progress() polls all outstanding
+ *  requests with a single call to MPI_Testsome and resumes the coroutines
+ *  whose requests completed.
+ *
+ *  The executor is deliberately minimal: it does not own the coroutines (the
+ *  Task objects do) and it makes no attempt to be thread-safe. Each thread
+ *  which wants to drive coroutines should use its own executor.
+ */
+class RequestExecutor {
+public:
+    /// Type of an MPI request handle
+    using request_type = RequestAwaitable::request_type;
+
+    /// Type of the status of a completed request
+    using status_type = RequestAwaitable::status_type;
+
+    /// Type of a type-erased handle to a suspended coroutine
+    using handle_type = std::coroutine_handle<>;
+
+    /// Unsigned type used for counting
+    using size_type = std::size_t;
+
+    /** @brief Makes a RequestAwaitable for @p request which resumes on *this.
+     *
+     *  This is the entry point for awaiting an MPI request which was started
+     *  by hand, e.g., `co_await executor.wait(req);`.
+     *
+     *  @param[in] request The MPI request to wait on.
+     *
+     *  @return An object which can be co_await-ed.
+     *
+     *  @throw None No throw guarantee.
+     */
+    RequestAwaitable wait(request_type request) noexcept {
+        return RequestAwaitable(*this, request);
+    }
+
+    /** @brief Registers a suspended coroutine with *this.
+     *
+     *  Users normally do not call this method directly, instead it is called
+     *  when a RequestAwaitable suspends a coroutine.
+     *
+     *  @param[in] request The request the coroutine is waiting on.
+     *  @param[in] h       The suspended coroutine.
+     *  @param[in] status  Where to write the status of the request upon
+     *                     completion. Must remain valid until @p h resumes.
+     *
+     *  @throw std::bad_alloc if there is a problem growing the internal
+     *                        arrays. Strong throw guarantee.
+     */
+    void submit(request_type request, handle_type h, status_type* status) {
+        m_requests_.reserve(m_requests_.size() + 1);
+        m_handles_.reserve(m_handles_.size() + 1);
+        m_statuses_.reserve(m_statuses_.size() + 1);
+        m_requests_.push_back(request);
+        m_handles_.push_back(h);
+        m_statuses_.push_back(status);
+    }
+
+    /// The number of coroutines currently waiting on a request
+    size_type size() const noexcept { return m_requests_.size(); }
+
+    /// True if no coroutines are waiting on *this
+    bool empty() const noexcept { return m_requests_.empty(); }
+
+    /** @brief Polls the outstanding requests and resumes finished coroutines.
+     *
+     *  This method calls MPI_Testsome once on all outstanding requests. The
+     *  coroutines whose requests completed are removed from *this and then
+     *  resumed (in the order they were submitted). Resumed coroutines are
+     *  free to co_await new requests; those requests will be polled on the
+     *  next call to progress().
+     *
+     *  @return The number of coroutines which were resumed.
+     */
+    size_type progress();
+
+    /** @brief Calls progress() until @p task is done.
+     *
+     *  @tparam TaskType A type with a `done()` member, e.g., Task<T>.
+     *
+     *  @param[in] task The task to drive to completion.
+     */
+    template<typename TaskType>
+    void run(const TaskType& task) {
+        while(!task.done()) progress();
+    }
+
+    /// Calls progress() until no coroutines are waiting on *this
+    void drain() {
+        while(!empty()) progress();
+    }
+
+private:
+    /// The outstanding requests, parallel to m_handles_ and m_statuses_
+    std::vector<request_type> m_requests_;
+
+    /// The coroutine waiting on the corresponding request
+    std::vector<handle_type> m_handles_;
+
+    /// Where to write the status of the corresponding request
+    std::vector<status_type*> m_statuses_;
+
+    /// Scratch space for MPI_Testsome, kept to avoid reallocating
+    std::vector<int> m_indices_;
+
+    /// Scratch space for MPI_Testsome, kept to avoid reallocating
+    std::vector<status_type> m_status_buffer_;
+
+    /// Scratch space for the handles ready to resume
+    std::vector<handle_type> m_ready_;
+};
+
+// -----------------------------------------------------------------------------
+// -- Inline Implementations
+// -----------------------------------------------------------------------------
+
+inline void RequestAwaitable::await_suspend(std::coroutine_handle<> h) {
+    m_executor_->submit(m_request_, h, &m_status_);
+}
+
+inline RequestExecutor::size_type RequestExecutor::progress() {
+    if(empty()) return 0;
+
+    const int n = m_requests_.size();
+    m_indices_.resize(n);
+    m_status_buffer_.resize(n);
+
+    int n_done = 0;
+    MPI_Testsome(n, m_requests_.data(), &n_done, m_indices_.data(),
+                 m_status_buffer_.data());
+    if(n_done == MPI_UNDEFINED || n_done == 0) return 0;
+
+    // Record the statuses and flag the finished requests (m_statuses_[i] is
+    // reset to nullptr to flag request i as done)
+    for(int i = 0; i < n_done; ++i) {
+        const auto idx    = m_indices_[i];
+        *m_statuses_[idx] = m_status_buffer_[i];
+        m_statuses_[idx]  = nullptr;
+    }
+
+    // Compact the arrays before resuming anything, since resumed coroutines
+    // may submit new requests. Ready coroutines keep their submission order.
+    m_ready_.clear();
+    size_type j = 0;
+    for(size_type i = 0; i < m_handles_.size(); ++i) {
+        if(m_statuses_[i] == nullptr) {
+            m_ready_.push_back(m_handles_[i]);
+            continue;
+        }
+        m_requests_[j] = m_requests_[i];
+        m_handles_[j]  = m_handles_[i];
+        m_statuses_[j] = m_statuses_[i];
+        ++j;
+    }
+    m_requests_.resize(j);
+    m_handles_.resize(j);
+    m_statuses_.resize(j);
+
+    // A resumed coroutine may drive *this (e.g., by calling run), so resume
+    // from a local copy of the ready list
+    auto ready = std::move(m_ready_);
+    m_ready_   = {};
+    for(auto h : ready) h.resume();
+    return n_done;
+}
+
+} // namespace parallelzone::mpi_helpers::coroutine
+
+#endif
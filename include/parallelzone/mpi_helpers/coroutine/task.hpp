@@ -0,0 +1,209 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/** @file task.hpp
+ *
+ *  The contents of this file require C++20 coroutine support. When compiled
+ *  under an older standard this file is empty.
+ */
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace parallelzone::mpi_helpers::coroutine {
+
+template<typename T>
+class Task;
+
+namespace detail_ {
+
+/** @brief State common to the promise types of all Task instantiations.
+ *
+ *  Tasks start eagerly and suspend at their final suspension point so the
+ *  Task object can retrieve the result. If another coroutine is awaiting the
+ *  task, control is transferred to that coroutine when the task finishes.
+ */
+struct TaskPromiseBase {
+    /// Resumes the awaiting coroutine (if any) once the task finishes
+    struct FinalAwaitable {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<Promise> h) const noexcept {
+            auto next = h.promise().m_continuation;
+            return next ? next : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /// Tasks start running as soon as they are called
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+
+    /// Tasks suspend when done so the Task can read the result
+    FinalAwaitable final_suspend() const noexcept { return {}; }
+
+    /// Stores the exception so it can be rethrown by Task::get
+    void unhandled_exception() noexcept {
+        m_exception = std::current_exception();
+    }
+
+    /// Rethrows the stored exception, if any
+    void rethrow_if_exception() const {
+        if(m_exception) std::rethrow_exception(m_exception);
+    }
+
+    /// The coroutine awaiting this task's result (may be null)
+    std::coroutine_handle<> m_continuation;
+
+    /// Exception which escaped the coroutine body (if any)
+    std::exception_ptr m_exception;
+};
+
+/// Promise type for Task<T> with non-void T
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& value) {
+        m_value.emplace(std::forward<U>(value));
+    }
+
+    T& result() & {
+        rethrow_if_exception();
+        return *m_value;
+    }
+
+    /// The value returned by the coroutine
+    std::optional<T> m_value;
+};
+
+/// Promise type for Task<void>
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() { rethrow_if_exception(); }
+};
+
+} // namespace detail_
+
+/** @brief The return type of coroutines which await MPI requests.
+ *
+ *  A Task owns the coroutine frame of the coroutine which returned it. Tasks
+ *  start eagerly, i.e., the coroutine body runs until its first suspension
+ *  point before the Task is returned to the caller. A Task can be driven to
+ *  completion by a RequestExecutor (`executor.run(task)`) or co_await-ed from
+ *  another coroutine, which allows pipelined communication to be written as
+ *  ordinary straight-line code.
+ *
+ *  @tparam T The type of the value the coroutine co_returns. May be void.
+ */
+template<typename T = void>
+class Task {
+public:
+    /// The promise type the compiler uses for the coroutine frame
+    using promise_type = detail_::TaskPromise<T>;
+
+    /// Type of a handle to the owned coroutine
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /// Takes ownership of the coroutine @p h
+    explicit Task(handle_type h) noexcept : m_handle_(h) {}
+
+    /// Tasks own their coroutine frame and are thus move-only
+    Task(const Task&) = delete;
+
+    /// Tasks own their coroutine frame and are thus move-only
+    Task& operator=(const Task&) = delete;
+
+    /// Takes ownership of the coroutine in @p other
+    Task(Task&& other) noexcept :
+      m_handle_(std::exchange(other.m_handle_, nullptr)) {}
+
+    /// Releases the current coroutine and takes ownership of @p rhs's
+    Task& operator=(Task&& rhs) noexcept {
+        if(this != &rhs) {
+            if(m_handle_) m_handle_.destroy();
+            m_handle_ = std::exchange(rhs.m_handle_, nullptr);
+        }
+        return *this;
+    }
+
+    /// Destroys the coroutine frame
+    ~Task() noexcept {
+        if(m_handle_) m_handle_.destroy();
+    }
+
+    /// True if the coroutine has run to completion
+    bool done() const noexcept { return !m_handle_ || m_handle_.done(); }
+
+    /** @brief Returns the result of the coroutine.
+     *
+     *  @return The value co_returned by the coroutine (nothing for
+     *          Task<void>).
+     *
+     *  @throw std::runtime_error if the coroutine has not finished.
+     *  @throw ??? Rethrows any exception which escaped the coroutine.
+     */
+    decltype(auto) get() {
+        if(!done()) throw std::runtime_error("Task has not finished");
+        return m_handle_.promise().result();
+    }
+
+    // -------------------------------------------------------------------------
+    // -- Awaitable interface, allows Tasks to co_await other Tasks
+    // -------------------------------------------------------------------------
+
+    bool await_ready() const noexcept { return done(); }
+
+    void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        m_handle_.promise().m_continuation = awaiting;
+    }
+
+    decltype(auto) await_resume() { return m_handle_.promise().result(); }
+
+private:
+    /// The coroutine *this owns
+    handle_type m_handle_;
+};
+
+namespace detail_ {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(
+      std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail_
+} // namespace parallelzone::mpi_helpers::coroutine
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/** @file mpi.hpp
+ *
+ *  ParallelZone includes this header instead of `<mpi.h>`. Normally it is
+ *  just `<mpi.h>`. If ParallelZone was configured with BUILD_WITHOUT_MPI
+ *  (which defines PARALLELZONE_WITHOUT_MPI) it is instead a built-in,
+ *  single-process stand-in for the parts of MPI ParallelZone uses, see
+ *  serial_mpi.hpp.
+ */
+
+#ifdef PARALLELZONE_WITHOUT_MPI
+#include <parallelzone/mpi_helpers/serial_mpi/serial_mpi.hpp>
+#else
+#include <mpi.h>
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+/** @file serial_mpi.hpp
+ *
+ *  A single-process implementation of the subset of MPI used by
+ *  ParallelZone. It is used in place of a real MPI when ParallelZone is built
+ *  with BUILD_WITHOUT_MPI. Names and signatures follow the MPI standard so
+ *  the rest of ParallelZone compiles unchanged.
+ *
+ *  Every communicator has exactly one rank (rank 0). Collectives copy the
+ *  send buffer into the receive buffer, nonblocking operations complete
+ *  immediately, and point-to-point messages a rank sends to itself are
+ *  buffered until they are received. Communicators made with MPI_Comm_dup,
+ *  MPI_Comm_split, or MPI_Comm_split_type are distinct handles, which compare
+ *  MPI_CONGRUENT to each other. Attributes are never copied by MPI_Comm_dup.
+ *  All functions are thread-safe, so any thread level can be provided.
+ *
+ *  The functions have C++ linkage, so the stand-in can not collide with a
+ *  real MPI library linked into the same program.
+ */
+
+// -----------------------------------------------------------------------------
+// -- Handles
+// -----------------------------------------------------------------------------
+
+using MPI_Comm     = int;
+using MPI_Datatype = int;
+using MPI_Op       = int;
+using MPI_Request  = int;
+using MPI_Info     = int;
+
+/// Mirrors the public members of MPI's status object
+struct MPI_Status {
+    int MPI_SOURCE;
+    int MPI_TAG;
+    int MPI_ERROR;
+};
+
+using MPI_Comm_copy_attr_function = int(MPI_Comm, int, void*, void*, void*,
+                                        int*);
+using MPI_Comm_delete_attr_function = int(MPI_Comm, int, void*, void*);
+
+#define MPI_COMM_NULL 0
+#define MPI_COMM_WORLD 1
+#define MPI_COMM_SELF 2
+
+#define MPI_REQUEST_NULL 0
+#define MPI_INFO_NULL 0
+#define MPI_OP_NULL 0
+#define MPI_DATATYPE_NULL 0
+
+#define MPI_STATUS_IGNORE (static_cast<MPI_Status*>(nullptr))
+#define MPI_STATUSES_IGNORE (static_cast<MPI_Status*>(nullptr))
+#define MPI_IN_PLACE (reinterpret_cast<void*>(1))
+
+#define MPI_COMM_NULL_COPY_FN \
+    (static_cast<MPI_Comm_copy_attr_function*>(nullptr))
+#define MPI_COMM_NULL_DELETE_FN \
+    (static_cast<MPI_Comm_delete_attr_function*>(nullptr))
+
+// -----------------------------------------------------------------------------
+// -- Constants
+// -----------------------------------------------------------------------------
+
+#define MPI_SUCCESS 0
+#define MPI_ERR_ARG 1
+#define MPI_ERR_COMM 2
+#define MPI_ERR_RANK 3
+#define MPI_ERR_ROOT 4
+#define MPI_ERR_TYPE 5
+#define MPI_ERR_OP 6
+#define MPI_ERR_KEYVAL 7
+#define MPI_ERR_REQUEST 8
+#define MPI_ERR_TRUNCATE 9
+#define MPI_ERR_OTHER 10
+
+#define MPI_PROC_NULL (-2)
+#define MPI_ANY_SOURCE (-1)
+#define MPI_ANY_TAG (-1)
+#define MPI_UNDEFINED (-32766)
+#define MPI_KEYVAL_INVALID (-1)
+#define MPI_MAX_PROCESSOR_NAME 256
+
+#define MPI_THREAD_SINGLE 0
+#define MPI_THREAD_FUNNELED 1
+#define MPI_THREAD_SERIALIZED 2
+#define MPI_THREAD_MULTIPLE 3
+
+#define MPI_IDENT 0
+#define MPI_CONGRUENT 1
+#define MPI_SIMILAR 2
+#define MPI_UNEQUAL 3
+
+#define MPI_COMM_TYPE_SHARED 1
+
+// Datatypes
+#define MPI_CHAR 1
+#define MPI_SIGNED_CHAR 2
+#define MPI_UNSIGNED_CHAR 3
+#define MPI_BYTE 4
+#define MPI_SHORT 5
+#define MPI_UNSIGNED_SHORT 6
+#define MPI_INT 7
+#define MPI_UNSIGNED 8
+#define MPI_LONG 9
+#define MPI_UNSIGNED_LONG 10
+#define MPI_LONG_LONG 11
+#define MPI_UNSIGNED_LONG_LONG 12
+#define MPI_FLOAT 13
+#define MPI_DOUBLE 14
+#define MPI_LONG_DOUBLE 15
+#define MPI_C_BOOL 16
+#define MPI_C_FLOAT_COMPLEX 17
+#define MPI_C_DOUBLE_COMPLEX 18
+#define MPI_C_LONG_DOUBLE_COMPLEX 19
+
+// Operations
+#define MPI_MAX 1
+#define MPI_MIN 2
+#define MPI_SUM 3
+#define MPI_PROD 4
+#define MPI_LAND 5
+#define MPI_BAND 6
+#define MPI_LOR 7
+#define MPI_BOR 8
+#define MPI_LXOR 9
+#define MPI_BXOR 10
+
+// -----------------------------------------------------------------------------
+// -- Environment
+// -----------------------------------------------------------------------------
+
+int MPI_Init(int* argc, char*** argv);
+int MPI_Init_thread(int* argc, char*** argv, int required, int* provided);
+int MPI_Initialized(int* flag);
+int MPI_Finalize();
+int MPI_Finalized(int* flag);
+int MPI_Query_thread(int* provided);
+int MPI_Abort(MPI_Comm comm, int errorcode);
+double MPI_Wtime();
+int MPI_Get_processor_name(char* name, int* resultlen);
+
+// -----------------------------------------------------------------------------
+// -- Communicators and attributes
+// -----------------------------------------------------------------------------
+
+int MPI_Comm_size(MPI_Comm comm, int* size);
+int MPI_Comm_rank(MPI_Comm comm, int* rank);
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm* newcomm);
+int MPI_Comm_split(MPI_Comm comm, int color, int key, MPI_Comm* newcomm);
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info info,
+                        MPI_Comm* newcomm);
+int MPI_Comm_free(MPI_Comm* comm);
+int MPI_Comm_compare(MPI_Comm comm1, MPI_Comm comm2, int* result);
+int MPI_Comm_create_keyval(MPI_Comm_copy_attr_function* copy_fn,
+                           MPI_Comm_delete_attr_function* delete_fn,
+                           int* keyval, void* extra_state);
+int MPI_Comm_free_keyval(int* keyval);
+int MPI_Comm_set_attr(MPI_Comm comm, int keyval, void* value);
+int MPI_Comm_get_attr(MPI_Comm comm, int keyval, void* value, int* flag);
+int MPI_Comm_delete_attr(MPI_Comm comm, int keyval);
+
+// -----------------------------------------------------------------------------
+// -- Datatypes and reductions
+// -----------------------------------------------------------------------------
+
+int MPI_Type_size(MPI_Datatype type, int* size);
+int MPI_Reduce_local(const void* inbuf, void* inoutbuf, int count,
+                     MPI_Datatype type, MPI_Op op);
+
+// -----------------------------------------------------------------------------
+// -- Point-to-point
+// -----------------------------------------------------------------------------
+
+int MPI_Send(const void* buf, int count, MPI_Datatype type, int dest, int tag,
+             MPI_Comm comm);
+int MPI_Recv(void* buf, int count, MPI_Datatype type, int source, int tag,
+             MPI_Comm comm, MPI_Status* status);
+int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                 int dest, int sendtag, void* recvbuf, int recvcount,
+                 MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm,
+                 MPI_Status* status);
+
+// -----------------------------------------------------------------------------
+// -- Collectives
+// -----------------------------------------------------------------------------
+
+int MPI_Barrier(MPI_Comm comm);
+int MPI_Bcast(void* buf, int count, MPI_Datatype type, int root,
+              MPI_Comm comm);
+int MPI_Gather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+               void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
+               MPI_Comm comm);
+int MPI_Gatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                void* recvbuf, const int* recvcounts, const int* displs,
+                MPI_Datatype recvtype, int root, MPI_Comm comm);
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                  MPI_Comm comm);
+int MPI_Allgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                   void* recvbuf, const int* recvcounts, const int* displs,
+                   MPI_Datatype recvtype, MPI_Comm comm);
+int MPI_Reduce(const void* sendbuf, void* recvbuf, int count,
+               MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm);
+int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
+                  MPI_Datatype type, MPI_Op op, MPI_Comm comm);
+
+// -----------------------------------------------------------------------------
+// -- Nonblocking collectives and completion
+// -----------------------------------------------------------------------------
+
+int MPI_Ibarrier(MPI_Comm comm, MPI_Request* request);
+int MPI_Igather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
+                MPI_Comm comm, MPI_Request* request);
+int MPI_Iallgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                   void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                   MPI_Comm comm, MPI_Request* request);
+int MPI_Ireduce(const void* sendbuf, void* recvbuf, int count,
+                MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm,
+                MPI_Request* request);
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count,
+                   MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request);
+
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status);
+int MPI_Wait(MPI_Request* request, MPI_Status* status);
+int MPI_Testsome(int incount, MPI_Request* requests, int* outcount,
+                 int* indices, MPI_Status* statuses);
+int MPI_Waitall(int count, MPI_Request* requests, MPI_Status* statuses);
@@ -16,7 +16,7 @@
 
 #pragma once
 #include <complex>
-#include <mpi.h>
+#include <parallelzone/mpi_helpers/mpi.hpp>
 #include <type_traits>
 
 namespace parallelzone::mpi_helpers {
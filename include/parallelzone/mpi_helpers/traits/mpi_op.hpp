@@ -17,7 +17,7 @@
 #pragma once
 #include <algorithm>
 #include <functional>
-#include <mpi.h>
+#include <parallelzone/mpi_helpers/mpi.hpp>
 
 namespace parallelzone::mpi_helpers {
 
@@ -39,6 +39,36 @@ namespace parallelzone::mpi_helpers {
 template<typename T>
 struct MPIOp : std::false_type {};
 
+/** @brief Functor which returns the smaller of its two arguments.
+ *
+ *  The C++ standard library does not provide a functor for `std::min`. This
+ *  functor fills that role so that reductions can take the minimum across
+ *  processes (it maps to MPI_MIN).
+ *
+ *  @tparam T The type of the values being compared.
+ */
+template<typename T>
+struct minimum {
+    /// Returns the smaller of @p lhs and @p rhs
+    constexpr T operator()(const T& lhs, const T& rhs) const {
+        return std::min(lhs, rhs);
+    }
+};
+
+/** @brief Functor which returns the larger of its two arguments.
+ *
+ *  Counterpart of minimum for `std::max`, it maps to MPI_MAX.
+ *
+ *  @tparam T The type of the values being compared.
+ */
+template<typename T>
+struct maximum {
+    /// Returns the larger of @p lhs and @p rhs
+    constexpr T operator()(const T& lhs, const T& rhs) const {
+        return std::max(lhs, rhs);
+    }
+};
+
 /// Wraps the process of associating functor @p cxx_op with the MPI operation
 /// @p mpi_op. @p cxx_op is just the name of the functor (no template params)
 #define REGISTER_OP(cxx_op, mpi_op)            \
@@ -54,6 +84,8 @@ REGISTER_OP(std::bit_and, MPI_BAND);
 REGISTER_OP(std::logical_or, MPI_LOR);
 REGISTER_OP(std::bit_or, MPI_BOR);
 REGISTER_OP(std::bit_xor, MPI_BXOR);
+REGISTER_OP(minimum, MPI_MIN);
+REGISTER_OP(maximum, MPI_MAX);
 
 #undef REGISTER_OP
 
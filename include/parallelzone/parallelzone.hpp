@@ -24,6 +24,7 @@
  */
 
 #include "parallelzone/serialization.hpp"
+#include <parallelzone/logging/macros.hpp>
 #include <parallelzone/runtime/runtime.hpp>
 
 namespace parallelzone {} // namespace parallelzone
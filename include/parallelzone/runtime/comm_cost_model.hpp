@@ -0,0 +1,160 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace parallelzone::runtime {
+
+/** @brief A latency/bandwidth model of point-to-point communication.
+ *
+ *  CommCostModel is the classic "alpha-beta" (or Hockney) model: sending a
+ *  message of `n` bytes costs `alpha + beta * n` seconds, where alpha is the
+ *  latency and beta is the inverse bandwidth. Since messages between ranks
+ *  on the same node and messages between nodes travel over very different
+ *  hardware, the model holds one (alpha, beta) pair per level:
+ *
+ *  - self: a rank talking to itself, which is modeled as free,
+ *  - intra_node: two ranks on the same node,
+ *  - inter_node: two ranks on different nodes.
+ *
+ *  The parameters are usually measured by
+ *  RuntimeView::characterize_interconnect and then queried through
+ *  RuntimeView::comm_cost. Models can be saved to, and loaded from, a small
+ *  text file so measurements can be reused by later runs on the same
+ *  topology.
+ */
+class CommCostModel {
+public:
+    /// Unsigned integral type used for message sizes
+    using size_type = std::size_t;
+
+    /// Type used for times, in seconds
+    using time_type = double;
+
+    /// Type of the key identifying the topology a model was measured on
+    using key_type = std::uint64_t;
+
+    /// The levels of the communication hierarchy
+    enum class level { self, intra_node, inter_node };
+
+    /// The parameters of one level
+    struct LinkParameters {
+        /// Latency, in seconds
+        time_type alpha = 0.0;
+
+        /// Inverse bandwidth, in seconds per byte
+        time_type beta = 0.0;
+
+        /// Parameters are equal if both alpha and beta are equal
+        bool operator==(const LinkParameters& rhs) const noexcept {
+            return alpha == rhs.alpha && beta == rhs.beta;
+        }
+
+        /// Negation of operator==
+        bool operator!=(const LinkParameters& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+    };
+
+    /** @brief Creates a model in which all communication is free.
+     *
+     *  @throw None No throw guarantee.
+     */
+    CommCostModel() noexcept = default;
+
+    /** @brief Creates a model with the provided parameters.
+     *
+     *  @param[in] intra_node The parameters for ranks on the same node.
+     *  @param[in] inter_node The parameters for ranks on different nodes.
+     *
+     *  @throw None No throw guarantee.
+     */
+    CommCostModel(LinkParameters intra_node,
+                  LinkParameters inter_node) noexcept :
+      m_intra_(intra_node), m_inter_(inter_node) {}
+
+    /** @brief The parameters of level @p l.
+     *
+     *  @param[in] l The level of interest.
+     *
+     *  @return The parameters of @p l. Those of level::self are always zero.
+     *
+     *  @throw None No throw guarantee.
+     */
+    LinkParameters parameters(level l) const noexcept;
+
+    /** @brief The modeled time to send @p n_bytes over level @p l.
+     *
+     *  @param[in] n_bytes The size of the message.
+     *  @param[in] l The level the message travels over.
+     *
+     *  @return `alpha + beta * n_bytes` for level @p l, in seconds.
+     *
+     *  @throw None No throw guarantee.
+     */
+    time_type cost(size_type n_bytes, level l) const noexcept {
+        const auto p = parameters(l);
+        return p.alpha + p.beta * time_type(n_bytes);
+    }
+
+    /** @brief Writes *this to the file @p path.
+     *
+     *  @param[in] path The file to write. Existing files are overwritten.
+     *  @param[in] key  The topology *this was measured on. load will only
+     *                  accept the file when given the same key.
+     *
+     *  @return True if the file was written and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool save(const std::string& path, key_type key) const noexcept;
+
+    /** @brief Reads a model written by save.
+     *
+     *  @param[in] path The file to read.
+     *  @param[in] key  The topology the caller is running on.
+     *
+     *  @return The model in @p path, or std::nullopt if @p path does not
+     *          exist, can not be parsed, or was written for a different key.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static std::optional<CommCostModel> load(const std::string& path,
+                                             key_type key) noexcept;
+
+    /// Models are equal if the parameters of every level are equal
+    bool operator==(const CommCostModel& rhs) const noexcept {
+        return m_intra_ == rhs.m_intra_ && m_inter_ == rhs.m_inter_;
+    }
+
+    /// Negation of operator==
+    bool operator!=(const CommCostModel& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    /// Parameters for ranks on the same node
+    LinkParameters m_intra_;
+
+    /// Parameters for ranks on different nodes
+    LinkParameters m_inter_;
+};
+
+} // namespace parallelzone::runtime
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <parallelzone/hardware/cpu/hardware_counters.hpp>
+#include <string>
+#include <vector>
+
+namespace parallelzone::runtime {
+namespace detail_ {
+class TimerRegistry;
+}
+
+/** @brief The count of one hardware event in a region, summarized across
+ *         ranks.
+ *
+ *  Like times, counts are inclusive and summed over every time the region was
+ *  entered on a rank. Only ranks which entered the region and could count
+ *  the event contribute to the statistics.
+ */
+struct CounterStatistics {
+    /// Type of the event
+    using event_type = hardware::HardwareCounters::event;
+
+    /// Type used for the counts (double so averages are exact enough)
+    using value_type = double;
+
+    /// The event which was counted
+    event_type event = event_type::cycles;
+
+    /// The number of ranks which entered the region and counted the event
+    std::size_t n_ranks = 0;
+
+    /// The smallest per-rank count
+    value_type min = 0.0;
+
+    /// The average per-rank count
+    value_type mean = 0.0;
+
+    /// The largest per-rank count
+    value_type max = 0.0;
+
+    /// Statistics are equal if all of their members are equal
+    bool operator==(const CounterStatistics& rhs) const noexcept {
+        return event == rhs.event && n_ranks == rhs.n_ranks &&
+               min == rhs.min && mean == rhs.mean && max == rhs.max;
+    }
+
+    /// Negation of operator==
+    bool operator!=(const CounterStatistics& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+};
+
+/** @brief The timings of one region, summarized across ranks.
+ *
+ *  RuntimeView::report_timers returns one RegionStatistics object per region
+ *  which was timed on at least one rank. Regions are identified by their path,
+ *  i.e., the names of the regions they are nested in and their own name,
+ *  joined by "/". So a region "diis" timed while the region "scf" was
+ *  running has the path "scf/diis".
+ *
+ *  Times are inclusive (a region's time includes the time of the regions
+ *  nested in it) and are summed over every time the region was entered on a
+ *  rank. The minimum, mean, and maximum are over the ranks which entered the
+ *  region (n_ranks of them), ranks which never entered it are left out.
+ *
+ *  If hardware counters were enabled (RuntimeView::enable_hardware_counters)
+ *  the counts of the events are summarized too.
+ */
+struct RegionStatistics {
+    /// Unsigned integral type used for counting
+    using size_type = std::size_t;
+
+    /// Type used for times, in seconds
+    using time_type = double;
+
+    /// Type of a hardware event
+    using event_type = CounterStatistics::event_type;
+
+    /// The path of the region, e.g., "scf/diis"
+    std::string path;
+
+    /// How many regions the region is nested in, i.e., the number of "/"
+    size_type depth = 0;
+
+    /// The number of ranks which entered the region
+    size_type n_ranks = 0;
+
+    /// The number of times the region was entered, summed over ranks
+    size_type n_calls = 0;
+
+    /// The smallest wall time of the ranks entering the region, in seconds
+    time_type wall_min = 0.0;
+
+    /// The average wall time of the ranks entering the region, in seconds
+    time_type wall_mean = 0.0;
+
+    /// The largest wall time of the ranks entering the region, in seconds
+    time_type wall_max = 0.0;
+
+    /// The smallest CPU time of the ranks entering the region, in seconds
+    time_type cpu_min = 0.0;
+
+    /// The average CPU time of the ranks entering the region, in seconds
+    time_type cpu_mean = 0.0;
+
+    /// The largest CPU time of the ranks entering the region, in seconds
+    time_type cpu_max = 0.0;
+
+    /// The events counted by at least one rank, in the order they are declared
+    std::vector<CounterStatistics> counters;
+
+    /** @brief The name of the region without the names of its parents.
+     *
+     *  @return The part of path after the last "/".
+     *
+     *  @throw std::bad_alloc if there is a problem copying the name. Strong
+     *                        throw guarantee.
+     */
+    std::string name() const;
+
+    /** @brief The load imbalance of the region.
+     *
+     *  The imbalance is the ratio of the largest per-rank wall time to the
+     *  average per-rank wall time. A perfectly balanced region has an
+     *  imbalance of 1, while a region on which one of `P` ranks does all of
+     *  the work has an imbalance of `P`. Time lost to imbalance is
+     *  `wall_max - wall_mean` per rank. Like the times, only the ranks which
+     *  entered the region count.
+     *
+     *  @return The imbalance. Regions which took no time have an imbalance of
+     *          1.
+     *
+     *  @throw None No throw guarantee.
+     */
+    time_type imbalance() const noexcept {
+        return wall_mean > 0.0 ? wall_max / wall_mean : 1.0;
+    }
+
+    /** @brief The statistics of event @p e.
+     *
+     *  @param[in] e The event of interest.
+     *
+     *  @return A pointer to the statistics of @p e, or a null pointer if no
+     *          rank counted @p e.
+     *
+     *  @throw None No throw guarantee.
+     */
+    const CounterStatistics* counter(event_type e) const noexcept {
+        for(const auto& stats : counters)
+            if(stats.event == e) return &stats;
+        return nullptr;
+    }
+
+    /** @brief The achieved floating-point rate of the region.
+     *
+     *  @return The average per-rank number of floating-point operations
+     *          divided by the average per-rank wall time, in GFLOP/s. 0 if
+     *          floating-point operations were not counted (they require
+     *          PAPI) or the region took no time.
+     *
+     *  @throw None No throw guarantee.
+     */
+    time_type gflops() const noexcept {
+        const auto* flops = counter(event_type::flops);
+        if(flops == nullptr || wall_mean <= 0.0) return 0.0;
+        return flops->mean / wall_mean * 1.0e-9;
+    }
+
+    /// Statistics are equal if all of their members are equal
+    bool operator==(const RegionStatistics& rhs) const noexcept {
+        return path == rhs.path && depth == rhs.depth &&
+               n_ranks == rhs.n_ranks && n_calls == rhs.n_calls &&
+               wall_min == rhs.wall_min && wall_mean == rhs.wall_mean &&
+               wall_max == rhs.wall_max && cpu_min == rhs.cpu_min &&
+               cpu_mean == rhs.cpu_mean && cpu_max == rhs.cpu_max &&
+               counters == rhs.counters;
+    }
+
+    /// Negation of operator==
+    bool operator!=(const RegionStatistics& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+};
+
+/** @brief Formats a timer report as a table.
+ *
+ *  @relates RegionStatistics
+ *
+ *  Each region occupies one row and is indented by its depth, so nesting is
+ *  visible. If events were counted, the average per-rank count of each one
+ *  is added as a column, as is the rate in GFLOP/s if floating-point
+ *  operations were counted.
+ *
+ *  @param[in] report The statistics to format, in the order they should be
+ *                    listed.
+ *
+ *  @return The table, one row per line, with a header line.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the string. Strong
+ *                        throw guarantee.
+ */
+std::string to_string(const std::vector<RegionStatistics>& report);
+
+/** @brief Times a region of code while it is in scope.
+ *
+ *  RegionTimer objects are made by RuntimeView::timer. Creating one starts
+ *  the clocks and the region ends when the object is stopped or destroyed,
+ *  whichever comes first. At that point the wall time, the CPU time of the
+ *  calling thread, and the hardware events the thread caused (if enabled),
+ *  are added to the totals of the region, which are kept by the runtime (and
+ *  thus outlive the RegionTimer).
+ *
+ *  Regions started while another region is running on the same thread are
+ *  nested in it. Regions must therefore end on the thread they were started
+ *  on, in the reverse order they were started in, which is what happens
+ *  naturally when RegionTimer objects are used as scoped variables.
+ */
+class RegionTimer {
+public:
+    /// Unsigned integral type used for counting
+    using size_type = std::size_t;
+
+    /// Type of the object keeping the totals of each region
+    using registry_type = detail_::TimerRegistry;
+
+    /// Type of a pointer to the registry
+    using registry_pointer = std::shared_ptr<registry_type>;
+
+    /** @brief Creates a timer which is not timing anything.
+     *
+     *  @throw None No throw guarantee.
+     */
+    RegionTimer() noexcept;
+
+    /** @brief Starts timing the region @p name.
+     *
+     *  This ctor is used by RuntimeView::timer. Users of ParallelZone do not
+     *  have access to the registry and thus can not call it.
+     *
+     *  @param[in] registry Where the totals of the region are kept.
+     *  @param[in] name The name of the region. The name should not contain
+     *                  "/" as that is used to separate the names of nested
+     *                  regions.
+     *
+     *  @throw std::bad_alloc if there is a problem recording the region.
+     *                        Strong throw guarantee.
+     */
+    RegionTimer(registry_pointer registry, const std::string& name);
+
+    /// Deleted, a region is ended exactly once
+    RegionTimer(const RegionTimer&) = delete;
+
+    /// Deleted, a region is ended exactly once
+    RegionTimer& operator=(const RegionTimer&) = delete;
+
+    /** @brief Takes over timing the region @p other is timing.
+     *
+     *  @param[in,out] other The timer to take the region from. After this
+     *                       call @p other is not running.
+     *
+     *  @throw None No throw guarantee.
+     */
+    RegionTimer(RegionTimer&& other) noexcept;
+
+    /** @brief Stops *this and then takes over the region of @p rhs.
+     *
+     *  @param[in,out] rhs The timer to take the region from. After this call
+     *                     @p rhs is not running.
+     *
+     *  @return *this after taking over the region of @p rhs.
+     *
+     *  @throw None No throw guarantee.
+     */
+    RegionTimer& operator=(RegionTimer&& rhs) noexcept;
+
+    /// Calls stop()
+    ~RegionTimer() noexcept;
+
+    /** @brief Ends the region.
+     *
+     *  Calling stop on a timer which is not running is a no-op.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void stop() noexcept;
+
+    /** @brief Is *this timing a region?
+     *
+     *  @return True if *this was started and has not been stopped yet.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool running() const noexcept { return static_cast<bool>(m_registry_); }
+
+    /** @brief The path of the region *this is timing.
+     *
+     *  @return The names of the regions *this is nested in and the name of
+     *          the region, joined by "/". Empty if *this is not running.
+     *
+     *  @throw None No throw guarantee.
+     */
+    const std::string& path() const noexcept { return m_path_; }
+
+private:
+    /// Type of the clock used for wall times
+    using clock_type = std::chrono::steady_clock;
+
+    /// Where the region's totals go (null if *this is not running)
+    registry_pointer m_registry_;
+
+    /// The path of the region
+    std::string m_path_;
+
+    /// The nesting depth of the region on the thread which started it
+    size_type m_depth_ = 0;
+
+    /// Wall clock reading when the region started
+    clock_type::time_point m_wall_start_;
+
+    /// CPU time of the starting thread when the region started, in seconds
+    double m_cpu_start_ = 0.0;
+
+    /// Which of the thread's hardware counters were read (0 for none)
+    size_type m_counters_id_ = 0;
+
+    /// The hardware counters when the region started
+    hardware::HardwareCounters::value_container m_counters_start_;
+};
+
+} // namespace parallelzone::runtime
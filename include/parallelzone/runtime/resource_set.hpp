@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include "parallelzone/hardware/cpu/cpu.hpp"
 #include "parallelzone/hardware/ram/ram.hpp"
 #include "parallelzone/logging/logger.hpp"
 #include <memory>
@@ -63,6 +64,12 @@ public:
     /// Type of a read-only reference to the RAM
     using const_ram_reference = const ram_type&;
 
+    /// Type of the object representing the processors
+    using cpu_type = hardware::CPU;
+
+    /// Type of a read-only reference to the CPU
+    using const_cpu_reference = const cpu_type&;
+
     /// The type of the class implementing the ResourceSet
     using pimpl_type = detail_::ResourceSetPIMPL;
 
@@ -220,6 +227,28 @@ public:
      */
     const_ram_reference ram() const;
 
+    /** @brief Does this ResourceSet have a (non-empty) CPU?
+     *
+     *  The processor topology is discovered by the process which owns the
+     *  ResourceSet. At the moment that information is not communicated to
+     *  other processes, so only ResourceSets for which is_mine() is true have
+     *  a CPU.
+     *
+     *  @return True if calling `cpu()` will not throw and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool has_cpu() const noexcept;
+
+    /** @brief Retrieves the processors for this resource set.
+     *
+     *  @return A read-only reference to the CPU.
+     *
+     *  @throw std::out_of_range if the instance does not have a CPU. Strong
+     *                           throw guarantee.
+     */
+    const_cpu_reference cpu() const;
+
     /** @brief Gets the process-local logger for this ResourceSet
      *
      * This logger can be used to print process-local messages. In general,
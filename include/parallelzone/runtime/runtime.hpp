@@ -23,5 +23,7 @@
  *
  */
 
+#include <parallelzone/runtime/comm_cost_model.hpp>
+#include <parallelzone/runtime/region_timer.hpp>
 #include <parallelzone/runtime/resource_set.hpp>
 #include <parallelzone/runtime/runtime_view.hpp>
@@ -16,8 +16,16 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <parallelzone/logging/logger_factory.hpp>
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <parallelzone/runtime/comm_cost_model.hpp>
+#include <parallelzone/runtime/region_timer.hpp>
 #include <parallelzone/runtime/resource_set.hpp>
+#include <string>
+#include <vector>
 
 namespace parallelzone::runtime {
 namespace detail_ {
@@ -48,6 +56,12 @@ struct RuntimeViewPIMPL;
  *        managed with a shared_ptr. So if you want to ensure that MPI
  *        is not finalized while you're doing something, make sure you hold on
  *        to a RuntimeView.
+ *
+ *  @note A RuntimeView can also be built around a communicator whose "ranks"
+ *        are threads of the current process (see run_threaded and
+ *        CommPP::make_threaded). Such a runtime does not use MPI, hence
+ *        mpi_comm() is MPI_COMM_NULL and the MPI-specific features (e.g.,
+ *        thread_comm and the progress thread) are unavailable.
  */
 class RuntimeView {
 public:
@@ -78,6 +92,9 @@ public:
     /// Type of a read/write reference to a logger_type object
     using logger_reference = logger_type&;
 
+    /// Type describing which log messages are written
+    using log_limits_type = LoggerFactory::log_limits;
+
     // TODO: Write an iterator class
     /// Type of an interator over a range of resource_set_type instances
     using const_iterator = int;
@@ -100,6 +117,53 @@ public:
     /// Type of a callback function
     using callback_function_type = std::function<void()>;
 
+    /** @brief The level of thread support MPI provides.
+     *
+     *  These values mirror MPI_THREAD_SINGLE, MPI_THREAD_FUNNELED,
+     *  MPI_THREAD_SERIALIZED, and MPI_THREAD_MULTIPLE respectively and are
+     *  ordered from least to most thread support.
+     */
+    enum class thread_level { single, funneled, serialized, multiple };
+
+    /// Type of the object used to communicate among the ranks
+    using comm_type = mpi_helpers::CommPP;
+
+    /// Type of the function run on each rank by run_threaded
+    using rank_function_type = std::function<void(RuntimeView&)>;
+
+    /// Type of a handle to a nonblocking MPI operation
+    using mpi_request_type = MPI_Request;
+
+    /// Type used to specify how often the progress thread polls
+    using progress_interval_type = std::chrono::microseconds;
+
+    /// Type of the future signaling that a registered request completed
+    using request_future_type = std::future<void>;
+
+    /// Type of a container of MPI ranks
+    using rank_container = std::vector<size_type>;
+
+    /// Type of a read-only reference to a rank_container
+    using const_rank_container_reference = const rank_container&;
+
+    /// Type of the model of the interconnect's performance
+    using comm_cost_model_type = CommCostModel;
+
+    /// Type of a read-only reference to the interconnect model
+    using const_comm_cost_model_reference = const comm_cost_model_type&;
+
+    /// Type of a modeled communication time, in seconds
+    using comm_time_type = comm_cost_model_type::time_type;
+
+    /// Type of the object timing a region of code
+    using region_timer_type = RegionTimer;
+
+    /// Type of the summary of the timed regions
+    using timer_report_type = std::vector<RegionStatistics>;
+
+    /// Type of a list of hardware events to count in timed regions
+    using counter_event_container = hardware::HardwareCounters::event_container;
+
     // -------------------------------------------------------------------------
     // -- Ctors, Assignment, Dtor
     // -------------------------------------------------------------------------
@@ -129,6 +193,18 @@ public:
      */
     RuntimeView(argc_type argc, argv_type argv);
 
+    /** @brief Initializes the runtime with a requested level of thread support
+     *
+     *  This ctor is the same as the argc/argv ctor except that if MPI needs
+     *  to be started, MPI will be asked for the @p requested level of thread
+     *  support. See the primary ctor's description for more details.
+     *
+     *  @param[in] argc The number of arguments the program was called with.
+     *  @param[in] argv The argument to the program.
+     *  @param[in] requested The level of thread support to request from MPI.
+     */
+    RuntimeView(argc_type argc, argv_type argv, thread_level requested);
+
     /** @brief Creates a RuntimeView which aliases the provided MPI runtime.
      *
      *  This ctor is primarily meant for initializing a RuntimeView instance
@@ -164,6 +240,44 @@ public:
      */
     RuntimeView(argc_type argc, argv_type argv, mpi_comm_type comm);
 
+    /** @brief Primary ctor for creating a new RuntimeView with a requested
+     *         level of thread support.
+     *
+     *  If MPI has not been initialized, this ctor initializes it by calling
+     *  MPI_Init_thread with @p requested. MPI is free to provide less (or
+     *  more) thread support than requested; the level actually provided can
+     *  be retrieved with provided_thread_level(). If MPI has already been
+     *  initialized, @p requested is ignored. The remaining behavior is the
+     *  same as the (argc, argv, comm) ctor, which dispatches to this ctor with
+     *  `requested = thread_level::single`.
+     *
+     *  @param[in] argc The number of arguments the program was called with.
+     *  @param[in] argv The argument to the program.
+     *  @param[in] comm The MPI_Comm this RuntimeView should alias.
+     *  @param[in] requested The level of thread support to request from MPI.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the PIMPL.
+     */
+    RuntimeView(argc_type argc, argv_type argv, mpi_comm_type comm,
+                thread_level requested);
+
+    /** @brief Creates a RuntimeView whose ranks are those of @p comm.
+     *
+     *  This ctor never initializes (or finalizes) MPI. If @p comm wraps an MPI
+     *  communicator, MPI must already be running. The main use of this ctor
+     *  is with the communicators made by CommPP::make_threaded, which do not
+     *  require MPI; see run_threaded for a convenience function which does
+     *  that.
+     *
+     *  Like the other ctors, this ctor is collective over @p comm.
+     *
+     *  @param[in] comm The communicator this RuntimeView should use.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the PIMPL.
+     *                        Strong throw guarantee.
+     */
+    explicit RuntimeView(comm_type comm);
+
     /** @brief Ctor for explicitly setting the state of the RuntimeView.
      *
      *  This ctor is primarily exposed for unit testing purposes. Users of
@@ -244,6 +358,11 @@ public:
      *  When the counter reaches zero (and assuming the original RuntimeView
      *  actually initialized MPI) MPI will be finalized.
      *
+     *  If the counter reaches zero while an exception is propagating, the
+     *  messages kept by every flight recorder (see
+     *  LoggerFactory::make_flight_recorder) are written out first. Copies
+     *  destroyed during unwinding while other copies remain do not.
+     *
      *  @throw None No throw guarantee.
      */
     ~RuntimeView() noexcept;
@@ -258,7 +377,8 @@ public:
      *  used to retrieve the MPI communicator which is managing the resources
      *  in this RuntimeView.
      *
-     *  @note A view of the null runtime returns `MPI_COMM_NULL`.
+     *  @note A view of the null runtime, or of a runtime whose ranks are
+     *        threads, returns `MPI_COMM_NULL`.
      *
      *  @return An object identifying which MPI communicator powers *this.
      *
@@ -311,6 +431,71 @@ public:
      */
     bool did_i_start_mpi() const noexcept;
 
+    /** @brief The level of thread support MPI actually provides.
+     *
+     *  The level provided by MPI may differ from the level which was
+     *  requested when *this was created (and if MPI was started by someone
+     *  else, no level was requested by *this at all). This method returns the
+     *  level MPI actually provides, i.e., the result of MPI_Query_thread.
+     *
+     *  @note A null runtime, or a runtime whose ranks are threads, returns
+     *        thread_level::single.
+     *
+     *  @return The level of thread support MPI provides.
+     *
+     *  @throw None No throw guarantee.
+     */
+    thread_level provided_thread_level() const noexcept;
+
+    /** @brief Creates the communicators returned by thread_comm.
+     *
+     *  Collectives issued from different threads on the same communicator are
+     *  serialized by (or worse, mismatched within) MPI. To let threads run
+     *  collectives concurrently each thread should use its own communicator.
+     *  This method makes sure that at least @p n duplicates of mpi_comm()
+     *  exist, creating the missing ones with MPI_Comm_dup. The duplicates are
+     *  shared by all views of the runtime, and are freed (before MPI is
+     *  finalized) when the last view of the runtime goes out of scope.
+     *
+     *  MPI_Comm_dup is collective, so this method must be called by every
+     *  rank in mpi_comm(), with the same @p n, and from one thread per rank;
+     *  typically before spawning the threads. The duplicates are created in
+     *  index order, so the @p i-th communicator on one rank matches the
+     *  @p i-th communicator on every other rank. Calling this method with an
+     *  @p n no larger than a previous call does nothing (and does not call
+     *  MPI).
+     *
+     *  @param[in] n The number of communicators needed.
+     *
+     *  @throw std::runtime_error if *this is null or is not backed by MPI.
+     *                            Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem storing the duplicates.
+     *                        Strong throw guarantee.
+     */
+    void reserve_thread_comms(size_type n) const;
+
+    /** @brief Returns a duplicate of mpi_comm() dedicated to a thread.
+     *
+     *  This method returns the @p i-th communicator made by
+     *  reserve_thread_comms. It never creates a communicator, so, unlike
+     *  reserve_thread_comms, it is not collective and may be called from any
+     *  thread at any time.
+     *
+     *  Using the duplicates from multiple threads at once requires
+     *  provided_thread_level() to be thread_level::multiple.
+     *
+     *  @param[in] i Index of the thread (or logical stream of collectives)
+     *               the communicator is for.
+     *
+     *  @return The MPI communicator for index @p i.
+     *
+     *  @throw std::runtime_error if *this is null or is not backed by MPI.
+     *                            Strong throw guarantee.
+     *  @throw std::out_of_range if fewer than @p i + 1 communicators were
+     *                           reserved. Strong throw guarantee.
+     */
+    mpi_comm_type thread_comm(size_type i) const;
+
     /** @brief Returns the @p i-th resource set in a read-only state.
      *
      *  This method behaves identical to the non-const version, except that the
@@ -369,17 +554,151 @@ public:
      *  determine how many of the ResourceSets in *this have access to the
      *  specified RAM instance.
      *
+     *  RAM is identified by its node (see node_of) and size, so the RAM of
+     *  every ResourceSet on a node counts. The hardware of every rank is
+     *  tabulated when *this is created, so this is a table lookup and does not
+     *  instantiate any ResourceSets.
+     *
      *  @param[in] ram The chunk of RAM we are looking for. @p ram may be local
      *                 or remote relative to my_resource_set().
      *
-     *  @throw std::bad_alloc Looking for the RAM instance requires us to check
-     *                        each ResourceSet. At the moment this requires us
-     *                        to create ResourceSets for each rank. An exception
-     *                        may be raised if the creation of a ResourceSet
-     *                        fails. Strong throw guarantee.
+     *  @return The number of ResourceSets in *this with access to @p ram. If
+     *          *this is null, the result is 0.
+     *
+     *  @throw None No throw guarantee.
      */
     size_type count(const_ram_reference ram) const;
 
+    /** @brief The number of nodes the ranks of *this run on.
+     *
+     *  Two ranks are on the same node if MPI_Get_processor_name returns the
+     *  same name for them. The node map is built once, when *this is created.
+     *
+     *  @return The number of distinct nodes. Null instances return 0.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type n_nodes() const noexcept;
+
+    /** @brief The node rank @p rank runs on.
+     *
+     *  Nodes are numbered from 0 to n_nodes() - 1 in the order they are first
+     *  encountered when walking the ranks of *this. In particular, rank 0 is
+     *  always on node 0. Every rank agrees on the numbering.
+     *
+     *  @param[in] rank The rank of interest. Must be in [0, size()).
+     *
+     *  @return The index of the node @p rank runs on.
+     *
+     *  @throw std::out_of_range if @p rank is not in [0, size()). Strong throw
+     *                           guarantee.
+     */
+    size_type node_of(size_type rank) const;
+
+    /** @brief The ranks running on node @p node.
+     *
+     *  @param[in] node The node of interest. Must be in [0, n_nodes()).
+     *
+     *  @return The ranks on @p node, in increasing order.
+     *
+     *  @throw std::out_of_range if @p node is not in [0, n_nodes()). Strong
+     *                           throw guarantee.
+     */
+    const_rank_container_reference ranks_on_node(size_type node) const;
+
+    /** @brief The current process's index among the ranks on its node.
+     *
+     *  This is the position of the current process's rank in
+     *  `ranks_on_node(node_of(rank))`. It is the usual choice for selecting
+     *  node-local resources such as GPUs or shared-memory segments.
+     *
+     *  @return The current process's local rank.
+     *
+     *  @throw std::runtime_error if *this is null. Strong throw guarantee.
+     *  @throw std::out_of_range if the current process is not part of *this.
+     *                           Strong throw guarantee.
+     */
+    size_type local_rank() const;
+
+    /** @brief Measures the latency and bandwidth of the interconnect.
+     *
+     *  This runs a short ping-pong probe between the first two ranks of a
+     *  node (for the intra-node link) and between the leaders of two nodes
+     *  (for the inter-node link). The results are stored in *this as a
+     *  CommCostModel and can be queried with comm_cost.
+     *
+     *  Since the probe takes time (and perturbs other jobs on the network) the
+     *  model is cached in @p cache_dir, in a file whose name is derived from
+     *  the job's topology, i.e., the number of ranks and the node each rank
+     *  runs on. Later runs on the same topology load the file instead of
+     *  probing. Rank 0 reads and writes the file and shares its contents, so
+     *  the cache directory does not need to be on a shared file system.
+     *
+     *  This method is collective. Characterizing again replaces the model.
+     *
+     *  @param[in] cache_dir The directory to cache models in. An empty string
+     *                       disables caching. Failing to read or write the
+     *                       cache is not an error.
+     *  @param[in] reprobe If true, the cache is ignored and the interconnect
+     *                     is probed (the new model is still cached).
+     *                     Defaults to false.
+     *
+     *  @throw std::runtime_error if *this is null or is not backed by MPI.
+     *                            Strong throw guarantee.
+     */
+    void characterize_interconnect(const std::string& cache_dir,
+                                   bool reprobe = false);
+
+    /** @brief Measures the interconnect, caching in the default directory.
+     *
+     *  Same as characterize_interconnect(cache_dir) with `cache_dir` set to
+     *  `$PARALLELZONE_CACHE_DIR` if it is set, or else the `parallelzone`
+     *  subdirectory of `$XDG_CACHE_HOME` or of `$HOME/.cache`.
+     *
+     *  @throw std::runtime_error if *this is null or is not backed by MPI.
+     *                            Strong throw guarantee.
+     */
+    void characterize_interconnect();
+
+    /** @brief Has the interconnect of *this been characterized?
+     *
+     *  @return True if characterize_interconnect has been called on *this (or
+     *          a copy of *this) and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool has_comm_cost_model() const noexcept;
+
+    /** @brief The model of the interconnect.
+     *
+     *  @return A read-only reference to the model.
+     *
+     *  @throw std::runtime_error if the interconnect has not been
+     *                            characterized. Strong throw guarantee.
+     */
+    const_comm_cost_model_reference comm_cost_model() const;
+
+    /** @brief The modeled time to send @p n_bytes from @p src to @p dst.
+     *
+     *  The cost is `alpha + beta * n_bytes` where alpha and beta are those of
+     *  the intra-node link if @p src and @p dst are on the same node, and of
+     *  the inter-node link otherwise. Sending to oneself is free. This is
+     *  meant for choosing between algorithms, not for predicting run times.
+     *
+     *  @param[in] n_bytes The size of the message.
+     *  @param[in] src The sending rank. Must be in [0, size()).
+     *  @param[in] dst The receiving rank. Must be in [0, size()).
+     *
+     *  @return The modeled time, in seconds.
+     *
+     *  @throw std::runtime_error if the interconnect has not been
+     *                            characterized. Strong throw guarantee.
+     *  @throw std::out_of_range if @p src or @p dst is not in [0, size()).
+     *                           Strong throw guarantee.
+     */
+    comm_time_type comm_cost(size_type n_bytes, size_type src,
+                             size_type dst) const;
+
     /** @brief Returns the program-wide logger
      *
      *  The program-wide logger is used for logging replicated data and state
@@ -393,6 +712,134 @@ public:
      */
     logger_reference logger() const;
 
+    /** @brief Limits what the loggers of the current process write.
+     *
+     *  This method replaces the program-wide logger, and the logger of the
+     *  current process's ResourceSet, with the result of passing them to
+     *  LoggerFactory::make_limited, so rank sampling and rate limiting apply
+     *  to both in the same way. Each call wraps the loggers again, i.e., the
+     *  limits of successive calls combine.
+     *
+     *  @param[in] limits Which messages to write.
+     *
+     *  @throw std::runtime_error if *this does not have a PIMPL. Strong throw
+     *                            guarantee.
+     *  @throw std::out_of_range if @p limits.rank_stride is 0. Strong throw
+     *                           guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the loggers.
+     *                        Strong throw guarantee.
+     */
+    void limit_logging(const log_limits_type& limits);
+
+    /** @brief Starts timing the region @p name.
+     *
+     *  The region ends when the returned object is stopped or goes out of
+     *  scope. The wall time and CPU time (of the calling thread) spent in
+     *  the region are added to totals which are kept by the runtime, so
+     *  every view of the runtime contributes to, and reports, the same
+     *  totals. Regions started while another region is running on the same
+     *  thread are nested in it, e.g.:
+     *
+     *  @code
+     *  auto scf = rt.timer("scf");
+     *  {
+     *      auto t = rt.timer("fock_build"); // Region "scf/fock_build"
+     *      build_fock();
+     *  }
+     *  @endcode
+     *
+     *  Timing is local to the current process, use report_timers to
+     *  summarize the totals across processes.
+     *
+     *  @param[in] name The name of the region. The name should not contain
+     *                  "/", which separates the names of nested regions.
+     *
+     *  @return An object which ends the region when it is destroyed.
+     *
+     *  @throw std::runtime_error if *this is null. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem recording the region.
+     *                        Strong throw guarantee.
+     */
+    region_timer_type timer(const std::string& name) const;
+
+    /** @brief Summarizes the timed regions across the ranks of *this.
+     *
+     *  For each region timed on any rank, this method computes the minimum,
+     *  average, and maximum (over ranks) of the total wall and CPU times
+     *  spent in the region, as well as the resulting load imbalance. Ranks
+     *  which did not time a region count as having spent no time in it. Only
+     *  regions which ended contribute, regions which are still running do
+     *  not. The summary is logged as an info message to logger() (unless no
+     *  region was timed) and returned.
+     *
+     *  This method is collective.
+     *
+     *  @return The summary. Every rank gets the same summary, in which
+     *          nested regions follow their parent.
+     *
+     *  @throw std::runtime_error if *this is null. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the summary.
+     */
+    timer_report_type report_timers() const;
+
+    /** @brief Calls report_timers when the runtime is finalized.
+     *
+     *  This registers a finalize callback (see stack_callback) which calls
+     *  report_timers when the last view of the runtime is destroyed, before
+     *  the logger is flushed and before MPI is finalized. Calling this method
+     *  more than once has no additional effect.
+     *
+     *  Since report_timers is collective, every rank must call this method
+     *  and every rank must destroy its views of the runtime.
+     *
+     *  @throw std::runtime_error if *this is null. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem adding the callback.
+     *                        Strong throw guarantee.
+     */
+    void report_timers_at_finalize();
+
+    /** @brief Discards the totals of the timed regions.
+     *
+     *  This can be used to report the timings of different phases of a
+     *  program separately. Regions which are running are unaffected and are
+     *  counted when they end.
+     *
+     *  @throw std::runtime_error if *this is null. Strong throw guarantee.
+     */
+    void clear_timers();
+
+    /** @brief Counts hardware events in the timed regions.
+     *
+     *  Once enabled, the events the calling thread causes while a region is
+     *  running (e.g., cycles, cache misses, or floating-point operations) are
+     *  added to the totals of the region, and report_timers summarizes them
+     *  like the times. This gives, e.g., the achieved FLOP rate of each
+     *  region (see RegionStatistics::gflops). For example:
+     *
+     *  @code
+     *  using event = hardware::HardwareCounters::event;
+     *  rt.enable_hardware_counters({event::flops, event::cache_misses});
+     *  {
+     *      auto t = rt.timer("gemm");
+     *      gemm();
+     *  }
+     *  rt.report_timers();
+     *  @endcode
+     *
+     *  The events are read with the sources described by HardwareCounters,
+     *  i.e., PAPI if it was built and perf_event_open or getrusage otherwise.
+     *  Events which can not be counted on a rank are skipped on that rank.
+     *  The events take effect the next time a thread enters a region which
+     *  is not nested in another region.
+     *
+     *  @param[in] events The events to count. Empty disables the counters.
+     *
+     *  @throw std::runtime_error if *this is null. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem copying @p events. Strong
+     *                        throw guarantee.
+     */
+    void enable_hardware_counters(counter_event_container events);
+
     // -------------------------------------------------------------------------
     // -- MPI all-to-all methods
     // -------------------------------------------------------------------------
@@ -506,6 +953,55 @@ public:
      */
     void stack_callback(callback_function_type cb_func);
 
+    /** @brief Starts a background thread which drives MPI progress.
+     *
+     *  Many MPI implementations only advance nonblocking operations while the
+     *  process is inside an MPI call. Once started, the progress thread
+     *  periodically tests the requests handed to it via register_request, so
+     *  that large nonblocking operations overlap with computation. The thread
+     *  is shared by all views of the runtime and is stopped (after waiting on
+     *  any outstanding requests) by the finalize callback stack, before MPI is
+     *  finalized.
+     *
+     *  The progress thread calls MPI concurrently with the rest of the
+     *  program, hence MPI must have been initialized with
+     *  MPI_THREAD_MULTIPLE.
+     *
+     *  @param[in] interval How long the thread sleeps between polls. Defaults
+     *                      to 100 microseconds.
+     *
+     *  @throw std::runtime_error if *this is null, if *this is not backed by
+     *                            MPI, if the thread was already started, or
+     *                            if MPI was not initialized with
+     *                            MPI_THREAD_MULTIPLE. Strong throw guarantee.
+     */
+    void start_progress_thread(
+      progress_interval_type interval = progress_interval_type{100});
+
+    /** @brief Is the background progress thread running?
+     *
+     *  @return True if start_progress_thread has been called on (a view of)
+     *          this runtime and the thread has not been stopped yet.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool progress_thread_running() const noexcept;
+
+    /** @brief Hands a nonblocking MPI request to the progress thread.
+     *
+     *  After this call the progress thread owns @p request. The caller must
+     *  not test, wait on, or free @p request; it should instead wait on the
+     *  returned future.
+     *
+     *  @param[in] request The request for an in-flight nonblocking operation.
+     *
+     *  @return A future which becomes ready when @p request completes.
+     *
+     *  @throw std::runtime_error if *this is null or if the progress thread is
+     *                            not running. Strong throw guarantee.
+     */
+    request_future_type register_request(mpi_request_type request);
+
     /** @brief Swaps the state of *this with @p other.
      *
      *  This method simply swaps the pointers of the PIMPLs. As such all
@@ -531,10 +1027,47 @@ public:
      */
     bool operator==(const RuntimeView& rhs) const;
 
+    /** @brief Runs @p fxn on @p n_ranks threads acting as ranks.
+     *
+     *  This function makes a team of @p n_ranks communicators with
+     *  CommPP::make_threaded, starts one thread per communicator, and on each
+     *  thread calls @p fxn with a RuntimeView built around that thread's
+     *  communicator. Collectives on the views (e.g., gather and reduce) are
+     *  carried out in shared memory, so this is a way to run SPMD code with
+     *  several ranks without MPI (or on a single node without the overhead of
+     *  MPI's shared memory transport). The function returns once every thread
+     *  has finished.
+     *
+     *  Like with MPI, every rank must take part in every collective. If
+     *  @p fxn throws on a rank, the team is aborted (see CommPP::abort), so
+     *  the other ranks' collectives throw rather than wait for it.
+     *
+     *  @param[in] n_ranks The number of threads (ranks) to run @p fxn on.
+     *  @param[in] fxn The function to run. It is called concurrently from
+     *                 @p n_ranks threads.
+     *
+     *  @throw std::out_of_range if @p n_ranks is 0. Strong throw guarantee.
+     *  @throw ??? If @p fxn throws on any rank, the exception from the lowest
+     *             rank which threw is rethrown after all threads finish.
+     *             Exceptions caused only by another rank aborting the team
+     *             are rethrown only if nothing else was thrown.
+     *  @throw std::system_error if a thread can not be started. The threads
+     *                           already started are aborted and joined
+     *                           first.
+     */
+    static void run_threaded(size_type n_ranks, const rank_function_type& fxn);
+
 private:
-    /// Returns the MPI communicator as our internal CommPP object
+    /// Returns the communicator of *this (a null one if *this is null)
     mpi_helpers::CommPP comm_() const;
 
+    /** @brief Code factorization for ensuring *this is backed by MPI.
+     *
+     *  @throw std::runtime_error if *this is null or if *this is not backed
+     *         by an MPI communicator. Strong throw guarantee.
+     */
+    void needs_mpi_() const;
+
     /** @brief Code factorization for ensuring *this is not null.
      *
      *  @throw std::runtime_error if *this is a view of the null runtime. Strong
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detail_/cpu_pimpl.hpp"
+#include <algorithm>
+#include <stdexcept>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace parallelzone::hardware {
+
+// -----------------------------------------------------------------------------
+// -- Ctors, Assignment, Dtor
+// -----------------------------------------------------------------------------
+
+CPU::CPU() noexcept = default;
+
+CPU::CPU(pimpl_pointer pimpl) noexcept : m_pimpl_(std::move(pimpl)) {}
+
+CPU::CPU(const CPU& other) :
+  CPU(other.has_pimpl_() ? other.m_pimpl_->clone() : nullptr) {}
+
+CPU::CPU(CPU&& other) noexcept = default;
+
+CPU& CPU::operator=(const CPU& rhs) {
+    if(this != &rhs) CPU(rhs).swap(*this);
+    return *this;
+}
+
+CPU& CPU::operator=(CPU&& rhs) noexcept = default;
+
+CPU::~CPU() noexcept = default;
+
+// -----------------------------------------------------------------------------
+// -- Topology
+// -----------------------------------------------------------------------------
+
+CPU::size_type CPU::n_sockets() const noexcept {
+    return has_pimpl_() ? m_pimpl_->m_n_sockets : 0;
+}
+
+CPU::size_type CPU::n_cores() const noexcept {
+    return has_pimpl_() ? m_pimpl_->m_n_cores : 0;
+}
+
+CPU::size_type CPU::n_hardware_threads() const noexcept {
+    return has_pimpl_() ? m_pimpl_->m_threads.size() : 0;
+}
+
+CPU::id_container CPU::hardware_threads() const {
+    id_container ids;
+    if(!has_pimpl_()) return ids;
+    ids.reserve(m_pimpl_->m_threads.size());
+    for(const auto& t : m_pimpl_->m_threads) ids.push_back(t.id);
+    return ids;
+}
+
+CPU::size_type CPU::socket_of(size_type cpu) const {
+    assert_non_empty_();
+    return m_pimpl_->at(cpu).socket;
+}
+
+CPU::size_type CPU::core_of(size_type cpu) const {
+    assert_non_empty_();
+    return m_pimpl_->at(cpu).core;
+}
+
+CPU::id_container CPU::hardware_threads_on_socket(size_type socket) const {
+    if(socket >= n_sockets())
+        throw std::out_of_range(std::to_string(socket) +
+                                " is not in the range [0, " +
+                                std::to_string(n_sockets()) + ").");
+    id_container ids;
+    for(const auto& t : m_pimpl_->m_threads)
+        if(t.socket == socket) ids.push_back(t.id);
+    return ids;
+}
+
+CPU::size_type CPU::n_numa_nodes() const noexcept {
+    return has_pimpl_() ? m_pimpl_->m_numa_nodes.size() : 0;
+}
+
+CPU::id_container CPU::numa_nodes() const {
+    return has_pimpl_() ? m_pimpl_->m_numa_nodes : id_container{};
+}
+
+CPU::size_type CPU::numa_node_of(size_type cpu) const {
+    assert_non_empty_();
+    return m_pimpl_->at(cpu).numa_node;
+}
+
+CPU::id_container CPU::hardware_threads_on_numa_node(size_type node) const {
+    const auto nodes = numa_nodes();
+    if(!std::binary_search(nodes.begin(), nodes.end(), node))
+        throw std::out_of_range(std::to_string(node) +
+                                " is not a NUMA node with CPUs");
+    id_container ids;
+    for(const auto& t : m_pimpl_->m_threads)
+        if(t.numa_node == node) ids.push_back(t.id);
+    return ids;
+}
+
+// -----------------------------------------------------------------------------
+// -- Caches
+// -----------------------------------------------------------------------------
+
+CPU::size_type CPU::cache_size(size_type level) const noexcept {
+    if(!has_pimpl_()) return 0;
+    for(const auto& c : m_pimpl_->m_caches)
+        if(c.level == level) return c.size;
+    return 0;
+}
+
+CPU::size_type CPU::cache_line_size() const noexcept {
+    if(!has_pimpl_() || m_pimpl_->m_caches.empty()) return 0;
+    return m_pimpl_->m_caches.front().line_size;
+}
+
+CPU::size_type CPU::n_cache_levels() const noexcept {
+    if(!has_pimpl_() || m_pimpl_->m_caches.empty()) return 0;
+    return m_pimpl_->m_caches.back().level;
+}
+
+// -----------------------------------------------------------------------------
+// -- Affinity
+// -----------------------------------------------------------------------------
+
+CPU::id_container CPU::affinity() const {
+    assert_non_empty_();
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if(sched_getaffinity(0, sizeof(mask), &mask) != 0)
+        throw std::runtime_error("sched_getaffinity failed");
+    id_container ids;
+    for(size_type i = 0; i < CPU_SETSIZE; ++i)
+        if(CPU_ISSET(i, &mask)) ids.push_back(i);
+    return ids;
+#else
+    throw std::runtime_error("Thread affinity is only supported on Linux");
+#endif
+}
+
+void CPU::set_affinity(const id_container& cpus) const {
+    assert_non_empty_();
+    if(cpus.empty())
+        throw std::runtime_error("Can not set an empty affinity mask");
+    for(auto cpu : cpus) m_pimpl_->at(cpu); // Throws if cpu is not online
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for(auto cpu : cpus) {
+        if(cpu >= CPU_SETSIZE)
+            throw std::out_of_range(std::to_string(cpu) +
+                                    " exceeds CPU_SETSIZE");
+        CPU_SET(cpu, &mask);
+    }
+    if(sched_setaffinity(0, sizeof(mask), &mask) != 0)
+        throw std::runtime_error("sched_setaffinity failed");
+#else
+    throw std::runtime_error("Thread affinity is only supported on Linux");
+#endif
+}
+
+void CPU::pin_thread(size_type cpu) const { set_affinity(id_container{cpu}); }
+
+// -----------------------------------------------------------------------------
+// -- Hardware counters
+// -----------------------------------------------------------------------------
+
+HardwareCounters CPU::counters(HardwareCounters::event_container events) const {
+    assert_non_empty_();
+    return HardwareCounters(std::move(events));
+}
+
+// -----------------------------------------------------------------------------
+// -- Utility methods
+// -----------------------------------------------------------------------------
+
+bool CPU::empty() const noexcept { return n_hardware_threads() == 0; }
+
+void CPU::swap(CPU& other) noexcept { m_pimpl_.swap(other.m_pimpl_); }
+
+bool CPU::operator==(const CPU& rhs) const noexcept {
+    // Rule out one empty and one non-empty
+    if(empty() != rhs.empty()) return false;
+
+    // If both are empty return early
+    if(empty()) return true;
+
+    const auto& lhs = *m_pimpl_;
+    const auto& r   = *rhs.m_pimpl_;
+    return lhs.m_n_sockets == r.m_n_sockets && lhs.m_n_cores == r.m_n_cores &&
+           lhs.m_threads == r.m_threads && lhs.m_caches == r.m_caches &&
+           lhs.m_numa_nodes == r.m_numa_nodes;
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+bool CPU::has_pimpl_() const noexcept { return static_cast<bool>(m_pimpl_); }
+
+void CPU::assert_non_empty_() const {
+    if(!empty()) return;
+    throw std::runtime_error("The current CPU instance is empty. Was it "
+                             "default constructed or moved from?");
+}
+
+} // namespace parallelzone::hardware
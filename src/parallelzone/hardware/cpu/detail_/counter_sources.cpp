@@ -0,0 +1,301 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "counter_sources.hpp"
+#include <array>
+#include <sys/resource.h>
+#include <vector>
+#ifdef PARALLELZONE_HAS_PAPI
+#include <papi.h>
+#include <pthread.h>
+#endif
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace parallelzone::hardware::detail_ {
+namespace {
+
+using event_type  = CounterSource::event_type;
+using value_type  = CounterSource::value_type;
+using source_type = CounterSource::source_type;
+
+// -----------------------------------------------------------------------------
+// -- PAPI
+// -----------------------------------------------------------------------------
+
+#ifdef PARALLELZONE_HAS_PAPI
+
+unsigned long papi_thread_id() { return (unsigned long)(pthread_self()); }
+
+// Initializes PAPI once per process, returns whether it worked
+bool papi_initialized() noexcept {
+    static const bool initialized = [] {
+        if(PAPI_library_init(PAPI_VER_CURRENT) != PAPI_VER_CURRENT)
+            return false;
+        return PAPI_thread_init(papi_thread_id) == PAPI_OK;
+    }();
+    return initialized;
+}
+
+// The PAPI preset for e, false if there is none
+bool papi_code(event_type e, int& code) noexcept {
+    switch(e) {
+        case event_type::cycles: code = PAPI_TOT_CYC; return true;
+        case event_type::instructions: code = PAPI_TOT_INS; return true;
+        case event_type::cache_references: code = PAPI_L3_TCA; return true;
+        case event_type::cache_misses: code = PAPI_L3_TCM; return true;
+        case event_type::branch_misses: code = PAPI_BR_MSP; return true;
+        case event_type::flops: code = PAPI_DP_OPS; return true;
+        default: return false;
+    }
+}
+
+class PapiSource : public CounterSource {
+public:
+    ~PapiSource() noexcept override {
+        if(m_event_set_ == PAPI_NULL) return;
+        if(m_started_) PAPI_stop(m_event_set_, m_buffer_.data());
+        PAPI_cleanup_eventset(m_event_set_);
+        PAPI_destroy_eventset(&m_event_set_);
+    }
+
+    bool add(event_type e) noexcept override {
+        int code;
+        if(m_started_ || !papi_code(e, code)) return false;
+        if(PAPI_query_event(code) != PAPI_OK) return false;
+        if(m_event_set_ == PAPI_NULL &&
+           PAPI_create_eventset(&m_event_set_) != PAPI_OK)
+            return false;
+        if(PAPI_add_event(m_event_set_, code) != PAPI_OK) return false;
+        ++m_n_events_;
+        return true;
+    }
+
+    bool start() noexcept override {
+        if(m_n_events_ == 0) return false;
+        m_started_ = PAPI_start(m_event_set_) == PAPI_OK;
+        return m_started_;
+    }
+
+    void read(value_type* values) const noexcept override {
+        const bool good =
+          m_started_ && PAPI_read(m_event_set_, m_buffer_.data()) == PAPI_OK;
+        for(std::size_t i = 0; i < m_n_events_; ++i)
+            values[i] = good ? value_type(m_buffer_[i]) : 0;
+    }
+
+    source_type type() const noexcept override { return source_type::papi; }
+
+private:
+    /// The PAPI handle for the added events
+    int m_event_set_ = PAPI_NULL;
+
+    /// How many events were added
+    std::size_t m_n_events_ = 0;
+
+    /// Was PAPI_start successful?
+    bool m_started_ = false;
+
+    /// Where PAPI_read puts the counts (one slot per possible event)
+    mutable std::array<long long, 8> m_buffer_{};
+};
+
+#endif
+
+// -----------------------------------------------------------------------------
+// -- perf_event_open
+// -----------------------------------------------------------------------------
+
+#ifdef __linux__
+
+// The type and config of e, false if the kernel has no generic event for it
+bool perf_config(event_type e, perf_event_attr& attr) noexcept {
+    attr.type = PERF_TYPE_HARDWARE;
+    switch(e) {
+        case event_type::cycles:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            return true;
+        case event_type::instructions:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            return true;
+        case event_type::cache_references:
+            attr.config = PERF_COUNT_HW_CACHE_REFERENCES;
+            return true;
+        case event_type::cache_misses:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            return true;
+        case event_type::branch_misses:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            return true;
+        default: break;
+    }
+    attr.type = PERF_TYPE_SOFTWARE;
+    switch(e) {
+        case event_type::page_faults:
+            attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+            return true;
+        case event_type::context_switches:
+            attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+            return true;
+        default: return false;
+    }
+}
+
+class PerfEventSource : public CounterSource {
+public:
+    ~PerfEventSource() noexcept override {
+        for(auto fd : m_fds_) ::close(fd);
+    }
+
+    bool add(event_type e) noexcept override {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        if(!perf_config(e, attr)) return false;
+        attr.disabled    = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // Hardware events only count user space, which is what unprivileged
+        // users may count. Software events happen in the kernel, so they need
+        // a lower perf_event_paranoid; if it is too high getrusage is used.
+        attr.exclude_kernel = attr.type == PERF_TYPE_HARDWARE;
+        attr.exclude_hv     = 1;
+
+        // pid 0 and cpu -1 count the calling thread on any CPU
+        const auto fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if(fd < 0) return false;
+        try {
+            m_fds_.push_back(int(fd));
+        } catch(...) {
+            ::close(int(fd));
+            return false;
+        }
+        return true;
+    }
+
+    bool start() noexcept override {
+        for(auto fd : m_fds_) {
+            if(ioctl(fd, PERF_EVENT_IOC_RESET, 0) != 0) return false;
+            if(ioctl(fd, PERF_EVENT_IOC_ENABLE, 0) != 0) return false;
+        }
+        return true;
+    }
+
+    void read(value_type* values) const noexcept override {
+        for(std::size_t i = 0; i < m_fds_.size(); ++i) {
+            // The count, the time enabled, and the time running
+            std::array<std::uint64_t, 3> buffer{};
+            const auto n = ::read(m_fds_[i], buffer.data(), sizeof(buffer));
+            values[i]    = n == sizeof(buffer) ? buffer[0] : 0;
+
+            // If the kernel multiplexed the counter, extrapolate the count
+            if(buffer[2] > 0 && buffer[2] < buffer[1])
+                values[i] = value_type(double(buffer[0]) * double(buffer[1]) /
+                                       double(buffer[2]));
+        }
+    }
+
+    source_type type() const noexcept override {
+        return source_type::perf_event;
+    }
+
+private:
+    /// One file descriptor per added event
+    std::vector<int> m_fds_;
+};
+
+#endif
+
+// -----------------------------------------------------------------------------
+// -- getrusage
+// -----------------------------------------------------------------------------
+
+class RusageSource : public CounterSource {
+public:
+    bool add(event_type e) noexcept override {
+        if(e != event_type::page_faults && e != event_type::context_switches)
+            return false;
+        try {
+            m_events_.push_back(e);
+        } catch(...) { return false; }
+        return true;
+    }
+
+    bool start() noexcept override {
+        m_start_ = sample();
+        return true;
+    }
+
+    void read(value_type* values) const noexcept override {
+        const auto now = sample();
+        for(std::size_t i = 0; i < m_events_.size(); ++i) {
+            const auto j = m_events_[i] == event_type::page_faults ? 0 : 1;
+            values[i]    = now[j] - m_start_[j];
+        }
+    }
+
+    source_type type() const noexcept override { return source_type::rusage; }
+
+private:
+    /// The page faults and the context switches so far
+    using sample_type = std::array<value_type, 2>;
+
+    static sample_type sample() noexcept {
+#ifdef RUSAGE_THREAD
+        const int who = RUSAGE_THREAD;
+#else
+        const int who = RUSAGE_SELF;
+#endif
+        rusage usage;
+        if(getrusage(who, &usage) != 0) return {0, 0};
+        return {value_type(usage.ru_minflt + usage.ru_majflt),
+                value_type(usage.ru_nvcsw + usage.ru_nivcsw)};
+    }
+
+    /// The added events
+    std::vector<event_type> m_events_;
+
+    /// The sample taken by start
+    sample_type m_start_{};
+};
+
+} // namespace
+
+counter_source_pointer make_papi_source() {
+#ifdef PARALLELZONE_HAS_PAPI
+    if(papi_initialized()) return std::make_unique<PapiSource>();
+#endif
+    return nullptr;
+}
+
+counter_source_pointer make_perf_event_source() {
+#ifdef __linux__
+    return std::make_unique<PerfEventSource>();
+#else
+    return nullptr;
+#endif
+}
+
+counter_source_pointer make_rusage_source() {
+    return std::make_unique<RusageSource>();
+}
+
+} // namespace parallelzone::hardware::detail_
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <memory>
+#include <parallelzone/hardware/cpu/hardware_counters.hpp>
+
+/** @file counter_sources.hpp
+ *
+ *  The ways HardwareCounters can read events. Each source wraps one API
+ *  (PAPI, perf_event_open(2), or getrusage(2)) and fails gracefully, i.e.,
+ *  events the source can not count on this machine are simply not added.
+ */
+
+namespace parallelzone::hardware::detail_ {
+
+/** @brief Common interface of the sources of event counts.
+ *
+ *  A source is used by first adding the events it should count (from the
+ *  thread which will read them), then starting it, and then reading it any
+ *  number of times.
+ */
+class CounterSource {
+public:
+    /// Type of an event
+    using event_type = HardwareCounters::event;
+
+    /// Type of an event count
+    using value_type = HardwareCounters::value_type;
+
+    /// Which source *this is
+    using source_type = HardwareCounters::source;
+
+    /// Releases the resources of the source
+    virtual ~CounterSource() noexcept = default;
+
+    /** @brief Asks *this to count @p e for the calling thread.
+     *
+     *  @param[in] e The event to count.
+     *
+     *  @return True if *this will count @p e and false otherwise. Events are
+     *          numbered in the order they were successfully added.
+     *
+     *  @throw None No throw guarantee.
+     */
+    virtual bool add(event_type e) noexcept = 0;
+
+    /** @brief Starts counting the added events from zero.
+     *
+     *  Starting can fail even if the events were added, e.g., PAPI only
+     *  allows one running event set per thread.
+     *
+     *  @return True if the events are being counted and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    virtual bool start() noexcept = 0;
+
+    /** @brief Reads the counts of the added events.
+     *
+     *  @param[out] values Where the counts go, one per added event. Counts
+     *                     which can not be read are set to 0.
+     *
+     *  @throw None No throw guarantee.
+     */
+    virtual void read(value_type* values) const noexcept = 0;
+
+    /// Which source *this is
+    virtual source_type type() const noexcept = 0;
+};
+
+/// Type of a pointer to a source
+using counter_source_pointer = std::unique_ptr<CounterSource>;
+
+/** @brief Makes a source backed by PAPI.
+ *
+ *  @return The source, or a null pointer if ParallelZone was not built with
+ *          PAPI or PAPI can not be initialized.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the source.
+ */
+counter_source_pointer make_papi_source();
+
+/** @brief Makes a source backed by perf_event_open(2).
+ *
+ *  @return The source, or a null pointer on platforms other than Linux.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the source.
+ */
+counter_source_pointer make_perf_event_source();
+
+/** @brief Makes a source backed by getrusage(2).
+ *
+ *  The counts are those of the calling thread where the platform supports
+ *  it (RUSAGE_THREAD) and those of the process otherwise.
+ *
+ *  @return The source.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the source.
+ */
+counter_source_pointer make_rusage_source();
+
+} // namespace parallelzone::hardware::detail_
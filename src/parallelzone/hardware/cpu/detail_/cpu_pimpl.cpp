@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_pimpl.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+namespace parallelzone::hardware::detail_ {
+namespace {
+
+// Reads the first line of a (sysfs) file, returns false if it can't be read
+bool read_line(const std::string& path, std::string& line) {
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, line));
+}
+
+// Reads a non-negative integer from a (sysfs) file
+bool read_size(const std::string& path, CPUPIMPL::size_type& value) {
+    std::string line;
+    if(!read_line(path, line)) return false;
+    try {
+        value = std::stoul(line);
+    } catch(...) { return false; }
+    return true;
+}
+
+// Finds the "nodeN" entry of a CPU's sysfs directory, returns N
+CPUPIMPL::size_type read_numa_node(const std::string& cpu_dir) {
+    std::error_code ec;
+    std::filesystem::directory_iterator itr(cpu_dir, ec), end;
+    for(; !ec && itr != end; itr.increment(ec)) {
+        const auto name = itr->path().filename().string();
+        if(name.size() < 5 || name.compare(0, 4, "node") != 0) continue;
+        const auto digits = name.substr(4);
+        if(digits.find_first_not_of("0123456789") != std::string::npos)
+            continue;
+        try {
+            return std::stoul(digits);
+        } catch(...) { continue; }
+    }
+    return 0;
+}
+
+} // namespace
+
+const CPUPIMPL::HardwareThread& CPUPIMPL::at(size_type cpu) const {
+    auto itr = std::lower_bound(
+      m_threads.begin(), m_threads.end(), cpu,
+      [](const HardwareThread& t, size_type id) { return t.id < id; });
+    if(itr != m_threads.end() && itr->id == cpu) return *itr;
+    throw std::out_of_range(std::to_string(cpu) +
+                            " is not an online logical CPU");
+}
+
+CPUPIMPL::id_container parse_cpu_list(const std::string& list) {
+    CPUPIMPL::id_container ids;
+    std::size_t begin = 0;
+    while(begin < list.size()) {
+        auto end = list.find(',', begin);
+        if(end == std::string::npos) end = list.size();
+        auto range = list.substr(begin, end - begin);
+        begin      = end + 1;
+
+        // Trailing whitespace/newlines
+        range.erase(range.find_last_not_of(" \n\t") + 1);
+        if(range.empty()) continue;
+
+        try {
+            auto dash = range.find('-');
+            if(dash == std::string::npos) {
+                ids.push_back(std::stoul(range));
+            } else {
+                auto lo = std::stoul(range.substr(0, dash));
+                auto hi = std::stoul(range.substr(dash + 1));
+                if(hi < lo) throw std::invalid_argument(range);
+                for(auto i = lo; i <= hi; ++i) ids.push_back(i);
+            }
+        } catch(const std::logic_error&) {
+            throw std::runtime_error("Malformed CPU list: " + list);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+CPUPIMPL::size_type parse_cache_size(const std::string& size) noexcept {
+    try {
+        std::size_t n_read = 0;
+        CPUPIMPL::size_type value = std::stoul(size, &n_read);
+        if(n_read == size.size()) return value;
+        switch(size[n_read]) {
+            case 'K': return value << 10;
+            case 'M': return value << 20;
+            case 'G': return value << 30;
+            default: return value;
+        }
+    } catch(...) { return 0; }
+}
+
+CPUPIMPL::pimpl_pointer discover_cpu(const std::string& sysfs_root) {
+    using size_type = CPUPIMPL::size_type;
+    auto pimpl      = std::make_unique<CPUPIMPL>();
+
+    CPUPIMPL::id_container ids;
+    std::string line;
+    if(read_line(sysfs_root + "/online", line)) {
+        try {
+            ids = parse_cpu_list(line);
+        } catch(const std::runtime_error&) { ids.clear(); }
+    }
+    if(ids.empty()) {
+        const size_type n = std::max(std::thread::hardware_concurrency(), 1u);
+        for(size_type i = 0; i < n; ++i) ids.push_back(i);
+    }
+
+    // Read the raw package and core ids, and the NUMA nodes
+    std::vector<std::pair<size_type, size_type>> raw(ids.size());
+    std::vector<size_type> nodes(ids.size());
+    for(std::size_t i = 0; i < ids.size(); ++i) {
+        const auto dir = sysfs_root + "/cpu" + std::to_string(ids[i]);
+        size_type package = 0, core = ids[i];
+        read_size(dir + "/topology/physical_package_id", package);
+        read_size(dir + "/topology/core_id", core);
+        raw[i]   = {package, core};
+        nodes[i] = read_numa_node(dir);
+    }
+
+    // Renumber sockets and cores so they are contiguous
+    std::map<size_type, size_type> socket_index;
+    for(const auto& [package, core] : raw) socket_index.emplace(package, 0);
+    size_type counter = 0;
+    for(auto& [package, index] : socket_index) index = counter++;
+
+    std::map<std::pair<size_type, size_type>, size_type> core_index;
+    for(const auto& [package, core] : raw)
+        core_index.emplace(std::make_pair(socket_index[package], core), 0);
+    counter = 0;
+    for(auto& [key, index] : core_index) index = counter++;
+
+    for(std::size_t i = 0; i < ids.size(); ++i) {
+        const auto socket = socket_index[raw[i].first];
+        const auto core   = core_index[{socket, raw[i].second}];
+        pimpl->m_threads.push_back({ids[i], socket, core, nodes[i]});
+    }
+    pimpl->m_n_sockets = socket_index.size();
+    pimpl->m_n_cores   = core_index.size();
+
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    pimpl->m_numa_nodes = std::move(nodes);
+
+    // Caches, as seen by the first online CPU
+    const auto cache_dir =
+      sysfs_root + "/cpu" + std::to_string(ids.front()) + "/cache/index";
+    for(size_type i = 0;; ++i) {
+        const auto dir = cache_dir + std::to_string(i);
+        CPUPIMPL::Cache cache{0, 0, 0};
+        if(!read_size(dir + "/level", cache.level)) break;
+        if(read_line(dir + "/type", line) && line == "Instruction") continue;
+        if(read_line(dir + "/size", line)) cache.size = parse_cache_size(line);
+        read_size(dir + "/coherency_line_size", cache.line_size);
+        pimpl->m_caches.push_back(cache);
+    }
+    std::sort(pimpl->m_caches.begin(), pimpl->m_caches.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.level < rhs.level;
+              });
+
+    return pimpl;
+}
+
+} // namespace parallelzone::hardware::detail_
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <parallelzone/hardware/cpu/cpu.hpp>
+#include <string>
+#include <tuple>
+
+namespace parallelzone::hardware::detail_ {
+
+struct CPUPIMPL {
+    /// Type of the class *this implements
+    using parent_type = CPU;
+
+    /// Ultimately a typedef of CPU::size_type
+    using size_type = parent_type::size_type;
+
+    /// Ultimately a typedef of CPU::id_container
+    using id_container = parent_type::id_container;
+
+    /// Ultimately a typedef of CPU::pimpl_pointer
+    using pimpl_pointer = parent_type::pimpl_pointer;
+
+    /// Where a logical CPU lives
+    struct HardwareThread {
+        /// The OS's id for the logical CPU
+        size_type id;
+
+        /// Index of the socket, in the range [0, m_n_sockets)
+        size_type socket;
+
+        /// Index of the physical core, in the range [0, m_n_cores)
+        size_type core;
+
+        /// The OS's id for the NUMA node the logical CPU belongs to
+        size_type numa_node;
+
+        bool operator==(const HardwareThread& rhs) const noexcept {
+            return std::tie(id, socket, core, numa_node) ==
+                   std::tie(rhs.id, rhs.socket, rhs.core, rhs.numa_node);
+        }
+    };
+
+    /// A data or unified cache
+    struct Cache {
+        /// 1 for L1, 2 for L2, etc.
+        size_type level;
+
+        /// Size in bytes
+        size_type size;
+
+        /// Coherency line size in bytes
+        size_type line_size;
+
+        bool operator==(const Cache& rhs) const noexcept {
+            return std::tie(level, size, line_size) ==
+                   std::tie(rhs.level, rhs.size, rhs.line_size);
+        }
+    };
+
+    pimpl_pointer clone() const { return std::make_unique<CPUPIMPL>(*this); }
+
+    /// Returns the HardwareThread for logical CPU @p cpu, throws if not found
+    const HardwareThread& at(size_type cpu) const;
+
+    /// The online logical CPUs, sorted by id
+    std::vector<HardwareThread> m_threads;
+
+    /// The data and unified caches seen by one core, sorted by level
+    std::vector<Cache> m_caches;
+
+    /// Number of sockets
+    size_type m_n_sockets = 0;
+
+    /// Number of physical cores
+    size_type m_n_cores = 0;
+
+    /// The OS's ids for the NUMA nodes with CPUs, sorted
+    id_container m_numa_nodes;
+};
+
+/** @brief Parses a Linux CPU list (e.g., "0-3,8,10-11").
+ *
+ *  @param[in] list The list, as found in, e.g.,
+ *                  `/sys/devices/system/cpu/online`.
+ *
+ *  @return The ids in @p list, in increasing order.
+ *
+ *  @throw std::runtime_error if @p list is malformed. Strong throw guarantee.
+ */
+CPUPIMPL::id_container parse_cpu_list(const std::string& list);
+
+/** @brief Parses a sysfs cache size (e.g., "32K" or "2048K") into bytes.
+ *
+ *  @param[in] size The size string. A "K", "M", or "G" suffix is honored.
+ *
+ *  @return The size in bytes, or 0 if @p size can not be parsed.
+ *
+ *  @throw None No throw guarantee.
+ */
+CPUPIMPL::size_type parse_cache_size(const std::string& size) noexcept;
+
+/** @brief Discovers the topology of the processors from sysfs.
+ *
+ *  Missing files are tolerated. If the list of online CPUs can not be read,
+ *  std::thread::hardware_concurrency logical CPUs (with ids starting at 0)
+ *  are assumed. If a CPU's topology can not be read, the CPU is assumed to be
+ *  its own core on socket 0. The NUMA node of a CPU is found from the
+ *  `nodeN` entry of the CPU's directory; CPUs without one are assumed to be
+ *  on node 0.
+ *
+ *  @param[in] sysfs_root The directory describing the CPUs. Defaults to
+ *                        `/sys/devices/system/cpu`; tests use a fake tree.
+ *
+ *  @return A PIMPL describing the discovered topology.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the PIMPL. Strong
+ *                        throw guarantee.
+ */
+CPUPIMPL::pimpl_pointer discover_cpu(
+  const std::string& sysfs_root = "/sys/devices/system/cpu");
+
+/** @brief Wraps the process of making a CPU instance for the current node.
+ *
+ *  @relates CPUPIMPL
+ *
+ *  @return A CPU instance describing the processors of the current node.
+ */
+inline auto make_cpu() { return CPU(discover_cpu()); }
+
+} // namespace parallelzone::hardware::detail_
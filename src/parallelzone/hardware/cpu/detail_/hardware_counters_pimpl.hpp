@@ -0,0 +1,87 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "counter_sources.hpp"
+#include <vector>
+
+namespace parallelzone::hardware::detail_ {
+
+/** @brief Implements HardwareCounters.
+ *
+ *  Each event is assigned to the first source (PAPI, perf_event_open,
+ *  getrusage) which can count it and which starts, so, e.g., page faults may
+ *  come from getrusage while cycles come from perf_event_open.
+ */
+class HardwareCountersPIMPL {
+public:
+    /// Type of the class *this implements
+    using parent_type = HardwareCounters;
+
+    /// Ultimately a typedef of HardwareCounters::event
+    using event_type = parent_type::event;
+
+    /// Ultimately a typedef of HardwareCounters::source
+    using source_type = parent_type::source;
+
+    /// Ultimately a typedef of HardwareCounters::event_container
+    using event_container = parent_type::event_container;
+
+    /// Ultimately a typedef of HardwareCounters::value_container
+    using value_container = parent_type::value_container;
+
+    /** @brief Assigns @p events to sources and starts counting them.
+     *
+     *  @param[in] events The events to count.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the state.
+     *                        Strong throw guarantee.
+     */
+    explicit HardwareCountersPIMPL(event_container events);
+
+    /// Reads every source, see HardwareCounters::read
+    value_container read() const;
+
+    /// The source counting @p e, see HardwareCounters::source_of
+    source_type source_of(event_type e) const noexcept;
+
+    /// The events, as passed to the ctor
+    const event_container& events() const noexcept { return m_events_; }
+
+private:
+    /// Where the count of an event is found
+    struct Slot {
+        /// Index into m_sources_, not a valid index if unsupported
+        std::size_t source;
+
+        /// Index of the count among those read from the source
+        std::size_t index;
+    };
+
+    /// The events, as passed to the ctor
+    event_container m_events_;
+
+    /// The sources counting at least one event
+    std::vector<counter_source_pointer> m_sources_;
+
+    /// How many events each source counts
+    std::vector<std::size_t> m_n_counted_;
+
+    /// The slot of each of m_events_
+    std::vector<Slot> m_slots_;
+};
+
+} // namespace parallelzone::hardware::detail_
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detail_/hardware_counters_pimpl.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace parallelzone::hardware {
+namespace detail_ {
+
+HardwareCountersPIMPL::HardwareCountersPIMPL(event_container events) :
+  m_events_(std::move(events)) {
+    // Until a source is found, events are unsupported
+    const Slot none{std::numeric_limits<std::size_t>::max(), 0};
+    m_slots_.assign(m_events_.size(), none);
+
+    // Each source gets the events the sources before it could not count. A
+    // source which fails to start (e.g., PAPI when the thread already has a
+    // running event set) is dropped and its events go to the next source
+    for(auto make : {make_papi_source, make_perf_event_source,
+                     make_rusage_source}) {
+        auto source = make();
+        if(!source) continue;
+
+        std::vector<std::size_t> added;
+        for(std::size_t i = 0; i < m_events_.size(); ++i) {
+            if(m_slots_[i].source != none.source) continue;
+            // Repeated events share the slot of their first occurrence
+            const auto first = std::find(m_events_.begin(), m_events_.end(),
+                                         m_events_[i]) -
+                               m_events_.begin();
+            if(std::size_t(first) < i) continue;
+            if(source->add(m_events_[i])) added.push_back(i);
+        }
+        if(added.empty() || !source->start()) continue;
+
+        for(std::size_t k = 0; k < added.size(); ++k)
+            m_slots_[added[k]] = Slot{m_sources_.size(), k};
+        m_n_counted_.push_back(added.size());
+        m_sources_.push_back(std::move(source));
+    }
+
+    for(std::size_t i = 0; i < m_events_.size(); ++i) {
+        const auto first =
+          std::find(m_events_.begin(), m_events_.end(), m_events_[i]) -
+          m_events_.begin();
+        if(m_slots_[i].source == none.source) m_slots_[i] = m_slots_[first];
+    }
+}
+
+HardwareCountersPIMPL::value_container HardwareCountersPIMPL::read() const {
+    std::vector<value_container> counts(m_sources_.size());
+    for(std::size_t s = 0; s < m_sources_.size(); ++s) {
+        if(m_n_counted_[s] == 0) continue;
+        counts[s].resize(m_n_counted_[s]);
+        m_sources_[s]->read(counts[s].data());
+    }
+
+    value_container values(m_slots_.size(), 0);
+    for(std::size_t i = 0; i < m_slots_.size(); ++i) {
+        const auto& slot = m_slots_[i];
+        if(slot.source < m_sources_.size())
+            values[i] = counts[slot.source][slot.index];
+    }
+    return values;
+}
+
+HardwareCountersPIMPL::source_type HardwareCountersPIMPL::source_of(
+  event_type e) const noexcept {
+    for(std::size_t i = 0; i < m_events_.size(); ++i) {
+        if(m_events_[i] != e) continue;
+        const auto s = m_slots_[i].source;
+        if(s >= m_sources_.size()) return source_type::none;
+        return m_sources_[s]->type();
+    }
+    return source_type::none;
+}
+
+} // namespace detail_
+
+// -----------------------------------------------------------------------------
+// -- Ctors, Assignment, Dtor
+// -----------------------------------------------------------------------------
+
+HardwareCounters::HardwareCounters() noexcept = default;
+
+HardwareCounters::HardwareCounters(event_container events) :
+  m_pimpl_(std::make_unique<pimpl_type>(std::move(events))) {}
+
+HardwareCounters::HardwareCounters(HardwareCounters&& other) noexcept =
+  default;
+
+HardwareCounters& HardwareCounters::operator=(
+  HardwareCounters&& rhs) noexcept = default;
+
+HardwareCounters::~HardwareCounters() noexcept = default;
+
+// -----------------------------------------------------------------------------
+// -- Accessors
+// -----------------------------------------------------------------------------
+
+HardwareCounters::event_container HardwareCounters::events() const {
+    return m_pimpl_ ? m_pimpl_->events() : event_container{};
+}
+
+HardwareCounters::source HardwareCounters::source_of(event e) const noexcept {
+    return m_pimpl_ ? m_pimpl_->source_of(e) : source::none;
+}
+
+HardwareCounters::value_container HardwareCounters::read() const {
+    return m_pimpl_ ? m_pimpl_->read() : value_container{};
+}
+
+bool HardwareCounters::have_papi() noexcept {
+#ifdef PARALLELZONE_HAS_PAPI
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string HardwareCounters::name(event e) {
+    switch(e) {
+        case event::cycles: return "cycles";
+        case event::instructions: return "instructions";
+        case event::cache_references: return "cache_references";
+        case event::cache_misses: return "cache_misses";
+        case event::branch_misses: return "branch_misses";
+        case event::flops: return "flops";
+        case event::page_faults: return "page_faults";
+        case event::context_switches: return "context_switches";
+    }
+    return "unknown";
+}
+
+} // namespace parallelzone::hardware
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_info.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace parallelzone::hardware::detail_ {
+namespace {
+
+// Reads an entire (small) file, returns false if it can't be read
+bool read_file(const std::string& path, std::string& contents) noexcept {
+    try {
+        std::ifstream file(path);
+        if(!file) return false;
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        contents = ss.str();
+        return true;
+    } catch(...) { return false; }
+}
+
+// Reads a file containing a single number of bytes ("max" means no limit)
+std::optional<memory_size_type> read_bytes(const std::string& path) noexcept {
+    std::string contents;
+    if(!read_file(path, contents)) return std::nullopt;
+    try {
+        return std::stoull(contents);
+    } catch(...) { return std::nullopt; }
+}
+
+} // namespace
+
+std::optional<memory_size_type> parse_proc_entry(
+  const std::string& contents, const std::string& key) noexcept {
+    const auto target = key + ":";
+    std::size_t pos   = 0;
+    while(pos < contents.size()) {
+        auto eol = contents.find('\n', pos);
+        if(eol == std::string::npos) eol = contents.size();
+        if(contents.compare(pos, target.size(), target) == 0) {
+            try {
+                std::size_t n_read = 0;
+                auto value_begin   = pos + target.size();
+                auto value = std::stoull(contents.substr(value_begin), &n_read);
+                // Entries are in kB, unless no unit is given
+                auto unit = contents.find("kB", value_begin + n_read);
+                if(unit != std::string::npos && unit < eol) value *= 1024;
+                return value;
+            } catch(...) { return std::nullopt; }
+        }
+        pos = eol + 1;
+    }
+    return std::nullopt;
+}
+
+std::optional<memory_size_type> read_proc_entry(
+  const std::string& path, const std::string& key) noexcept {
+    std::string contents;
+    if(!read_file(path, contents)) return std::nullopt;
+    return parse_proc_entry(contents, key);
+}
+
+memory_size_type physical_memory() noexcept {
+    const auto n_pages   = sysconf(_SC_PHYS_PAGES);
+    const auto page_size = sysconf(_SC_PAGE_SIZE);
+    if(n_pages > 0 && page_size > 0)
+        return memory_size_type(n_pages) * memory_size_type(page_size);
+    return read_proc_entry("/proc/meminfo", "MemTotal").value_or(0);
+}
+
+std::optional<std::string> parse_proc_cgroup(
+  const std::string& contents, const std::string& controller) noexcept {
+    try {
+        std::istringstream ss(contents);
+        std::string line;
+        // Lines are "hierarchy-id:controller,controller,...:path"
+        while(std::getline(ss, line)) {
+            const auto first  = line.find(':');
+            const auto second = line.find(':', first + 1);
+            if(first == std::string::npos || second == std::string::npos)
+                continue;
+            const auto id = line.substr(0, first);
+            const auto names =
+              "," + line.substr(first + 1, second - first - 1) + ",";
+            const bool match =
+              controller.empty() ?
+                id == "0" && names == ",," :
+                names.find("," + controller + ",") != std::string::npos;
+            if(match) return line.substr(second + 1);
+        }
+    } catch(...) {}
+    return std::nullopt;
+}
+
+namespace {
+
+// A cgroup's directory and the names of its memory controller's files
+struct CgroupDir {
+    std::string path;
+    std::string limit_file;
+    std::string usage_file;
+};
+
+// Reads the limit and usage of @p dir, limits of at least @p phys are none
+CgroupLevel read_cgroup(const CgroupDir& dir, memory_size_type phys) noexcept {
+    CgroupLevel level;
+    try {
+        level.limit = read_bytes(dir.path + "/" + dir.limit_file);
+        // cgroup v1 reports "no limit" as a huge number
+        if(level.limit && *level.limit >= phys) level.limit.reset();
+        level.usage = read_bytes(dir.path + "/" + dir.usage_file);
+    } catch(...) {}
+    return level;
+}
+
+// Walks from mount + path up to mount, returning the cgroup with the
+// tightest limit, or the innermost one with a usage if none has a limit
+std::optional<CgroupDir> tightest_cgroup(const std::string& mount,
+                                         std::string path,
+                                         const std::string& limit_file,
+                                         const std::string& usage_file,
+                                         memory_size_type phys) noexcept {
+    std::optional<CgroupDir> tightest;
+    std::optional<memory_size_type> tightest_limit;
+    try {
+        while(!path.empty() && path.back() == '/') path.pop_back();
+        while(true) {
+            CgroupDir dir{mount + path, limit_file, usage_file};
+            const auto level = read_cgroup(dir, phys);
+            if(level.limit &&
+               (!tightest_limit || *level.limit < *tightest_limit)) {
+                tightest_limit = level.limit;
+                tightest       = std::move(dir);
+            } else if(!tightest && level.usage) {
+                tightest = std::move(dir);
+            }
+            if(path.empty()) break;
+            const auto slash = path.rfind('/');
+            path.erase(slash == std::string::npos ? 0 : slash);
+        }
+    } catch(...) {}
+    return tightest;
+}
+
+// The tightest cgroup of the current process, v2 is tried before v1
+std::optional<CgroupDir> process_cgroup(const std::string& root,
+                                        const std::string& proc_cgroup,
+                                        memory_size_type phys) noexcept {
+    std::string contents;
+    if(!read_file(proc_cgroup, contents)) contents.clear();
+
+    const auto v2_path = parse_proc_cgroup(contents, "").value_or("/");
+    auto dir =
+      tightest_cgroup(root, v2_path, "memory.max", "memory.current", phys);
+    if(dir) return dir;
+
+    const auto v1_path = parse_proc_cgroup(contents, "memory").value_or("/");
+    return tightest_cgroup(root + "/memory", v1_path, "memory.limit_in_bytes",
+                           "memory.usage_in_bytes", phys);
+}
+
+} // namespace
+
+CgroupLevel cgroup_memory(const std::string& root,
+                          const std::string& proc_cgroup) noexcept {
+    const auto phys = physical_memory();
+    const auto dir  = process_cgroup(root, proc_cgroup, phys);
+    return dir ? read_cgroup(*dir, phys) : CgroupLevel{};
+}
+
+CgroupLevel cgroup_memory() noexcept {
+    // Resolved once, the cgroups are set up before the process starts
+    static const auto phys = physical_memory();
+    static const auto dir =
+      process_cgroup("/sys/fs/cgroup", "/proc/self/cgroup", phys);
+    return dir ? read_cgroup(*dir, phys) : CgroupLevel{};
+}
+
+std::optional<memory_size_type> cgroup_limit(
+  const std::string& root, const std::string& proc_cgroup) noexcept {
+    return cgroup_memory(root, proc_cgroup).limit;
+}
+
+std::optional<memory_size_type> cgroup_usage(
+  const std::string& root, const std::string& proc_cgroup) noexcept {
+    return cgroup_memory(root, proc_cgroup).usage;
+}
+
+memory_size_type total_memory() noexcept {
+    const auto phys  = physical_memory();
+    const auto limit = cgroup_memory().limit;
+    return limit ? std::min(phys, *limit) : phys;
+}
+
+memory_size_type available_memory() noexcept {
+    std::string contents;
+    memory_size_type avail = 0;
+    if(read_file("/proc/meminfo", contents)) {
+        auto value = parse_proc_entry(contents, "MemAvailable");
+        if(!value) value = parse_proc_entry(contents, "MemFree");
+        avail = value.value_or(0);
+    }
+    const auto [limit, usage] = cgroup_memory();
+    if(limit) {
+        const auto used     = usage.value_or(0);
+        const auto headroom = used < *limit ? *limit - used : 0;
+        avail               = std::min(avail, headroom);
+    }
+    return avail;
+}
+
+memory_size_type process_resident_memory() noexcept {
+    return read_proc_entry("/proc/self/status", "VmRSS").value_or(0);
+}
+
+memory_size_type process_peak_memory() noexcept {
+    return read_proc_entry("/proc/self/status", "VmHWM").value_or(0);
+}
+
+} // namespace parallelzone::hardware::detail_
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+
+/** @file memory_info.hpp
+ *
+ *  Functions for querying the operating system about memory. The functions
+ *  read small pseudo-files (/proc/meminfo, /proc/self/status, and the cgroup
+ *  memory controller) and are cheap enough to call whenever an up-to-date
+ *  value is needed; the process's cgroup is only looked up once. Paths are parameters so that tests can use fake files.
+ */
+
+namespace parallelzone::hardware::detail_ {
+
+/// Unsigned type used for sizes (in bytes)
+using memory_size_type = std::size_t;
+
+/** @brief Finds a "Key: value kB" entry in the contents of a proc file.
+ *
+ *  This is the format of /proc/meminfo and /proc/self/status.
+ *
+ *  @param[in] contents The contents of the file.
+ *  @param[in] key      The key to look for, without the trailing colon.
+ *
+ *  @return The value converted to bytes, or std::nullopt if @p key is not
+ *          present.
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<memory_size_type> parse_proc_entry(const std::string& contents,
+                                                 const std::string& key) noexcept;
+
+/** @brief Reads a "Key: value kB" entry from a proc file.
+ *
+ *  @param[in] path The file to read (e.g., /proc/meminfo).
+ *  @param[in] key  The key to look for, without the trailing colon.
+ *
+ *  @return The value in bytes, or std::nullopt if the file can not be read
+ *          or does not contain @p key.
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<memory_size_type> read_proc_entry(const std::string& path,
+                                                const std::string& key) noexcept;
+
+/** @brief The amount of physical memory installed in the node.
+ *
+ *  @return sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE), or the
+ *          MemTotal entry of /proc/meminfo if sysconf fails (0 if both fail).
+ *
+ *  @throw None No throw guarantee.
+ */
+memory_size_type physical_memory() noexcept;
+
+/** @brief Finds the cgroup of the current process in /proc/self/cgroup.
+ *
+ *  Each line of the file is "hierarchy-id:controllers:path". The cgroup v2
+ *  hierarchy is the line "0::path", a cgroup v1 hierarchy is the line whose
+ *  comma-separated controllers include the requested one.
+ *
+ *  @param[in] contents The contents of /proc/self/cgroup.
+ *  @param[in] controller The v1 controller to look for (e.g., "memory"), or
+ *                        the empty string for the v2 hierarchy.
+ *
+ *  @return The path of the cgroup relative to the mount point of the
+ *          hierarchy (e.g., "/slurm/uid_1000/job_42"), or std::nullopt if
+ *          there is no such line.
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<std::string> parse_proc_cgroup(
+  const std::string& contents, const std::string& controller) noexcept;
+
+/// The limit and usage of the cgroup whose memory limit is the tightest
+struct CgroupLevel {
+    /// The limit in bytes, std::nullopt if there is none
+    std::optional<memory_size_type> limit;
+    /// The memory charged to the cgroup, std::nullopt if it can't be read
+    std::optional<memory_size_type> usage;
+};
+
+/** @brief The memory limit and usage of the current process's cgroup.
+ *
+ *  The process's cgroup is found in @p proc_cgroup and looked up under
+ *  @p root, for cgroup v2 (`memory.max`, `memory.current`) and, if there is
+ *  no v2 memory controller, for v1 (`memory/<path>/memory.limit_in_bytes`,
+ *  `memory/<path>/memory.usage_in_bytes`). Since the limits of the parents of
+ *  a cgroup also apply to it, the parents are checked too and the cgroup
+ *  with the tightest limit wins; its usage is returned with the limit, so
+ *  the difference of the two is the head room left. If no cgroup has a limit
+ *  the usage is that of the process's own cgroup. If the cgroup's directory
+ *  does not exist under @p root (e.g., a container which only sees its own
+ *  cgroup, mounted at @p root) the walk starts at the closest existing
+ *  parent.
+ *
+ *  @param[in] root Where the cgroup filesystem is mounted.
+ *  @param[in] proc_cgroup The file listing the cgroups of the process.
+ *
+ *  @return The limit and usage in bytes. Either is std::nullopt if it can not
+ *          be determined (or, for the limit, if there is none).
+ *
+ *  @throw None No throw guarantee.
+ */
+CgroupLevel cgroup_memory(
+  const std::string& root,
+  const std::string& proc_cgroup = "/proc/self/cgroup") noexcept;
+
+/** @brief cgroup_memory for the real cgroup filesystem, resolved once.
+ *
+ *  The first call finds the cgroup with the tightest limit (reading
+ *  /proc/self/cgroup and walking the hierarchy under /sys/fs/cgroup) and
+ *  remembers its directory. Every call, including the first, then reads the
+ *  current limit and usage of that directory, i.e., two small files. Moving
+ *  the process to another cgroup, or changing which of its cgroups has the
+ *  tightest limit, after the first call is not noticed.
+ *
+ *  @return The limit and usage in bytes, as for cgroup_memory(root,
+ *          proc_cgroup).
+ *
+ *  @throw None No throw guarantee.
+ */
+CgroupLevel cgroup_memory() noexcept;
+
+/** @brief The memory limit of the current process's cgroup.
+ *
+ *  This is the limit of cgroup_memory(@p root, @p proc_cgroup).
+ *
+ *  @param[in] root Where the cgroup filesystem is mounted.
+ *  @param[in] proc_cgroup The file listing the cgroups of the process.
+ *
+ *  @return The limit in bytes, or std::nullopt if there is no limit (or it
+ *          can not be determined).
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<memory_size_type> cgroup_limit(
+  const std::string& root        = "/sys/fs/cgroup",
+  const std::string& proc_cgroup = "/proc/self/cgroup") noexcept;
+
+/** @brief The memory currently charged to the current process's cgroup.
+ *
+ *  This is the usage of cgroup_memory(@p root, @p proc_cgroup). Use
+ *  cgroup_memory when both the limit and the usage are needed, it finds the
+ *  cgroup once.
+ *
+ *  @param[in] root Where the cgroup filesystem is mounted.
+ *  @param[in] proc_cgroup The file listing the cgroups of the process.
+ *
+ *  @return The usage in bytes, or std::nullopt if it can not be determined.
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<memory_size_type> cgroup_usage(
+  const std::string& root        = "/sys/fs/cgroup",
+  const std::string& proc_cgroup = "/proc/self/cgroup") noexcept;
+
+/** @brief The memory usable by the current process.
+ *
+ *  This is the smaller of physical_memory() and the limit of
+ *  cgroup_memory().
+ *
+ *  @throw None No throw guarantee.
+ */
+memory_size_type total_memory() noexcept;
+
+/** @brief The memory which can still be allocated without swapping.
+ *
+ *  This is MemAvailable from /proc/meminfo (MemFree if MemAvailable is not
+ *  reported), further limited by the head room left in the process's cgroup
+ *  (the limit minus the usage of cgroup_memory()).
+ *  The value is for the whole node (or cgroup), i.e., it is shared by all
+ *  processes on the node.
+ *
+ *  @throw None No throw guarantee.
+ */
+memory_size_type available_memory() noexcept;
+
+/** @brief The resident set size of the current process (VmRSS).
+ *
+ *  @throw None No throw guarantee.
+ */
+memory_size_type process_resident_memory() noexcept;
+
+/** @brief The peak resident set size of the current process (VmHWM).
+ *
+ *  @throw None No throw guarantee.
+ */
+memory_size_type process_peak_memory() noexcept;
+
+} // namespace parallelzone::hardware::detail_
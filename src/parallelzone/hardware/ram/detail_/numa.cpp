@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../cpu/detail_/cpu_pimpl.hpp"
+#include "memory_info.hpp"
+#include "numa.hpp"
+#include <fstream>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace parallelzone::hardware::detail_ {
+namespace {
+
+// Bits in the masks we pass to the kernel (the kernel wants maxnode + 1)
+constexpr unsigned long mask_bits = 8 * sizeof(numa_mask_type);
+
+// Flags for get_mempolicy: return the node of the page at the address
+constexpr unsigned long mpol_f_node = 1;
+constexpr unsigned long mpol_f_addr = 2;
+
+} // namespace
+
+numa_node_container online_numa_nodes(const std::string& root) {
+    std::ifstream file(root + "/online");
+    std::string line;
+    numa_node_container nodes;
+    if(std::getline(file, line)) {
+        try {
+            nodes = parse_cpu_list(line);
+        } catch(const std::runtime_error&) { nodes.clear(); }
+    }
+    if(nodes.empty()) nodes.push_back(0);
+    return nodes;
+}
+
+std::optional<numa_size_type> numa_node_memory(
+  numa_size_type node, const std::string& root) noexcept {
+    const auto id = std::to_string(node);
+    return read_proc_entry(root + "/node" + id + "/meminfo",
+                           "Node " + id + " MemTotal");
+}
+
+bool numa_bind_memory(void* p, numa_size_type n_bytes, numa_mode mode,
+                      numa_mask_type mask) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long m = mask;
+    auto* pmask     = mask ? &m : nullptr;
+    return syscall(SYS_mbind, p, n_bytes, int(mode), pmask,
+                   mask ? mask_bits + 1 : 0, 0u) == 0;
+#else
+    return false;
+#endif
+}
+
+bool numa_set_thread_policy(numa_mode mode, numa_mask_type mask) noexcept {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    unsigned long m = mask;
+    auto* pmask     = mask ? &m : nullptr;
+    return syscall(SYS_set_mempolicy, int(mode), pmask,
+                   mask ? mask_bits + 1 : 0) == 0;
+#else
+    return false;
+#endif
+}
+
+std::optional<numa_size_type> numa_node_of_address(const void* p) noexcept {
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    int node = -1;
+    auto rv  = syscall(SYS_get_mempolicy, &node, nullptr, 0ul, p,
+                       mpol_f_node | mpol_f_addr);
+    if(rv == 0 && node >= 0) return numa_size_type(node);
+#endif
+    return std::nullopt;
+}
+
+numa_mask_type numa_make_mask(const numa_node_container& nodes) noexcept {
+    numa_mask_type mask = 0;
+    for(auto node : nodes)
+        if(node < mask_bits) mask |= numa_mask_type(1) << node;
+    return mask;
+}
+
+} // namespace parallelzone::hardware::detail_
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/** @file numa.hpp
+ *
+ *  Thin wrappers around the Linux NUMA system calls and the sysfs files
+ *  describing the NUMA nodes. The system calls are made with syscall(2) so
+ *  that libnuma is not needed. On other platforms (or kernels without NUMA
+ *  support) the wrappers fail gracefully.
+ */
+
+namespace parallelzone::hardware::detail_ {
+
+/// Unsigned type used for node ids and sizes
+using numa_size_type = std::size_t;
+
+/// Type of a set of NUMA node ids
+using numa_node_container = std::vector<numa_size_type>;
+
+/// Type of a bit mask of NUMA nodes (bit i is node i)
+using numa_mask_type = std::uint64_t;
+
+/// The memory policy modes understood by the kernel (see set_mempolicy(2))
+enum class numa_mode : int {
+    default_   = 0,
+    preferred  = 1,
+    bind       = 2,
+    interleave = 3
+};
+
+/** @brief The NUMA nodes with memory which are online.
+ *
+ *  @param[in] root The sysfs directory describing the nodes.
+ *
+ *  @return The ids of the online nodes, in increasing order. If the nodes
+ *          can not be determined (e.g., the kernel lacks NUMA support), {0}
+ *          is returned.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the result. Strong
+ *                        throw guarantee.
+ */
+numa_node_container online_numa_nodes(
+  const std::string& root = "/sys/devices/system/node");
+
+/** @brief The memory installed on NUMA node @p node.
+ *
+ *  @param[in] node The id of the node.
+ *  @param[in] root The sysfs directory describing the nodes.
+ *
+ *  @return The size of the node's memory in bytes, or std::nullopt if it can
+ *          not be determined.
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<numa_size_type> numa_node_memory(
+  numa_size_type node,
+  const std::string& root = "/sys/devices/system/node") noexcept;
+
+/** @brief Wraps mbind(2) for the pages in [p, p + n_bytes).
+ *
+ *  @return True if the kernel accepted the policy.
+ *
+ *  @throw None No throw guarantee.
+ */
+bool numa_bind_memory(void* p, numa_size_type n_bytes, numa_mode mode,
+                      numa_mask_type mask) noexcept;
+
+/** @brief Wraps set_mempolicy(2) for the calling thread.
+ *
+ *  @return True if the kernel accepted the policy.
+ *
+ *  @throw None No throw guarantee.
+ */
+bool numa_set_thread_policy(numa_mode mode, numa_mask_type mask) noexcept;
+
+/** @brief Wraps get_mempolicy(2) to find the node holding the page at @p p.
+ *
+ *  If the page has not been touched yet, the kernel faults it in (placing it
+ *  according to the policy in effect).
+ *
+ *  @return The node id, or std::nullopt if the kernel can not tell.
+ *
+ *  @throw None No throw guarantee.
+ */
+std::optional<numa_size_type> numa_node_of_address(const void* p) noexcept;
+
+/** @brief Converts a set of node ids into a mask.
+ *
+ *  @return The mask. Ids of max_nodes or more are ignored.
+ *
+ *  @throw None No throw guarantee.
+ */
+numa_mask_type numa_make_mask(const numa_node_container& nodes) noexcept;
+
+} // namespace parallelzone::hardware::detail_
@@ -33,11 +33,16 @@ struct RAMPIMPL {
     /// Type of the communicator in this PIMPL
     using comm_type = mpi_helpers::CommPP;
 
+    /// Type of a pointer to the allocation tracker
+    using tracker_pointer = std::shared_ptr<parent_type::tracker_type>;
+
     /** @brief Makes a new PIMPL given the size of the managed RAM, the rank
-     *         who owns the RAM, and the MPI communicator.
+     *         who owns the RAM, the MPI communicator, and the node the RAM is
+     *         on.
      *
      */
-    RAMPIMPL(size_type size, size_type my_rank, comm_type comm);
+    RAMPIMPL(size_type size, size_type my_rank, comm_type comm,
+             size_type node = 0);
 
     pimpl_pointer clone() const { return std::make_unique<RAMPIMPL>(*this); }
 
@@ -49,6 +54,12 @@ struct RAMPIMPL {
 
     /// The MPI communicator to communicate with this RAM
     comm_type m_mpi_comm;
+
+    /// Index of the node (of m_mpi_comm) the RAM is on
+    size_type m_node;
+
+    /// Tracks allocations made through this RAM (shared by copies)
+    tracker_pointer m_tracker;
 };
 
 /** @brief Wraps the process of making a RAM instance by calling RAMPIMPL's
@@ -59,16 +70,23 @@ struct RAMPIMPL {
  *  @brief size How much memory does the instance actually have?
  *  @brief rank Which MPI rank owns the RAM (rank one @p mpi_comm)
  *  @brief mpi_comm The MPI communicator to use for communicating.
+ *  @brief node The node the RAM is on. RAM on different nodes is never the
+ *              same RAM.
  *
  *  @return A RAM instance initialized from the provided state.
  */
 inline auto make_ram(RAMPIMPL::size_type size, RAMPIMPL::size_type rank,
-                     RAMPIMPL::comm_type comm) {
-    auto pram = std::make_unique<RAMPIMPL>(size, rank, std::move(comm));
+                     RAMPIMPL::comm_type comm, RAMPIMPL::size_type node = 0) {
+    auto pram = std::make_unique<RAMPIMPL>(size, rank, std::move(comm), node);
     return RAM(std::move(pram));
 }
 
-inline RAMPIMPL::RAMPIMPL(size_type size, size_type rank, comm_type comm) :
-  m_size(size), m_rank(rank), m_mpi_comm(comm) {}
+inline RAMPIMPL::RAMPIMPL(size_type size, size_type rank, comm_type comm,
+                          size_type node) :
+  m_size(size),
+  m_rank(rank),
+  m_mpi_comm(comm),
+  m_node(node),
+  m_tracker(std::make_shared<parent_type::tracker_type>()) {}
 
 } // namespace parallelzone::hardware::detail_
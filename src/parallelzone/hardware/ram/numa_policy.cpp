@@ -0,0 +1,144 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detail_/numa.hpp"
+#include <parallelzone/hardware/ram/numa_policy.hpp>
+#include <stdexcept>
+#include <string>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace parallelzone::hardware {
+namespace {
+
+// The nodes online now. They don't change while we run, so read them once.
+const detail_::numa_node_container& online_nodes() {
+    static const auto nodes = detail_::online_numa_nodes();
+    return nodes;
+}
+
+// Rounds n_bytes up to a whole number of pages
+NUMAPolicy::size_type round_to_pages(NUMAPolicy::size_type n_bytes) noexcept {
+    const auto page = NUMAPolicy::page_size();
+    return (n_bytes + page - 1) / page * page;
+}
+
+} // namespace
+
+NUMAPolicy NUMAPolicy::interleave() noexcept {
+    return NUMAPolicy(kind_type::interleave, 0);
+}
+
+NUMAPolicy NUMAPolicy::interleave(const node_container& nodes) {
+    return NUMAPolicy(kind_type::interleave, make_mask_(nodes));
+}
+
+NUMAPolicy NUMAPolicy::bind(size_type node) {
+    return bind(node_container{node});
+}
+
+NUMAPolicy NUMAPolicy::bind(const node_container& nodes) {
+    return NUMAPolicy(kind_type::bind, make_mask_(nodes));
+}
+
+NUMAPolicy::node_container NUMAPolicy::nodes() const {
+    node_container rv;
+    for(size_type i = 0; i < max_nodes; ++i)
+        if(m_mask_ & (mask_type(1) << i)) rv.push_back(i);
+    return rv;
+}
+
+bool NUMAPolicy::apply_to_thread() const noexcept {
+    using detail_::numa_mode;
+    if(!multi_node_()) return false;
+    switch(m_kind_) {
+        case kind_type::interleave:
+            return detail_::numa_set_thread_policy(
+              numa_mode::interleave,
+              m_mask_ ? m_mask_ : detail_::numa_make_mask(online_nodes()));
+        case kind_type::bind:
+            return detail_::numa_set_thread_policy(numa_mode::bind, m_mask_);
+        default:
+            return detail_::numa_set_thread_policy(numa_mode::default_, 0);
+    }
+}
+
+NUMAPolicy::size_type NUMAPolicy::page_size() noexcept {
+#ifdef __linux__
+    static const size_type size = [] {
+        const auto rv = sysconf(_SC_PAGESIZE);
+        return rv > 0 ? size_type(rv) : size_type(4096);
+    }();
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+NUMAPolicy::mask_type NUMAPolicy::make_mask_(const node_container& nodes) {
+    if(nodes.empty())
+        throw std::runtime_error("A NUMA policy needs at least one node");
+    for(auto node : nodes)
+        if(node >= max_nodes)
+            throw std::out_of_range("NUMA node " + std::to_string(node) +
+                                    " is not less than " +
+                                    std::to_string(max_nodes));
+    return detail_::numa_make_mask(nodes);
+}
+
+bool NUMAPolicy::multi_node_() noexcept {
+    try {
+        return online_nodes().size() > 1;
+    } catch(...) { return false; }
+}
+
+void* NUMAPolicy::map_(size_type n_bytes) const {
+#ifdef __linux__
+    const auto length = round_to_pages(n_bytes);
+    void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED) throw std::bad_alloc();
+
+    // Only called on multi node machines (see is_placed). Failure to place is
+    // not an error, the memory is still usable.
+    using detail_::numa_mode;
+    if(m_kind_ == kind_type::bind)
+        detail_::numa_bind_memory(p, length, numa_mode::bind, m_mask_);
+    else
+        detail_::numa_bind_memory(
+          p, length, numa_mode::interleave,
+          m_mask_ ? m_mask_ : detail_::numa_make_mask(online_nodes()));
+    return p;
+#else
+    return ::operator new(n_bytes);
+#endif
+}
+
+void NUMAPolicy::unmap_(void* p, size_type n_bytes) noexcept {
+#ifdef __linux__
+    munmap(p, round_to_pages(n_bytes));
+#else
+    ::operator delete(p);
+#endif
+}
+
+} // namespace parallelzone::hardware
@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "detail_/memory_info.hpp"
+#include "detail_/numa.hpp"
 #include "detail_/ram_pimpl.hpp"
+#include <algorithm>
 #include <stdexcept>
 
 namespace parallelzone::hardware {
@@ -48,6 +51,65 @@ RAM::size_type RAM::total_space() const noexcept {
     return !empty() ? m_pimpl_->m_size : 0;
 }
 
+RAM::size_type RAM::node() const noexcept {
+    return !empty() ? m_pimpl_->m_node : 0;
+}
+
+RAM::size_type RAM::free_space() const {
+    if(empty()) return 0;
+    assert_local_();
+    return std::min(detail_::available_memory(), total_space());
+}
+
+RAM::size_type RAM::used_space() const {
+    if(empty()) return 0;
+    assert_local_();
+    return detail_::process_resident_memory();
+}
+
+RAM::size_type RAM::high_water_mark() const {
+    if(empty()) return 0;
+    assert_local_();
+    return detail_::process_peak_memory();
+}
+
+// -----------------------------------------------------------------------------
+// -- NUMA topology
+// -----------------------------------------------------------------------------
+
+RAM::numa_node_container RAM::numa_nodes() const {
+    if(empty()) return {};
+    assert_local_();
+    return detail_::online_numa_nodes();
+}
+
+RAM::size_type RAM::numa_node_space(size_type node) const {
+    assert_non_empty_local_();
+    const auto nodes = detail_::online_numa_nodes();
+    if(!std::binary_search(nodes.begin(), nodes.end(), node))
+        throw std::out_of_range(std::to_string(node) +
+                                " is not an online NUMA node");
+    if(auto size = detail_::numa_node_memory(node)) return *size;
+    if(nodes.size() == 1) return total_space();
+    return 0;
+}
+
+std::optional<RAM::size_type> RAM::numa_node_of(const void* p) const {
+    assert_non_empty_local_();
+    return detail_::numa_node_of_address(p);
+}
+
+// -----------------------------------------------------------------------------
+// -- Allocation tracking
+// -----------------------------------------------------------------------------
+
+RAM::tracker_reference RAM::tracker() const { return *tracker_pointer_(); }
+
+RAM::buffer_pool_reference RAM::buffer_pool() const {
+    assert_non_empty_local_();
+    return buffer_pool_type::default_pool();
+}
+
 // -----------------------------------------------------------------------------
 // -- Utility methods
 // -----------------------------------------------------------------------------
@@ -66,6 +128,7 @@ bool RAM::operator==(const RAM& rhs) const noexcept {
     // If both are empty return early
     if(empty()) return true;
 
+    if(m_pimpl_->m_node != rhs.m_pimpl_->m_node) return false;
     return m_pimpl_->m_size == rhs.m_pimpl_->m_size;
 }
 
@@ -91,4 +154,23 @@ void RAM::assert_pimpl_() const {
                              "constructed or moved from?");
 }
 
+std::shared_ptr<RAM::tracker_type> RAM::tracker_pointer_() const {
+    if(!empty()) return m_pimpl_->m_tracker;
+    throw std::runtime_error("The current RAM instance is empty and can not "
+                             "track allocations");
+}
+
+void RAM::assert_local_() const {
+    assert_pimpl_();
+    if(size_type(comm_().me()) == my_rank_()) return;
+    throw std::runtime_error("Memory usage can only be queried for the RAM "
+                             "of the current process");
+}
+
+void RAM::assert_non_empty_local_() const {
+    if(empty())
+        throw std::runtime_error("The current RAM instance is empty");
+    assert_local_();
+}
+
 } // namespace parallelzone::hardware
@@ -0,0 +1,263 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "detail_/binary/binary_format.hpp"
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <parallelzone/logging/binary_log.hpp>
+#include <parallelzone/logging/detail_/packed_args.hpp>
+#include <parallelzone/logging/logger.hpp>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+namespace parallelzone {
+namespace {
+
+namespace binary_format = detail_::binary_format;
+using detail_::PackedArgs;
+using record_kind = binary_format::record_kind;
+
+/// A record read back from a binary log
+struct Record {
+    std::int64_t m_time      = 0;
+    std::uint8_t m_severity  = 0;
+    bool m_structured        = false;
+    std::uint32_t m_template = 0; // Only used if m_structured
+    std::string m_payload;        // The message, or the packed arguments
+};
+
+/// Reads the records of one binary log, one at a time
+class Reader {
+public:
+    explicit Reader(const std::string& file_name) :
+      m_file_name_(file_name), m_file_(file_name, std::ios::binary) {
+        if(!m_file_) error_("could not be opened");
+
+        char magic[sizeof(binary_format::magic)];
+        std::uint32_t version = 0;
+        if(!read_(magic) || !read_(version) || !read_(m_rank_) ||
+           !std::equal(magic, magic + sizeof(magic), binary_format::magic))
+            error_("is not a binary ParallelZone log");
+        if(version != binary_format::version)
+            error_("has unsupported version " + std::to_string(version));
+    }
+
+    /// Reads the next message into record, false if there are no more
+    bool next(Record& record) {
+        while(true) {
+            std::uint8_t kind;
+            if(!read_(kind)) return false;
+            switch(record_kind(kind)) {
+                case(record_kind::template_definition): {
+                    std::uint32_t id;
+                    std::string value;
+                    if(!read_(id) || !read_string_(value)) return false;
+                    if(id != m_templates_.size())
+                        error_("defines template ids out of order");
+                    m_templates_.push_back(std::move(value));
+                    break;
+                }
+                case(record_kind::structured): {
+                    record.m_structured = true;
+                    if(!read_(record.m_time) || !read_(record.m_severity) ||
+                       !read_(record.m_template) ||
+                       !read_string_(record.m_payload))
+                        return false;
+                    if(record.m_template >= m_templates_.size())
+                        error_("uses an undefined template");
+                    return true;
+                }
+                case(record_kind::text): {
+                    record.m_structured = false;
+                    return read_(record.m_time) && read_(record.m_severity) &&
+                           read_string_(record.m_payload);
+                }
+                default: error_("is corrupted");
+            }
+        }
+    }
+
+    /// The rank which wrote the file
+    std::uint64_t rank() const noexcept { return m_rank_; }
+
+    /// The template with id @p id
+    const std::string& get_template(std::uint32_t id) const {
+        return m_templates_[id];
+    }
+
+private:
+    template<typename T>
+    bool read_(T& value) {
+        m_file_.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return bool(m_file_);
+    }
+
+    bool read_string_(std::string& value) {
+        std::uint32_t n;
+        if(!read_(n)) return false;
+        value.resize(n);
+        m_file_.read(value.data(), n);
+        return bool(m_file_);
+    }
+
+    [[noreturn]] void error_(const std::string& what) const {
+        throw std::runtime_error("The file " + m_file_name_ + " " + what);
+    }
+
+    std::string m_file_name_;
+    std::ifstream m_file_;
+    std::uint64_t m_rank_ = 0;
+    std::vector<std::string> m_templates_;
+};
+
+/// The name of severity @p s, as spdlog prints it
+const char* severity_name(std::uint8_t s) {
+    constexpr const char* names[] = {"trace", "debug", "info",
+                                     "warning", "error", "critical"};
+    return s < std::size(names) ? names[s] : "unknown";
+}
+
+/// Prints @p value as a JSON string
+void print_json_string(std::ostream& os, std::string_view value) {
+    os << '"';
+    for(const char c : value) {
+        switch(c) {
+            case('"'): os << "\\\""; break;
+            case('\\'): os << "\\\\"; break;
+            case('\n'): os << "\\n"; break;
+            case('\r'): os << "\\r"; break;
+            case('\t'): os << "\\t"; break;
+            default: {
+                if(static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[7];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    os << buffer;
+                } else {
+                    os << c;
+                }
+            }
+        }
+    }
+    os << '"';
+}
+
+/// Prints one packed argument as a JSON value
+struct JSONArgPrinter {
+    void operator()(bool value) const { m_os << (value ? "true" : "false"); }
+    void operator()(char value) const {
+        print_json_string(m_os, std::string_view(&value, 1));
+    }
+    void operator()(std::string_view value) const {
+        print_json_string(m_os, value);
+    }
+    void operator()(double value) const {
+        if(!std::isfinite(value)) {
+            m_os << "null";
+            return;
+        }
+        const auto precision = m_os.precision(17);
+        m_os << value;
+        m_os.precision(precision);
+    }
+    template<typename T>
+    void operator()(T value) const {
+        m_os << value;
+    }
+
+    std::ostream& m_os;
+};
+
+/// Prints @p time (nanoseconds since the epoch) as a UTC date and time
+void print_time(std::ostream& os, std::int64_t time) {
+    const std::time_t seconds = time / 1000000000;
+    const auto nanoseconds    = time % 1000000000;
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    os << std::put_time(&utc, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(9)
+       << std::setfill('0') << nanoseconds << std::setfill(' ');
+}
+
+void print_record(std::ostream& os, const Reader& reader,
+                  const Record& record, binary_log_format how) {
+    const auto* args_begin =
+      reinterpret_cast<const std::byte*>(record.m_payload.data());
+    const auto* args_end = args_begin + record.m_payload.size();
+
+    std::string msg;
+    if(record.m_structured) {
+        const auto& fmt = reader.get_template(record.m_template);
+        msg             = PackedArgs::format(fmt, args_begin, args_end);
+    }
+    const auto& message = record.m_structured ? msg : record.m_payload;
+
+    if(how == binary_log_format::text) {
+        os << '[';
+        print_time(os, record.m_time);
+        os << "] [Rank " << reader.rank() << "] ["
+           << severity_name(record.m_severity) << "] " << message << '\n';
+        return;
+    }
+
+    os << "{\"time_ns\":" << record.m_time << ",\"rank\":" << reader.rank()
+       << ",\"severity\":\"" << severity_name(record.m_severity)
+       << "\",\"message\":";
+    print_json_string(os, message);
+    if(record.m_structured) {
+        os << ",\"template\":";
+        print_json_string(os, reader.get_template(record.m_template));
+        os << ",\"args\":[";
+        bool first = true;
+        JSONArgPrinter printer{os};
+        PackedArgs::visit(args_begin, args_end, [&](const auto& value) {
+            if(!first) os << ',';
+            first = false;
+            printer(value);
+        });
+        os << ']';
+    }
+    os << "}\n";
+}
+
+} // namespace
+
+void decode_binary_logs(const std::vector<std::string>& files,
+                        std::ostream& os, binary_log_format format) {
+    std::vector<std::unique_ptr<Reader>> readers;
+    std::vector<Record> heads(files.size());
+    for(const auto& file : files)
+        readers.push_back(std::make_unique<Reader>(file));
+
+    // Min-heap of (time stamp, file index) for the next record of each file
+    using entry_type = std::pair<std::int64_t, std::size_t>;
+    std::priority_queue<entry_type, std::vector<entry_type>,
+                        std::greater<entry_type>>
+      queue;
+    for(std::size_t i = 0; i < readers.size(); ++i)
+        if(readers[i]->next(heads[i])) queue.emplace(heads[i].m_time, i);
+
+    while(!queue.empty()) {
+        const auto i = queue.top().second;
+        queue.pop();
+        print_record(os, *readers[i], heads[i], format);
+        if(readers[i]->next(heads[i])) queue.emplace(heads[i].m_time, i);
+    }
+}
+
+} // namespace parallelzone
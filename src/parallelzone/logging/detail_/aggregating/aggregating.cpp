@@ -0,0 +1,105 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "aggregating.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace parallelzone::detail_ {
+
+AggregatingLoggerPIMPL::AggregatingLoggerPIMPL(comm_type comm, pimpl_ptr sink,
+                                               rank_type root) {
+    if(root < 0 || root >= comm.size())
+        throw std::out_of_range("Root rank " + std::to_string(root) +
+                                " is not in the communicator");
+    // Only the root writes
+    if(comm.me() != root) sink.reset();
+    if(sink) sink->set_severity(severity_type::trace);
+    m_state_ =
+      std::make_shared<shared_state>(std::move(comm), std::move(sink), root);
+}
+
+std::size_t AggregatingLoggerPIMPL::n_buffered() const {
+    std::lock_guard<std::mutex> lock(m_state_->m_mutex);
+    return m_state_->m_buffer.size();
+}
+
+AggregatingLoggerPIMPL::pimpl_ptr AggregatingLoggerPIMPL::clone_() const {
+    using self_type = AggregatingLoggerPIMPL;
+    return std::unique_ptr<self_type>(new self_type(*this));
+}
+
+void AggregatingLoggerPIMPL::set_severity_(severity_type severity) {
+    m_severity_ = severity;
+}
+
+bool AggregatingLoggerPIMPL::should_log_(
+  severity_type severity) const noexcept {
+    return severity >= m_severity_;
+}
+
+void AggregatingLoggerPIMPL::log_(severity_type severity,
+                                  const_string_reference msg) {
+    if(!should_log_(severity)) return;
+    using namespace std::chrono;
+    const auto now = system_clock::now().time_since_epoch();
+    record_type record{duration_cast<nanoseconds>(now).count(), severity, msg};
+
+    std::lock_guard<std::mutex> lock(m_state_->m_mutex);
+    m_state_->m_buffer.push_back(std::move(record));
+}
+
+void AggregatingLoggerPIMPL::flush_() {
+    auto& state = *m_state_;
+
+    buffer_type local;
+    {
+        std::lock_guard<std::mutex> lock(state.m_mutex);
+        local.swap(state.m_buffer);
+    }
+
+    auto gathered = state.m_comm.gatherv(std::move(local), state.m_root);
+    if(!gathered.has_value()) return; // Not the root
+
+    // Merge the buffers, recording the rank of each record
+    std::vector<std::pair<rank_type, record_type>> records;
+    for(rank_type r = 0; r < rank_type(gathered->size()); ++r)
+        for(auto& record : (*gathered)[r])
+            records.emplace_back(r, std::move(record));
+
+    // Stable, so records with the same time stamp stay in rank order
+    std::stable_sort(records.begin(), records.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                         return lhs.second.m_time < rhs.second.m_time;
+                     });
+
+    if(!state.m_sink) return;
+    for(const auto& [r, record] : records) {
+        const auto tag = "[Rank " + std::to_string(r) + "] ";
+        state.m_sink->log(record.m_severity, tag + record.m_msg);
+    }
+    state.m_sink->flush();
+}
+
+bool AggregatingLoggerPIMPL::are_equal_(
+  const LoggerPIMPL& other) const noexcept {
+    auto p = dynamic_cast<const AggregatingLoggerPIMPL*>(&other);
+    if(p == nullptr) return false;
+    return m_state_ == p->m_state_;
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../logger_pimpl.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <vector>
+
+namespace parallelzone::detail_ {
+
+/** @brief A message buffered by an AggregatingLoggerPIMPL.
+ *
+ *  Records are sent to the root rank as part of a CommPP::gatherv, hence they
+ *  are serializable.
+ */
+struct LogRecord {
+    /// Ultimately a typedef of Logger::severity
+    using severity_type = Logger::severity;
+
+    /// Ultimately a typedef of Logger::string_type
+    using string_type = Logger::string_type;
+
+    /// When the message was logged, in nanoseconds since the system epoch
+    std::int64_t m_time = 0;
+
+    /// The severity of the message
+    severity_type m_severity = severity_type::info;
+
+    /// The message
+    string_type m_msg;
+
+    /// Serializes or deserializes *this with @p ar
+    template<typename Archive>
+    void serialize(Archive& ar) {
+        ar(m_time, m_severity, m_msg);
+    }
+};
+
+/** @brief Buffers messages locally and writes them from the root rank.
+ *
+ *  Logging to *this only time stamps the message and appends it to a buffer
+ *  local to the rank. Flushing *this is collective: every rank of the
+ *  communicator sends its buffer to the root rank with CommPP::gatherv, and
+ *  the root writes the records of all ranks to its sink, ordered by time
+ *  stamp and prefixed by "[Rank r] ". Only the root writes, so the ranks do
+ *  not compete for the sink.
+ *
+ *  Copies of *this share the buffer, but have their own threshold.
+ */
+class AggregatingLoggerPIMPL : public LoggerPIMPL {
+public:
+    /// Type of the communicator records are gathered over
+    using comm_type = mpi_helpers::CommPP;
+
+    /// Ultimately a typedef of CommPP::size_type
+    using rank_type = comm_type::size_type;
+
+    /// Type of a buffered message
+    using record_type = LogRecord;
+
+    /// Type of a rank's buffer
+    using buffer_type = std::vector<record_type>;
+
+    /** @brief Creates a logger which aggregates messages on @p root.
+     *
+     *  The threshold of *this is severity::info. Since *this does the
+     *  filtering, the threshold of @p sink is set to severity::trace.
+     *
+     *  @param[in] comm The ranks whose messages are aggregated. Every rank
+     *                  of @p comm must make an AggregatingLoggerPIMPL with
+     *                  the same @p root.
+     *  @param[in] sink Where the root writes the messages. Only used on the
+     *                  root, and may be null (in which case the root discards
+     *                  the messages).
+     *  @param[in] root The rank which writes the messages.
+     *
+     *  @throw std::out_of_range if @p root is not a rank of @p comm. Strong
+     *                           throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the buffer.
+     *                        Strong throw guarantee.
+     */
+    AggregatingLoggerPIMPL(comm_type comm, pimpl_ptr sink, rank_type root);
+
+    /// The number of messages logged to this rank and not yet flushed
+    std::size_t n_buffered() const;
+
+protected:
+    AggregatingLoggerPIMPL(const AggregatingLoggerPIMPL&) = default;
+    AggregatingLoggerPIMPL& operator=(const AggregatingLoggerPIMPL&) = default;
+    AggregatingLoggerPIMPL(AggregatingLoggerPIMPL&&)                 = default;
+    AggregatingLoggerPIMPL& operator=(AggregatingLoggerPIMPL&&) = default;
+
+    /// Implemented by calling the copy ctor, the copy shares the buffer
+    pimpl_ptr clone_() const override;
+
+    /// Sets the threshold of *this (not of the sink)
+    void set_severity_(severity_type severity) override;
+
+    /// Compares @p severity to the threshold of *this
+    bool should_log_(severity_type severity) const noexcept override;
+
+    /// Time stamps @p msg and buffers it, if it is at least the threshold
+    void log_(severity_type severity, const_string_reference msg) override;
+
+    /// Gathers the buffers on the root, which writes them. Collective.
+    void flush_() override;
+
+    /// Equal if @p other is an AggregatingLoggerPIMPL sharing the buffer
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+private:
+    /// The state shared among copies of *this
+    struct shared_state {
+        shared_state(comm_type comm, pimpl_ptr sink, rank_type root) :
+          m_comm(std::move(comm)), m_sink(std::move(sink)), m_root(root) {}
+
+        /// The ranks whose messages are aggregated
+        comm_type m_comm;
+
+        /// Where the root writes (null on the other ranks)
+        pimpl_ptr m_sink;
+
+        /// The rank which writes
+        rank_type m_root;
+
+        /// Guards m_buffer
+        std::mutex m_mutex;
+
+        /// Messages logged on this rank since the last flush
+        buffer_type m_buffer;
+    };
+
+    /// The minimum severity which is logged
+    severity_type m_severity_ = severity_type::info;
+
+    /// The buffer, communicator, and sink
+    std::shared_ptr<shared_state> m_state_;
+};
+
+} // namespace parallelzone::detail_
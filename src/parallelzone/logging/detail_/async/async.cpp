@@ -0,0 +1,164 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "async.hpp"
+
+namespace parallelzone::detail_ {
+
+// -----------------------------------------------------------------------------
+// -- AsyncBackend
+// -----------------------------------------------------------------------------
+
+AsyncBackend::AsyncBackend(pimpl_ptr sink, size_type queue_size,
+                           policy_type policy) :
+  m_sink_(std::move(sink)), m_policy_(policy), m_queue_(queue_size) {
+    m_thread_ = std::thread([this]() { run_(); });
+}
+
+AsyncBackend::~AsyncBackend() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_stop_ = true;
+    }
+    m_cv_.notify_one();
+    if(m_thread_.joinable()) m_thread_.join();
+}
+
+void AsyncBackend::push(severity_type severity, const_string_reference msg) {
+    record_type record{severity, msg};
+    while(!m_queue_.try_push(record)) {
+        if(m_policy_ == policy_type::drop) {
+            ++m_n_dropped_;
+            return;
+        } else if(m_policy_ == policy_type::overwrite) {
+            record_type oldest;
+            if(m_queue_.try_pop(oldest)) {
+                ++m_n_dropped_;
+                ++m_n_done_;
+            }
+        } else {
+            // Block until the background thread makes room
+            wake_();
+            std::this_thread::yield();
+        }
+    }
+    wake_();
+}
+
+void AsyncBackend::flush() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex_);
+    // Everything which claimed a spot in the queue before now
+    const auto target = m_queue_.n_pushed();
+    if(m_n_flushed_ >= target) return;
+    if(target > m_flush_target_) m_flush_target_ = target;
+    m_cv_.notify_one();
+    m_flushed_cv_.wait(lock, [&]() { return m_n_flushed_ >= target; });
+}
+
+void AsyncBackend::run_() {
+    record_type buffer;
+    while(true) {
+        drain_(buffer);
+
+        std::unique_lock<std::mutex> lock(m_mutex_);
+        if(m_flush_target_ > m_n_flushed_) {
+            const auto n_done = m_n_done_.load();
+            if(n_done < m_flush_target_) {
+                // Records before the target are still being pushed
+                lock.unlock();
+                std::this_thread::yield();
+                continue;
+            }
+            lock.unlock();
+            flush_sink_();
+            lock.lock();
+            m_n_flushed_ = n_done;
+            m_flushed_cv_.notify_all();
+            continue;
+        }
+        if(m_stop_) break;
+
+        m_sleeping_.store(true);
+        m_cv_.wait_for(lock, idle_interval, [this]() {
+            return m_stop_ || m_flush_target_ > m_n_flushed_ ||
+                   !m_queue_.empty();
+        });
+        m_sleeping_.store(false);
+    }
+
+    // Stopping: nobody else holds *this, so nothing else will be queued
+    drain_(buffer);
+    flush_sink_();
+}
+
+void AsyncBackend::drain_(record_type& buffer) noexcept {
+    while(m_queue_.try_pop(buffer)) {
+        try {
+            m_sink_->log(buffer.m_severity, buffer.m_msg);
+        } catch(...) {
+            // There's no one to report the error to, so the record is lost
+        }
+        ++m_n_done_;
+    }
+}
+
+void AsyncBackend::flush_sink_() noexcept {
+    try {
+        m_sink_->flush();
+    } catch(...) {}
+}
+
+void AsyncBackend::wake_() noexcept {
+    if(m_sleeping_.load(std::memory_order_relaxed)) m_cv_.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+// -- AsyncLoggerPIMPL
+// -----------------------------------------------------------------------------
+
+AsyncLoggerPIMPL::AsyncLoggerPIMPL(pimpl_ptr sink, size_type queue_size,
+                                   policy_type policy) {
+    sink->set_severity(severity_type::trace);
+    m_backend_ =
+      std::make_shared<backend_type>(std::move(sink), queue_size, policy);
+}
+
+AsyncLoggerPIMPL::pimpl_ptr AsyncLoggerPIMPL::clone_() const {
+    return std::unique_ptr<AsyncLoggerPIMPL>(new AsyncLoggerPIMPL(*this));
+}
+
+void AsyncLoggerPIMPL::set_severity_(severity_type severity) {
+    m_severity_ = severity;
+}
+
+bool AsyncLoggerPIMPL::should_log_(severity_type severity) const noexcept {
+    return severity >= m_severity_;
+}
+
+void AsyncLoggerPIMPL::log_(severity_type severity,
+                            const_string_reference msg) {
+    if(!should_log_(severity)) return;
+    m_backend_->push(severity, msg);
+}
+
+void AsyncLoggerPIMPL::flush_() { m_backend_->flush(); }
+
+bool AsyncLoggerPIMPL::are_equal_(const LoggerPIMPL& other) const noexcept {
+    auto p = dynamic_cast<const AsyncLoggerPIMPL*>(&other);
+    if(p == nullptr) return false;
+    return m_backend_ == p->m_backend_;
+}
+
+} // namespace parallelzone::detail_
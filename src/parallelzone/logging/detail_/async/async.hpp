@@ -0,0 +1,245 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../logger_pimpl.hpp"
+#include "bounded_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <parallelzone/logging/logger_factory.hpp>
+#include <thread>
+
+namespace parallelzone::detail_ {
+
+/** @brief The queue and thread shared by copies of an AsyncLoggerPIMPL.
+ *
+ *  Producers (the threads logging) place records in a lock-free bounded
+ *  queue. A single background thread takes records off of the queue and
+ *  writes them to the wrapped sink. When the queue is full producers follow
+ *  the overflow policy. The background thread sleeps when there is nothing to
+ *  do; producers only touch the condition variable when the thread is
+ *  sleeping, so the common case of logging is free of locks.
+ */
+class AsyncBackend {
+public:
+    /// Ultimately a typedef of LoggerPIMPL::pimpl_ptr
+    using pimpl_ptr = LoggerPIMPL::pimpl_ptr;
+
+    /// Ultimately a typedef of LoggerPIMPL::severity_type
+    using severity_type = LoggerPIMPL::severity_type;
+
+    /// Ultimately a typedef of LoggerPIMPL::string_type
+    using string_type = LoggerPIMPL::string_type;
+
+    /// Ultimately a typedef of LoggerPIMPL::const_string_reference
+    using const_string_reference = LoggerPIMPL::const_string_reference;
+
+    /// Ultimately a typedef of LoggerFactory::overflow_policy
+    using policy_type = LoggerFactory::overflow_policy;
+
+    /// Unsigned type used for counting
+    using size_type = std::size_t;
+
+    /// A queued message
+    struct record_type {
+        severity_type m_severity = severity_type::info;
+        string_type m_msg;
+    };
+
+    /// Type of the queue of records
+    using queue_type = BoundedQueue<record_type>;
+
+    /// How long the background thread sleeps when it has nothing to do
+    static constexpr std::chrono::milliseconds idle_interval{10};
+
+    /** @brief Starts the background thread which writes to @p sink.
+     *
+     *  @param[in] sink Where the messages are written. Only the background
+     *                  thread logs to @p sink.
+     *  @param[in] queue_size The minimum number of records the queue holds.
+     *  @param[in] policy What to do when the queue is full.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the queue.
+     *                        Strong throw guarantee.
+     *  @throw std::system_error if the thread can not be started. Strong
+     *                           throw guarantee.
+     */
+    AsyncBackend(pimpl_ptr sink, size_type queue_size, policy_type policy);
+
+    /// Not copyable, *this owns a thread
+    AsyncBackend(const AsyncBackend&) = delete;
+
+    /// Not copyable, *this owns a thread
+    AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+    /// Writes the queued records, flushes the sink, and joins the thread
+    ~AsyncBackend() noexcept;
+
+    /** @brief Queues @p msg, following the overflow policy if the queue is
+     *         full.
+     *
+     *  @param[in] severity The severity of the message.
+     *  @param[in] msg The message.
+     *
+     *  @throw std::bad_alloc if there is a problem copying @p msg. Strong
+     *                        throw guarantee.
+     */
+    void push(severity_type severity, const_string_reference msg);
+
+    /** @brief Blocks until every record queued before the call is written
+     *         and the sink has been flushed.
+     *
+     *  Records discarded by the overflow policy count as written.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void flush() noexcept;
+
+    /// The number of records discarded because the queue was full
+    size_type n_dropped() const noexcept { return m_n_dropped_.load(); }
+
+    /// What *this does when the queue is full
+    policy_type policy() const noexcept { return m_policy_; }
+
+private:
+    /// The body of the background thread
+    void run_();
+
+    /// Writes records until the queue is empty
+    void drain_(record_type& buffer) noexcept;
+
+    /// Flushes the sink, swallowing any exception
+    void flush_sink_() noexcept;
+
+    /// Wakes the background thread if it is sleeping
+    void wake_() noexcept;
+
+    /// Where the records are written
+    pimpl_ptr m_sink_;
+
+    /// What to do when the queue is full
+    policy_type m_policy_;
+
+    /// The records waiting to be written
+    queue_type m_queue_;
+
+    /// How many records have been written (or discarded after being queued)
+    std::atomic<size_type> m_n_done_{0};
+
+    /// How many records have been discarded
+    std::atomic<size_type> m_n_dropped_{0};
+
+    /// True while the background thread is (about to be) waiting on m_cv_
+    std::atomic<bool> m_sleeping_{false};
+
+    /// Guards m_flush_target_, m_n_flushed_, and m_stop_
+    std::mutex m_mutex_;
+
+    /// Used to wake the background thread
+    std::condition_variable m_cv_;
+
+    /// Used to signal that the sink was flushed
+    std::condition_variable m_flushed_cv_;
+
+    /// The number of records which must be written before the next flush
+    size_type m_flush_target_ = 0;
+
+    /// The number of records which were written when the sink last flushed
+    size_type m_n_flushed_ = 0;
+
+    /// Set when *this is being destroyed
+    bool m_stop_ = false;
+
+    /// The background thread
+    std::thread m_thread_;
+};
+
+/** @brief Logs asynchronously to the sink of another LoggerPIMPL.
+ *
+ *  Logging to *this only compares the severity to the threshold and queues
+ *  the message with an AsyncBackend, which writes it to the wrapped sink from
+ *  a background thread. Copies of *this share the backend, but have their own
+ *  threshold.
+ */
+class AsyncLoggerPIMPL : public LoggerPIMPL {
+public:
+    /// Type of the state shared among copies
+    using backend_type = AsyncBackend;
+
+    /// Type of a pointer to the shared state
+    using backend_pointer = std::shared_ptr<backend_type>;
+
+    /// Ultimately a typedef of AsyncBackend::size_type
+    using size_type = backend_type::size_type;
+
+    /// Ultimately a typedef of AsyncBackend::policy_type
+    using policy_type = backend_type::policy_type;
+
+    /** @brief Creates a logger which writes to @p sink asynchronously.
+     *
+     *  The threshold of *this is severity::info. Since *this does the
+     *  filtering, the threshold of @p sink is set to severity::trace.
+     *
+     *  @param[in] sink The LoggerPIMPL which writes the messages.
+     *  @param[in] queue_size The minimum number of messages which can be
+     *                        queued.
+     *  @param[in] policy What to do when the queue is full.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the backend.
+     *                        Strong throw guarantee.
+     *  @throw std::system_error if the thread can not be started. Strong
+     *                           throw guarantee.
+     */
+    AsyncLoggerPIMPL(pimpl_ptr sink, size_type queue_size, policy_type policy);
+
+    /// The number of messages discarded because the queue was full
+    size_type n_dropped() const noexcept { return m_backend_->n_dropped(); }
+
+protected:
+    AsyncLoggerPIMPL(const AsyncLoggerPIMPL&) = default;
+    AsyncLoggerPIMPL& operator=(const AsyncLoggerPIMPL&) = default;
+    AsyncLoggerPIMPL(AsyncLoggerPIMPL&&)                 = default;
+    AsyncLoggerPIMPL& operator=(AsyncLoggerPIMPL&&) = default;
+
+    /// Implemented by calling the copy ctor, the copy shares the backend
+    pimpl_ptr clone_() const override;
+
+    /// Sets the threshold of *this (not of the sink)
+    void set_severity_(severity_type severity) override;
+
+    /// Compares @p severity to the threshold of *this
+    bool should_log_(severity_type severity) const noexcept override;
+
+    /// Queues @p msg if @p severity is at least the threshold
+    void log_(severity_type severity, const_string_reference msg) override;
+
+    /// Waits for the backend to write the queued messages and flush
+    void flush_() override;
+
+    /// Equal if @p other is an AsyncLoggerPIMPL sharing the backend
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+private:
+    /// The minimum severity which is logged
+    severity_type m_severity_ = severity_type::info;
+
+    /// The queue and thread writing to the sink
+    backend_pointer m_backend_;
+};
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace parallelzone::detail_ {
+
+/** @brief A fixed-capacity, lock-free, multi-producer/multi-consumer queue.
+ *
+ *  This is the array-based queue of D. Vyukov. Each cell of a ring buffer
+ *  carries a sequence number which tells producers and consumers whether the
+ *  cell is ready to be written or read on the current lap around the ring.
+ *  Producers (consumers) claim a cell by advancing the enqueue (dequeue)
+ *  position with a compare-and-swap, so neither pushing nor popping takes a
+ *  lock. Neither operation blocks either: try_push fails when the queue is
+ *  full and try_pop fails when it is empty, leaving the caller to decide what
+ *  to do about it.
+ *
+ *  @tparam T The type of the elements. Must be default constructible and
+ *            move assignable.
+ */
+template<typename T>
+class BoundedQueue {
+public:
+    /// Type of the elements
+    using value_type = T;
+
+    /// Unsigned type used for sizes and positions
+    using size_type = std::size_t;
+
+    /** @brief Creates an empty queue which holds at least @p capacity
+     *         elements.
+     *
+     *  @param[in] capacity The minimum number of elements the queue can hold.
+     *                      It is rounded up to a power of two (and to at least
+     *                      two).
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the ring.
+     *                        Strong throw guarantee.
+     */
+    explicit BoundedQueue(size_type capacity);
+
+    /// Not copyable, elements are in flight between threads
+    BoundedQueue(const BoundedQueue&) = delete;
+
+    /// Not copyable, elements are in flight between threads
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /// The maximum number of elements the queue can hold
+    size_type capacity() const noexcept { return m_mask_ + 1; }
+
+    /** @brief Adds @p value to the back of the queue, if there is room.
+     *
+     *  @param[in,out] value The element to add. It is only moved from if the
+     *                       push succeeds.
+     *
+     *  @return True if @p value was added and false if the queue was full.
+     *
+     *  @throw None No throw guarantee if moving T is no throw.
+     */
+    bool try_push(value_type& value);
+
+    /** @brief Removes the element at the front of the queue, if there is one.
+     *
+     *  @param[out] value Where the removed element is moved to. Only modified
+     *                    if the pop succeeds.
+     *
+     *  @return True if an element was removed and false if the queue was
+     *          empty.
+     *
+     *  @throw None No throw guarantee if moving T is no throw.
+     */
+    bool try_pop(value_type& value);
+
+    /** @brief The number of pushes which have claimed a cell so far.
+     *
+     *  A push claims its cell before it writes the element. Elements are
+     *  popped in the order their cells were claimed, so once this many
+     *  elements have been popped every push which completed before the call
+     *  has been popped too.
+     */
+    size_type n_pushed() const noexcept {
+        return m_enqueue_pos_.load(std::memory_order_acquire);
+    }
+
+    /** @brief Is the queue empty?
+     *
+     *  When other threads are pushing or popping the answer may be stale by
+     *  the time it is returned.
+     */
+    bool empty() const noexcept;
+
+private:
+    /// An element and the sequence number of the lap it belongs to
+    struct cell_type {
+        std::atomic<size_type> m_sequence{0};
+        value_type m_value{};
+    };
+
+    /// Keeps the positions on different cache lines to avoid false sharing
+    static constexpr size_type cache_line = 64;
+
+    /// capacity() - 1, used to map positions to cells
+    size_type m_mask_;
+
+    /// The ring buffer
+    std::unique_ptr<cell_type[]> m_cells_;
+
+    /// The position the next push will write to
+    alignas(cache_line) std::atomic<size_type> m_enqueue_pos_{0};
+
+    /// The position the next pop will read from
+    alignas(cache_line) std::atomic<size_type> m_dequeue_pos_{0};
+};
+
+} // namespace parallelzone::detail_
+
+#include "bounded_queue.ipp"
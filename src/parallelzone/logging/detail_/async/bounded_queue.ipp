@@ -0,0 +1,94 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+/** @file bounded_queue.ipp
+ *
+ *  This file contains the inline definitions for the BoundedQueue class. It
+ *  is meant only for inclusion by bounded_queue.hpp
+ */
+
+namespace parallelzone::detail_ {
+
+template<typename T>
+BoundedQueue<T>::BoundedQueue(size_type capacity) : m_mask_(1) {
+    while(m_mask_ + 1 < capacity) m_mask_ = (m_mask_ << 1) | 1;
+    m_cells_ = std::make_unique<cell_type[]>(m_mask_ + 1);
+    for(size_type i = 0; i <= m_mask_; ++i)
+        m_cells_[i].m_sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool BoundedQueue<T>::try_push(value_type& value) {
+    auto pos = m_enqueue_pos_.load(std::memory_order_relaxed);
+    while(true) {
+        auto& cell    = m_cells_[pos & m_mask_];
+        const auto sq = cell.m_sequence.load(std::memory_order_acquire);
+        const auto d  = std::ptrdiff_t(sq) - std::ptrdiff_t(pos);
+        if(d == 0) {
+            // The cell is free on this lap, try to claim it
+            if(m_enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                    std::memory_order_relaxed))
+            {
+                cell.m_value = std::move(value);
+                cell.m_sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if(d < 0) {
+            // The cell still holds an element from the previous lap
+            return false;
+        } else {
+            // Another producer claimed the cell, try again at the new end
+            pos = m_enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+bool BoundedQueue<T>::try_pop(value_type& value) {
+    auto pos = m_dequeue_pos_.load(std::memory_order_relaxed);
+    while(true) {
+        auto& cell    = m_cells_[pos & m_mask_];
+        const auto sq = cell.m_sequence.load(std::memory_order_acquire);
+        const auto d  = std::ptrdiff_t(sq) - std::ptrdiff_t(pos + 1);
+        if(d == 0) {
+            // The cell was written on this lap, try to claim it
+            if(m_dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                    std::memory_order_relaxed))
+            {
+                value = std::move(cell.m_value);
+                cell.m_sequence.store(pos + m_mask_ + 1,
+                                      std::memory_order_release);
+                return true;
+            }
+        } else if(d < 0) {
+            // Nothing has been written to the cell on this lap
+            return false;
+        } else {
+            // Another consumer claimed the cell, try again at the new front
+            pos = m_dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+bool BoundedQueue<T>::empty() const noexcept {
+    const auto front = m_dequeue_pos_.load(std::memory_order_acquire);
+    const auto back  = m_enqueue_pos_.load(std::memory_order_acquire);
+    return front >= back;
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "binary_file.hpp"
+#include "binary_format.hpp"
+#include <chrono>
+#include <stdexcept>
+
+namespace parallelzone::detail_ {
+
+namespace {
+
+/// Size of the buffer the file is written through
+constexpr std::size_t buffer_size = 1 << 16;
+
+} // namespace
+
+BinaryFilePIMPL::BinaryFilePIMPL(const_string_reference file_name,
+                                 rank_type rank) :
+  m_state_(std::make_shared<shared_state>()) {
+    auto& state = *m_state_;
+    state.m_buffer.resize(buffer_size);
+    state.m_file.rdbuf()->pubsetbuf(state.m_buffer.data(), buffer_size);
+    state.m_file.open(file_name, std::ios::binary | std::ios::trunc);
+    if(!state.m_file)
+        throw std::runtime_error("Could not open the binary log " + file_name);
+
+    state.m_file.write(binary_format::magic, sizeof(binary_format::magic));
+    write_(binary_format::version);
+    write_(rank);
+}
+
+BinaryFilePIMPL::pimpl_ptr BinaryFilePIMPL::clone_() const {
+    return std::unique_ptr<BinaryFilePIMPL>(new BinaryFilePIMPL(*this));
+}
+
+void BinaryFilePIMPL::set_severity_(severity_type severity) {
+    m_severity_ = severity;
+}
+
+bool BinaryFilePIMPL::should_log_(severity_type severity) const noexcept {
+    return severity >= m_severity_;
+}
+
+void BinaryFilePIMPL::log_(severity_type severity,
+                           const_string_reference msg) {
+    if(!should_log_(severity)) return;
+    const std::uint32_t n = msg.size();
+
+    std::lock_guard<std::mutex> lock(m_state_->m_mutex);
+    write_(binary_format::record_kind::text);
+    write_prefix_(severity);
+    write_(n);
+    m_state_->m_file.write(msg.data(), n);
+}
+
+void BinaryFilePIMPL::log_packed_(severity_type severity, std::string_view fmt,
+                                  const PackedArgs& args) {
+    if(!should_log_(severity)) return;
+    const auto& bytes           = args.data();
+    const std::uint32_t n_bytes = bytes.size();
+
+    std::lock_guard<std::mutex> lock(m_state_->m_mutex);
+    const auto id = template_id_(fmt);
+    write_(binary_format::record_kind::structured);
+    write_prefix_(severity);
+    write_(id);
+    write_(n_bytes);
+    m_state_->m_file.write(reinterpret_cast<const char*>(bytes.data()),
+                           n_bytes);
+}
+
+void BinaryFilePIMPL::flush_() {
+    std::lock_guard<std::mutex> lock(m_state_->m_mutex);
+    m_state_->m_file.flush();
+}
+
+bool BinaryFilePIMPL::are_equal_(const LoggerPIMPL& other) const noexcept {
+    auto p = dynamic_cast<const BinaryFilePIMPL*>(&other);
+    if(p == nullptr) return false;
+    return m_state_ == p->m_state_;
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+std::uint32_t BinaryFilePIMPL::template_id_(std::string_view fmt) {
+    auto& state = *m_state_;
+
+    auto addr_itr = state.m_ids_by_address.find(fmt.data());
+    if(addr_itr != state.m_ids_by_address.end()) {
+        // Same address, but the characters may have changed
+        if(state.m_templates[addr_itr->second] == fmt) return addr_itr->second;
+    }
+
+    auto [itr, is_new] = state.m_ids.try_emplace(string_type(fmt), 0);
+    if(is_new) {
+        itr->second = state.m_templates.size();
+        state.m_templates.push_back(itr->first);
+
+        const std::uint32_t n = fmt.size();
+        write_(binary_format::record_kind::template_definition);
+        write_(itr->second);
+        write_(n);
+        state.m_file.write(fmt.data(), n);
+    }
+    state.m_ids_by_address[fmt.data()] = itr->second;
+    return itr->second;
+}
+
+void BinaryFilePIMPL::write_prefix_(severity_type severity) {
+    using namespace std::chrono;
+    const auto now = system_clock::now().time_since_epoch();
+    const std::int64_t time = duration_cast<nanoseconds>(now).count();
+    write_(time);
+    write_(std::uint8_t(severity));
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../logger_pimpl.hpp"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace parallelzone::detail_ {
+
+/** @brief Logger which writes compact binary records to a file.
+ *
+ *  Messages logged with a template and arguments (i.e., through
+ *  Logger::log(severity, fmt, args...)) are never formatted. Instead the
+ *  record holds a time stamp, the severity, an integer id for the template,
+ *  and the packed arguments. Each template is written to the file once, the
+ *  first time it is used. Messages which are already formatted are written
+ *  as text. The format is described in binary_format.hpp and the files are
+ *  turned back into text (or JSON) by decode_binary_logs.
+ *
+ *  Copies of *this share the file, but have their own threshold.
+ */
+class BinaryFilePIMPL : public LoggerPIMPL {
+public:
+    /// Type used for the rank which wrote the file
+    using rank_type = std::uint64_t;
+
+    /** @brief Creates a logger which writes to @p file_name.
+     *
+     *  If @p file_name exists it is overwritten. Like other newly made
+     *  loggers the threshold of *this is severity::info.
+     *
+     *  @param[in] file_name The file to write to.
+     *  @param[in] rank The rank recorded in the file's header.
+     *
+     *  @throw std::runtime_error if the file can not be opened. Strong throw
+     *                            guarantee.
+     */
+    BinaryFilePIMPL(const_string_reference file_name, rank_type rank);
+
+protected:
+    BinaryFilePIMPL(const BinaryFilePIMPL&) = default;
+    BinaryFilePIMPL& operator=(const BinaryFilePIMPL&) = default;
+    BinaryFilePIMPL(BinaryFilePIMPL&&)                 = default;
+    BinaryFilePIMPL& operator=(BinaryFilePIMPL&&) = default;
+
+    /// Implemented by calling the copy ctor, the copy shares the file
+    pimpl_ptr clone_() const override;
+
+    /// Sets the threshold of *this
+    void set_severity_(severity_type severity) override;
+
+    /// Compares @p severity to the threshold of *this
+    bool should_log_(severity_type severity) const noexcept override;
+
+    /// Writes a text record
+    void log_(severity_type severity, const_string_reference msg) override;
+
+    /// Writes a structured record (and the template, if it's new)
+    void log_packed_(severity_type severity, std::string_view fmt,
+                     const PackedArgs& args) override;
+
+    /// Flushes the file
+    void flush_() override;
+
+    /// Equal if @p other is a BinaryFilePIMPL sharing the file
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+private:
+    /// The state shared among copies of *this
+    struct shared_state {
+        /// Buffer used by m_file, declared first so it outlives m_file
+        std::vector<char> m_buffer;
+
+        /// The file being written
+        std::ofstream m_file;
+
+        /// The message templates, indexed by id
+        std::vector<string_type> m_templates;
+
+        /// Maps message templates to their ids
+        std::unordered_map<string_type, std::uint32_t> m_ids;
+
+        /// Maps the address of a template's characters to the template's id.
+        /// Templates are usually string literals, so this avoids hashing
+        /// (and copying) them.
+        std::unordered_map<const char*, std::uint32_t> m_ids_by_address;
+
+        /// Serializes writes to m_file
+        std::mutex m_mutex;
+    };
+
+    /// Finds the id of @p fmt, writing a template definition if @p fmt is
+    /// new. Assumes the lock is held.
+    std::uint32_t template_id_(std::string_view fmt);
+
+    /// Writes the time stamp and severity which start structured and text
+    /// records. Assumes the lock is held.
+    void write_prefix_(severity_type severity);
+
+    /// Writes the bytes of @p value. Assumes the lock is held.
+    template<typename T>
+    void write_(const T& value) {
+        m_state_->m_file.write(reinterpret_cast<const char*>(&value),
+                               sizeof(T));
+    }
+
+    /// The minimum severity which is logged
+    severity_type m_severity_ = severity_type::info;
+
+    /// The file and the template ids
+    std::shared_ptr<shared_state> m_state_;
+};
+
+} // namespace parallelzone::detail_
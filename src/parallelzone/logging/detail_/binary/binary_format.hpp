@@ -0,0 +1,54 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <cstdint>
+
+/** @file binary_format.hpp
+ *
+ *  Constants describing the files written by BinaryFilePIMPL and read by
+ *  decode_binary_logs. All values are written in the byte order of the
+ *  machine which wrote the file.
+ *
+ *  A file starts with a header:
+ *
+ *  - magic: the 8 characters "PZBINLOG",
+ *  - version: std::uint32_t,
+ *  - rank: std::uint64_t, the rank which wrote the file.
+ *
+ *  The header is followed by records, each starting with a record_kind byte:
+ *
+ *  - template_definition: std::uint32_t id, std::uint32_t length, and the
+ *    characters of the message template. Appears before the first record
+ *    which uses the id.
+ *  - structured: std::int64_t time stamp (nanoseconds since the system
+ *    epoch), std::uint8_t severity, std::uint32_t template id,
+ *    std::uint32_t length, and that many bytes of PackedArgs.
+ *  - text: std::int64_t time stamp, std::uint8_t severity, std::uint32_t
+ *    length, and the characters of an already formatted message.
+ */
+
+namespace parallelzone::detail_::binary_format {
+
+/// The first bytes of every binary log
+inline constexpr char magic[8] = {'P', 'Z', 'B', 'I', 'N', 'L', 'O', 'G'};
+
+/// The version of the format described above
+inline constexpr std::uint32_t version = 1;
+
+/// The first byte of each record
+enum class record_kind : std::uint8_t { template_definition, structured, text };
+
+} // namespace parallelzone::detail_::binary_format
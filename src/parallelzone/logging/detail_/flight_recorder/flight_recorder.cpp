@@ -0,0 +1,391 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "flight_recorder.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <signal.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+namespace parallelzone::detail_ {
+namespace {
+
+using state_type  = FlightRecorderPIMPL::shared_state;
+using ring_type   = FlightRecorderPIMPL::ring_type;
+using record_type = ring_type::record_type;
+
+/// The maximum number of flight recorders dump_all can find
+constexpr std::size_t max_recorders = 64;
+
+/// The live flight recorders, read without locking by the signal handler
+std::array<std::atomic<state_type*>, max_recorders> g_registry{};
+
+/// Serializes dump_all with the creation and destruction of recorders
+std::mutex g_registry_mutex;
+
+/// Source of the shared_state ids
+std::atomic<std::uint64_t> g_next_id = 1;
+
+/// Prefixed to each dumped message, followed by the thread's number
+constexpr const char prefix[] = "[Flight recorder, thread ";
+
+const char* severity_name(Logger::severity s) noexcept {
+    constexpr const char* names[] = {"trace", "debug", "info",
+                                     "warn",  "error", "critical"};
+    const auto i = static_cast<std::size_t>(s);
+    return i < std::size(names) ? names[i] : "unknown";
+}
+
+// The functions below are called from signal handlers, so they only use
+// write(2) and do not allocate
+
+void write_all(int fd, const char* data, std::size_t n) noexcept {
+    while(n > 0) {
+        const auto written = ::write(fd, data, n);
+        if(written < 0 && errno == EINTR) continue;
+        if(written <= 0) return;
+        data += written;
+        n -= written;
+    }
+}
+
+void write_cstr(int fd, const char* str) noexcept {
+    write_all(fd, str, std::strlen(str));
+}
+
+void write_number(int fd, std::size_t n) noexcept {
+    char buffer[20];
+    std::size_t i = sizeof(buffer);
+    do {
+        buffer[--i] = '0' + n % 10;
+        n /= 10;
+    } while(n > 0);
+    write_all(fd, buffer + i, sizeof(buffer) - i);
+}
+
+void write_record(int fd, std::size_t thread,
+                  const record_type& record) noexcept {
+    write_cstr(fd, prefix);
+    write_number(fd, thread);
+    write_cstr(fd, "] [");
+    write_cstr(fd, severity_name(record.m_severity));
+    write_cstr(fd, "] ");
+    write_all(fd, record.m_msg.data(), record.m_msg.size());
+    write_cstr(fd, "\n");
+}
+
+/// The number of messages @p ring holds
+std::uint64_t ring_size(const ring_type& ring) noexcept {
+    return std::min<std::uint64_t>(ring.m_n_written, ring.m_records.size());
+}
+
+/// Writes the rings of @p state to @p fd, merged by time, without locking
+void write_unlocked(int fd, const state_type& state) noexcept {
+    const auto n_rings = state.m_n_rings.load(std::memory_order_acquire);
+
+    // Next record of each ring to write, and one past the last
+    std::array<std::uint64_t, FlightRecorderPIMPL::max_threads> next{};
+    std::array<std::uint64_t, FlightRecorderPIMPL::max_threads> end{};
+    for(std::size_t i = 0; i < n_rings; ++i) {
+        auto ring = state.m_rings[i].load(std::memory_order_acquire);
+        if(ring == nullptr) continue;
+        end[i]  = ring->m_n_written;
+        next[i] = end[i] - ring_size(*ring);
+    }
+
+    while(true) {
+        const record_type* oldest = nullptr;
+        std::size_t oldest_ring   = 0;
+        for(std::size_t i = 0; i < n_rings; ++i) {
+            if(next[i] == end[i]) continue;
+            auto ring    = state.m_rings[i].load(std::memory_order_acquire);
+            const auto n = ring->m_records.size();
+            const auto& record = ring->m_records[next[i] % n];
+            if(oldest == nullptr || record.m_time < oldest->m_time) {
+                oldest      = &record;
+                oldest_ring = i;
+            }
+        }
+        if(oldest == nullptr) return;
+        write_record(fd, oldest_ring, *oldest);
+        ++next[oldest_ring];
+    }
+}
+
+bool is_fatal(int signal_number) noexcept {
+    switch(signal_number) {
+        case SIGSEGV:
+        case SIGBUS:
+        case SIGFPE:
+        case SIGILL:
+        case SIGABRT: return true;
+        default: return false;
+    }
+}
+
+extern "C" void flight_recorder_signal_handler(int signal_number) {
+    const int saved_errno = errno;
+    for(const auto& entry : g_registry) {
+        auto state = entry.load(std::memory_order_acquire);
+        if(state != nullptr) write_unlocked(STDERR_FILENO, *state);
+    }
+    errno = saved_errno;
+    if(!is_fatal(signal_number)) return;
+    std::signal(signal_number, SIG_DFL);
+    std::raise(signal_number);
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// -- ring_type and shared_state
+// -----------------------------------------------------------------------------
+
+FlightRecorderPIMPL::ring_type::ring_type(size_type n) : m_records(n) {
+    for(auto& record : m_records) record.m_msg.reserve(slot_capacity);
+}
+
+FlightRecorderPIMPL::shared_state::shared_state(pimpl_ptr sink,
+                                                size_type n_records,
+                                                severity_type dump_severity) :
+  m_sink(std::move(sink)),
+  m_n_records(n_records),
+  m_dump_severity(dump_severity),
+  m_id(g_next_id++) {
+    if(m_sink) m_sink->set_severity(severity_type::trace);
+
+    // If the registry is full *this still works, but dump_all can't find it
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for(auto& entry : g_registry) {
+        if(entry.load() != nullptr) continue;
+        entry.store(this, std::memory_order_release);
+        break;
+    }
+}
+
+FlightRecorderPIMPL::shared_state::~shared_state() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        for(auto& entry : g_registry)
+            if(entry.load() == this) entry.store(nullptr);
+    }
+    for(auto& ring : m_rings) delete ring.load();
+}
+
+void FlightRecorderPIMPL::shared_state::dump() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Take the messages out of the rings, recording the thread of each
+    std::vector<std::pair<size_type, record_type>> records;
+    const auto n_rings = m_n_rings.load(std::memory_order_acquire);
+    for(size_type i = 0; i < n_rings; ++i) {
+        auto& ring = *m_rings[i].load(std::memory_order_acquire);
+        std::lock_guard<std::mutex> ring_lock(ring.m_mutex);
+        const auto n     = ring.m_records.size();
+        const auto first = ring.m_n_written - ring_size(ring);
+        for(auto j = first; j < ring.m_n_written; ++j)
+            records.emplace_back(i, ring.m_records[j % n]);
+        ring.m_n_written = 0;
+    }
+
+    // Stable, so messages with the same time stamp stay in thread order
+    std::stable_sort(records.begin(), records.end(),
+                     [](const auto& lhs, const auto& rhs) {
+                         return lhs.second.m_time < rhs.second.m_time;
+                     });
+
+    if(!m_sink) {
+        for(const auto& [i, record] : records)
+            write_record(STDERR_FILENO, i, record);
+        return;
+    }
+    for(const auto& [i, record] : records) {
+        const auto tag = prefix + std::to_string(i) + "] ";
+        m_sink->log(record.m_severity, tag + record.m_msg);
+    }
+    m_sink->flush();
+}
+
+// -----------------------------------------------------------------------------
+// -- FlightRecorderPIMPL
+// -----------------------------------------------------------------------------
+
+FlightRecorderPIMPL::FlightRecorderPIMPL(pimpl_ptr sink, size_type n_records,
+                                         severity_type dump_severity) {
+    if(n_records == 0)
+        throw std::out_of_range("A flight recorder must keep a message");
+    m_state_ = std::make_shared<shared_state>(std::move(sink), n_records,
+                                              dump_severity);
+}
+
+void FlightRecorderPIMPL::dump() { m_state_->dump(); }
+
+FlightRecorderPIMPL::size_type FlightRecorderPIMPL::n_records()
+  const noexcept {
+    return m_state_->m_n_records;
+}
+
+FlightRecorderPIMPL::size_type FlightRecorderPIMPL::n_kept() const {
+    auto& state = *m_state_;
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    size_type n = 0;
+    const auto n_rings = state.m_n_rings.load(std::memory_order_acquire);
+    for(size_type i = 0; i < n_rings; ++i) {
+        auto& ring = *state.m_rings[i].load(std::memory_order_acquire);
+        std::lock_guard<std::mutex> ring_lock(ring.m_mutex);
+        n += ring_size(ring);
+    }
+    return n;
+}
+
+void FlightRecorderPIMPL::dump_all() noexcept {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for(const auto& entry : g_registry) {
+        auto state = entry.load(std::memory_order_acquire);
+        if(state == nullptr) continue;
+        try {
+            state->dump();
+        } catch(...) {
+            // Something is already going wrong, keep dumping the others
+        }
+    }
+}
+
+void FlightRecorderPIMPL::install_signal_handler(int signal_number) {
+    struct sigaction action {};
+    action.sa_handler = flight_recorder_signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if(sigaction(signal_number, &action, nullptr) != 0)
+        throw std::runtime_error("Could not install a flight recorder handler "
+                                 "for signal " +
+                                 std::to_string(signal_number));
+}
+
+FlightRecorderPIMPL::pimpl_ptr FlightRecorderPIMPL::clone_() const {
+    using self_type = FlightRecorderPIMPL;
+    return std::unique_ptr<self_type>(new self_type(*this));
+}
+
+void FlightRecorderPIMPL::set_severity_(severity_type severity) {
+    m_severity_ = severity;
+}
+
+bool FlightRecorderPIMPL::should_log_(severity_type severity) const noexcept {
+    return severity >= m_severity_;
+}
+
+void FlightRecorderPIMPL::log_(severity_type severity,
+                               const_string_reference msg) {
+    if(!should_log_(severity)) return;
+
+    // If there are too many threads the message is only dropped, a severe
+    // message still dumps what the other threads kept
+    if(auto ring = my_ring_(); ring != nullptr) {
+        using namespace std::chrono;
+        const auto now = system_clock::now().time_since_epoch();
+
+        std::lock_guard<std::mutex> lock(ring->m_mutex);
+        const auto n  = ring->m_records.size();
+        auto& record  = ring->m_records[ring->m_n_written % n];
+        record.m_time = duration_cast<nanoseconds>(now).count();
+        record.m_severity = severity;
+        record.m_msg.assign(msg); // Reuses the slot's memory
+        ++ring->m_n_written;
+    }
+
+    if(severity >= m_state_->m_dump_severity) m_state_->dump();
+}
+
+void FlightRecorderPIMPL::flush_() {
+    auto& state = *m_state_;
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if(state.m_sink) state.m_sink->flush();
+}
+
+bool FlightRecorderPIMPL::are_equal_(const LoggerPIMPL& other) const noexcept {
+    auto p = dynamic_cast<const FlightRecorderPIMPL*>(&other);
+    if(p == nullptr) return false;
+    return m_state_ == p->m_state_;
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+FlightRecorderPIMPL::ring_type* FlightRecorderPIMPL::my_ring_() {
+    // The ring this thread used last, and the id of the recorder it is in
+    thread_local std::uint64_t t_id = 0;
+    thread_local ring_type* t_ring  = nullptr;
+
+    auto& state = *m_state_;
+    if(t_id == state.m_id) return t_ring;
+
+    // Only this thread claims its ring, so if it's not found it doesn't have
+    // one
+    const auto me = std::this_thread::get_id();
+    ring_type* ring = nullptr;
+    auto n_rings    = state.m_n_rings.load(std::memory_order_acquire);
+    for(size_type i = 0; i < n_rings && ring == nullptr; ++i) {
+        auto p = state.m_rings[i].load(std::memory_order_acquire);
+        if(p->m_in_use->load(std::memory_order_acquire) && p->m_owner == me)
+            ring = p;
+    }
+
+    if(ring == nullptr) {
+        std::lock_guard<std::mutex> lock(state.m_mutex);
+        n_rings = state.m_n_rings.load(std::memory_order_acquire);
+
+        // Prefer a free ring with nothing left to dump. A free ring which
+        // still holds messages is only taken if no new ring can be made.
+        ring_type* oldest        = nullptr;
+        std::int64_t oldest_time = 0;
+        for(size_type i = 0; i < n_rings; ++i) {
+            auto p = state.m_rings[i].load(std::memory_order_acquire);
+            if(p->m_in_use->load(std::memory_order_acquire)) continue;
+            std::lock_guard<std::mutex> ring_lock(p->m_mutex);
+            if(p->m_n_written == 0) {
+                ring = p;
+                break;
+            }
+            const auto n    = p->m_records.size();
+            const auto time = p->m_records[(p->m_n_written - 1) % n].m_time;
+            if(oldest == nullptr || time < oldest_time) {
+                oldest      = p;
+                oldest_time = time;
+            }
+        }
+        if(ring == nullptr && n_rings < max_threads) {
+            ring = new ring_type(state.m_n_records);
+            state.m_rings[n_rings].store(ring, std::memory_order_release);
+            state.m_n_rings.store(n_rings + 1, std::memory_order_release);
+        }
+        if(ring == nullptr) ring = oldest;
+        if(ring == nullptr) return nullptr;
+        ring->m_owner = me;
+        release_on_thread_exit(ring->m_in_use);
+    }
+
+    t_id   = state.m_id;
+    t_ring = ring;
+    return ring;
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../logger_pimpl.hpp"
+#include "../thread_slot.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallelzone::detail_ {
+
+/** @brief Keeps the most recent messages of each thread in memory, and only
+ *         writes them when something goes wrong.
+ *
+ *  Each thread which logs to a flight recorder gets its own ring of
+ *  preallocated slots the first time it logs. Logging copies the message into
+ *  the oldest slot of the thread's ring, so it does no I/O and, once the
+ *  slots have grown to fit the messages, no allocation. The rings are dumped
+ *  (the messages of all threads are written to the sink, in time stamp
+ *  order, and the rings are emptied) when:
+ *
+ *  - a message with at least the dump severity is logged,
+ *  - dump_all is called, which RuntimeView does if it is destroyed while an
+ *    exception is propagating, or
+ *  - a signal handler installed with install_signal_handler runs.
+ *
+ *  Flushing the logger only flushes the sink; the kept messages are not
+ *  written. Otherwise a clean RuntimeView teardown, which flushes the logger,
+ *  would dump the rings.
+ *
+ *  When a thread exits its ring is marked free. A thread which needs a ring
+ *  takes over a free ring which has been dumped since its thread exited,
+ *  else a new ring, else (once there are max_threads rings) the free ring
+ *  whose newest message is the oldest; the messages of the exited thread are
+ *  then overwritten as the new one logs. Copies of *this share the rings,
+ *  but have their own threshold.
+ */
+class FlightRecorderPIMPL : public LoggerPIMPL {
+public:
+    /// Unsigned type used for sizes
+    using size_type = std::size_t;
+
+    /// The maximum number of rings, i.e., of running threads whose messages
+    /// are kept
+    static constexpr size_type max_threads = 256;
+
+    /// The number of characters reserved in each slot
+    static constexpr size_type slot_capacity = 128;
+
+    /** @brief Creates a flight recorder which dumps to @p sink.
+     *
+     *  The threshold of *this is severity::trace. The threshold of @p sink
+     *  is also lowered to severity::trace, so every dumped message is
+     *  written.
+     *
+     *  @param[in] sink Where the messages are dumped. If null, they are
+     *                  written to standard error.
+     *  @param[in] n_records The number of messages kept per thread.
+     *  @param[in] dump_severity Logging a message with at least this
+     *                           severity dumps the rings.
+     *
+     *  @throw std::out_of_range if @p n_records is 0. Strong throw guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the state.
+     *                        Strong throw guarantee.
+     */
+    FlightRecorderPIMPL(pimpl_ptr sink, size_type n_records,
+                        severity_type dump_severity);
+
+    /// Writes the kept messages to the sink and empties the rings
+    void dump();
+
+    /// The number of messages kept per thread
+    size_type n_records() const noexcept;
+
+    /// The number of messages currently kept, summed over the threads
+    size_type n_kept() const;
+
+    /** @brief Dumps every flight recorder which currently exists.
+     *
+     *  @throw None No throw guarantee. Errors while dumping are ignored.
+     */
+    static void dump_all() noexcept;
+
+    /** @brief Dumps every flight recorder when @p signal_number is raised.
+     *
+     *  The installed handler writes the messages of every flight recorder to
+     *  standard error. Signal handlers can not take locks, so the handler
+     *  does not empty the rings and a message which is being logged while
+     *  the handler runs may be printed garbled. For signals which end the
+     *  program (SIGSEGV, SIGBUS, SIGFPE, SIGILL, and SIGABRT) the handler
+     *  then restores the default action and raises the signal again.
+     *
+     *  @param[in] signal_number The signal to handle.
+     *
+     *  @throw std::runtime_error if the handler can not be installed. Strong
+     *                            throw guarantee.
+     */
+    static void install_signal_handler(int signal_number);
+
+    /// The messages of one thread
+    struct ring_type {
+        /// A kept message
+        struct record_type {
+            /// When the message was logged, in ns since the system epoch
+            std::int64_t m_time = 0;
+
+            /// The severity of the message
+            severity_type m_severity = severity_type::trace;
+
+            /// The message
+            string_type m_msg;
+        };
+
+        /// Preallocates @p n slots
+        explicit ring_type(size_type n);
+
+        /// The thread which logs to *this
+        std::atomic<std::thread::id> m_owner = std::this_thread::get_id();
+
+        /// True while m_owner is running, see release_on_thread_exit
+        thread_slot_flag m_in_use = std::make_shared<std::atomic<bool>>();
+
+        /// Guards m_records and m_n_written against dumps
+        std::mutex m_mutex;
+
+        /// The slots
+        std::vector<record_type> m_records;
+
+        /// Number of messages logged since the last dump
+        std::uint64_t m_n_written = 0;
+    };
+
+    /// The state shared among copies of *this
+    struct shared_state {
+        /// Registers *this so that dump_all can find it
+        shared_state(pimpl_ptr sink, size_type n_records,
+                     severity_type dump_severity);
+
+        /// Unregisters *this and frees the rings
+        ~shared_state() noexcept;
+
+        /// Implements FlightRecorderPIMPL::dump
+        void dump();
+
+        /// Where dumps are written (null means standard error)
+        pimpl_ptr m_sink;
+
+        /// Number of slots per ring
+        size_type m_n_records;
+
+        /// Messages with at least this severity trigger a dump
+        severity_type m_dump_severity;
+
+        /// Distinguishes *this from other (possibly since freed) states
+        std::uint64_t m_id;
+
+        /// Serializes dumps and the making of rings
+        std::mutex m_mutex;
+
+        /// Number of entries of m_rings which are in use
+        std::atomic<size_type> m_n_rings = 0;
+
+        /// The rings, in the order they were made
+        std::array<std::atomic<ring_type*>, max_threads> m_rings{};
+    };
+
+protected:
+    FlightRecorderPIMPL(const FlightRecorderPIMPL&) = default;
+    FlightRecorderPIMPL& operator=(const FlightRecorderPIMPL&) = default;
+    FlightRecorderPIMPL(FlightRecorderPIMPL&&)                 = default;
+    FlightRecorderPIMPL& operator=(FlightRecorderPIMPL&&) = default;
+
+    /// Implemented by calling the copy ctor, the copy shares the rings
+    pimpl_ptr clone_() const override;
+
+    /// Sets the threshold of *this (not of the sink)
+    void set_severity_(severity_type severity) override;
+
+    /// Compares @p severity to the threshold of *this
+    bool should_log_(severity_type severity) const noexcept override;
+
+    /// Keeps @p msg in the calling thread's ring, dumping if it is severe
+    void log_(severity_type severity, const_string_reference msg) override;
+
+    /// Flushes the sink, the rings are kept (only dumps write them)
+    void flush_() override;
+
+    /// Equal if @p other is a FlightRecorderPIMPL sharing the rings
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+private:
+    /// The calling thread's ring, taken over from an exited thread or made if
+    /// need be (null if max_threads running threads have rings)
+    ring_type* my_ring_();
+
+    /// The minimum severity which is kept
+    severity_type m_severity_ = severity_type::trace;
+
+    /// The rings and the sink
+    std::shared_ptr<shared_state> m_state_;
+};
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "limiting.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace parallelzone::detail_ {
+
+LimitingLoggerPIMPL::LimitingLoggerPIMPL(pimpl_ptr sink, rank_type rank,
+                                         limits_type limits) {
+    if(limits.rank_stride == 0)
+        throw std::out_of_range("The rank stride must be at least 1");
+
+    const auto& ranks = limits.ranks;
+    bool sampled      = rank % limits.rank_stride == 0;
+    if(!ranks.empty())
+        sampled = std::find(ranks.begin(), ranks.end(), rank) != ranks.end();
+
+    // Start with the sink's threshold, then let *this do the filtering
+    m_severity_ = severity_type::critical;
+    for(auto s : {severity_type::error, severity_type::warn,
+                  severity_type::info, severity_type::debug,
+                  severity_type::trace})
+        if(sink->should_log(s)) m_severity_ = s;
+    sink->set_severity(severity_type::trace);
+
+    m_state_ = std::make_shared<shared_state>();
+    m_state_->m_sink    = std::move(sink);
+    m_state_->m_rank    = rank;
+    m_state_->m_limits  = std::move(limits);
+    m_state_->m_sampled = sampled;
+}
+
+bool LimitingLoggerPIMPL::sampled() const noexcept {
+    return m_state_->m_sampled;
+}
+
+LimitingLoggerPIMPL::size_type LimitingLoggerPIMPL::n_suppressed() const {
+    auto& state = *m_state_;
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    size_type n = state.m_n_unsampled;
+    for(const auto& [key, site] : state.m_sites) n += site.m_n_suppressed;
+    return n;
+}
+
+LimitingLoggerPIMPL::pimpl_ptr LimitingLoggerPIMPL::clone_() const {
+    using self_type = LimitingLoggerPIMPL;
+    return std::unique_ptr<self_type>(new self_type(*this));
+}
+
+void LimitingLoggerPIMPL::set_severity_(severity_type severity) {
+    m_severity_ = severity;
+}
+
+bool LimitingLoggerPIMPL::should_log_(severity_type severity) const noexcept {
+    return severity >= m_severity_;
+}
+
+void LimitingLoggerPIMPL::log_(severity_type severity,
+                               const_string_reference msg) {
+    if(!should_log_(severity)) return;
+    if(admit_(severity, msg)) m_state_->m_sink->log(severity, msg);
+}
+
+void LimitingLoggerPIMPL::log_packed_(severity_type severity,
+                                      std::string_view fmt,
+                                      const PackedArgs& args) {
+    if(!should_log_(severity)) return;
+    // Passed on packed, so sinks which store templates still can
+    if(admit_(severity, fmt)) m_state_->m_sink->log(severity, fmt, args);
+}
+
+void LimitingLoggerPIMPL::flush_() {
+    auto& state = *m_state_;
+
+    std::vector<std::pair<severity_type, string_type>> summaries;
+    {
+        std::lock_guard<std::mutex> lock(state.m_mutex);
+        if(state.m_n_unsampled > 0) {
+            summaries.emplace_back(state.m_unsampled_severity,
+                                   "Suppressed " +
+                                     std::to_string(state.m_n_unsampled) +
+                                     " messages, rank " +
+                                     std::to_string(state.m_rank) +
+                                     " is not sampled");
+            state.m_n_unsampled        = 0;
+            state.m_unsampled_severity = severity_type::trace;
+        }
+        for(auto& [key, site] : state.m_sites) {
+            if(site.m_n_suppressed == 0) continue;
+            summaries.emplace_back(site.m_severity,
+                                   "Suppressed " +
+                                     std::to_string(site.m_n_suppressed) +
+                                     " messages like: " + site.m_text);
+            site.m_n_suppressed = 0;
+            site.m_severity     = severity_type::trace;
+        }
+    }
+
+    for(const auto& [severity, msg] : summaries)
+        state.m_sink->log(severity, msg);
+    state.m_sink->flush();
+}
+
+bool LimitingLoggerPIMPL::are_equal_(const LoggerPIMPL& other) const noexcept {
+    auto p = dynamic_cast<const LimitingLoggerPIMPL*>(&other);
+    if(p == nullptr) return false;
+    return m_state_ == p->m_state_;
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+bool LimitingLoggerPIMPL::admit_(severity_type severity,
+                                 std::string_view text) {
+    auto& state = *m_state_;
+    const auto max_per_interval = state.m_limits.max_per_interval;
+    const bool sampled =
+      state.m_sampled || severity >= state.m_limits.all_ranks_severity;
+    if(sampled && max_per_interval == 0) return true;
+
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if(!sampled) {
+        ++state.m_n_unsampled;
+        state.m_unsampled_severity =
+          std::max(state.m_unsampled_severity, severity);
+        return false;
+    }
+
+    // Once max_sites are tracked, new sites share the entry keyed on 0
+    auto key = std::hash<std::string_view>{}(text);
+    if(state.m_sites.size() >= max_sites && !state.m_sites.count(key))
+        key = 0;
+    auto& site = state.m_sites[key];
+
+    const auto now = clock_type::now();
+    if(site.m_n_written == 0 || now - site.m_start >= state.m_limits.interval) {
+        site.m_start     = now;
+        site.m_n_written = 0;
+    }
+    if(site.m_n_written < max_per_interval) {
+        ++site.m_n_written;
+        return true;
+    }
+
+    ++site.m_n_suppressed;
+    site.m_severity = std::max(site.m_severity, severity);
+    if(site.m_text.empty()) site.m_text = text;
+    return false;
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../logger_pimpl.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <parallelzone/logging/logger_factory.hpp>
+#include <unordered_map>
+
+namespace parallelzone::detail_ {
+
+/** @brief Writes the messages which pass rank sampling and rate limiting to
+ *         another LoggerPIMPL, and counts the rest.
+ *
+ *  Whether the current rank is sampled is decided when *this is made. On a
+ *  rank which is not sampled every message less severe than
+ *  LoggerFactory::log_limits::all_ranks_severity is counted, and not written;
+ *  more severe ones are treated as if the rank were sampled. With a rate
+ *  limit, each call site gets a window of
+ *  LoggerFactory::log_limits::interval; the first max_per_interval messages
+ *  from the site in the window are written and the rest are counted. A
+ *  message logged with a template is keyed on the template, one logged as a
+ *  string on the string. At most max_sites sites are tracked, the messages of
+ *  later sites share one extra site.
+ *
+ *  Flushing *this writes a summary of the counted messages, resets the
+ *  counts, and flushes the sink. Copies of *this share the counts, but have
+ *  their own threshold.
+ */
+class LimitingLoggerPIMPL : public LoggerPIMPL {
+public:
+    /// Ultimately a typedef of LoggerFactory::log_limits
+    using limits_type = LoggerFactory::log_limits;
+
+    /// Ultimately a typedef of LoggerFactory::mpi_rank_type
+    using rank_type = LoggerFactory::mpi_rank_type;
+
+    /// Unsigned type used for counting
+    using size_type = std::size_t;
+
+    /// The clock the rate limiting windows are measured with
+    using clock_type = std::chrono::steady_clock;
+
+    /// The maximum number of call sites which are tracked
+    static constexpr size_type max_sites = 4096;
+
+    /** @brief Wraps @p sink so that only what @p limits allows is written.
+     *
+     *  The threshold of *this starts out as the threshold of @p sink, which
+     *  is then lowered to severity::trace.
+     *
+     *  @param[in] sink Where messages which pass the limits are written.
+     *                  Must not be null.
+     *  @param[in] rank The rank *this logs for.
+     *  @param[in] limits Which messages to write.
+     *
+     *  @throw std::out_of_range if @p limits.rank_stride is 0. Strong throw
+     *                           guarantee.
+     *  @throw std::bad_alloc if there is a problem allocating the state.
+     *                        Strong throw guarantee.
+     */
+    LimitingLoggerPIMPL(pimpl_ptr sink, rank_type rank, limits_type limits);
+
+    /// True if messages logged to *this may be written
+    bool sampled() const noexcept;
+
+    /// The number of messages suppressed since the last flush
+    size_type n_suppressed() const;
+
+protected:
+    LimitingLoggerPIMPL(const LimitingLoggerPIMPL&) = default;
+    LimitingLoggerPIMPL& operator=(const LimitingLoggerPIMPL&) = default;
+    LimitingLoggerPIMPL(LimitingLoggerPIMPL&&)                 = default;
+    LimitingLoggerPIMPL& operator=(LimitingLoggerPIMPL&&) = default;
+
+    /// Implemented by calling the copy ctor, the copy shares the counts
+    pimpl_ptr clone_() const override;
+
+    /// Sets the threshold of *this (not of the sink)
+    void set_severity_(severity_type severity) override;
+
+    /// Compares @p severity to the threshold of *this
+    bool should_log_(severity_type severity) const noexcept override;
+
+    /// Writes @p msg if the limits of its site allow it, else counts it
+    void log_(severity_type severity, const_string_reference msg) override;
+
+    /// Passes the template and arguments on if the limits of @p fmt allow it
+    void log_packed_(severity_type severity, std::string_view fmt,
+                     const PackedArgs& args) override;
+
+    /// Writes the summary of the suppressed messages and flushes the sink
+    void flush_() override;
+
+    /// Equal if @p other is a LimitingLoggerPIMPL sharing the counts
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+private:
+    /// The rate limiting state of a call site
+    struct site_type {
+        /// When the current window started
+        clock_type::time_point m_start;
+
+        /// The number of messages written in the current window
+        size_type m_n_written = 0;
+
+        /// The number of messages suppressed since the last flush
+        size_type m_n_suppressed = 0;
+
+        /// The most severe suppressed message's severity
+        severity_type m_severity = severity_type::trace;
+
+        /// The first suppressed message, or template, used in the summary
+        string_type m_text;
+    };
+
+    /// The state shared among copies of *this
+    struct shared_state {
+        /// Where messages are written
+        pimpl_ptr m_sink;
+
+        /// The rank *this logs for
+        rank_type m_rank;
+
+        /// The rate limit and its interval
+        limits_type m_limits;
+
+        /// Whether m_rank writes at all
+        bool m_sampled;
+
+        /// Guards the counts
+        std::mutex m_mutex;
+
+        /// The call sites, keyed on the hash of their template or message
+        std::unordered_map<std::size_t, site_type> m_sites;
+
+        /// Messages suppressed because m_rank is not sampled
+        size_type m_n_unsampled = 0;
+
+        /// The most severe of the messages counted by m_n_unsampled
+        severity_type m_unsampled_severity = severity_type::trace;
+    };
+
+    /// Decides if a message from the site @p text may be written
+    bool admit_(severity_type severity, std::string_view text);
+
+    /// The minimum severity which is logged
+    severity_type m_severity_ = severity_type::info;
+
+    /// The sink, limits, and counts
+    std::shared_ptr<shared_state> m_state_;
+};
+
+} // namespace parallelzone::detail_
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <parallelzone/logging/detail_/packed_args.hpp>
 #include <parallelzone/logging/logger.hpp>
 
 namespace parallelzone::detail_ {
@@ -84,6 +85,25 @@ public:
      */
     void set_severity(severity_type severity) { set_severity_(severity); }
 
+    /** @brief Determines if a message with the provided severity would be
+     *         logged.
+     *
+     *  This method ultimately dispatches to should_log_, which is implemented
+     *  by the derived class. It is meant to be cheap enough to call before
+     *  every message, so that messages which would be discarded need not be
+     *  built.
+     *
+     *  @param[in] severity The severity of the message.
+     *
+     *  @return True if a message with severity @p severity would be logged
+     *          and false otherwise.
+     *
+     *  @throw None No throw guarantee.
+     */
+    bool should_log(severity_type severity) const noexcept {
+        return should_log_(severity);
+    }
+
     /** @brief Logs the provided message and associates with it the provided
      *         severity level.
      *
@@ -107,6 +127,34 @@ public:
         log_(severity, msg);
     }
 
+    /** @brief Logs the message made by formatting @p fmt with @p args.
+     *
+     *  This method ultimately calls log_packed_. Unless the derived class
+     *  overrides log_packed_, the message is formatted (see
+     *  PackedArgs::format) and passed to log_.
+     *
+     *  @param[in] severity How important is this message?
+     *  @param[in] fmt The message template.
+     *  @param[in] args The arguments for the "{}" in @p fmt.
+     *
+     *  @throw ??? It is up to the backend whether this method throws or not
+     *             and what guarantee it provides if it does throw.
+     */
+    void log(severity_type severity, std::string_view fmt,
+             const PackedArgs& args) {
+        log_packed_(severity, fmt, args);
+    }
+
+    /** @brief Writes out the messages logged so far.
+     *
+     *  This method ultimately calls flush_, which is implemented by the
+     *  derived class. After it returns every message logged to *this before
+     *  the call should have reached the sink.
+     *
+     *  @throw ??? Throws if the derived class's implementation throws.
+     */
+    void flush() { flush_(); }
+
     /** @brief Used to polymorphically compare PIMPLs.
      *
      *  Exactly what value equality means depends on the backend. In general,
@@ -159,6 +207,20 @@ protected:
      */
     virtual void set_severity_(severity_type severity) = 0;
 
+    /** @brief Hook for querying the threshold severity.
+     *
+     *  The derived class should override this function so that it returns
+     *  true if, and only if, a message tagged with @p severity would be
+     *  logged.
+     *
+     *  @param[in] severity The severity being queried.
+     *
+     *  @return True if messages with severity @p severity are logged.
+     *
+     *  @throw None No throw guarantee.
+     */
+    virtual bool should_log_(severity_type severity) const noexcept = 0;
+
     /** @brief Hook for actually logging.
      *
      *  The derived class should override this function so that it prints the
@@ -173,6 +235,34 @@ protected:
      */
     virtual void log_(severity_type severity, const_string_reference msg) = 0;
 
+    /** @brief Hook for logging a message template and its arguments.
+     *
+     *  Derived classes which can store the template and arguments more
+     *  cheaply than the formatted message should override this method. The
+     *  default formats the message and calls log_.
+     *
+     *  @param[in] severity How important is this message?
+     *  @param[in] fmt The message template.
+     *  @param[in] args The arguments for the "{}" in @p fmt.
+     *
+     *  @throw ??? Throws if formatting the message, or log_, throws.
+     */
+    virtual void log_packed_(severity_type severity, std::string_view fmt,
+                             const PackedArgs& args) {
+        log_(severity, args.format(fmt));
+    }
+
+    /** @brief Hook for flushing.
+     *
+     *  The derived class should override this function so that, when it
+     *  returns, every message previously passed to log_ has been written to
+     *  the sink.
+     *
+     *  @throw ??? Derived classes may throw if there is a problem writing the
+     *             messages.
+     */
+    virtual void flush_() = 0;
+
     /** @brief Hook for polymorphic value comparison
      *
      *  The most derived class is responsible for attempting to downcast
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <limits>
+#include <parallelzone/logging/detail_/packed_args.hpp>
+#include <stdexcept>
+
+namespace parallelzone::detail_ {
+
+std::string PackedArgs::format(std::string_view fmt) const {
+    const auto* begin = m_buffer_.data();
+    return format(fmt, begin, begin + m_buffer_.size());
+}
+
+std::string PackedArgs::format(std::string_view fmt, const byte_type* begin,
+                               const byte_type* end) {
+    std::ostringstream ss;
+    visit(begin, end, [&](const auto& value) {
+        const auto pos = fmt.find("{}");
+        if(pos == std::string_view::npos) return; // More arguments than "{}"
+        ss << fmt.substr(0, pos) << value;
+        fmt.remove_prefix(pos + 2);
+    });
+    ss << fmt;
+    return ss.str();
+}
+
+void PackedArgs::append_string_(std::string_view value) {
+    using length_type = std::uint32_t;
+    constexpr auto max_length = std::numeric_limits<length_type>::max();
+    if(value.size() > max_length) value = value.substr(0, max_length);
+
+    const length_type n = value.size();
+    append_(tag_type::string, n);
+    const auto offset = m_buffer_.size();
+    m_buffer_.resize(offset + n);
+    std::memcpy(m_buffer_.data() + offset, value.data(), n);
+}
+
+void PackedArgs::corrupt_() {
+    throw std::runtime_error("Packed log arguments are corrupted");
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "per_thread.hpp"
+#include <algorithm>
+
+namespace parallelzone::detail_ {
+namespace {
+
+/// Source of the PerThreadBackend ids
+std::atomic<std::uint64_t> g_next_id = 1;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// -- PerThreadBackend
+// -----------------------------------------------------------------------------
+
+PerThreadBackend::PerThreadBackend(pimpl_ptr sink, size_type buffer_size) :
+  m_sink_(std::move(sink)), m_buffer_size_(buffer_size), m_id_(g_next_id++) {
+    m_thread_ = std::thread([this]() { run_(); });
+}
+
+PerThreadBackend::~PerThreadBackend() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_stop_ = true;
+    }
+    m_cv_.notify_one();
+    if(m_thread_.joinable()) m_thread_.join();
+    for(auto& buffer : m_buffers_) delete buffer.load();
+}
+
+void PerThreadBackend::push(severity_type severity,
+                            const_string_reference msg) {
+    using namespace std::chrono;
+    const auto now = system_clock::now().time_since_epoch();
+
+    auto buffer = my_buffer_();
+    if(buffer == nullptr) {
+        // Too many threads, this one has to take turns with the consumer
+        std::lock_guard<std::mutex> lock(m_consumer_mutex_);
+        m_sink_->log(severity, msg);
+        return;
+    }
+
+    // Swapped with the ring's cells, so in the steady state the strings are
+    // recycled instead of allocated
+    thread_local record_type t_record;
+    t_record.m_time     = duration_cast<nanoseconds>(now).count();
+    t_record.m_severity = severity;
+    t_record.m_msg.assign(msg);
+
+    auto& ring = buffer->m_ring;
+    while(!ring.try_push(t_record)) {
+        // Full, wait for the consumer to make room
+        wake_();
+        std::this_thread::yield();
+    }
+    if(2 * ring.size() >= ring.capacity()) wake_();
+}
+
+void PerThreadBackend::flush() {
+    std::lock_guard<std::mutex> lock(m_consumer_mutex_);
+    drain_();
+    m_sink_->flush();
+}
+
+PerThreadBackend::size_type PerThreadBackend::n_buffered() const noexcept {
+    size_type n        = 0;
+    const auto n_rings = m_n_buffers_.load(std::memory_order_acquire);
+    for(size_type i = 0; i < n_rings; ++i)
+        n += m_buffers_[i].load(std::memory_order_acquire)->m_ring.size();
+    return n;
+}
+
+// -----------------------------------------------------------------------------
+// -- PerThreadBackend private methods
+// -----------------------------------------------------------------------------
+
+PerThreadBackend::buffer_type* PerThreadBackend::my_buffer_() {
+    // The buffer this thread used last, and the id of its backend
+    thread_local std::uint64_t t_id    = 0;
+    thread_local buffer_type* t_buffer = nullptr;
+    if(t_id == m_id_) return t_buffer;
+
+    // Only this thread claims its buffer, so if it's not found it doesn't
+    // have one
+    const auto me       = std::this_thread::get_id();
+    buffer_type* buffer = nullptr;
+    auto n_buffers      = m_n_buffers_.load(std::memory_order_acquire);
+    for(size_type i = 0; i < n_buffers && buffer == nullptr; ++i) {
+        auto p = m_buffers_[i].load(std::memory_order_acquire);
+        if(p->m_in_use->load(std::memory_order_acquire) && p->m_owner == me)
+            buffer = p;
+    }
+
+    if(buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(m_consumer_mutex_);
+        n_buffers = m_n_buffers_.load(std::memory_order_acquire);
+
+        // The ring of an exited thread has no producer, so this thread can
+        // become its producer. Leftover records are drained as usual.
+        for(size_type i = 0; i < n_buffers && buffer == nullptr; ++i) {
+            auto p = m_buffers_[i].load(std::memory_order_acquire);
+            if(!p->m_in_use->load(std::memory_order_acquire)) buffer = p;
+        }
+        if(buffer == nullptr) {
+            if(n_buffers == max_threads) return nullptr;
+            buffer = new buffer_type(m_buffer_size_);
+            m_buffers_[n_buffers].store(buffer, std::memory_order_release);
+            m_n_buffers_.store(n_buffers + 1, std::memory_order_release);
+        }
+        buffer->m_owner = me;
+        release_on_thread_exit(buffer->m_in_use);
+    }
+
+    t_id     = m_id_;
+    t_buffer = buffer;
+    return buffer;
+}
+
+void PerThreadBackend::run_() {
+    while(true) {
+        {
+            std::lock_guard<std::mutex> lock(m_consumer_mutex_);
+            try {
+                drain_();
+            } catch(...) {
+                // There's no one to report the error to, the records are lost
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex_);
+        if(m_stop_) break;
+        m_sleeping_.store(true);
+        m_cv_.wait_for(lock, idle_interval,
+                       [this]() { return m_stop_ || m_wake_.load(); });
+        m_sleeping_.store(false);
+        m_wake_.store(false);
+    }
+
+    // Stopping: nobody else holds *this, so nothing else will be buffered
+    std::lock_guard<std::mutex> lock(m_consumer_mutex_);
+    try {
+        drain_();
+        m_sink_->flush();
+    } catch(...) {}
+}
+
+void PerThreadBackend::drain_() {
+    // m_batch_'s records are swapped with the rings' cells, so its strings
+    // are recycled too. n is how much of m_batch_ is in use.
+    size_type n          = 0;
+    const auto n_buffers = m_n_buffers_.load(std::memory_order_acquire);
+    for(size_type i = 0; i < n_buffers; ++i) {
+        auto& ring = m_buffers_[i].load(std::memory_order_acquire)->m_ring;
+        // At most one ring's worth, so a busy thread can't keep us here
+        for(size_type j = 0; j < ring.capacity(); ++j, ++n) {
+            if(n == m_batch_.size()) m_batch_.emplace_back();
+            if(!ring.try_pop(m_batch_[n].second)) break;
+            m_batch_[n].first = i;
+        }
+    }
+
+    // Each ring is in time order, stable keeps equal times in thread order
+    const auto end = m_batch_.begin() + n;
+    std::stable_sort(m_batch_.begin(), end,
+                     [](const auto& lhs, const auto& rhs) {
+                         return lhs.second.m_time < rhs.second.m_time;
+                     });
+    for(auto it = m_batch_.begin(); it != end; ++it)
+        m_sink_->log(it->second.m_severity, it->second.m_msg);
+}
+
+void PerThreadBackend::wake_() noexcept {
+    if(!m_sleeping_.load(std::memory_order_relaxed)) return;
+    m_wake_.store(true);
+    m_cv_.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+// -- PerThreadLoggerPIMPL
+// -----------------------------------------------------------------------------
+
+PerThreadLoggerPIMPL::PerThreadLoggerPIMPL(pimpl_ptr sink,
+                                           size_type buffer_size) {
+    sink->set_severity(severity_type::trace);
+    m_backend_ = std::make_shared<backend_type>(std::move(sink), buffer_size);
+}
+
+PerThreadLoggerPIMPL::pimpl_ptr PerThreadLoggerPIMPL::clone_() const {
+    using self_type = PerThreadLoggerPIMPL;
+    return std::unique_ptr<self_type>(new self_type(*this));
+}
+
+void PerThreadLoggerPIMPL::set_severity_(severity_type severity) {
+    m_severity_ = severity;
+}
+
+bool PerThreadLoggerPIMPL::should_log_(severity_type severity) const noexcept {
+    return severity >= m_severity_;
+}
+
+void PerThreadLoggerPIMPL::log_(severity_type severity,
+                                const_string_reference msg) {
+    if(!should_log_(severity)) return;
+    m_backend_->push(severity, msg);
+}
+
+void PerThreadLoggerPIMPL::flush_() { m_backend_->flush(); }
+
+bool PerThreadLoggerPIMPL::are_equal_(const LoggerPIMPL& other) const noexcept {
+    auto p = dynamic_cast<const PerThreadLoggerPIMPL*>(&other);
+    if(p == nullptr) return false;
+    return m_backend_ == p->m_backend_;
+}
+
+} // namespace parallelzone::detail_
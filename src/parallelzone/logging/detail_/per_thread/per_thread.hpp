@@ -0,0 +1,263 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "../logger_pimpl.hpp"
+#include "../thread_slot.hpp"
+#include "spsc_ring.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallelzone::detail_ {
+
+/** @brief The per-thread buffers and the consumer shared by copies of a
+ *         PerThreadLoggerPIMPL.
+ *
+ *  The first time a thread logs it gets its own SpscRing of records. After
+ *  that, logging only writes to the thread's ring: no lock is taken and no
+ *  cache line is shared with the other producing threads. A single consumer
+ *  empties the rings, merges their records by time stamp, and writes them to
+ *  the wrapped sink. The consumer is a background thread, which wakes up
+ *  every idle_interval (or when a ring is half full), or a thread calling
+ *  flush; the two take turns via a mutex, so each ring still has one consumer
+ *  at a time.
+ *
+ *  A thread whose ring is full waits for the consumer. When a thread exits
+ *  its ring is marked free, and the next thread which needs a ring takes it
+ *  over; records the exited thread left in the ring are still written, before
+ *  those of the new thread. Once max_threads rings are owned by running
+ *  threads, further threads do not get a ring and instead write to the sink
+ *  while holding the consumer's mutex.
+ */
+class PerThreadBackend {
+public:
+    /// Ultimately a typedef of LoggerPIMPL::pimpl_ptr
+    using pimpl_ptr = LoggerPIMPL::pimpl_ptr;
+
+    /// Ultimately a typedef of LoggerPIMPL::severity_type
+    using severity_type = LoggerPIMPL::severity_type;
+
+    /// Ultimately a typedef of LoggerPIMPL::string_type
+    using string_type = LoggerPIMPL::string_type;
+
+    /// Ultimately a typedef of LoggerPIMPL::const_string_reference
+    using const_string_reference = LoggerPIMPL::const_string_reference;
+
+    /// Unsigned type used for counting
+    using size_type = std::size_t;
+
+    /// A buffered message
+    struct record_type {
+        std::int64_t m_time = 0;
+        severity_type m_severity = severity_type::info;
+        string_type m_msg;
+    };
+
+    /// The records of one thread
+    struct buffer_type {
+        explicit buffer_type(size_type n) : m_ring(n) {}
+
+        /// The thread which writes to *this
+        std::atomic<std::thread::id> m_owner = std::this_thread::get_id();
+
+        /// True while m_owner is running, see release_on_thread_exit
+        thread_slot_flag m_in_use = std::make_shared<std::atomic<bool>>();
+
+        /// The records
+        SpscRing<record_type> m_ring;
+    };
+
+    /// The maximum number of running threads which get a buffer
+    static constexpr size_type max_threads = 256;
+
+    /// How long the background thread sleeps when it has nothing to do
+    static constexpr std::chrono::milliseconds idle_interval{10};
+
+    /** @brief Starts the consumer thread which writes to @p sink.
+     *
+     *  @param[in] sink Where the messages are written.
+     *  @param[in] buffer_size The minimum number of records each thread's
+     *                         buffer holds.
+     *
+     *  @throw std::system_error if the thread can not be started. Strong
+     *                           throw guarantee.
+     */
+    PerThreadBackend(pimpl_ptr sink, size_type buffer_size);
+
+    /// Not copyable, *this owns a thread
+    PerThreadBackend(const PerThreadBackend&) = delete;
+
+    /// Not copyable, *this owns a thread
+    PerThreadBackend& operator=(const PerThreadBackend&) = delete;
+
+    /// Writes the buffered records, flushes the sink, and joins the thread
+    ~PerThreadBackend() noexcept;
+
+    /** @brief Buffers @p msg in the calling thread's buffer.
+     *
+     *  @param[in] severity The severity of the message.
+     *  @param[in] msg The message.
+     *
+     *  @throw std::bad_alloc if there is a problem making the thread's buffer
+     *                        or copying @p msg. Strong throw guarantee.
+     */
+    void push(severity_type severity, const_string_reference msg);
+
+    /** @brief Writes every record buffered before the call and flushes the
+     *         sink.
+     *
+     *  @throw ??? Throws if the sink throws. Records which were taken out of
+     *             the buffers before the throw are lost.
+     */
+    void flush();
+
+    /// The number of buffers made, buffers of exited threads are reused
+    size_type n_buffers() const noexcept { return m_n_buffers_.load(); }
+
+    /// The number of records waiting to be written, summed over the threads
+    size_type n_buffered() const noexcept;
+
+private:
+    /// The calling thread's buffer, taken over from an exited thread or made
+    /// if need be (null if max_threads running threads have buffers)
+    buffer_type* my_buffer_();
+
+    /// The body of the background thread
+    void run_();
+
+    /// Empties the buffers and writes their records. Caller holds
+    /// m_consumer_mutex_.
+    void drain_();
+
+    /// Wakes the background thread if it is sleeping
+    void wake_() noexcept;
+
+    /// Where the records are written
+    pimpl_ptr m_sink_;
+
+    /// The minimum number of records per buffer
+    size_type m_buffer_size_;
+
+    /// Distinguishes *this from other (possibly since freed) backends
+    std::uint64_t m_id_;
+
+    /// Number of entries of m_buffers_ which are in use
+    std::atomic<size_type> m_n_buffers_{0};
+
+    /// The buffers, in the order they were made
+    std::array<std::atomic<buffer_type*>, max_threads> m_buffers_{};
+
+    /// Serializes consumers, the sink, and the making of buffers
+    std::mutex m_consumer_mutex_;
+
+    /// Records taken out of the buffers, and which thread they came from
+    std::vector<std::pair<size_type, record_type>> m_batch_;
+
+    /// True while the background thread is (about to be) waiting on m_cv_
+    std::atomic<bool> m_sleeping_{false};
+
+    /// Set by wake_ so the background thread stops waiting
+    std::atomic<bool> m_wake_{false};
+
+    /// Guards m_stop_
+    std::mutex m_mutex_;
+
+    /// Used to wake the background thread
+    std::condition_variable m_cv_;
+
+    /// Set when *this is being destroyed
+    bool m_stop_ = false;
+
+    /// The background thread
+    std::thread m_thread_;
+};
+
+/** @brief Logs through per-thread buffers to the sink of another
+ *         LoggerPIMPL.
+ *
+ *  Logging to *this only compares the severity to the threshold and buffers
+ *  the message with a PerThreadBackend, so threads logging at the same time
+ *  do not contend on a lock. Copies of *this share the backend, but have
+ *  their own threshold.
+ */
+class PerThreadLoggerPIMPL : public LoggerPIMPL {
+public:
+    /// Type of the state shared among copies
+    using backend_type = PerThreadBackend;
+
+    /// Type of a pointer to the shared state
+    using backend_pointer = std::shared_ptr<backend_type>;
+
+    /// Ultimately a typedef of PerThreadBackend::size_type
+    using size_type = backend_type::size_type;
+
+    /** @brief Creates a logger which writes to @p sink through per-thread
+     *         buffers.
+     *
+     *  The threshold of *this is severity::info. Since *this does the
+     *  filtering, the threshold of @p sink is set to severity::trace.
+     *
+     *  @param[in] sink The LoggerPIMPL which writes the messages.
+     *  @param[in] buffer_size The minimum number of messages each thread can
+     *                         buffer.
+     *
+     *  @throw std::system_error if the consumer thread can not be started.
+     *                           Strong throw guarantee.
+     */
+    PerThreadLoggerPIMPL(pimpl_ptr sink, size_type buffer_size);
+
+    /// The state shared with copies of *this
+    const backend_type& backend() const noexcept { return *m_backend_; }
+
+protected:
+    PerThreadLoggerPIMPL(const PerThreadLoggerPIMPL&) = default;
+    PerThreadLoggerPIMPL& operator=(const PerThreadLoggerPIMPL&) = default;
+    PerThreadLoggerPIMPL(PerThreadLoggerPIMPL&&)                 = default;
+    PerThreadLoggerPIMPL& operator=(PerThreadLoggerPIMPL&&) = default;
+
+    /// Implemented by calling the copy ctor, the copy shares the backend
+    pimpl_ptr clone_() const override;
+
+    /// Sets the threshold of *this (not of the sink)
+    void set_severity_(severity_type severity) override;
+
+    /// Compares @p severity to the threshold of *this
+    bool should_log_(severity_type severity) const noexcept override;
+
+    /// Buffers @p msg if it is at least the threshold
+    void log_(severity_type severity, const_string_reference msg) override;
+
+    /// Writes the buffered messages and flushes the sink
+    void flush_() override;
+
+    /// Equal if @p other is a PerThreadLoggerPIMPL sharing the backend
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+private:
+    /// The minimum severity which is logged
+    severity_type m_severity_ = severity_type::info;
+
+    /// The buffers and the consumer
+    backend_pointer m_backend_;
+};
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace parallelzone::detail_ {
+
+/** @brief A fixed-capacity, lock-free, single-producer/single-consumer queue.
+ *
+ *  Only one thread may push and only one thread may pop (at a time), which
+ *  lets both operations get away with a load and a store of an atomic
+ *  position; unlike BoundedQueue there is no compare-and-swap and no
+ *  contention between producers. Elements are exchanged with the cells via
+ *  swap, so the caller gets back the element previously held by the cell.
+ *  For elements which own memory (e.g., strings) this recycles the memory
+ *  instead of allocating for every element.
+ *
+ *  @tparam T The type of the elements. Must be default constructible and
+ *            swappable.
+ */
+template<typename T>
+class SpscRing {
+public:
+    /// Type of the elements
+    using value_type = T;
+
+    /// Unsigned type used for sizes and positions
+    using size_type = std::size_t;
+
+    /** @brief Creates an empty queue which holds at least @p capacity
+     *         elements.
+     *
+     *  @param[in] capacity The minimum number of elements the queue can hold.
+     *                      It is rounded up to a power of two (and to at least
+     *                      two).
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the ring.
+     *                        Strong throw guarantee.
+     */
+    explicit SpscRing(size_type capacity);
+
+    /// Not copyable, elements are in flight between threads
+    SpscRing(const SpscRing&) = delete;
+
+    /// Not copyable, elements are in flight between threads
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /// The maximum number of elements the queue can hold
+    size_type capacity() const noexcept { return m_mask_ + 1; }
+
+    /** @brief Adds @p value to the back of the queue, if there is room.
+     *
+     *  Must only be called by the producer.
+     *
+     *  @param[in,out] value The element to add. If the push succeeds it is
+     *                       swapped with the stale element held by the cell.
+     *
+     *  @return True if @p value was added and false if the queue was full.
+     *
+     *  @throw None No throw guarantee if swapping T is no throw.
+     */
+    bool try_push(value_type& value);
+
+    /** @brief Removes the element at the front of the queue, if there is one.
+     *
+     *  Must only be called by the consumer.
+     *
+     *  @param[in,out] value Swapped with the removed element. Only modified
+     *                       if the pop succeeds.
+     *
+     *  @return True if an element was removed and false if the queue was
+     *          empty.
+     *
+     *  @throw None No throw guarantee if swapping T is no throw.
+     */
+    bool try_pop(value_type& value);
+
+    /** @brief The number of elements in the queue.
+     *
+     *  When the producer or consumer is active the answer may be stale by the
+     *  time it is returned.
+     */
+    size_type size() const noexcept;
+
+    /// Is the queue empty? Subject to the same caveat as size().
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    /// Keeps the positions on different cache lines to avoid false sharing
+    static constexpr size_type cache_line = 64;
+
+    /// capacity() - 1, used to map positions to cells
+    size_type m_mask_;
+
+    /// The ring buffer
+    std::unique_ptr<value_type[]> m_cells_;
+
+    /// The position the next push will write to, only stored by the producer
+    alignas(cache_line) std::atomic<size_type> m_tail_{0};
+
+    /// The position the next pop will read from, only stored by the consumer
+    alignas(cache_line) std::atomic<size_type> m_head_{0};
+};
+
+} // namespace parallelzone::detail_
+
+#include "spsc_ring.ipp"
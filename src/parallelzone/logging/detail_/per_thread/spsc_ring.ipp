@@ -0,0 +1,60 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+/** @file spsc_ring.ipp
+ *
+ *  This file contains the inline definitions for the SpscRing class. It is
+ *  meant only for inclusion by spsc_ring.hpp
+ */
+
+namespace parallelzone::detail_ {
+
+template<typename T>
+SpscRing<T>::SpscRing(size_type capacity) : m_mask_(1) {
+    while(m_mask_ + 1 < capacity) m_mask_ = (m_mask_ << 1) | 1;
+    m_cells_ = std::make_unique<value_type[]>(m_mask_ + 1);
+}
+
+template<typename T>
+bool SpscRing<T>::try_push(value_type& value) {
+    const auto tail = m_tail_.load(std::memory_order_relaxed);
+    // Acquire, so the consumer is done with the cell before we reuse it
+    if(tail - m_head_.load(std::memory_order_acquire) > m_mask_) return false;
+    using std::swap;
+    swap(m_cells_[tail & m_mask_], value);
+    m_tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool SpscRing<T>::try_pop(value_type& value) {
+    const auto head = m_head_.load(std::memory_order_relaxed);
+    // Acquire, so the producer's writes to the cell are visible
+    if(head == m_tail_.load(std::memory_order_acquire)) return false;
+    using std::swap;
+    swap(value, m_cells_[head & m_mask_]);
+    m_head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+typename SpscRing<T>::size_type SpscRing<T>::size() const noexcept {
+    const auto head = m_head_.load(std::memory_order_acquire);
+    return m_tail_.load(std::memory_order_acquire) - head;
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "spdlog.hpp"
+
+namespace parallelzone::detail_ {
+
+/** @brief Logger which writes to a file, starting a new file when the current
+ *         one gets too big.
+ *
+ *  This class specializes SpdlogPIMPL for when the sink is a rotating set of
+ *  files. When writing a message would make the file exceed the maximum size,
+ *  the file is renamed (e.g., "log.txt" becomes "log.1.txt", "log.1.txt"
+ *  becomes "log.2.txt", etc.), the oldest file is removed if there are too
+ *  many, and logging continues in a new, empty file.
+ */
+class RotatingFileSpdlog : public SpdlogPIMPL {
+public:
+    /// Unsigned type used for sizes
+    using size_type = std::size_t;
+
+    /** @brief Creates a LoggerPIMPL whose sink is a rotating set of files.
+     *
+     *  If the file already exists the resulting logger will append to it.
+     *
+     *  @param[in] id An ID for the logger.
+     *  @param[in] file_name The path to the file which is currently being
+     *                       written. If @p file_name is relative it will be
+     *                       created relative to where the program is
+     *                       currently running.
+     *  @param[in] max_size The maximum size, in bytes, of a file.
+     *  @param[in] max_files The maximum number of rotated files kept, in
+     *                       addition to @p file_name.
+     *
+     *  @throw spdlog::spdlog_ex if the file can not be opened. Strong throw
+     *                           guarantee.
+     */
+    RotatingFileSpdlog(const_string_reference id,
+                       const_string_reference file_name, size_type max_size,
+                       size_type max_files);
+
+protected:
+    RotatingFileSpdlog(const RotatingFileSpdlog&) = default;
+    RotatingFileSpdlog& operator=(const RotatingFileSpdlog&) = default;
+    RotatingFileSpdlog(RotatingFileSpdlog&&)                 = default;
+    RotatingFileSpdlog& operator=(RotatingFileSpdlog&&) = default;
+
+    /// Implemented by calling the copy ctor on *this
+    pimpl_ptr clone_() const override;
+
+    /// If other is RotatingFileSpdlog object, compares file names then calls
+    /// SpdlogPIMPL::are_equal_(other)
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override;
+
+    /// Copy of the file name for comparisons
+    string_type m_file_name_;
+};
+
+} // namespace parallelzone::detail_
@@ -73,10 +73,16 @@ void SpdlogPIMPL::set_severity_(severity_type severity) {
     m_logger_.set_level(map_severity_levels(severity));
 }
 
+bool SpdlogPIMPL::should_log_(severity_type severity) const noexcept {
+    return m_logger_.should_log(map_severity_levels(severity));
+}
+
 void SpdlogPIMPL::log_(severity_type severity, const_string_reference msg) {
     m_logger_.log(map_severity_levels(severity), msg);
 }
 
+void SpdlogPIMPL::flush_() { m_logger_.flush(); }
+
 bool SpdlogPIMPL::are_equal_(const LoggerPIMPL& other) const noexcept {
     auto p = dynamic_cast<const SpdlogPIMPL*>(&other);
     if(p == nullptr) return false;
@@ -60,9 +60,15 @@ protected:
     /// Implements set_severity_ by setting the level on m_logger_
     void set_severity_(severity_type severity) override;
 
+    /// Implements should_log_ by asking m_logger_
+    bool should_log_(severity_type severity) const noexcept override;
+
     /// Implements LoggerPIMPL::log by dispatching to spdlog::logger::log
     void log_(severity_type severity, const_string_reference msg) override;
 
+    /// Implements LoggerPIMPL::flush by dispatching to spdlog::logger::flush
+    void flush_() override;
+
     /** @brief Implements LoggerPIMPL::are_equal by downcasting @p other and
      *         comparing m_logger_ to other.m_logger_
      *
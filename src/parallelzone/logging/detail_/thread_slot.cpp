@@ -0,0 +1,48 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <limits>
+
+#include "thread_slot.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace parallelzone::detail_ {
+namespace {
+
+/// Clears the flags of the calling thread's slots when the thread exits
+struct ThreadSlots {
+    ~ThreadSlots() noexcept {
+        for(auto& flag : m_flags) flag->store(false, std::memory_order_release);
+    }
+
+    /// The flags of the slots the thread owns
+    std::vector<thread_slot_flag> m_flags;
+};
+
+} // namespace
+
+void release_on_thread_exit(const thread_slot_flag& flag) {
+    thread_local ThreadSlots t_slots;
+    auto& flags = t_slots.m_flags;
+
+    // Flags nobody else holds belong to slots which were freed
+    auto freed = [](const auto& f) { return f.use_count() == 1; };
+    flags.erase(std::remove_if(flags.begin(), flags.end(), freed), flags.end());
+    flags.push_back(flag);
+    flag->store(true, std::memory_order_release);
+}
+
+} // namespace parallelzone::detail_
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <limits>
+
+#pragma once
+#include <atomic>
+#include <memory>
+
+namespace parallelzone::detail_ {
+
+/** @brief Shared between a per-thread slot (e.g., a ring of messages) and the
+ *         thread which owns it; true while the thread is running.
+ *
+ *  The per-thread loggers hand each thread which logs a slot of its own.
+ *  Without this, the slots of threads which have finished would stay taken,
+ *  and a program which starts many short-lived threads would run out of
+ *  them. The flag is shared, so it outlives the slot (or the thread) if need
+ *  be.
+ */
+using thread_slot_flag = std::shared_ptr<std::atomic<bool>>;
+
+/** @brief Sets @p flag to true, and back to false when the calling thread
+ *         exits.
+ *
+ *  The store at exit has release semantics, so once a thread which claims the
+ *  slot reads false (with acquire semantics) it sees everything the exiting
+ *  thread wrote to the slot.
+ *
+ *  @param[in] flag The flag of the slot the calling thread now owns. Must not
+ *                  be null.
+ *
+ *  @throw std::bad_alloc if there is a problem recording @p flag. Strong
+ *                        throw guarantee.
+ */
+void release_on_thread_exit(const thread_slot_flag& flag);
+
+} // namespace parallelzone::detail_
@@ -74,8 +74,16 @@ Logger& Logger::log(severity s, const_string_reference msg) {
     return *this;
 }
 
+bool Logger::should_log(severity s) const noexcept {
+    return has_pimpl_() && m_pimpl_->should_log(s);
+}
+
 Logger& Logger::operator<<(const_string_reference msg) { return log(msg); }
 
+void Logger::flush() {
+    if(m_pimpl_) m_pimpl_->flush();
+}
+
 // -----------------------------------------------------------------------------
 // -- Utility
 // -----------------------------------------------------------------------------
@@ -98,4 +106,10 @@ bool Logger::operator!=(const Logger& rhs) const noexcept {
 
 bool Logger::has_pimpl_() const noexcept { return static_cast<bool>(m_pimpl_); }
 
+Logger& Logger::log_packed_(severity s, std::string_view fmt,
+                            const detail_::PackedArgs& args) {
+    if(m_pimpl_) m_pimpl_->log(s, fmt, args);
+    return *this;
+}
+
 } // namespace parallelzone
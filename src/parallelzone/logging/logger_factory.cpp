@@ -14,8 +14,19 @@
  * limitations under the License.
  */
 
+#include "detail_/aggregating/aggregating.hpp"
+#include "detail_/async/async.hpp"
+#include "detail_/binary/binary_file.hpp"
+#include "detail_/flight_recorder/flight_recorder.hpp"
+#include "detail_/limiting/limiting.hpp"
+#include "detail_/per_thread/per_thread.hpp"
+#include "detail_/spdlog/file.hpp"
+#include "detail_/spdlog/rotating_file.hpp"
 #include "detail_/spdlog/stdout.hpp"
+#include <filesystem>
 #include <parallelzone/logging/logger_factory.hpp>
+#include <stdexcept>
+#include <string>
 
 namespace parallelzone {
 
@@ -29,4 +40,95 @@ LoggerFactory::logger_type LoggerFactory::default_global_logger(
     return log;
 }
 
+LoggerFactory::logger_type LoggerFactory::file_logger(
+  const_string_reference file_name, size_type max_size, size_type max_files) {
+    if(max_size == 0)
+        return Logger(std::make_unique<detail_::FileSpdlog>(file_name,
+                                                            file_name));
+    using pimpl_type = detail_::RotatingFileSpdlog;
+    return Logger(std::make_unique<pimpl_type>(file_name, file_name, max_size,
+                                               max_files));
+}
+
+LoggerFactory::logger_type LoggerFactory::rank_file_logger(
+  mpi_rank_type rank, const_string_reference directory, size_type max_size,
+  size_type max_files) {
+    std::filesystem::path dir(directory);
+    std::filesystem::create_directories(dir);
+    const auto file_name = "log.rank" + std::to_string(rank) + ".txt";
+    return file_logger((dir / file_name).string(), max_size, max_files);
+}
+
+LoggerFactory::logger_type LoggerFactory::binary_file_logger(
+  mpi_rank_type rank, const_string_reference directory) {
+    std::filesystem::path dir(directory);
+    std::filesystem::create_directories(dir);
+    const auto file_name = "log.rank" + std::to_string(rank) + ".pzlog";
+    return Logger(std::make_unique<detail_::BinaryFilePIMPL>(
+      (dir / file_name).string(), rank));
+}
+
+LoggerFactory::logger_type LoggerFactory::make_async(logger_type logger,
+                                                     size_type queue_size,
+                                                     overflow_policy policy) {
+    if(queue_size == 0)
+        throw std::out_of_range("An asynchronous logger needs a queue");
+    if(!logger.has_pimpl_()) return logger;
+
+    using pimpl_type = detail_::AsyncLoggerPIMPL;
+    auto sink        = std::move(logger.m_pimpl_);
+    return Logger(std::make_unique<pimpl_type>(std::move(sink), queue_size,
+                                               policy));
+}
+
+LoggerFactory::logger_type LoggerFactory::make_per_thread(
+  logger_type logger, size_type buffer_size) {
+    if(buffer_size == 0)
+        throw std::out_of_range("A per-thread logger needs buffers");
+    if(!logger.has_pimpl_()) return logger;
+
+    using pimpl_type = detail_::PerThreadLoggerPIMPL;
+    auto sink        = std::move(logger.m_pimpl_);
+    return Logger(std::make_unique<pimpl_type>(std::move(sink), buffer_size));
+}
+
+LoggerFactory::logger_type LoggerFactory::make_aggregating(
+  comm_type comm, logger_type sink, mpi_rank_type root) {
+    if(root >= mpi_rank_type(comm.size()))
+        throw std::out_of_range("Root rank " + std::to_string(root) +
+                                " is not in the communicator");
+
+    using pimpl_type = detail_::AggregatingLoggerPIMPL;
+    using rank_type  = pimpl_type::rank_type;
+    return Logger(std::make_unique<pimpl_type>(
+      std::move(comm), std::move(sink.m_pimpl_), rank_type(root)));
+}
+
+LoggerFactory::logger_type LoggerFactory::make_limited(logger_type logger,
+                                                       mpi_rank_type rank,
+                                                       log_limits limits) {
+    if(limits.rank_stride == 0)
+        throw std::out_of_range("The rank stride must be at least 1");
+    if(!logger.has_pimpl_()) return logger;
+
+    using pimpl_type = detail_::LimitingLoggerPIMPL;
+    return Logger(std::make_unique<pimpl_type>(std::move(logger.m_pimpl_),
+                                               rank, std::move(limits)));
+}
+
+LoggerFactory::logger_type LoggerFactory::make_flight_recorder(
+  logger_type sink, size_type n_records, Logger::severity dump_severity) {
+    using pimpl_type = detail_::FlightRecorderPIMPL;
+    return Logger(std::make_unique<pimpl_type>(std::move(sink.m_pimpl_),
+                                               n_records, dump_severity));
+}
+
+void LoggerFactory::dump_flight_recorders() noexcept {
+    detail_::FlightRecorderPIMPL::dump_all();
+}
+
+void LoggerFactory::dump_flight_recorders_on(int signal_number) {
+    detail_::FlightRecorderPIMPL::install_signal_handler(signal_number);
+}
+
 } // namespace parallelzone
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <new>
+#include <parallelzone/mpi_helpers/binary_buffer/buffer_pool.hpp>
+#include <set>
+#include <vector>
+
+namespace parallelzone::mpi_helpers {
+namespace {
+
+// Used to give each pool a distinct id
+std::atomic<std::uint64_t> g_next_id{0};
+
+// Guards live_pools(), and keeps a pool alive while a thread gives it blocks.
+// Both are leaked so that they outlive the thread caches.
+std::mutex& registry_mutex() {
+    static auto* mutex = new std::mutex;
+    return *mutex;
+}
+
+// The ids of the pools which have not been destroyed
+std::set<std::uint64_t>& live_pools() {
+    static auto* ids = new std::set<std::uint64_t>;
+    return *ids;
+}
+
+// Set once the calling thread's cache is destroyed, i.e., the thread is
+// exiting. Blocks released after that bypass the cache.
+thread_local bool t_cache_destroyed = false;
+
+} // namespace
+
+struct BufferPool::CacheEntry {
+    /// The pool the blocks are cached for
+    BufferPool* pool;
+
+    /// The id of the pool
+    std::uint64_t id;
+
+    /// Heads of the free lists, one per size class
+    std::array<FreeBlock*, n_classes_> free{};
+
+    /// The number of blocks in each free list
+    std::array<size_type, n_classes_> n_free{};
+
+    /// Frees the blocks, for when the pool was destroyed
+    void clear() noexcept {
+        for(auto& head : free) {
+            while(head != nullptr) {
+                auto* p = head;
+                head    = p->m_next;
+                ::operator delete(p);
+            }
+        }
+        n_free.fill(0);
+    }
+};
+
+struct BufferPool::ThreadCache {
+    /// One entry per pool the thread used
+    std::vector<CacheEntry> entries;
+
+    /// Gives the blocks back to the pools which still exist
+    ~ThreadCache() noexcept {
+        t_cache_destroyed = true;
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        for(auto& entry : entries) {
+            if(live_pools().count(entry.id))
+                entry.pool->absorb_(entry);
+            else
+                entry.clear();
+        }
+    }
+};
+
+BufferPool::BufferPool(size_type max_cached_bytes) noexcept :
+  m_id_(g_next_id++), m_max_cached_(max_cached_bytes) {
+    try {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        live_pools().insert(m_id_);
+    } catch(...) {
+        // Not registered, so threads free their blocks instead of returning
+        // them, which is always safe
+    }
+}
+
+BufferPool::~BufferPool() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        live_pools().erase(m_id_);
+    }
+    if(auto* entry = cache_entry_(false)) absorb_(*entry);
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    shrink_to_(0);
+}
+
+BufferPool& BufferPool::default_pool() noexcept {
+    // Intentionally leaked, see the description
+    static auto* pool = new BufferPool;
+    return *pool;
+}
+
+BufferPool::size_type BufferPool::block_size(size_type n) noexcept {
+    if(n > max_block_size) return n;
+    size_type block = min_block_size;
+    while(block < n) block <<= 1;
+    return block;
+}
+
+BufferPool::pointer BufferPool::acquire(size_type n) {
+    const auto block  = block_size(n);
+    const bool pooled = block <= max_block_size;
+    ++m_stats_.n_acquires;
+
+    // Lock-free if the calling thread has a block of the right size
+    CacheEntry* entry = nullptr;
+    if(block <= thread_cache_max_block) entry = cache_entry_();
+    if(entry != nullptr) {
+        const auto i = size_class_(block);
+        if(auto* p = entry->free[i]) {
+            entry->free[i] = p->m_next;
+            --entry->n_free[i];
+            ++m_stats_.n_hits;
+            m_stats_.bytes_cached -= block;
+            add_in_use_(block);
+            return reinterpret_cast<pointer>(p);
+        }
+    }
+
+    hook_type hook;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        if(pooled) {
+            auto& head = m_free_[size_class_(block)];
+            if(head != nullptr) {
+                auto* p = head;
+                head    = p->m_next;
+                ++m_stats_.n_hits;
+                m_stats_.bytes_cached -= block;
+                add_in_use_(block);
+                return reinterpret_cast<pointer>(p);
+            }
+        }
+        if(m_miss_hook_) hook = m_miss_hook_;
+    }
+    ++m_stats_.n_misses;
+
+    auto p = static_cast<pointer>(::operator new(block));
+    add_in_use_(block);
+
+    if(hook) {
+        try {
+            hook(block);
+        } catch(...) {
+            release(p, block);
+            throw;
+        }
+    }
+    return p;
+}
+
+void BufferPool::release(pointer p, size_type n) noexcept {
+    if(p == nullptr) return;
+    const auto block = block_size(n);
+    ++m_stats_.n_releases;
+    m_stats_.bytes_in_use -= block;
+
+    auto* free_block = reinterpret_cast<FreeBlock*>(p);
+    const bool pooled =
+      block <= max_block_size &&
+      m_stats_.bytes_cached.load() + block <= m_max_cached_.load();
+    if(pooled && block <= thread_cache_max_block) {
+        auto* entry  = cache_entry_();
+        const auto i = size_class_(block);
+        if(entry != nullptr && entry->n_free[i] < thread_cache_depth) {
+            free_block->m_next = entry->free[i];
+            entry->free[i]     = free_block;
+            ++entry->n_free[i];
+            m_stats_.bytes_cached += block;
+            return;
+        }
+    }
+    if(pooled) {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        auto& head         = m_free_[size_class_(block)];
+        free_block->m_next = head;
+        head               = free_block;
+        m_stats_.bytes_cached += block;
+        return;
+    }
+    ::operator delete(p);
+}
+
+void BufferPool::trim() noexcept {
+    if(auto* entry = cache_entry_()) absorb_(*entry);
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    shrink_to_(0);
+}
+
+BufferPool::Statistics BufferPool::stats() const noexcept {
+    Statistics rv;
+    rv.n_acquires        = m_stats_.n_acquires;
+    rv.n_hits            = m_stats_.n_hits;
+    rv.n_misses          = m_stats_.n_misses;
+    rv.n_releases        = m_stats_.n_releases;
+    rv.bytes_in_use      = m_stats_.bytes_in_use;
+    rv.bytes_cached      = m_stats_.bytes_cached;
+    rv.peak_bytes_in_use = m_stats_.peak_bytes_in_use;
+    return rv;
+}
+
+void BufferPool::reset_stats() noexcept {
+    m_stats_.n_acquires        = 0;
+    m_stats_.n_hits            = 0;
+    m_stats_.n_misses          = 0;
+    m_stats_.n_releases        = 0;
+    m_stats_.peak_bytes_in_use = m_stats_.bytes_in_use.load();
+}
+
+void BufferPool::set_miss_hook(hook_type hook) noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_miss_hook_.swap(hook);
+}
+
+BufferPool::size_type BufferPool::max_cached_bytes() const noexcept {
+    return m_max_cached_;
+}
+
+void BufferPool::set_max_cached_bytes(size_type n) noexcept {
+    m_max_cached_ = n;
+    if(auto* entry = cache_entry_()) absorb_(*entry);
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    shrink_to_(n);
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+BufferPool::size_type BufferPool::size_class_(size_type block) noexcept {
+    size_type i = 0;
+    for(auto b = min_block_size; b < block; b <<= 1) ++i;
+    return i;
+}
+
+BufferPool::CacheEntry* BufferPool::cache_entry_(bool create) noexcept {
+    if(t_cache_destroyed) return nullptr;
+    static thread_local ThreadCache cache;
+    for(auto& entry : cache.entries)
+        if(entry.pool == this && entry.id == m_id_) return &entry;
+    if(!create) return nullptr;
+
+    // First use of *this by the calling thread. Entries of destroyed pools
+    // are dropped here, so they do not pile up on long-lived threads.
+    try {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        auto& entries = cache.entries;
+        for(auto itr = entries.begin(); itr != entries.end();) {
+            if(live_pools().count(itr->id)) {
+                ++itr;
+                continue;
+            }
+            itr->clear();
+            itr = entries.erase(itr);
+        }
+        entries.push_back(CacheEntry{this, m_id_});
+        return &entries.back();
+    } catch(...) { return nullptr; }
+}
+
+void BufferPool::absorb_(CacheEntry& entry) noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    for(size_type i = 0; i < n_classes_; ++i) {
+        auto& head = entry.free[i];
+        while(head != nullptr) {
+            auto* p    = head;
+            head       = p->m_next;
+            p->m_next  = m_free_[i];
+            m_free_[i] = p;
+        }
+        entry.n_free[i] = 0;
+    }
+}
+
+void BufferPool::add_in_use_(size_type block) noexcept {
+    const auto now = m_stats_.bytes_in_use += block;
+    auto peak      = m_stats_.peak_bytes_in_use.load();
+    while(now > peak &&
+          !m_stats_.peak_bytes_in_use.compare_exchange_weak(peak, now)) {}
+}
+
+void BufferPool::shrink_to_(size_type n) noexcept {
+    // Free the largest blocks first, they give back the most memory
+    for(size_type i = n_classes_; i-- > 0 && m_stats_.bytes_cached > n;) {
+        const auto block = min_block_size << i;
+        auto& head       = m_free_[i];
+        while(head != nullptr && m_stats_.bytes_cached > n) {
+            auto* p = head;
+            head    = p->m_next;
+            m_stats_.bytes_cached -= block;
+            ::operator delete(p);
+        }
+    }
+}
+
+} // namespace parallelzone::mpi_helpers
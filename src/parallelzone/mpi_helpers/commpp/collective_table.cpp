@@ -0,0 +1,296 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detail_/collective_algorithms.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <parallelzone/mpi_helpers/commpp/collective_table.hpp>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace parallelzone::mpi_helpers {
+namespace {
+
+// First line of a saved table, bump the version if the format changes
+constexpr const char* file_header = "parallelzone-collective-table 1";
+
+constexpr std::array all_collectives{
+  collective_type::gather, collective_type::allgather,
+  collective_type::allgatherv, collective_type::allreduce};
+
+// In order of preference when timings tie
+constexpr std::array all_algorithms{
+  collective_algorithm::vendor, collective_algorithm::ring,
+  collective_algorithm::recursive_doubling, collective_algorithm::binomial,
+  collective_algorithm::hierarchical};
+
+std::optional<collective_type> collective_from_string(const std::string& s) {
+    for(auto c : all_collectives)
+        if(to_string(c) == s) return c;
+    return std::nullopt;
+}
+
+std::optional<collective_algorithm> algorithm_from_string(
+  const std::string& s) {
+    for(auto a : all_algorithms)
+        if(to_string(a) == s) return a;
+    return std::nullopt;
+}
+
+// Runs algorithm a of collective c once on n_bytes per rank
+void run_once(collective_type c, collective_algorithm a, MPI_Comm comm,
+              std::size_t n_bytes, std::vector<char>& in,
+              std::vector<char>& out, const std::vector<int>& sizes,
+              const std::vector<int>& disps) {
+    const int n = static_cast<int>(n_bytes);
+    switch(c) {
+        case collective_type::gather:
+            return detail_::run_gather(a, in.data(), n, out.data(), 0, comm);
+        case collective_type::allgather:
+            return detail_::run_allgather(a, in.data(), n, out.data(), comm);
+        case collective_type::allgatherv:
+            return detail_::run_allgatherv(a, in.data(), sizes.data(),
+                                           disps.data(), out.data(), comm);
+        case collective_type::allreduce: {
+            const int count = std::max<int>(1, n / int(sizeof(double)));
+            return detail_::run_allreduce(a, in.data(), out.data(), count,
+                                          MPI_DOUBLE, MPI_SUM, comm);
+        }
+    }
+}
+
+// Time of the slowest rank for n_iterations calls, the same on every rank
+double time_algorithm(collective_type c, collective_algorithm a,
+                      MPI_Comm comm, std::size_t n_bytes,
+                      const TuneSettings& settings, std::vector<char>& in,
+                      std::vector<char>& out, const std::vector<int>& sizes,
+                      const std::vector<int>& disps) {
+    for(std::size_t i = 0; i < settings.n_warmup; ++i)
+        run_once(c, a, comm, n_bytes, in, out, sizes, disps);
+
+    MPI_Barrier(comm);
+    const double start = MPI_Wtime();
+    for(std::size_t i = 0; i < settings.n_iterations; ++i)
+        run_once(c, a, comm, n_bytes, in, out, sizes, disps);
+    double elapsed = MPI_Wtime() - start;
+    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, comm);
+    return elapsed;
+}
+
+} // namespace
+
+std::string to_string(collective_type c) {
+    switch(c) {
+        case collective_type::gather: return "gather";
+        case collective_type::allgather: return "allgather";
+        case collective_type::allgatherv: return "allgatherv";
+        case collective_type::allreduce: return "allreduce";
+    }
+    return "unknown";
+}
+
+std::string to_string(collective_algorithm a) {
+    switch(a) {
+        case collective_algorithm::vendor: return "vendor";
+        case collective_algorithm::ring: return "ring";
+        case collective_algorithm::recursive_doubling:
+            return "recursive_doubling";
+        case collective_algorithm::binomial: return "binomial";
+        case collective_algorithm::hierarchical: return "hierarchical";
+    }
+    return "unknown";
+}
+
+bool is_applicable(collective_type c, collective_algorithm a,
+                   std::size_t comm_size) noexcept {
+    using alg = collective_algorithm;
+    if(a == alg::vendor) return true;
+    const bool pow2 = detail_::is_power_of_two(static_cast<int>(comm_size));
+    switch(c) {
+        case collective_type::gather: return a == alg::binomial;
+        case collective_type::allgather:
+        case collective_type::allgatherv:
+            return a == alg::ring || (a == alg::recursive_doubling && pow2);
+        case collective_type::allreduce:
+            return a == alg::ring || a == alg::hierarchical ||
+                   (a == alg::recursive_doubling && pow2);
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// -- CollectiveTable
+// -----------------------------------------------------------------------------
+
+CollectiveTable::CollectiveTable(const CollectiveTable& other) {
+    std::lock_guard<std::mutex> lock(other.m_mutex_);
+    m_entries_ = other.m_entries_;
+}
+
+CollectiveTable& CollectiveTable::operator=(const CollectiveTable& rhs) {
+    if(this == &rhs) return *this;
+    auto entries = CollectiveTable(rhs).m_entries_;
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_entries_.swap(entries);
+    return *this;
+}
+
+CollectiveTable::size_type CollectiveTable::bucket(size_type n_bytes) noexcept {
+    size_type b = 0;
+    while(n_bytes > 1) {
+        n_bytes >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+collective_algorithm CollectiveTable::select(
+  collective_type c, size_type comm_size, size_type n_bytes) const noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    if(m_entries_.empty()) return collective_algorithm::vendor;
+    auto itr = m_entries_.find(key_type{c, comm_size, bucket(n_bytes)});
+    return itr != m_entries_.end() ? itr->second : collective_algorithm::vendor;
+}
+
+void CollectiveTable::set(collective_type c, size_type comm_size,
+                          size_type bucket, collective_algorithm a) {
+    if(!is_applicable(c, a, comm_size))
+        throw std::runtime_error(to_string(a) + " can not be used for " +
+                                 to_string(c) + " on " +
+                                 std::to_string(comm_size) + " ranks");
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_entries_[key_type{c, comm_size, bucket}] = a;
+}
+
+void CollectiveTable::merge(const CollectiveTable& other) {
+    if(this == &other) return;
+    auto entries = CollectiveTable(other).m_entries_;
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    for(const auto& [key, a] : entries) m_entries_[key] = a;
+}
+
+CollectiveTable::size_type CollectiveTable::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_entries_.size();
+}
+
+void CollectiveTable::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_entries_.clear();
+}
+
+bool CollectiveTable::save(const std::string& path) const noexcept {
+    try {
+        const CollectiveTable copy(*this);
+        std::ofstream file(path, std::ios::trunc);
+        if(!file) return false;
+        file << file_header << '\n';
+        for(const auto& [key, a] : copy.m_entries_) {
+            const auto& [c, comm_size, b] = key;
+            file << to_string(c) << ' ' << comm_size << ' ' << b << ' '
+                 << to_string(a) << '\n';
+        }
+        return static_cast<bool>(file);
+    } catch(...) { return false; }
+}
+
+std::optional<CollectiveTable> CollectiveTable::load(
+  const std::string& path) noexcept {
+    try {
+        std::ifstream file(path);
+        if(!file) return std::nullopt;
+
+        std::string header;
+        std::getline(file, header);
+        if(header != file_header) return std::nullopt;
+
+        CollectiveTable rv;
+        std::string c_name, a_name;
+        size_type comm_size = 0, b = 0;
+        while(file >> c_name >> comm_size >> b >> a_name) {
+            auto c = collective_from_string(c_name);
+            auto a = algorithm_from_string(a_name);
+            if(!c || !a || !is_applicable(*c, *a, comm_size))
+                return std::nullopt;
+            rv.m_entries_[key_type{*c, comm_size, b}] = *a;
+        }
+        if(!file.eof()) return std::nullopt;
+        return rv;
+    } catch(...) { return std::nullopt; }
+}
+
+CollectiveTable& CollectiveTable::default_table() {
+    static auto* table = new CollectiveTable;
+    return *table;
+}
+
+bool CollectiveTable::operator==(const CollectiveTable& rhs) const {
+    if(this == &rhs) return true;
+    const CollectiveTable copy(rhs);
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_entries_ == copy.m_entries_;
+}
+
+// -----------------------------------------------------------------------------
+// -- Tuning
+// -----------------------------------------------------------------------------
+
+CollectiveTable tune_collectives(const CommPP& comm,
+                                 const TuneSettings& settings) {
+    if(comm.size() == 0)
+        throw std::runtime_error("Can not tune collectives on a null CommPP");
+    if(comm.comm() == MPI_COMM_NULL)
+        throw std::runtime_error("Can only tune collectives over MPI");
+
+    const auto mpi_comm  = comm.comm();
+    const auto n_ranks   = std::size_t(comm.size());
+    const auto max_b     = CollectiveTable::bucket(settings.max_bytes);
+    const auto max_bytes = std::size_t(1) << max_b;
+
+    // Buffers big enough for the largest message of any collective
+    std::vector<char> in(max_bytes), out(max_bytes * n_ranks);
+    std::vector<int> sizes(n_ranks), disps(n_ranks);
+
+    CollectiveTable rv;
+    for(auto c : all_collectives) {
+        for(std::size_t b = 0; b <= max_b; ++b) {
+            const std::size_t n_bytes = std::size_t(1) << b;
+            for(std::size_t i = 0; i < n_ranks; ++i) {
+                sizes[i] = static_cast<int>(n_bytes);
+                disps[i] = static_cast<int>(i * n_bytes);
+            }
+
+            auto best      = collective_algorithm::vendor;
+            auto best_time = std::numeric_limits<double>::max();
+            for(auto a : all_algorithms) {
+                if(!is_applicable(c, a, n_ranks)) continue;
+                const auto t = time_algorithm(c, a, mpi_comm, n_bytes,
+                                              settings, in, out, sizes, disps);
+                if(t < best_time) {
+                    best      = a;
+                    best_time = t;
+                }
+            }
+            rv.set(c, n_ranks, b, best);
+        }
+    }
+    return rv;
+}
+
+} // namespace parallelzone::mpi_helpers
@@ -15,6 +15,7 @@
  */
 
 #include "detail_/commpp_pimpl.hpp"
+#include "detail_/thread_comm_pimpl.hpp"
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
 #include <stdexcept>
 
@@ -44,6 +45,20 @@ CommPP& CommPP::operator=(CommPP&& rhs) noexcept = default;
 
 CommPP::~CommPP() noexcept = default;
 
+std::vector<CommPP> CommPP::make_threaded(size_type n_ranks) {
+    if(n_ranks <= 0)
+        throw std::out_of_range("A thread team needs at least one rank");
+
+    auto team = std::make_shared<detail_::ThreadTeam>(n_ranks);
+    std::vector<CommPP> comms;
+    comms.reserve(n_ranks);
+    for(size_type i = 0; i < n_ranks; ++i) {
+        auto pimpl = std::make_unique<detail_::ThreadCommPPPIMPL>(team, i);
+        comms.push_back(CommPP(std::move(pimpl)));
+    }
+    return comms;
+}
+
 // -----------------------------------------------------------------------------
 // -- Accessors
 // -----------------------------------------------------------------------------
@@ -66,6 +81,10 @@ CommPP::size_type CommPP::me() const noexcept {
 
 void CommPP::swap(CommPP& other) noexcept { m_pimpl_.swap(other.m_pimpl_); }
 
+void CommPP::abort() const noexcept {
+    if(has_pimpl_()) m_pimpl_->abort();
+}
+
 bool CommPP::operator==(const CommPP& rhs) const noexcept {
     if(has_pimpl_() != rhs.has_pimpl_()) return false;
     if(!has_pimpl_()) return true; // Both Null
@@ -80,6 +99,8 @@ bool CommPP::operator!=(const CommPP& rhs) const noexcept {
 // -- Private Methods
 // -----------------------------------------------------------------------------
 
+CommPP::CommPP(pimpl_pointer pimpl) noexcept : m_pimpl_(std::move(pimpl)) {}
+
 bool CommPP::has_pimpl_() const noexcept { return static_cast<bool>(m_pimpl_); }
 
 const CommPP::pimpl_type& CommPP::pimpl_() const {
@@ -102,4 +123,10 @@ CommPP::binary_gatherv_return CommPP::gatherv_(const_binary_reference data,
     return pimpl_().gatherv(data, root);
 }
 
+void CommPP::reduce_(const void* send, void* recv, int count,
+                     MPI_Datatype type, MPI_Op op, local_reduce_type local,
+                     opt_root_t root) const {
+    pimpl_().reduce(send, recv, count, type, op, local, root);
+}
+
 } // namespace parallelzone::mpi_helpers
@@ -0,0 +1,372 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "collective_algorithms.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <parallelzone/mpi_helpers/binary_buffer/detail_/pooled_buffer.hpp>
+
+namespace parallelzone::mpi_helpers::detail_ {
+namespace {
+
+constexpr int tag = 0;
+
+// Pointer arithmetic in bytes
+char* byte_ptr(void* p, long offset = 0) noexcept {
+    return static_cast<char*>(p) + offset;
+}
+
+// Copies n bytes unless the source and destination are the same
+void copy_bytes(const void* from, void* to, std::size_t n) noexcept {
+    if(from != to && n > 0) std::memcpy(to, from, n);
+}
+
+// Scratch space from the default pool
+PooledBuffer scratch(std::size_t n) {
+    return PooledBuffer(n, BufferPool::default_pool());
+}
+
+int comm_rank(MPI_Comm comm) {
+    int me = 0;
+    MPI_Comm_rank(comm, &me);
+    return me;
+}
+
+int comm_size(MPI_Comm comm) {
+    int n = 0;
+    MPI_Comm_size(comm, &n);
+    return n;
+}
+
+// -- Node communicators for the hierarchical algorithms ----------------------
+
+// The communicators of a node, cached on the parent communicator
+struct NodeComms {
+    // The ranks on the current node
+    MPI_Comm node = MPI_COMM_NULL;
+
+    // The leaders (node rank 0) of every node, null if we aren't a leader
+    MPI_Comm leaders = MPI_COMM_NULL;
+};
+
+// Called by MPI when the parent communicator is freed
+int free_node_comms(MPI_Comm, int, void* attr, void*) {
+    auto* comms = static_cast<NodeComms*>(attr);
+    if(comms->leaders != MPI_COMM_NULL) MPI_Comm_free(&comms->leaders);
+    if(comms->node != MPI_COMM_NULL) MPI_Comm_free(&comms->node);
+    delete comms;
+    return MPI_SUCCESS;
+}
+
+// The key node communicators are cached under (made on first use)
+int node_comms_keyval() {
+    static const int keyval = []() {
+        int k = MPI_KEYVAL_INVALID;
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, &free_node_comms, &k,
+                               nullptr);
+        return k;
+    }();
+    return keyval;
+}
+
+// Returns the node communicators of comm, creating them (collectively) if
+// this is the first time they're needed
+const NodeComms& node_comms(MPI_Comm comm) {
+    const int keyval = node_comms_keyval();
+    void* attr       = nullptr;
+    int found        = 0;
+    MPI_Comm_get_attr(comm, keyval, &attr, &found);
+    if(found) return *static_cast<NodeComms*>(attr);
+
+    auto* comms   = new NodeComms;
+    const auto me = comm_rank(comm);
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, me, MPI_INFO_NULL,
+                        &comms->node);
+    const int color = comm_rank(comms->node) == 0 ? 0 : MPI_UNDEFINED;
+    MPI_Comm_split(comm, color, me, &comms->leaders);
+    MPI_Comm_set_attr(comm, keyval, comms);
+    return *comms;
+}
+
+// Throws if a can't be used for c on comm
+void assert_applicable(collective_type c, collective_algorithm a,
+                       MPI_Comm comm) {
+    if(is_applicable(c, a, comm_size(comm))) return;
+    throw std::runtime_error(to_string(a) + " can not be used for " +
+                             to_string(c) + " on " +
+                             std::to_string(comm_size(comm)) + " ranks");
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// -- Gathers
+// -----------------------------------------------------------------------------
+
+void binomial_gather(const void* in, int n, void* out, int root,
+                     MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+    const int rel     = (me - root + n_ranks) % n_ranks; // Rank if root was 0
+
+    // Blocks in my subtree: the lowest set bit of rel, capped by the ranks
+    int mask = 1;
+    while(mask < n_ranks && !(rel & mask)) mask <<= 1;
+    const int n_blocks = std::min(mask, n_ranks - rel);
+
+    // Root 0 can accumulate straight into out, everyone else needs scratch
+    PooledBuffer temp;
+    void* buffer = out;
+    if(root != 0 || rel != 0) {
+        scratch(std::size_t(n) * n_blocks).swap(temp);
+        buffer = temp.data();
+    }
+    copy_bytes(in, buffer, n);
+
+    for(mask = 1; mask < n_ranks; mask <<= 1) {
+        if(rel & mask) {
+            const int parent = (rel - mask + root) % n_ranks;
+            const int count  = n * std::min(mask, n_ranks - rel);
+            MPI_Send(buffer, count, MPI_BYTE, parent, tag, comm);
+            break;
+        }
+        if(rel + mask < n_ranks) {
+            const int child = (rel + mask + root) % n_ranks;
+            const int count = n * std::min(mask, n_ranks - rel - mask);
+            MPI_Recv(byte_ptr(buffer, long(n) * mask), count, MPI_BYTE, child,
+                     tag, comm, MPI_STATUS_IGNORE);
+        }
+    }
+
+    // The buffer is in relative rank order, rotate it into rank order
+    if(rel == 0 && buffer != out) {
+        for(int i = 0; i < n_ranks; ++i) {
+            const long dest = long((i + root) % n_ranks) * n;
+            copy_bytes(byte_ptr(buffer, long(i) * n), byte_ptr(out, dest), n);
+        }
+    }
+}
+
+void ring_allgather(const void* in, int n, void* out, MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+    const int right   = (me + 1) % n_ranks;
+    const int left    = (me - 1 + n_ranks) % n_ranks;
+
+    copy_bytes(in, byte_ptr(out, long(me) * n), n);
+    for(int step = 0; step < n_ranks - 1; ++step) {
+        const int send_block = (me - step + n_ranks) % n_ranks;
+        const int recv_block = (me - step - 1 + n_ranks) % n_ranks;
+        MPI_Sendrecv(byte_ptr(out, long(send_block) * n), n, MPI_BYTE, right,
+                     tag, byte_ptr(out, long(recv_block) * n), n, MPI_BYTE,
+                     left, tag, comm, MPI_STATUS_IGNORE);
+    }
+}
+
+void recursive_doubling_allgather(const void* in, int n, void* out,
+                                  MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+
+    copy_bytes(in, byte_ptr(out, long(me) * n), n);
+    for(int mask = 1; mask < n_ranks; mask <<= 1) {
+        // Before this step we have the blocks of our group of `mask` ranks
+        const int partner = me ^ mask;
+        const int mine    = me & ~(mask - 1);
+        const int theirs  = partner & ~(mask - 1);
+        MPI_Sendrecv(byte_ptr(out, long(mine) * n), n * mask, MPI_BYTE,
+                     partner, tag, byte_ptr(out, long(theirs) * n), n * mask,
+                     MPI_BYTE, partner, tag, comm, MPI_STATUS_IGNORE);
+    }
+}
+
+void ring_allgatherv(const void* in, const int* sizes, const int* disps,
+                     void* out, MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+    const int right   = (me + 1) % n_ranks;
+    const int left    = (me - 1 + n_ranks) % n_ranks;
+
+    copy_bytes(in, byte_ptr(out, disps[me]), sizes[me]);
+    for(int step = 0; step < n_ranks - 1; ++step) {
+        const int send_block = (me - step + n_ranks) % n_ranks;
+        const int recv_block = (me - step - 1 + n_ranks) % n_ranks;
+        MPI_Sendrecv(byte_ptr(out, disps[send_block]), sizes[send_block],
+                     MPI_BYTE, right, tag, byte_ptr(out, disps[recv_block]),
+                     sizes[recv_block], MPI_BYTE, left, tag, comm,
+                     MPI_STATUS_IGNORE);
+    }
+}
+
+void recursive_doubling_allgatherv(const void* in, const int* sizes,
+                                   const int* disps, void* out,
+                                   MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+
+    // Bytes held by the group of `mask` ranks starting at rank `first`
+    auto group_bytes = [&](int first, int mask) {
+        const int last = first + mask - 1;
+        return disps[last] + sizes[last] - disps[first];
+    };
+
+    copy_bytes(in, byte_ptr(out, disps[me]), sizes[me]);
+    for(int mask = 1; mask < n_ranks; mask <<= 1) {
+        const int partner = me ^ mask;
+        const int mine    = me & ~(mask - 1);
+        const int theirs  = partner & ~(mask - 1);
+        MPI_Sendrecv(byte_ptr(out, disps[mine]), group_bytes(mine, mask),
+                     MPI_BYTE, partner, tag, byte_ptr(out, disps[theirs]),
+                     group_bytes(theirs, mask), MPI_BYTE, partner, tag, comm,
+                     MPI_STATUS_IGNORE);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -- All reduces
+// -----------------------------------------------------------------------------
+
+void ring_allreduce(const void* in, void* out, int count, MPI_Datatype type,
+                    MPI_Op op, MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+    const int right   = (me + 1) % n_ranks;
+    const int left    = (me - 1 + n_ranks) % n_ranks;
+
+    int type_size = 0;
+    MPI_Type_size(type, &type_size);
+    copy_bytes(in, out, std::size_t(count) * type_size);
+    if(n_ranks == 1) return;
+
+    // The data is split into n_ranks chunks, the first `extra` get one more
+    const int base  = count / n_ranks;
+    const int extra = count % n_ranks;
+    auto chunk_size = [&](int i) { return base + (i < extra ? 1 : 0); };
+    auto chunk_ptr  = [&](int i) {
+        const long offset = long(i) * base + std::min(i, extra);
+        return byte_ptr(out, offset * type_size);
+    };
+
+    // Reduce-scatter: afterwards we hold the reduced chunk (me + 1)
+    auto temp = scratch(std::size_t(base + 1) * type_size);
+    for(int step = 0; step < n_ranks - 1; ++step) {
+        const int send_chunk = (me - step + n_ranks) % n_ranks;
+        const int recv_chunk = (me - step - 1 + n_ranks) % n_ranks;
+        MPI_Sendrecv(chunk_ptr(send_chunk), chunk_size(send_chunk), type,
+                     right, tag, temp.data(), chunk_size(recv_chunk), type,
+                     left, tag, comm, MPI_STATUS_IGNORE);
+        MPI_Reduce_local(temp.data(), chunk_ptr(recv_chunk),
+                         chunk_size(recv_chunk), type, op);
+    }
+
+    // All-gather the reduced chunks
+    for(int step = 0; step < n_ranks - 1; ++step) {
+        const int send_chunk = (me + 1 - step + n_ranks) % n_ranks;
+        const int recv_chunk = (me - step + n_ranks) % n_ranks;
+        MPI_Sendrecv(chunk_ptr(send_chunk), chunk_size(send_chunk), type,
+                     right, tag, chunk_ptr(recv_chunk), chunk_size(recv_chunk),
+                     type, left, tag, comm, MPI_STATUS_IGNORE);
+    }
+}
+
+void recursive_doubling_allreduce(const void* in, void* out, int count,
+                                  MPI_Datatype type, MPI_Op op,
+                                  MPI_Comm comm) {
+    const int n_ranks = comm_size(comm);
+    const int me      = comm_rank(comm);
+
+    int type_size = 0;
+    MPI_Type_size(type, &type_size);
+    const auto n_bytes = std::size_t(count) * type_size;
+    copy_bytes(in, out, n_bytes);
+    if(n_ranks == 1) return;
+
+    // Partners combine the same two partial results, and the operation is
+    // commutative, so both end up with identical bits
+    auto temp = scratch(n_bytes);
+    for(int mask = 1; mask < n_ranks; mask <<= 1) {
+        const int partner = me ^ mask;
+        MPI_Sendrecv(out, count, type, partner, tag, temp.data(), count, type,
+                     partner, tag, comm, MPI_STATUS_IGNORE);
+        MPI_Reduce_local(temp.data(), out, count, type, op);
+    }
+}
+
+void hierarchical_allreduce(const void* in, void* out, int count,
+                            MPI_Datatype type, MPI_Op op, MPI_Comm comm) {
+    const auto& comms = node_comms(comm);
+    MPI_Reduce(in, out, count, type, op, 0, comms.node);
+    if(comms.leaders != MPI_COMM_NULL)
+        MPI_Allreduce(MPI_IN_PLACE, out, count, type, op, comms.leaders);
+    MPI_Bcast(out, count, type, 0, comms.node);
+}
+
+// -----------------------------------------------------------------------------
+// -- Dispatch
+// -----------------------------------------------------------------------------
+
+void run_gather(collective_algorithm a, const void* in, int n, void* out,
+                int root, MPI_Comm comm) {
+    assert_applicable(collective_type::gather, a, comm);
+    if(a == collective_algorithm::binomial)
+        return binomial_gather(in, n, out, root, comm);
+    MPI_Gather(in, n, MPI_BYTE, out, n, MPI_BYTE, root, comm);
+}
+
+void run_allgather(collective_algorithm a, const void* in, int n, void* out,
+                   MPI_Comm comm) {
+    assert_applicable(collective_type::allgather, a, comm);
+    switch(a) {
+        case collective_algorithm::ring:
+            return ring_allgather(in, n, out, comm);
+        case collective_algorithm::recursive_doubling:
+            return recursive_doubling_allgather(in, n, out, comm);
+        default: MPI_Allgather(in, n, MPI_BYTE, out, n, MPI_BYTE, comm);
+    }
+}
+
+void run_allgatherv(collective_algorithm a, const void* in, const int* sizes,
+                    const int* disps, void* out, MPI_Comm comm) {
+    assert_applicable(collective_type::allgatherv, a, comm);
+    switch(a) {
+        case collective_algorithm::ring:
+            return ring_allgatherv(in, sizes, disps, out, comm);
+        case collective_algorithm::recursive_doubling:
+            return recursive_doubling_allgatherv(in, sizes, disps, out, comm);
+        default: {
+            const int me = comm_rank(comm);
+            MPI_Allgatherv(in, sizes[me], MPI_BYTE, out, sizes, disps,
+                           MPI_BYTE, comm);
+        }
+    }
+}
+
+void run_allreduce(collective_algorithm a, const void* in, void* out,
+                   int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm) {
+    assert_applicable(collective_type::allreduce, a, comm);
+    switch(a) {
+        case collective_algorithm::ring:
+            return ring_allreduce(in, out, count, type, op, comm);
+        case collective_algorithm::recursive_doubling:
+            return recursive_doubling_allreduce(in, out, count, type, op, comm);
+        case collective_algorithm::hierarchical:
+            return hierarchical_allreduce(in, out, count, type, op, comm);
+        default: MPI_Allreduce(in, out, count, type, op, comm);
+    }
+}
+
+} // namespace parallelzone::mpi_helpers::detail_
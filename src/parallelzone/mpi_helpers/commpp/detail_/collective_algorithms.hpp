@@ -0,0 +1,178 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <parallelzone/mpi_helpers/commpp/collective_table.hpp>
+#include <parallelzone/mpi_helpers/mpi.hpp>
+
+/** @file collective_algorithms.hpp
+ *
+ *  Alternatives to the vendor's implementations of the collectives CommPP
+ *  uses. Which implementation CommPP calls is decided by the
+ *  CollectiveTable. All functions here are collective over @p comm and, like
+ *  the MPI functions they replace, must be called by every rank with
+ *  consistent arguments. Sizes and displacements of the gather variants are
+ *  in bytes.
+ */
+
+namespace parallelzone::mpi_helpers::detail_ {
+
+/// True if @p n is a (positive) power of two
+inline bool is_power_of_two(int n) noexcept { return n > 0 && !(n & (n - 1)); }
+
+/** @brief Gathers @p n bytes from every rank to @p root along a binomial
+ *         tree.
+ *
+ *  Takes log2(P) steps, in step `k` ranks forward the `2^k` blocks they have
+ *  accumulated so far. Works for any number of ranks.
+ *
+ *  @param[in] in The @p n bytes to send.
+ *  @param[in] n The number of bytes each rank sends.
+ *  @param[out] out On @p root, room for `n * P` bytes. Ignored elsewhere.
+ *  @param[in] root The rank receiving the data.
+ *  @param[in] comm The communicator.
+ *
+ *  @throw std::bad_alloc if the temporary buffer can not be allocated.
+ */
+void binomial_gather(const void* in, int n, void* out, int root,
+                     MPI_Comm comm);
+
+/** @brief All-gathers @p n bytes per rank by passing blocks around a ring.
+ *
+ *  Takes P - 1 steps, each moving one block to the next rank. Bandwidth
+ *  optimal, so it favors large messages. Works for any number of ranks.
+ *
+ *  @param[in] in The @p n bytes to send.
+ *  @param[in] n The number of bytes each rank sends.
+ *  @param[out] out Room for `n * P` bytes.
+ *  @param[in] comm The communicator.
+ */
+void ring_allgather(const void* in, int n, void* out, MPI_Comm comm);
+
+/** @brief All-gathers @p n bytes per rank by recursive doubling.
+ *
+ *  Takes log2(P) steps, in step `k` partners `2^k` apart swap everything they
+ *  have. Latency optimal, so it favors small messages. Requires the number
+ *  of ranks to be a power of two.
+ *
+ *  @param[in] in The @p n bytes to send.
+ *  @param[in] n The number of bytes each rank sends.
+ *  @param[out] out Room for `n * P` bytes.
+ *  @param[in] comm The communicator.
+ */
+void recursive_doubling_allgather(const void* in, int n, void* out,
+                                  MPI_Comm comm);
+
+/** @brief The variable-size analog of ring_allgather.
+ *
+ *  @param[in] in The bytes this rank sends, `sizes[me]` of them.
+ *  @param[in] sizes Element `i` is the number of bytes rank `i` sends.
+ *  @param[in] disps Element `i` is where rank `i`'s bytes go in @p out.
+ *  @param[out] out The concatenated bytes.
+ *  @param[in] comm The communicator.
+ */
+void ring_allgatherv(const void* in, const int* sizes, const int* disps,
+                     void* out, MPI_Comm comm);
+
+/** @brief The variable-size analog of recursive_doubling_allgather.
+ *
+ *  The blocks must be stored in rank order (i.e., `disps[i + 1] ==
+ *  disps[i] + sizes[i]`), and the number of ranks must be a power of two.
+ *
+ *  @param[in] in The bytes this rank sends, `sizes[me]` of them.
+ *  @param[in] sizes Element `i` is the number of bytes rank `i` sends.
+ *  @param[in] disps Element `i` is where rank `i`'s bytes go in @p out.
+ *  @param[out] out The concatenated bytes.
+ *  @param[in] comm The communicator.
+ */
+void recursive_doubling_allgatherv(const void* in, const int* sizes,
+                                   const int* disps, void* out, MPI_Comm comm);
+
+/** @brief All-reduce as a ring reduce-scatter followed by a ring all-gather.
+ *
+ *  Each rank reduces one P-th of the data, so it is bandwidth optimal and
+ *  favors large messages. Every rank gets bit-identical results. Works for
+ *  any number of ranks. @p op must be commutative.
+ *
+ *  @param[in] in The @p count elements this rank contributes.
+ *  @param[out] out Room for @p count elements.
+ *  @param[in] count The number of elements.
+ *  @param[in] type The MPI type of the elements.
+ *  @param[in] op The (commutative) MPI operation.
+ *  @param[in] comm The communicator.
+ *
+ *  @throw std::bad_alloc if the temporary buffer can not be allocated.
+ */
+void ring_allreduce(const void* in, void* out, int count, MPI_Datatype type,
+                    MPI_Op op, MPI_Comm comm);
+
+/** @brief All-reduce by recursive doubling.
+ *
+ *  Takes log2(P) steps, in each partners swap and combine their partial
+ *  results. Latency optimal, so it favors small messages. Requires the
+ *  number of ranks to be a power of two and @p op to be commutative.
+ *
+ *  Parameters are the same as ring_allreduce.
+ */
+void recursive_doubling_allreduce(const void* in, void* out, int count,
+                                  MPI_Datatype type, MPI_Op op, MPI_Comm comm);
+
+/** @brief All-reduce which first reduces within each node.
+ *
+ *  Ranks reduce onto their node's leader, the leaders all-reduce among
+ *  themselves, and then each leader broadcasts the result on its node. Only
+ *  one rank per node touches the network. The node communicators are
+ *  created the first time they are needed and are cached on @p comm.
+ *
+ *  Parameters are the same as ring_allreduce.
+ */
+void hierarchical_allreduce(const void* in, void* out, int count,
+                            MPI_Datatype type, MPI_Op op, MPI_Comm comm);
+
+// -----------------------------------------------------------------------------
+// -- Dispatch
+// -----------------------------------------------------------------------------
+
+/** @brief Gathers with algorithm @p a, MPI_Gather is used for vendor.
+ *
+ *  @throw std::runtime_error if @p a is not applicable.
+ */
+void run_gather(collective_algorithm a, const void* in, int n, void* out,
+                int root, MPI_Comm comm);
+
+/** @brief All-gathers with algorithm @p a, MPI_Allgather is used for vendor.
+ *
+ *  @throw std::runtime_error if @p a is not applicable.
+ */
+void run_allgather(collective_algorithm a, const void* in, int n, void* out,
+                   MPI_Comm comm);
+
+/** @brief All-gathervs with algorithm @p a, MPI_Allgatherv is used for
+ *         vendor.
+ *
+ *  @throw std::runtime_error if @p a is not applicable.
+ */
+void run_allgatherv(collective_algorithm a, const void* in, const int* sizes,
+                    const int* disps, void* out, MPI_Comm comm);
+
+/** @brief All-reduces with algorithm @p a, MPI_Allreduce is used for vendor.
+ *
+ *  @throw std::runtime_error if @p a is not applicable.
+ */
+void run_allreduce(collective_algorithm a, const void* in, void* out,
+                   int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm);
+
+} // namespace parallelzone::mpi_helpers::detail_
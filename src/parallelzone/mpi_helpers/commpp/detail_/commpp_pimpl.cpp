@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include "collective_algorithms.hpp"
 #include "commpp_pimpl.hpp"
+#include <typeinfo>
 
 namespace parallelzone::mpi_helpers::detail_ {
 
@@ -24,6 +26,9 @@ CommPPPIMPL::CommPPPIMPL(mpi_comm_type comm) :
     MPI_Comm_size(m_comm_, &m_size_);
 }
 
+CommPPPIMPL::CommPPPIMPL(size_type me, size_type size) noexcept :
+  m_comm_(MPI_COMM_NULL), m_my_rank_(me), m_size_(size) {}
+
 // -----------------------------------------------------------------------------
 // -- MPI Operations
 // -----------------------------------------------------------------------------
@@ -55,10 +60,13 @@ void CommPPPIMPL::gather(const_binary_reference data,
     if(am_i_root && out_buffer.size() < n_in * size())
         throw std::runtime_error("The provided buffer is not large enough...");
 
+    const auto& table = CollectiveTable::default_table();
     if(root.has_value()) {
-        MPI_Gather(p_in, n_in, MPI_BYTE, p_out, n_in, MPI_BYTE, *root, m_comm_);
+        auto a = table.select(collective_type::gather, size(), n_in);
+        run_gather(a, p_in, n_in, p_out, *root, m_comm_);
     } else {
-        MPI_Allgather(p_in, n_in, MPI_BYTE, p_out, n_in, MPI_BYTE, m_comm_);
+        auto a = table.select(collective_type::allgather, size(), n_in);
+        run_allgather(a, p_in, n_in, p_out, m_comm_);
     }
 }
 
@@ -78,10 +86,13 @@ CommPPPIMPL::binary_gatherv_return CommPPPIMPL::gatherv(
 
     // Step 1: On root compute displacements and allocate buffer for gathered
     //         results. N.B. p_recv + disp[i] = address where rank i's data goes
-    std::vector<int> disp;
+    //         The displacements are scratch, each thread reuses its own
+    thread_local std::vector<int> t_disp;
+    auto& disp = t_disp;
+    disp.clear();
     binary_type buffer;
+    int total = 0;
     if(am_i_root) {
-        int total = 0;
         // In our case rank i's results go immediately after rank (i-1)'s
         for(size_type i = 0; i < size(); ++i) {
             disp.push_back(total);
@@ -99,7 +110,11 @@ CommPPPIMPL::binary_gatherv_return CommPPPIMPL::gatherv(
         MPI_Gatherv(p_in, n_in, byte, p_out, p_recv, p_disp, byte, *root,
                     m_comm_);
     } else {
-        MPI_Allgatherv(p_in, n_in, byte, p_out, p_recv, p_disp, byte, m_comm_);
+        // Tables are keyed on what each rank sends, on average
+        const auto& table = CollectiveTable::default_table();
+        const auto n_avg  = std::size_t(total) / size();
+        auto a = table.select(collective_type::allgatherv, size(), n_avg);
+        run_allgatherv(a, p_in, p_recv, p_disp, p_out, m_comm_);
     }
 
     // Step 3: Return buffer and sizes
@@ -111,11 +126,36 @@ CommPPPIMPL::binary_gatherv_return CommPPPIMPL::gatherv(
     return rv;
 }
 
+void CommPPPIMPL::reduce(const void* send, void* recv, int count,
+                         MPI_Datatype type, MPI_Op op, local_reduce_type,
+                         opt_root_t root) const {
+    if(root.has_value()) {
+        MPI_Reduce(send, recv, count, type, op, *root, m_comm_);
+        return;
+    }
+
+    int type_size = 0;
+    MPI_Type_size(type, &type_size);
+    const std::size_t n_bytes = std::size_t(count) * type_size;
+    const auto& table         = CollectiveTable::default_table();
+    auto a = table.select(collective_type::allreduce, size(), n_bytes);
+    run_allreduce(a, send, recv, count, type, op, m_comm_);
+}
+
 // -----------------------------------------------------------------------------
 // -- Utility functions
 // -----------------------------------------------------------------------------
 
 bool CommPPPIMPL::operator==(const CommPPPIMPL& rhs) const noexcept {
+    if(typeid(*this) != typeid(rhs)) return false;
+    return is_equal_(rhs);
+}
+
+// -----------------------------------------------------------------------------
+// -- Protected methods
+// -----------------------------------------------------------------------------
+
+bool CommPPPIMPL::is_equal_(const CommPPPIMPL& rhs) const noexcept {
     // N.B. Since the comparison is process local, and *this always describes
     //      the local process, we don't need to check m_my_rank_ or m_size_
 
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <parallelzone/mpi_helpers/commpp/collective_table.hpp>
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
 
 namespace parallelzone::mpi_helpers::detail_ {
@@ -22,7 +23,9 @@ namespace parallelzone::mpi_helpers::detail_ {
 /** @brief Basic implementations and state for the CommPP class.
  *
  *  This class primarily exists to facilitate unit testing the implementations
- *  of the MPI ops without exposing them through the public API.
+ *  of the MPI ops without exposing them through the public API. The
+ *  operations are virtual so that backends which do not go through MPI (e.g.,
+ *  ThreadCommPPPIMPL) can derive from this class and override them.
  */
 class CommPPPIMPL {
 public:
@@ -56,6 +59,9 @@ public:
     /// Ultimately a typedef of CommPP::binary_gatherv_return
     using binary_gatherv_return = parent_type::binary_gatherv_return;
 
+    /// Ultimately a typedef of CommPP::local_reduce_type
+    using local_reduce_type = parent_type::local_reduce_type;
+
     /// Type of an optional root
     using opt_root_t = std::optional<size_type>;
 
@@ -72,6 +78,9 @@ public:
      */
     explicit CommPPPIMPL(mpi_comm_type comm);
 
+    /// Defaulted polymorphic dtor
+    virtual ~CommPPPIMPL() noexcept = default;
+
     /** @brief Makes a deep copy of *this
      *
      *  This method creates a copy of *this by deep copying the wrapped MPI
@@ -80,7 +89,9 @@ public:
      *
      *  @return A deep copy of *this on the heap.
      */
-    pimpl_pointer clone() const { return std::make_unique<CommPPPIMPL>(*this); }
+    virtual pimpl_pointer clone() const {
+        return std::make_unique<CommPPPIMPL>(*this);
+    }
 
     /** @brief Returns the MPI communicator behind *this
      *
@@ -196,8 +207,9 @@ public:
      *                  receive the result, if it is not set then every
      *                  process gets a copy of the result.
      */
-    void gather(const_binary_reference data, binary_reference out_buffer,
-                opt_root_t root = std::nullopt) const;
+    virtual void gather(const_binary_reference data,
+                        binary_reference out_buffer,
+                        opt_root_t root = std::nullopt) const;
 
     /** @brief Analog of gather(data, root) where the length of data can vary.
      *
@@ -221,13 +233,48 @@ public:
      *          optional has a value on each process if @p root was not set and
      *          only on the process of rank @p root if @p root was set.
      */
-    binary_gatherv_return gatherv(const_binary_reference data,
-                                  opt_root_t root = std::nullopt) const;
+    virtual binary_gatherv_return gatherv(const_binary_reference data,
+                                          opt_root_t root = std::nullopt) const;
+
+    /** @brief Element-wise reduction of @p count elements.
+     *
+     *  If @p root is set this wraps MPI_Reduce on comm(). Otherwise this is a
+     *  drop-in replacement for MPI_Allreduce on comm() where the algorithm is
+     *  chosen by CollectiveTable::default_table() based on the size of the
+     *  communicator and the number of bytes being reduced.
+     *
+     *  @param[in] send The local elements.
+     *  @param[out] recv Where the reduced elements go. Must hold @p count
+     *                   elements on each rank receiving the result and must
+     *                   not overlap @p send.
+     *  @param[in] count The number of elements each rank contributes.
+     *  @param[in] type The MPI type of the elements.
+     *  @param[in] op The MPI operation to reduce with.
+     *  @param[in] local The same reduction as @p op, but applied to buffers in
+     *                   memory. Ignored by this class, but used by backends
+     *                   which do not reduce through MPI.
+     *  @param[in] root The rank which gets the result. If not set every rank
+     *                  gets the result.
+     */
+    virtual void reduce(const void* send, void* recv, int count,
+                        MPI_Datatype type, MPI_Op op, local_reduce_type local,
+                        opt_root_t root = std::nullopt) const;
 
     // -------------------------------------------------------------------------
     // -- Utility functions
     // -------------------------------------------------------------------------
 
+    /** @brief Tells the other ranks that this rank failed.
+     *
+     *  MPI communicators have no way to do this short of MPI_Abort, so this
+     *  implementation does nothing. Backends whose ranks would otherwise
+     *  wait forever for the failed rank (e.g., ThreadCommPPPIMPL) override
+     *  it.
+     *
+     *  @throw None No throw guarantee.
+     */
+    virtual void abort() const noexcept {}
+
     /** @brief Compares *this to another PIMPL instance.
      *
      *  Two CommPPPIMPL instances are equal if they both wrap the same MPI
@@ -235,7 +282,9 @@ public:
      *  that the communicators also have the same size and that the current
      *  process has the same rank.
      *
-     *  The actual handles are compared with MPI_Comm_compare.
+     *  The actual handles are compared with MPI_Comm_compare. Instances of
+     *  different backends (i.e., different most derived classes) are never
+     *  equal.
      *
      *  @param[in] rhs The PIMPL to compare to *this.
      *
@@ -245,6 +294,22 @@ public:
      */
     bool operator==(const CommPPPIMPL& rhs) const noexcept;
 
+protected:
+    /** @brief Initializes a PIMPL which is not backed by an MPI communicator.
+     *
+     *  Derived classes use this ctor to set the rank and size. comm() will
+     *  return MPI_COMM_NULL for the resulting instance.
+     *
+     *  @param[in] me The rank of the current "process".
+     *  @param[in] size The number of "processes" in the communicator.
+     *
+     *  @throw None No throw guarantee.
+     */
+    CommPPPIMPL(size_type me, size_type size) noexcept;
+
+    /// Derived classes override this to compare to a PIMPL of the same type
+    virtual bool is_equal_(const CommPPPIMPL& rhs) const noexcept;
+
 private:
     /// The MPI communicator *this wraps
     mpi_comm_type m_comm_;
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "thread_comm_pimpl.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace parallelzone::mpi_helpers::detail_ {
+
+// -----------------------------------------------------------------------------
+// -- ThreadTeam
+// -----------------------------------------------------------------------------
+
+void ThreadTeam::barrier() {
+    std::unique_lock<std::mutex> lock(m_mutex_);
+    if(m_aborted_) throw TeamAborted();
+    const auto generation = m_generation_;
+    if(++m_n_arrived_ == size()) {
+        m_n_arrived_ = 0;
+        ++m_generation_;
+        lock.unlock();
+        m_cv_.notify_all();
+        return;
+    }
+    m_cv_.wait(lock,
+               [&]() { return m_aborted_ || m_generation_ != generation; });
+    if(m_generation_ == generation) throw TeamAborted();
+}
+
+void ThreadTeam::abort() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_aborted_ = true;
+    }
+    m_cv_.notify_all();
+}
+
+bool ThreadTeam::aborted() const noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_aborted_;
+}
+
+// -----------------------------------------------------------------------------
+// -- ThreadCommPPPIMPL
+// -----------------------------------------------------------------------------
+
+ThreadCommPPPIMPL::ThreadCommPPPIMPL(team_pointer team,
+                                     size_type me) noexcept :
+  CommPPPIMPL(me, team->size()), m_team_(std::move(team)) {}
+
+ThreadCommPPPIMPL::pimpl_pointer ThreadCommPPPIMPL::clone() const {
+    return std::make_unique<ThreadCommPPPIMPL>(*this);
+}
+
+void ThreadCommPPPIMPL::gather(const_binary_reference data,
+                               binary_reference out_buffer,
+                               opt_root_t root) const {
+    const bool am_i_root = root.has_value() ? me() == *root : true;
+
+    const auto n_in = data.size();
+    if(am_i_root && out_buffer.size() < n_in * size()) {
+        // Only the root knows, so the other ranks must be told not to wait
+        m_team_->abort();
+        throw std::runtime_error("The provided buffer is not large enough...");
+    }
+
+    m_team_->post(me(), data.data(), n_in);
+    m_team_->barrier();
+    if(am_i_root && n_in > 0) {
+        auto* p_out = out_buffer.data();
+        for(size_type i = 0; i < size(); ++i)
+            std::memcpy(p_out + i * n_in, m_team_->slot(i).data, n_in);
+    }
+    // Nobody may reuse their buffer until everyone is done reading it
+    m_team_->barrier();
+}
+
+ThreadCommPPPIMPL::binary_gatherv_return ThreadCommPPPIMPL::gatherv(
+  const_binary_reference data, opt_root_t root) const {
+    const bool am_i_root = root.has_value() ? me() == *root : true;
+
+    m_team_->post(me(), data.data(), data.size());
+    m_team_->barrier();
+
+    // If the root fails the other ranks must not wait for it
+    binary_gatherv_return rv;
+    try {
+        if(am_i_root) {
+            std::vector<size_type> sizes(size());
+            std::size_t total = 0;
+            for(size_type i = 0; i < size(); ++i) {
+                sizes[i] = m_team_->slot(i).nbytes;
+                total += sizes[i];
+            }
+
+            binary_type buffer(total);
+            std::size_t offset = 0;
+            for(size_type i = 0; i < size(); ++i) {
+                const auto& slot = m_team_->slot(i);
+                if(slot.nbytes == 0) continue;
+                std::memcpy(buffer.data() + offset, slot.data, slot.nbytes);
+                offset += slot.nbytes;
+            }
+            rv.emplace(std::move(buffer), std::move(sizes));
+        }
+    } catch(...) {
+        m_team_->abort();
+        throw;
+    }
+    m_team_->barrier();
+    return rv;
+}
+
+void ThreadCommPPPIMPL::reduce(const void* send, void* recv, int count,
+                               MPI_Datatype, MPI_Op, local_reduce_type local,
+                               opt_root_t root) const {
+    const bool am_i_root = root.has_value() ? me() == *root : true;
+
+    m_team_->post(me(), send, count);
+    m_team_->barrier();
+    try {
+        if(am_i_root && count > 0) {
+            std::vector<const void*> inputs(size());
+            for(size_type i = 0; i < size(); ++i)
+                inputs[i] = m_team_->slot(i).data;
+            local(inputs.data(), inputs.size(), recv, count);
+        }
+    } catch(...) {
+        m_team_->abort();
+        throw;
+    }
+    m_team_->barrier();
+}
+
+// -----------------------------------------------------------------------------
+// -- Protected methods
+// -----------------------------------------------------------------------------
+
+bool ThreadCommPPPIMPL::is_equal_(const CommPPPIMPL& rhs) const noexcept {
+    // N.B. operator== already checked that rhs is a ThreadCommPPPIMPL
+    const auto& prhs = static_cast<const ThreadCommPPPIMPL&>(rhs);
+    return m_team_ == prhs.m_team_;
+}
+
+} // namespace parallelzone::mpi_helpers::detail_
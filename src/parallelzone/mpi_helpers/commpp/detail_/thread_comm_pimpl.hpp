@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "commpp_pimpl.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace parallelzone::mpi_helpers::detail_ {
+
+/// Thrown by the collectives of a ThreadTeam after a rank aborted it
+class TeamAborted : public std::runtime_error {
+public:
+    TeamAborted() : std::runtime_error("Another rank of the team failed") {}
+};
+
+/** @brief The state shared by the threads acting as the ranks of a
+ *         thread-backed communicator.
+ *
+ *  Each rank publishes a pointer to (and the size of) its contribution to a
+ *  collective in its slot, then waits at the team's barrier. After the
+ *  barrier every rank can read every other rank's slot. A second barrier
+ *  keeps the contributions alive (and the slots unchanged) until all ranks
+ *  are done reading them.
+ *
+ *  The barrier is a mutex and condition variable with a generation counter,
+ *  so the same barrier can be reused for every collective. A rank which
+ *  fails aborts the team, after which every barrier throws; otherwise the
+ *  remaining ranks would wait forever for the failed rank.
+ */
+class ThreadTeam {
+public:
+    /// Type used for ranks and sizes, same as CommPP::size_type
+    using size_type = CommPP::size_type;
+
+    /// What a rank publishes: the address and number of bytes of its data
+    struct slot_type {
+        const void* data   = nullptr;
+        std::size_t nbytes = 0;
+    };
+
+    /** @brief Creates the state for a team of @p n_ranks threads.
+     *
+     *  @param[in] n_ranks The number of threads in the team.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the slots.
+     *                        Strong throw guarantee.
+     */
+    explicit ThreadTeam(size_type n_ranks) : m_slots_(n_ranks) {}
+
+    /// The number of threads in the team
+    size_type size() const noexcept { return m_slots_.size(); }
+
+    /** @brief Blocks until all size() threads have called barrier.
+     *
+     *  Writes made by a thread before calling barrier are visible to every
+     *  thread of the team after it returns from the same barrier.
+     *
+     *  @throw TeamAborted if the team was aborted before or while waiting.
+     *                     Strong throw guarantee.
+     */
+    void barrier();
+
+    /** @brief Marks the team as failed and wakes the waiting threads.
+     *
+     *  Called by a rank which will not reach the next barrier (e.g., because
+     *  it threw). All current and future calls to barrier throw.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void abort() noexcept;
+
+    /// Has abort been called?
+    bool aborted() const noexcept;
+
+    /** @brief Publishes @p nbytes bytes at @p data as rank @p me's
+     *         contribution.
+     *
+     *  Only rank @p me may write to slot @p me and other ranks may only read
+     *  it after the next barrier.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void post(size_type me, const void* data, std::size_t nbytes) noexcept {
+        m_slots_[me] = slot_type{data, nbytes};
+    }
+
+    /// What rank @p rank published for the current collective
+    const slot_type& slot(size_type rank) const noexcept {
+        return m_slots_[rank];
+    }
+
+private:
+    /// Guards m_n_arrived_, m_generation_, and m_aborted_
+    mutable std::mutex m_mutex_;
+
+    /// Used to wake the waiting threads once the last thread arrives
+    std::condition_variable m_cv_;
+
+    /// How many threads have arrived at the current barrier
+    size_type m_n_arrived_ = 0;
+
+    /// How many barriers have completed, used to detect wake-ups
+    std::size_t m_generation_ = 0;
+
+    /// Has a rank failed?
+    bool m_aborted_ = false;
+
+    /// The i-th element is what rank i published
+    std::vector<slot_type> m_slots_;
+};
+
+/** @brief Implements CommPP for a team of threads in the current process.
+ *
+ *  Each instance is one rank of a ThreadTeam. Collectives are implemented by
+ *  having every rank publish its data to the team, then copying directly out
+ *  of the other ranks' buffers. No MPI calls are made, so MPI need not be
+ *  initialized to use this class, and comm() is MPI_COMM_NULL.
+ */
+class ThreadCommPPPIMPL : public CommPPPIMPL {
+public:
+    /// Type of a pointer to the team's shared state
+    using team_pointer = std::shared_ptr<ThreadTeam>;
+
+    /** @brief Makes *this rank @p me of @p team.
+     *
+     *  @param[in] team The state shared among the team's threads.
+     *  @param[in] me The rank of the thread which will use *this.
+     *
+     *  @throw None No throw guarantee.
+     */
+    ThreadCommPPPIMPL(team_pointer team, size_type me) noexcept;
+
+    /// Copies *this, the copy belongs to the same team and has the same rank
+    pimpl_pointer clone() const override;
+
+    /// Implements gather by copying out of the other ranks' buffers
+    void gather(const_binary_reference data, binary_reference out_buffer,
+                opt_root_t root = std::nullopt) const override;
+
+    /// Implements gatherv by copying out of the other ranks' buffers
+    binary_gatherv_return gatherv(
+      const_binary_reference data,
+      opt_root_t root = std::nullopt) const override;
+
+    /// Implements reduce by calling @p local on the other ranks' buffers
+    void reduce(const void* send, void* recv, int count, MPI_Datatype type,
+                MPI_Op op, local_reduce_type local,
+                opt_root_t root = std::nullopt) const override;
+
+    /// Brings the overload of gather which allocates the buffer into scope
+    using CommPPPIMPL::gather;
+
+    /// Aborts the team, so the other ranks' collectives throw
+    void abort() const noexcept override { m_team_->abort(); }
+
+protected:
+    /// Two instances are equal if they are part of the same team
+    bool is_equal_(const CommPPPIMPL& rhs) const noexcept override;
+
+private:
+    /// The state shared among the ranks
+    team_pointer m_team_;
+};
+
+} // namespace parallelzone::mpi_helpers::detail_
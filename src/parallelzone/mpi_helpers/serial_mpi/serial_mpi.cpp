@@ -0,0 +1,708 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* This file is only compiled into ParallelZone when it is configured with
+ * BUILD_WITHOUT_MPI. Otherwise the translation unit is empty.
+ */
+#ifdef PARALLELZONE_WITHOUT_MPI
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <parallelzone/mpi_helpers/serial_mpi/serial_mpi.hpp>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Handle given to nonblocking operations, which complete immediately
+constexpr MPI_Request completed_request = 1;
+
+// A message a rank sent to itself which has not been received yet
+struct Message {
+    MPI_Comm comm;
+    int tag;
+    std::vector<char> data;
+};
+
+// Callbacks registered with MPI_Comm_create_keyval
+struct Keyval {
+    MPI_Comm_copy_attr_function* copy_fn;
+    MPI_Comm_delete_attr_function* delete_fn;
+    void* extra_state;
+};
+
+// Attributes of a communicator, keyed by keyval
+using attribute_map = std::map<int, void*>;
+
+struct State {
+    // Guards everything in *this
+    std::mutex mutex;
+
+    // Signaled when a message is sent
+    std::condition_variable message_sent;
+
+    bool initialized = false;
+    bool finalized   = false;
+    int thread_level = MPI_THREAD_SINGLE;
+
+    // The live communicators, handles are never reused
+    std::map<MPI_Comm, attribute_map> comms{{MPI_COMM_WORLD, {}},
+                                            {MPI_COMM_SELF, {}}};
+    MPI_Comm next_comm = MPI_COMM_SELF + 1;
+
+    std::map<int, Keyval> keyvals;
+    int next_keyval = 0;
+
+    std::deque<Message> messages;
+};
+
+// Intentionally leaked so MPI can be used during static destruction
+State& state() {
+    static auto* s = new State;
+    return *s;
+}
+
+int type_size(MPI_Datatype type) noexcept {
+    switch(type) {
+        case MPI_CHAR: return sizeof(char);
+        case MPI_SIGNED_CHAR: return sizeof(signed char);
+        case MPI_UNSIGNED_CHAR: return sizeof(unsigned char);
+        case MPI_BYTE: return 1;
+        case MPI_SHORT: return sizeof(short);
+        case MPI_UNSIGNED_SHORT: return sizeof(unsigned short);
+        case MPI_INT: return sizeof(int);
+        case MPI_UNSIGNED: return sizeof(unsigned);
+        case MPI_LONG: return sizeof(long);
+        case MPI_UNSIGNED_LONG: return sizeof(unsigned long);
+        case MPI_LONG_LONG: return sizeof(long long);
+        case MPI_UNSIGNED_LONG_LONG: return sizeof(unsigned long long);
+        case MPI_FLOAT: return sizeof(float);
+        case MPI_DOUBLE: return sizeof(double);
+        case MPI_LONG_DOUBLE: return sizeof(long double);
+        case MPI_C_BOOL: return sizeof(bool);
+        case MPI_C_FLOAT_COMPLEX: return sizeof(std::complex<float>);
+        case MPI_C_DOUBLE_COMPLEX: return sizeof(std::complex<double>);
+        case MPI_C_LONG_DOUBLE_COMPLEX:
+            return sizeof(std::complex<long double>);
+    }
+    return -1;
+}
+
+// Checks that comm exists, caller must hold the lock
+bool is_valid(const State& s, MPI_Comm comm) {
+    return s.comms.count(comm) > 0;
+}
+
+bool is_valid(MPI_Comm comm) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return is_valid(s, comm);
+}
+
+// Makes a new communicator
+MPI_Comm new_comm() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const auto comm = s.next_comm++;
+    s.comms.emplace(comm, attribute_map{});
+    return comm;
+}
+
+// Calls the delete callbacks of attrs, without holding the lock since the
+// callbacks may call back into MPI
+int delete_attributes(MPI_Comm comm, const attribute_map& attrs) {
+    auto& s = state();
+    int rv  = MPI_SUCCESS;
+    for(const auto& [keyval, value] : attrs) {
+        Keyval kv{};
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            auto itr = s.keyvals.find(keyval);
+            if(itr == s.keyvals.end()) continue;
+            kv = itr->second;
+        }
+        if(kv.delete_fn == nullptr) continue;
+        if(kv.delete_fn(comm, keyval, value, kv.extra_state) != MPI_SUCCESS)
+            rv = MPI_ERR_OTHER;
+    }
+    return rv;
+}
+
+// Copies count elements from in to out, unless in is MPI_IN_PLACE
+int copy(const void* in, int count, MPI_Datatype type, void* out) {
+    const auto n = type_size(type);
+    if(n < 0) return MPI_ERR_TYPE;
+    if(count < 0) return MPI_ERR_ARG;
+    if(in == MPI_IN_PLACE || in == out || count == 0) return MPI_SUCCESS;
+    std::memmove(out, in, std::size_t(count) * n);
+    return MPI_SUCCESS;
+}
+
+// Checks comm and root, then copies
+int rooted_copy(const void* in, int count, MPI_Datatype type, void* out,
+                int root, MPI_Comm comm) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    if(root != 0) return MPI_ERR_ROOT;
+    return copy(in, count, type, out);
+}
+
+int all_copy(const void* in, int count, MPI_Datatype type, void* out,
+             MPI_Comm comm) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    return copy(in, count, type, out);
+}
+
+// Marks a nonblocking operation as done if it succeeded
+int complete(int error, MPI_Request* request) {
+    if(request != nullptr)
+        *request = error == MPI_SUCCESS ? completed_request : MPI_REQUEST_NULL;
+    return error;
+}
+
+void fill_status(MPI_Status* status, int source, int tag) {
+    if(status == MPI_STATUS_IGNORE) return;
+    status->MPI_SOURCE = source;
+    status->MPI_TAG    = tag;
+    status->MPI_ERROR  = MPI_SUCCESS;
+}
+
+template<typename T>
+struct is_complex : std::false_type {};
+
+template<typename T>
+struct is_complex<std::complex<T>> : std::true_type {};
+
+// inout[i] = in[i] op inout[i]
+template<typename T>
+int reduce_local(const void* pin, void* pinout, int count, MPI_Op op) {
+    const auto* in = static_cast<const T*>(pin);
+    auto* inout    = static_cast<T*>(pinout);
+
+    constexpr bool ordered = !is_complex<T>::value;
+    constexpr bool bitwise = std::is_integral_v<T>;
+
+    auto apply = [&](auto&& fxn) {
+        for(int i = 0; i < count; ++i) inout[i] = fxn(in[i], inout[i]);
+        return MPI_SUCCESS;
+    };
+
+    switch(op) {
+        case MPI_SUM: return apply([](T a, T b) { return T(a + b); });
+        case MPI_PROD: return apply([](T a, T b) { return T(a * b); });
+        case MPI_MAX:
+            if constexpr(ordered)
+                return apply([](T a, T b) { return std::max(a, b); });
+            break;
+        case MPI_MIN:
+            if constexpr(ordered)
+                return apply([](T a, T b) { return std::min(a, b); });
+            break;
+        case MPI_LAND:
+            if constexpr(ordered)
+                return apply([](T a, T b) { return T(a != T{} && b != T{}); });
+            break;
+        case MPI_LOR:
+            if constexpr(ordered)
+                return apply([](T a, T b) { return T(a != T{} || b != T{}); });
+            break;
+        case MPI_LXOR:
+            if constexpr(ordered)
+                return apply(
+                  [](T a, T b) { return T((a != T{}) != (b != T{})); });
+            break;
+        case MPI_BAND:
+            if constexpr(bitwise)
+                return apply([](T a, T b) { return T(a & b); });
+            break;
+        case MPI_BOR:
+            if constexpr(bitwise)
+                return apply([](T a, T b) { return T(a | b); });
+            break;
+        case MPI_BXOR:
+            if constexpr(bitwise)
+                return apply([](T a, T b) { return T(a ^ b); });
+            break;
+    }
+    return MPI_ERR_OP;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// -- Environment
+// -----------------------------------------------------------------------------
+
+int MPI_Init(int* argc, char*** argv) {
+    int provided = 0;
+    return MPI_Init_thread(argc, argv, MPI_THREAD_SINGLE, &provided);
+}
+
+int MPI_Init_thread(int*, char***, int required, int* provided) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if(s.initialized) return MPI_ERR_OTHER;
+    s.initialized  = true;
+    s.thread_level = std::clamp(required, MPI_THREAD_SINGLE,
+                                MPI_THREAD_MULTIPLE);
+    *provided      = s.thread_level;
+    return MPI_SUCCESS;
+}
+
+int MPI_Initialized(int* flag) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    *flag = s.initialized;
+    return MPI_SUCCESS;
+}
+
+int MPI_Finalize() {
+    auto& s = state();
+    attribute_map self_attrs;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if(!s.initialized || s.finalized) return MPI_ERR_OTHER;
+        self_attrs.swap(s.comms[MPI_COMM_SELF]);
+    }
+    // As in MPI, attributes on MPI_COMM_SELF are deleted first
+    delete_attributes(MPI_COMM_SELF, self_attrs);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.finalized = true;
+    return MPI_SUCCESS;
+}
+
+int MPI_Finalized(int* flag) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    *flag = s.finalized;
+    return MPI_SUCCESS;
+}
+
+int MPI_Query_thread(int* provided) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    *provided = s.thread_level;
+    return MPI_SUCCESS;
+}
+
+int MPI_Abort(MPI_Comm, int errorcode) { std::_Exit(errorcode); }
+
+double MPI_Wtime() {
+    using clock_type = std::chrono::steady_clock;
+    using seconds    = std::chrono::duration<double>;
+    return seconds(clock_type::now().time_since_epoch()).count();
+}
+
+int MPI_Get_processor_name(char* name, int* resultlen) {
+    if(gethostname(name, MPI_MAX_PROCESSOR_NAME) != 0) {
+        std::strcpy(name, "localhost");
+    }
+    name[MPI_MAX_PROCESSOR_NAME - 1] = '\0';
+    *resultlen = static_cast<int>(std::strlen(name));
+    return MPI_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// -- Communicators and attributes
+// -----------------------------------------------------------------------------
+
+int MPI_Comm_size(MPI_Comm comm, int* size) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    *size = 1;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_rank(MPI_Comm comm, int* rank) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    *rank = 0;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm* newcomm) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    *newcomm = new_comm();
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_split(MPI_Comm comm, int color, int, MPI_Comm* newcomm) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    *newcomm = color == MPI_UNDEFINED ? MPI_COMM_NULL : new_comm();
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info,
+                        MPI_Comm* newcomm) {
+    return MPI_Comm_split(comm, split_type, key, newcomm);
+}
+
+int MPI_Comm_free(MPI_Comm* comm) {
+    if(*comm == MPI_COMM_WORLD || *comm == MPI_COMM_SELF) return MPI_ERR_COMM;
+    auto& s = state();
+    attribute_map attrs;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto itr = s.comms.find(*comm);
+        if(itr == s.comms.end()) return MPI_ERR_COMM;
+        attrs.swap(itr->second);
+        s.comms.erase(itr);
+    }
+    const auto rv = delete_attributes(*comm, attrs);
+    *comm         = MPI_COMM_NULL;
+    return rv;
+}
+
+int MPI_Comm_compare(MPI_Comm comm1, MPI_Comm comm2, int* result) {
+    if(comm1 == comm2) {
+        *result = MPI_IDENT;
+    } else if(is_valid(comm1) && is_valid(comm2)) {
+        // Every communicator is rank 0 of this process
+        *result = MPI_CONGRUENT;
+    } else {
+        *result = MPI_UNEQUAL;
+    }
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_create_keyval(MPI_Comm_copy_attr_function* copy_fn,
+                           MPI_Comm_delete_attr_function* delete_fn,
+                           int* keyval, void* extra_state) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    *keyval = s.next_keyval++;
+    s.keyvals.emplace(*keyval, Keyval{copy_fn, delete_fn, extra_state});
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_free_keyval(int* keyval) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if(s.keyvals.erase(*keyval) == 0) return MPI_ERR_KEYVAL;
+    *keyval = MPI_KEYVAL_INVALID;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_set_attr(MPI_Comm comm, int keyval, void* value) {
+    auto& s = state();
+    void* old_value = nullptr;
+    bool had_value  = false;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if(!is_valid(s, comm)) return MPI_ERR_COMM;
+        if(!s.keyvals.count(keyval)) return MPI_ERR_KEYVAL;
+        auto& attrs = s.comms[comm];
+        auto itr    = attrs.find(keyval);
+        if(itr != attrs.end()) {
+            had_value = true;
+            old_value = itr->second;
+        }
+        attrs[keyval] = value;
+    }
+    // Replacing an attribute deletes the old value
+    if(had_value) return delete_attributes(comm, {{keyval, old_value}});
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_get_attr(MPI_Comm comm, int keyval, void* value, int* flag) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if(!is_valid(s, comm)) return MPI_ERR_COMM;
+    if(!s.keyvals.count(keyval)) return MPI_ERR_KEYVAL;
+    const auto& attrs = s.comms[comm];
+    auto itr          = attrs.find(keyval);
+    *flag             = itr != attrs.end();
+    if(*flag) *static_cast<void**>(value) = itr->second;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_delete_attr(MPI_Comm comm, int keyval) {
+    auto& s = state();
+    attribute_map attrs;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if(!is_valid(s, comm)) return MPI_ERR_COMM;
+        auto& comm_attrs = s.comms[comm];
+        auto itr         = comm_attrs.find(keyval);
+        if(itr == comm_attrs.end()) return MPI_ERR_KEYVAL;
+        attrs.emplace(*itr);
+        comm_attrs.erase(itr);
+    }
+    return delete_attributes(comm, attrs);
+}
+
+// -----------------------------------------------------------------------------
+// -- Datatypes and reductions
+// -----------------------------------------------------------------------------
+
+int MPI_Type_size(MPI_Datatype type, int* size) {
+    const auto n = type_size(type);
+    if(n < 0) return MPI_ERR_TYPE;
+    *size = n;
+    return MPI_SUCCESS;
+}
+
+int MPI_Reduce_local(const void* inbuf, void* inoutbuf, int count,
+                     MPI_Datatype type, MPI_Op op) {
+    switch(type) {
+        case MPI_CHAR: return reduce_local<char>(inbuf, inoutbuf, count, op);
+        case MPI_SIGNED_CHAR:
+            return reduce_local<signed char>(inbuf, inoutbuf, count, op);
+        case MPI_UNSIGNED_CHAR:
+        case MPI_BYTE:
+            return reduce_local<unsigned char>(inbuf, inoutbuf, count, op);
+        case MPI_SHORT:
+            return reduce_local<short>(inbuf, inoutbuf, count, op);
+        case MPI_UNSIGNED_SHORT:
+            return reduce_local<unsigned short>(inbuf, inoutbuf, count, op);
+        case MPI_INT: return reduce_local<int>(inbuf, inoutbuf, count, op);
+        case MPI_UNSIGNED:
+            return reduce_local<unsigned>(inbuf, inoutbuf, count, op);
+        case MPI_LONG: return reduce_local<long>(inbuf, inoutbuf, count, op);
+        case MPI_UNSIGNED_LONG:
+            return reduce_local<unsigned long>(inbuf, inoutbuf, count, op);
+        case MPI_LONG_LONG:
+            return reduce_local<long long>(inbuf, inoutbuf, count, op);
+        case MPI_UNSIGNED_LONG_LONG:
+            return reduce_local<unsigned long long>(inbuf, inoutbuf, count,
+                                                    op);
+        case MPI_FLOAT: return reduce_local<float>(inbuf, inoutbuf, count, op);
+        case MPI_DOUBLE:
+            return reduce_local<double>(inbuf, inoutbuf, count, op);
+        case MPI_LONG_DOUBLE:
+            return reduce_local<long double>(inbuf, inoutbuf, count, op);
+        case MPI_C_BOOL: return reduce_local<bool>(inbuf, inoutbuf, count, op);
+        case MPI_C_FLOAT_COMPLEX:
+            return reduce_local<std::complex<float>>(inbuf, inoutbuf, count,
+                                                     op);
+        case MPI_C_DOUBLE_COMPLEX:
+            return reduce_local<std::complex<double>>(inbuf, inoutbuf, count,
+                                                      op);
+        case MPI_C_LONG_DOUBLE_COMPLEX:
+            return reduce_local<std::complex<long double>>(inbuf, inoutbuf,
+                                                           count, op);
+    }
+    return MPI_ERR_TYPE;
+}
+
+// -----------------------------------------------------------------------------
+// -- Point-to-point
+// -----------------------------------------------------------------------------
+
+int MPI_Send(const void* buf, int count, MPI_Datatype type, int dest, int tag,
+             MPI_Comm comm) {
+    if(dest == MPI_PROC_NULL) return MPI_SUCCESS;
+    if(dest != 0) return MPI_ERR_RANK;
+    const auto n = type_size(type);
+    if(n < 0) return MPI_ERR_TYPE;
+
+    // Sends are buffered, so they never block
+    const auto* p = static_cast<const char*>(buf);
+    Message msg{comm, tag, std::vector<char>(p, p + std::size_t(count) * n)};
+    auto& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if(!is_valid(s, comm)) return MPI_ERR_COMM;
+        s.messages.push_back(std::move(msg));
+    }
+    s.message_sent.notify_all();
+    return MPI_SUCCESS;
+}
+
+int MPI_Recv(void* buf, int count, MPI_Datatype type, int source, int tag,
+             MPI_Comm comm, MPI_Status* status) {
+    if(source == MPI_PROC_NULL) {
+        fill_status(status, MPI_PROC_NULL, MPI_ANY_TAG);
+        return MPI_SUCCESS;
+    }
+    if(source != 0 && source != MPI_ANY_SOURCE) return MPI_ERR_RANK;
+    const auto n = type_size(type);
+    if(n < 0) return MPI_ERR_TYPE;
+
+    auto& s = state();
+    std::unique_lock<std::mutex> lock(s.mutex);
+    if(!is_valid(s, comm)) return MPI_ERR_COMM;
+
+    auto find_message = [&]() {
+        return std::find_if(s.messages.begin(), s.messages.end(),
+                            [&](const Message& m) {
+                                return m.comm == comm &&
+                                       (tag == MPI_ANY_TAG || m.tag == tag);
+                            });
+    };
+
+    auto itr = find_message();
+    if(itr == s.messages.end()) {
+        // Only another thread can send the message. If there can't be one,
+        // fail instead of deadlocking.
+        if(s.thread_level != MPI_THREAD_MULTIPLE) return MPI_ERR_OTHER;
+        s.message_sent.wait(lock, [&]() {
+            itr = find_message();
+            return itr != s.messages.end();
+        });
+    }
+
+    if(itr->data.size() > std::size_t(count) * n) return MPI_ERR_TRUNCATE;
+    std::copy(itr->data.begin(), itr->data.end(), static_cast<char*>(buf));
+    fill_status(status, 0, itr->tag);
+    s.messages.erase(itr);
+    return MPI_SUCCESS;
+}
+
+int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                 int dest, int sendtag, void* recvbuf, int recvcount,
+                 MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm,
+                 MPI_Status* status) {
+    auto rv = MPI_Send(sendbuf, sendcount, sendtype, dest, sendtag, comm);
+    if(rv != MPI_SUCCESS) return rv;
+    return MPI_Recv(recvbuf, recvcount, recvtype, source, recvtag, comm,
+                    status);
+}
+
+// -----------------------------------------------------------------------------
+// -- Collectives
+// -----------------------------------------------------------------------------
+
+int MPI_Barrier(MPI_Comm comm) {
+    return is_valid(comm) ? MPI_SUCCESS : MPI_ERR_COMM;
+}
+
+int MPI_Bcast(void*, int, MPI_Datatype, int root, MPI_Comm comm) {
+    if(!is_valid(comm)) return MPI_ERR_COMM;
+    return root == 0 ? MPI_SUCCESS : MPI_ERR_ROOT;
+}
+
+int MPI_Gather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+               void* recvbuf, int, MPI_Datatype, int root, MPI_Comm comm) {
+    return rooted_copy(sendbuf, sendcount, sendtype, recvbuf, root, comm);
+}
+
+int MPI_Gatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                void* recvbuf, const int*, const int* displs,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    if(sendbuf == MPI_IN_PLACE)
+        return rooted_copy(sendbuf, sendcount, sendtype, recvbuf, root, comm);
+    const auto n = type_size(recvtype);
+    if(n < 0) return MPI_ERR_TYPE;
+    auto* out = static_cast<char*>(recvbuf) + std::size_t(displs[0]) * n;
+    return rooted_copy(sendbuf, sendcount, sendtype, out, root, comm);
+}
+
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void* recvbuf, int, MPI_Datatype, MPI_Comm comm) {
+    return all_copy(sendbuf, sendcount, sendtype, recvbuf, comm);
+}
+
+int MPI_Allgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                   void* recvbuf, const int*, const int* displs,
+                   MPI_Datatype recvtype, MPI_Comm comm) {
+    if(sendbuf == MPI_IN_PLACE)
+        return all_copy(sendbuf, sendcount, sendtype, recvbuf, comm);
+    const auto n = type_size(recvtype);
+    if(n < 0) return MPI_ERR_TYPE;
+    auto* out = static_cast<char*>(recvbuf) + std::size_t(displs[0]) * n;
+    return all_copy(sendbuf, sendcount, sendtype, out, comm);
+}
+
+int MPI_Reduce(const void* sendbuf, void* recvbuf, int count,
+               MPI_Datatype type, MPI_Op, int root, MPI_Comm comm) {
+    return rooted_copy(sendbuf, count, type, recvbuf, root, comm);
+}
+
+int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
+                  MPI_Datatype type, MPI_Op, MPI_Comm comm) {
+    return all_copy(sendbuf, count, type, recvbuf, comm);
+}
+
+// -----------------------------------------------------------------------------
+// -- Nonblocking collectives and completion
+// -----------------------------------------------------------------------------
+
+int MPI_Ibarrier(MPI_Comm comm, MPI_Request* request) {
+    return complete(MPI_Barrier(comm), request);
+}
+
+int MPI_Igather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
+                MPI_Comm comm, MPI_Request* request) {
+    return complete(MPI_Gather(sendbuf, sendcount, sendtype, recvbuf,
+                               recvcount, recvtype, root, comm),
+                    request);
+}
+
+int MPI_Iallgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                   void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                   MPI_Comm comm, MPI_Request* request) {
+    return complete(MPI_Allgather(sendbuf, sendcount, sendtype, recvbuf,
+                                  recvcount, recvtype, comm),
+                    request);
+}
+
+int MPI_Ireduce(const void* sendbuf, void* recvbuf, int count,
+                MPI_Datatype type, MPI_Op op, int root, MPI_Comm comm,
+                MPI_Request* request) {
+    return complete(
+      MPI_Reduce(sendbuf, recvbuf, count, type, op, root, comm), request);
+}
+
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count,
+                   MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request) {
+    return complete(MPI_Allreduce(sendbuf, recvbuf, count, type, op, comm),
+                    request);
+}
+
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status) {
+    *flag = 1;
+    fill_status(status, 0, MPI_ANY_TAG);
+    *request = MPI_REQUEST_NULL;
+    return MPI_SUCCESS;
+}
+
+int MPI_Wait(MPI_Request* request, MPI_Status* status) {
+    int flag = 0;
+    return MPI_Test(request, &flag, status);
+}
+
+int MPI_Testsome(int incount, MPI_Request* requests, int* outcount,
+                 int* indices, MPI_Status* statuses) {
+    // Every active request is complete
+    *outcount = 0;
+    for(int i = 0; i < incount; ++i) {
+        if(requests[i] == MPI_REQUEST_NULL) continue;
+        requests[i] = MPI_REQUEST_NULL;
+        if(statuses != MPI_STATUSES_IGNORE)
+            fill_status(statuses + *outcount, 0, MPI_ANY_TAG);
+        indices[(*outcount)++] = i;
+    }
+    if(*outcount == 0) *outcount = MPI_UNDEFINED;
+    return MPI_SUCCESS;
+}
+
+int MPI_Waitall(int count, MPI_Request* requests, MPI_Status* statuses) {
+    for(int i = 0; i < count; ++i) {
+        requests[i] = MPI_REQUEST_NULL;
+        if(statuses != MPI_STATUSES_IGNORE)
+            fill_status(statuses + i, 0, MPI_ANY_TAG);
+    }
+    return MPI_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <parallelzone/runtime/comm_cost_model.hpp>
+
+namespace parallelzone::runtime {
+namespace {
+
+// First line of a saved model, bump the version if the format changes
+constexpr const char* file_header = "parallelzone-comm-cost-model 1";
+
+} // namespace
+
+CommCostModel::LinkParameters CommCostModel::parameters(
+  level l) const noexcept {
+    switch(l) {
+        case level::intra_node: return m_intra_;
+        case level::inter_node: return m_inter_;
+        default: return LinkParameters{};
+    }
+}
+
+bool CommCostModel::save(const std::string& path,
+                         key_type key) const noexcept {
+    try {
+        std::ofstream file(path, std::ios::trunc);
+        if(!file) return false;
+        // Enough digits for the doubles to round trip exactly
+        file << std::setprecision(17);
+        file << file_header << '\n' << std::hex << key << std::dec << '\n';
+        file << "intra_node " << m_intra_.alpha << ' ' << m_intra_.beta << '\n';
+        file << "inter_node " << m_inter_.alpha << ' ' << m_inter_.beta << '\n';
+        return static_cast<bool>(file);
+    } catch(...) { return false; }
+}
+
+std::optional<CommCostModel> CommCostModel::load(const std::string& path,
+                                                 key_type key) noexcept {
+    try {
+        std::ifstream file(path);
+        if(!file) return std::nullopt;
+
+        std::string header;
+        std::getline(file, header);
+        if(header != file_header) return std::nullopt;
+
+        key_type file_key = 0;
+        file >> std::hex >> file_key >> std::dec;
+        if(!file || file_key != key) return std::nullopt;
+
+        std::string intra, inter;
+        LinkParameters intra_p, inter_p;
+        file >> intra >> intra_p.alpha >> intra_p.beta;
+        file >> inter >> inter_p.alpha >> inter_p.beta;
+        if(!file || intra != "intra_node" || inter != "inter_node")
+            return std::nullopt;
+        return CommCostModel(intra_p, inter_p);
+    } catch(...) { return std::nullopt; }
+}
+
+} // namespace parallelzone::runtime
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interconnect_probe.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+#include <vector>
+
+namespace parallelzone::runtime::detail_ {
+namespace {
+
+// Average one-way time of n_iter round trips of n_bytes between a and b.
+// Only meaningful on rank a, other ranks get 0.
+double ping_pong(MPI_Comm comm, int me, int a, int b, std::vector<char>& buffer,
+                 std::size_t n_bytes, std::size_t n_warmup,
+                 std::size_t n_iter) {
+    constexpr int tag = 0;
+    const int count   = static_cast<int>(n_bytes);
+    double start      = 0.0;
+    for(std::size_t i = 0; i < n_warmup + n_iter; ++i) {
+        if(i == n_warmup) start = MPI_Wtime();
+        if(me == a) {
+            MPI_Send(buffer.data(), count, MPI_BYTE, b, tag, comm);
+            MPI_Recv(buffer.data(), count, MPI_BYTE, b, tag, comm,
+                     MPI_STATUS_IGNORE);
+        } else {
+            MPI_Recv(buffer.data(), count, MPI_BYTE, a, tag, comm,
+                     MPI_STATUS_IGNORE);
+            MPI_Send(buffer.data(), count, MPI_BYTE, a, tag, comm);
+        }
+    }
+    if(n_iter == 0) return 0.0;
+    return (MPI_Wtime() - start) / (2.0 * double(n_iter));
+}
+
+// The first two ranks of the first node with more than one rank, if any
+bool intra_node_pair(const ResourceSetTable& table, int& a, int& b) {
+    for(std::size_t node = 0; node < table.n_nodes(); ++node) {
+        const auto& ranks = table.ranks_on_node(node);
+        if(ranks.size() < 2) continue;
+        a = static_cast<int>(ranks[0]);
+        b = static_cast<int>(ranks[1]);
+        return true;
+    }
+    return false;
+}
+
+// The leaders of nodes 0 and 1, if there are two nodes
+bool inter_node_pair(const ResourceSetTable& table, int& a, int& b) {
+    if(table.n_nodes() < 2) return false;
+    a = static_cast<int>(table.ranks_on_node(0)[0]);
+    b = static_cast<int>(table.ranks_on_node(1)[0]);
+    return true;
+}
+
+} // namespace
+
+link_parameters measure_link(MPI_Comm comm, int a, int b,
+                             const ProbeSettings& settings) {
+    int me = 0;
+    MPI_Comm_rank(comm, &me);
+
+    double params[2] = {0.0, 0.0};
+    if(me == a || me == b) {
+        const auto small = settings.small_message;
+        const auto large = std::max(settings.large_message, small + 1);
+        std::vector<char> buffer(large);
+
+        const auto t_small = ping_pong(comm, me, a, b, buffer, small,
+                                       settings.n_warmup, settings.n_small);
+        const auto t_large = ping_pong(comm, me, a, b, buffer, large,
+                                       settings.n_warmup, settings.n_large);
+        params[0] = t_small;
+        params[1] = std::max(0.0, (t_large - t_small) / double(large - small));
+    }
+    MPI_Bcast(params, 2, MPI_DOUBLE, a, comm);
+    return link_parameters{params[0], params[1]};
+}
+
+CommCostModel probe_interconnect(MPI_Comm comm, const ResourceSetTable& table,
+                                 const ProbeSettings& settings) {
+    // Probe on a private communicator so our messages can't match the user's
+    MPI_Comm probe_comm;
+    MPI_Comm_dup(comm, &probe_comm);
+
+    int a = 0, b = 0;
+    const bool has_intra = intra_node_pair(table, a, b);
+    link_parameters intra;
+    if(has_intra) intra = measure_link(probe_comm, a, b, settings);
+
+    const bool has_inter = inter_node_pair(table, a, b);
+    link_parameters inter;
+    if(has_inter) inter = measure_link(probe_comm, a, b, settings);
+
+    MPI_Comm_free(&probe_comm);
+
+    if(!has_intra) intra = inter;
+    if(!has_inter) inter = intra;
+    return CommCostModel(intra, inter);
+}
+
+std::string default_cache_dir() {
+    namespace fs = std::filesystem;
+    if(const char* dir = std::getenv("PARALLELZONE_CACHE_DIR")) return dir;
+    if(const char* dir = std::getenv("XDG_CACHE_HOME"))
+        return (fs::path(dir) / "parallelzone").string();
+    if(const char* dir = std::getenv("HOME"))
+        return (fs::path(dir) / ".cache" / "parallelzone").string();
+    return "";
+}
+
+std::string cost_model_cache_file(const std::string& cache_dir,
+                                  CommCostModel::key_type key) {
+    std::ostringstream name;
+    name << "comm_cost_model_" << std::hex << key << ".txt";
+    return (std::filesystem::path(cache_dir) / name.str()).string();
+}
+
+CommCostModel load_or_probe_interconnect(MPI_Comm comm,
+                                         const ResourceSetTable& table,
+                                         const std::string& cache_dir,
+                                         bool reprobe) {
+    int me = 0;
+    MPI_Comm_rank(comm, &me);
+
+    const auto key   = table.topology_hash();
+    const bool cache = !cache_dir.empty();
+    const auto path  = cache ? cost_model_cache_file(cache_dir, key) : "";
+
+    // Rank 0 reads the cache and shares the result: {found, params...}
+    double buffer[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    if(me == 0 && cache && !reprobe) {
+        if(auto model = CommCostModel::load(path, key)) {
+            using level      = CommCostModel::level;
+            const auto intra = model->parameters(level::intra_node);
+            const auto inter = model->parameters(level::inter_node);
+            buffer[0]        = 1.0;
+            buffer[1]        = intra.alpha;
+            buffer[2]        = intra.beta;
+            buffer[3]        = inter.alpha;
+            buffer[4]        = inter.beta;
+        }
+    }
+    MPI_Bcast(buffer, 5, MPI_DOUBLE, 0, comm);
+    if(buffer[0] != 0.0)
+        return CommCostModel({buffer[1], buffer[2]}, {buffer[3], buffer[4]});
+
+    auto model = probe_interconnect(comm, table);
+    if(me == 0 && cache) {
+        std::error_code ec;
+        std::filesystem::create_directories(cache_dir, ec);
+        model.save(path, key);
+    }
+    return model;
+}
+
+} // namespace parallelzone::runtime::detail_
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "resource_set_table.hpp"
+#include <parallelzone/mpi_helpers/mpi.hpp>
+#include <parallelzone/runtime/comm_cost_model.hpp>
+#include <string>
+
+namespace parallelzone::runtime::detail_ {
+
+/// Type of the parameters of one level of the CommCostModel
+using link_parameters = CommCostModel::LinkParameters;
+
+/// Knobs for the interconnect probe
+struct ProbeSettings {
+    /// Unsigned type used for sizes and counts
+    using size_type = std::size_t;
+
+    /// Size of the message used to measure latency
+    size_type small_message = 8;
+
+    /// Size of the message used to measure bandwidth
+    size_type large_message = size_type(1) << 20;
+
+    /// Round trips done before timing starts
+    size_type n_warmup = 5;
+
+    /// Timed round trips with the small message
+    size_type n_small = 100;
+
+    /// Timed round trips with the large message
+    size_type n_large = 10;
+};
+
+/** @brief Measures the alpha-beta parameters of the link between two ranks.
+ *
+ *  Ranks @p a and @p b ping-pong a small and a large message. The latency is
+ *  taken as the one-way time of the small message and the inverse bandwidth
+ *  from the difference between the large and the small message. The
+ *  parameters are then broadcast from @p a.
+ *
+ *  This function is collective over @p comm, although only ranks @p a and
+ *  @p b exchange messages.
+ *
+ *  @param[in] comm The communicator to probe over. Should be private to the
+ *                  probe so the messages can not be confused with others.
+ *  @param[in] a One end of the link.
+ *  @param[in] b The other end of the link. Must differ from @p a.
+ *  @param[in] settings The sizes and repetition counts to use.
+ *
+ *  @return The measured parameters, the same on every rank.
+ *
+ *  @throw std::bad_alloc if the message buffer can not be allocated.
+ */
+link_parameters measure_link(MPI_Comm comm, int a, int b,
+                             const ProbeSettings& settings = {});
+
+/** @brief Measures the intra-node and inter-node links of a communicator.
+ *
+ *  The intra-node link is measured between the first two ranks of the
+ *  first node with more than one rank. The inter-node link is measured
+ *  between the leaders (lowest ranks) of nodes 0 and 1. If only one kind of
+ *  link exists, the other is given the same parameters. If neither exists
+ *  (one rank), all communication is free.
+ *
+ *  This function is collective over @p comm.
+ *
+ *  @param[in] comm The communicator to probe. It is duplicated internally.
+ *  @param[in] table The node map of @p comm.
+ *  @param[in] settings The sizes and repetition counts to use.
+ *
+ *  @return The measured model, the same on every rank.
+ */
+CommCostModel probe_interconnect(MPI_Comm comm, const ResourceSetTable& table,
+                                 const ProbeSettings& settings = {});
+
+/** @brief The directory interconnect models are cached in by default.
+ *
+ *  This is `$PARALLELZONE_CACHE_DIR` if it is set. Otherwise it is the
+ *  `parallelzone` subdirectory of `$XDG_CACHE_HOME` or of `$HOME/.cache`.
+ *
+ *  @return The directory, or an empty string if none of the environment
+ *          variables are set.
+ */
+std::string default_cache_dir();
+
+/** @brief The file the model for a topology is cached in.
+ *
+ *  @param[in] cache_dir The directory the models are cached in.
+ *  @param[in] key The topology hash, see ResourceSetTable::topology_hash.
+ *
+ *  @return The path of the cache file.
+ */
+std::string cost_model_cache_file(const std::string& cache_dir,
+                                  CommCostModel::key_type key);
+
+/** @brief Loads the model for @p table from the cache, or measures it.
+ *
+ *  Rank 0 looks for a cached model in @p cache_dir and broadcasts what it
+ *  finds, so every rank uses the same model even if the file system is not
+ *  shared. If no model is cached (or @p reprobe is true) the interconnect is
+ *  probed and rank 0 writes the result to @p cache_dir. Failing to read or
+ *  write the cache is not an error, the cache is only an optimization.
+ *
+ *  This function is collective over @p comm.
+ *
+ *  @param[in] comm The communicator to characterize.
+ *  @param[in] table The node map of @p comm.
+ *  @param[in] cache_dir The cache directory. Empty means no caching.
+ *  @param[in] reprobe If true the cache is not read (it is still written).
+ *
+ *  @return The model, the same on every rank.
+ */
+CommCostModel load_or_probe_interconnect(MPI_Comm comm,
+                                         const ResourceSetTable& table,
+                                         const std::string& cache_dir,
+                                         bool reprobe);
+
+} // namespace parallelzone::runtime::detail_
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "progress_engine.hpp"
+#include <stdexcept>
+
+namespace parallelzone::runtime::detail_ {
+
+ProgressEngine::ProgressEngine(interval_type interval) : m_interval_(interval) {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    if(provided != MPI_THREAD_MULTIPLE)
+        throw std::runtime_error("The MPI progress thread requires MPI to be "
+                                 "initialized with MPI_THREAD_MULTIPLE");
+    m_thread_ = std::thread([this]() { run_(); });
+}
+
+ProgressEngine::~ProgressEngine() noexcept { stop(); }
+
+ProgressEngine::future_type ProgressEngine::register_request(
+  request_type request) {
+    std::promise<void> p;
+    auto f = p.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        if(m_stop_)
+            throw std::runtime_error("The MPI progress thread was stopped");
+        m_incoming_.reserve(m_incoming_.size() + 1);
+        m_incoming_promises_.reserve(m_incoming_promises_.size() + 1);
+        m_incoming_.push_back(request);
+        m_incoming_promises_.push_back(std::move(p));
+        ++m_n_pending_;
+    }
+    return f;
+}
+
+void ProgressEngine::stop() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_stop_ = true;
+    }
+    m_cv_.notify_all();
+    if(m_thread_.joinable()) m_thread_.join();
+}
+
+bool ProgressEngine::running() const noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return !m_stop_;
+}
+
+ProgressEngine::size_type ProgressEngine::n_pending() const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_n_pending_;
+}
+
+// -----------------------------------------------------------------------------
+// -- Private methods
+// -----------------------------------------------------------------------------
+
+void ProgressEngine::run_() {
+    while(true) {
+        adopt_incoming_();
+        const bool any_done = poll_();
+
+        std::unique_lock<std::mutex> lock(m_mutex_);
+        if(m_stop_) break;
+        // If something finished, there's likely more work queued behind it,
+        // so poll again right away
+        if(any_done) continue;
+        m_cv_.wait_for(lock, m_interval_, [this]() { return m_stop_; });
+    }
+
+    // Stopping: finish everything which was handed to us
+    adopt_incoming_();
+    MPI_Waitall(m_requests_.size(), m_requests_.data(), MPI_STATUSES_IGNORE);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_n_pending_ = 0;
+    }
+    for(auto& p : m_promises_) p.set_value();
+    m_requests_.clear();
+    m_promises_.clear();
+}
+
+void ProgressEngine::adopt_incoming_() {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    for(std::size_t i = 0; i < m_incoming_.size(); ++i) {
+        // A null request is already complete
+        if(m_incoming_[i] == MPI_REQUEST_NULL) {
+            m_incoming_promises_[i].set_value();
+            --m_n_pending_;
+            continue;
+        }
+        m_requests_.push_back(m_incoming_[i]);
+        m_promises_.push_back(std::move(m_incoming_promises_[i]));
+    }
+    m_incoming_.clear();
+    m_incoming_promises_.clear();
+}
+
+bool ProgressEngine::poll_() {
+    if(m_requests_.empty()) return false;
+
+    const int n = m_requests_.size();
+    m_indices_.resize(n);
+    int n_done = 0;
+    MPI_Testsome(n, m_requests_.data(), &n_done, m_indices_.data(),
+                 MPI_STATUSES_IGNORE);
+    if(n_done == MPI_UNDEFINED || n_done == 0) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        m_n_pending_ -= n_done;
+    }
+    for(int i = 0; i < n_done; ++i) m_promises_[m_indices_[i]].set_value();
+
+    // MPI_Testsome nulled the completed requests, compact the arrays
+    std::size_t j = 0;
+    for(std::size_t i = 0; i < m_requests_.size(); ++i) {
+        if(m_requests_[i] == MPI_REQUEST_NULL) continue;
+        if(i != j) {
+            m_requests_[j] = m_requests_[i];
+            m_promises_[j] = std::move(m_promises_[i]);
+        }
+        ++j;
+    }
+    m_requests_.resize(j);
+    m_promises_.resize(j);
+    return true;
+}
+
+} // namespace parallelzone::runtime::detail_
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <parallelzone/mpi_helpers/mpi.hpp>
+#include <thread>
+#include <vector>
+
+namespace parallelzone::runtime::detail_ {
+
+/** @brief Drives MPI progress on nonblocking requests from a background
+ *         thread.
+ *
+ *  Many MPI implementations only make progress on nonblocking operations
+ *  while the process is inside an MPI call. The ProgressEngine owns a thread
+ *  which periodically calls MPI_Testsome on the requests registered with it,
+ *  so that nonblocking operations advance while the registering thread
+ *  computes.
+ *
+ *  Requests are handed to the engine with register_request, which returns a
+ *  future that becomes ready when the request completes. Only the progress
+ *  thread touches the registered requests. Because the progress thread calls
+ *  into MPI concurrently with the rest of the program, MPI must have been
+ *  initialized with MPI_THREAD_MULTIPLE.
+ */
+class ProgressEngine {
+public:
+    /// Type of an MPI request handle
+    using request_type = MPI_Request;
+
+    /// Type of the future returned when registering a request
+    using future_type = std::future<void>;
+
+    /// Type used to specify how long to sleep between polls
+    using interval_type = std::chrono::microseconds;
+
+    /// Unsigned type used for counting
+    using size_type = std::size_t;
+
+    /** @brief Starts the progress thread.
+     *
+     *  @param[in] interval How long the progress thread sleeps between polls
+     *                      of the registered requests.
+     *
+     *  @throw std::runtime_error if MPI was not initialized with
+     *                            MPI_THREAD_MULTIPLE. Strong throw guarantee.
+     *  @throw std::system_error if the thread can not be started. Strong
+     *                           throw guarantee.
+     */
+    explicit ProgressEngine(interval_type interval);
+
+    /// Not copyable, the engine owns a thread
+    ProgressEngine(const ProgressEngine&) = delete;
+
+    /// Not copyable, the engine owns a thread
+    ProgressEngine& operator=(const ProgressEngine&) = delete;
+
+    /// Calls stop()
+    ~ProgressEngine() noexcept;
+
+    /** @brief Hands @p request to the progress thread.
+     *
+     *  After this call the progress thread owns @p request. The caller must
+     *  not test, wait on, or free @p request; instead it should wait on the
+     *  returned future.
+     *
+     *  @param[in] request An active MPI request.
+     *
+     *  @return A future which becomes ready once @p request completes.
+     *
+     *  @throw std::runtime_error if the engine has been stopped. Strong throw
+     *                            guarantee.
+     */
+    future_type register_request(request_type request);
+
+    /** @brief Stops the progress thread.
+     *
+     *  Requests which are still outstanding are waited on before the thread
+     *  exits, so every future handed out by *this becomes ready. Calling stop
+     *  more than once is a no-op.
+     *
+     *  @throw None No throw guarantee.
+     */
+    void stop() noexcept;
+
+    /// True if the progress thread is running
+    bool running() const noexcept;
+
+    /// How long the progress thread sleeps between polls
+    interval_type interval() const noexcept { return m_interval_; }
+
+    /// The number of requests which have been registered, but not completed
+    size_type n_pending() const;
+
+private:
+    /// The body of the progress thread
+    void run_();
+
+    /// Moves newly registered requests into the thread's arrays
+    void adopt_incoming_();
+
+    /// Polls the adopted requests once, returns true if any completed
+    bool poll_();
+
+    /// Time between polls
+    interval_type m_interval_;
+
+    /// Guards m_incoming_, m_incoming_promises_, m_stop_, and m_n_pending_
+    mutable std::mutex m_mutex_;
+
+    /// Used to wake the progress thread early when stopping
+    std::condition_variable m_cv_;
+
+    /// True once stop() has been called
+    bool m_stop_ = false;
+
+    /// Registered requests not yet seen by the progress thread
+    std::vector<request_type> m_incoming_;
+
+    /// Promises for the requests in m_incoming_
+    std::vector<std::promise<void>> m_incoming_promises_;
+
+    /// Requests owned by the progress thread (only touched by that thread)
+    std::vector<request_type> m_requests_;
+
+    /// Promises for the requests in m_requests_
+    std::vector<std::promise<void>> m_promises_;
+
+    /// Scratch space for MPI_Testsome
+    std::vector<int> m_indices_;
+
+    /// Number of registered, but not yet completed, requests
+    size_type m_n_pending_ = 0;
+
+    /// The progress thread
+    std::thread m_thread_;
+};
+
+} // namespace parallelzone::runtime::detail_
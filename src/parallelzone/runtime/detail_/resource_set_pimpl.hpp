@@ -15,6 +15,8 @@
  */
 
 #pragma once
+#include "../../hardware/cpu/detail_/cpu_pimpl.hpp"
+#include "../../hardware/ram/detail_/memory_info.hpp"
 #include "../../hardware/ram/detail_/ram_pimpl.hpp"
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
 #include <parallelzone/runtime/resource_set.hpp>
@@ -37,6 +39,9 @@ struct ResourceSetPIMPL {
     /// Type used to model RAM, ultimately typedef of ResourceSet::ram_type
     using ram_type = resource_set_type::ram_type;
 
+    /// Type used to model the processors, ultimately ResourceSet::cpu_type
+    using cpu_type = resource_set_type::cpu_type;
+
     /// Type used for indexing, ultimately typedef of ResourceSet::size_type
     using size_type = resource_set_type::size_type;
 
@@ -62,9 +67,29 @@ struct ResourceSetPIMPL {
      *  @param[in] logger The process-local logger for MPI rank @p rank, as
      *                    seen by the current process (N.B. the current process
      *                    may not be rank @p rank).
+     *
+     *  N.B. This ctor knows nothing about the node topology, so the RAM is
+     *  assumed to be on node 0.
      */
     ResourceSetPIMPL(size_type rank, mpi_comm_type my_mpi, logger_type logger);
 
+    /** @brief Initializes *this with already discovered metadata.
+     *
+     *  The RuntimeView learns the RAM of every rank once, when it is created.
+     *  This ctor lets it build a ResourceSet from that metadata, rather than
+     *  rediscovering the hardware each time a ResourceSet is instantiated.
+     *
+     *  @param[in] rank The current process's rank on @p my_mpi
+     *  @param[in] ram_size The size, in bytes, of the RAM rank @p rank has
+     *                      access to.
+     *  @param[in] node The node rank @p rank runs on.
+     *  @param[in] my_mpi The MPI communicator to use for communication.
+     *  @param[in] logger The process-local logger for MPI rank @p rank, as
+     *                    seen by the current process.
+     */
+    ResourceSetPIMPL(size_type rank, size_type ram_size, size_type node,
+                     mpi_comm_type my_mpi, logger_type logger);
+
     /** @brief Makes a deep copy of *this.
      *
      * This method behaves identical to the copy ctor except that resulting
@@ -108,6 +133,9 @@ struct ResourceSetPIMPL {
     /// The RAM accessible to this process
     ram_type m_ram;
 
+    /// The processors of this process (empty if rank is not the current rank)
+    cpu_type m_cpu;
+
     /// The Runtime this resource set belongs to.
     mpi_comm_type m_my_mpi;
 
@@ -120,12 +148,26 @@ struct ResourceSetPIMPL {
  *  This function wraps the process of figuring out how much RAM the current
  *  process has local access to.
  *
- *  @return The amount of RAM, hard-coded to 10
- *  @todo Implement me
+ *  @return The physical memory of the node, capped by the process's cgroup
+ *          memory limit (if any), in bytes.
  */
 inline auto get_ram_size() {
-    // TODO: Implement this for real
-    return ResourceSetPIMPL::size_type(10);
+    return ResourceSetPIMPL::size_type(hardware::detail_::total_memory());
+}
+
+/** @brief Is @p rank the current process's rank on @p my_mpi?
+ *
+ *  Hardware which has to be discovered (e.g., the CPU) can only be discovered
+ *  for the current process. This function is used to decide whether a
+ *  ResourceSet is for the current process.
+ *
+ *  @return True if @p rank is a real rank and is the current process's rank.
+ */
+inline bool is_local_rank(ResourceSetPIMPL::size_type rank,
+                          const ResourceSetPIMPL::mpi_comm_type& my_mpi) {
+    using size_type = ResourceSetPIMPL::size_type;
+    if(rank == size_type(MPI_PROC_NULL)) return false;
+    return size_type(my_mpi.me()) == rank;
 }
 
 /** @brief Convenience function for creating a ResourceSet with the PIMPL's ctor
@@ -161,17 +203,24 @@ inline auto make_resource_set(ResourceSetPIMPL::size_type rank,
 
 inline ResourceSetPIMPL::ResourceSetPIMPL(size_type rank, mpi_comm_type my_mpi,
                                           logger_type logger) :
+  ResourceSetPIMPL(rank, get_ram_size(), 0, my_mpi, std::move(logger)) {}
+
+inline ResourceSetPIMPL::ResourceSetPIMPL(size_type rank, size_type ram_size,
+                                          size_type node, mpi_comm_type my_mpi,
+                                          logger_type logger) :
   m_rank(rank),
-  m_ram(hardware::detail_::make_ram(get_ram_size(), rank, my_mpi)),
+  m_ram(hardware::detail_::make_ram(ram_size, rank, my_mpi, node)),
+  m_cpu(is_local_rank(rank, my_mpi) ? hardware::detail_::make_cpu()
+                                    : cpu_type{}),
   m_my_mpi(my_mpi),
   m_plogger(std::make_unique<logger_type>(std::move(logger))) {}
 
 inline bool ResourceSetPIMPL::operator==(
   const ResourceSetPIMPL& rhs) const noexcept {
     // TODO: Compare loggers
-    auto my_state = std::tie(m_rank, m_ram, m_my_mpi, *m_plogger);
+    auto my_state = std::tie(m_rank, m_ram, m_cpu, m_my_mpi, *m_plogger);
     auto rhs_state =
-      std::tie(rhs.m_rank, rhs.m_ram, rhs.m_my_mpi, *rhs.m_plogger);
+      std::tie(rhs.m_rank, rhs.m_ram, rhs.m_cpu, rhs.m_my_mpi, *rhs.m_plogger);
 
     return my_state == rhs_state;
 }
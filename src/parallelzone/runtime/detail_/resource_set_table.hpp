@@ -0,0 +1,353 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "../../hardware/ram/detail_/memory_info.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace parallelzone::runtime::detail_ {
+
+/** @brief The hardware metadata of one rank, as stored in a ResourceSetTable.
+ *
+ *  Records are exchanged with a single, non-serialized gather, so this class
+ *  must remain trivially copyable.
+ */
+struct ResourceSetRecord {
+    /// Unsigned type used for sizes
+    using size_type = std::size_t;
+
+    /// Type of the hash identifying a node
+    using hash_type = std::uint64_t;
+
+    /// The RAM (in bytes) the rank has access to
+    size_type m_ram_size = 0;
+
+    /// Hash of the processor name of the node the rank runs on
+    hash_type m_node_hash = 0;
+
+    /// Index of the rank's node (assigned by the table, not gathered)
+    size_type m_node = 0;
+
+    /// The rank's index among the ranks on its node (assigned by the table)
+    size_type m_local_rank = 0;
+};
+
+/** @brief Hashes @p n_bytes bytes starting at @p data.
+ *
+ *  This is the 64-bit FNV-1a hash. It is used, instead of std::hash, because
+ *  every rank must compute the same value for the same input and std::hash
+ *  is only guaranteed to be consistent within one execution of one program.
+ *
+ *  @param[in] data The bytes to hash.
+ *  @param[in] n_bytes How many bytes to hash.
+ *  @param[in] seed The hash to continue from, allows hashing in pieces.
+ *
+ *  @return The hash of the bytes.
+ *
+ *  @throw None No throw guarantee.
+ */
+inline ResourceSetRecord::hash_type fnv1a_hash(
+  const void* data, std::size_t n_bytes,
+  ResourceSetRecord::hash_type seed = 14695981039346656037ull) noexcept {
+    auto h     = seed;
+    auto bytes = static_cast<const unsigned char*>(data);
+    for(std::size_t i = 0; i < n_bytes; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/** @brief Hashes the name of a node.
+ *
+ *  @param[in] name The name to hash.
+ *
+ *  @return The FNV-1a hash of @p name.
+ *
+ *  @throw None No throw guarantee.
+ */
+inline ResourceSetRecord::hash_type hash_node_name(
+  const std::string& name) noexcept {
+    return fnv1a_hash(name.data(), name.size());
+}
+
+/** @brief The name of the node the current process runs on.
+ *
+ *  Communicators which are not backed by MPI (see CommPP::make_threaded) may
+ *  be used without MPI running, in which case the host name is used instead.
+ *
+ *  @return The name MPI reports via MPI_Get_processor_name if MPI is running,
+ *          otherwise the result of gethostname.
+ *
+ *  @throw std::bad_alloc if there is a problem allocating the string. Strong
+ *                        throw guarantee.
+ */
+inline std::string processor_name() {
+    int initialized = 0;
+    int finalized   = 0;
+    MPI_Initialized(&initialized);
+    MPI_Finalized(&finalized);
+
+    char buffer[MPI_MAX_PROCESSOR_NAME] = {};
+    if(initialized && !finalized) {
+        int length = 0;
+        MPI_Get_processor_name(buffer, &length);
+        return std::string(buffer, length);
+    }
+    gethostname(buffer, MPI_MAX_PROCESSOR_NAME - 1);
+    return std::string(buffer);
+}
+
+/** @brief Flat table of the hardware metadata of every rank in a communicator.
+ *
+ *  Prior to the table, a RuntimeView discovered the resources of rank `i` the
+ *  first time rank `i`'s ResourceSet was requested, and questions such as
+ *  "how many ranks share this RAM" required instantiating all `P` ResourceSets.
+ *  The table instead stores one ResourceSetRecord per rank contiguously. It is
+ *  filled by a single all-gather when it is built and is read-only afterwards,
+ *  so it can be shared among everything built from the same communicator.
+ *
+ *  Nodes are identified by hashing the processor name of each rank. Nodes are
+ *  numbered in the order they are first encountered when walking the ranks,
+ *  so node 0 is always the node of rank 0, and the ranks of each node are
+ *  stored in increasing order. The position of a rank in its node's list is
+ *  the rank's local rank.
+ *
+ *  Alongside the records the table keeps an index from RAM identity (the
+ *  node and the size of the RAM) to the number of ranks with that RAM, making
+ *  RuntimeView::count(ram) a lookup.
+ */
+class ResourceSetTable {
+public:
+    /// Type of an entry in the table
+    using record_type = ResourceSetRecord;
+
+    /// Type of a read-only reference to an entry
+    using const_record_reference = const record_type&;
+
+    /// Type of the container holding the records
+    using record_container = std::vector<record_type>;
+
+    /// Unsigned type used for sizes and indexing
+    using size_type = record_type::size_type;
+
+    /// Type used to communicate
+    using comm_type = mpi_helpers::CommPP;
+
+    /// Type of a container of ranks
+    using rank_container = std::vector<size_type>;
+
+    /// Type of a read-only reference to a container of ranks
+    using const_rank_container_reference = const rank_container&;
+
+    static_assert(std::is_trivially_copyable_v<record_type>,
+                  "ResourceSetRecord must be trivially copyable");
+
+    /// Makes an empty table
+    ResourceSetTable() = default;
+
+    /** @brief Builds the table for the ranks of @p comm.
+     *
+     *  This ctor is collective. Each rank discovers its own hardware and
+     *  hashes its processor name, then the results are exchanged with one
+     *  all-gather. If @p comm is null the
+     *  table is empty and no communication occurs.
+     *
+     *  @param[in] comm The communicator whose ranks are tabulated.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the table.
+     *                        Strong throw guarantee.
+     */
+    explicit ResourceSetTable(const comm_type& comm);
+
+    /** @brief Builds a table from already known records.
+     *
+     *  Only the gathered fields of @p records (the RAM size and the node
+     *  hash) are used, the remaining fields are (re)computed.
+     *
+     *  @param[in] records The records, element `i` is for rank `i`.
+     *
+     *  @throw std::bad_alloc if there is a problem building the index. Strong
+     *                        throw guarantee.
+     */
+    explicit ResourceSetTable(record_container records);
+
+    /// The number of ranks in the table
+    size_type size() const noexcept { return m_records_.size(); }
+
+    /** @brief The record for rank @p rank
+     *
+     *  @param[in] rank The rank of interest. Must be in [0, size()).
+     *
+     *  @return A read-only reference to the record.
+     *
+     *  @throw None No throw guarantee.
+     */
+    const_record_reference operator[](size_type rank) const noexcept {
+        return m_records_[rank];
+    }
+
+    /// The number of distinct nodes the ranks run on
+    size_type n_nodes() const noexcept { return m_node_ranks_.size(); }
+
+    /** @brief The ranks running on node @p node
+     *
+     *  @param[in] node The node of interest. Must be in [0, n_nodes()).
+     *
+     *  @return The ranks on @p node, in increasing order.
+     *
+     *  @throw None No throw guarantee.
+     */
+    const_rank_container_reference ranks_on_node(
+      size_type node) const noexcept {
+        return m_node_ranks_[node];
+    }
+
+    /** @brief The number of ranks on node @p node whose RAM has @p ram_size
+     *         bytes.
+     *
+     *  Two RAM instances are the same if they are on the same node and have
+     *  the same size, which is what this lookup keys on.
+     *
+     *  @param[in] ram_size The size of the RAM of interest.
+     *  @param[in] node The node the RAM is on.
+     *
+     *  @return The number of ranks in the table with that RAM.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type count_ram(size_type ram_size, size_type node) const noexcept;
+
+    /** @brief Hashes the job topology, i.e., which node each rank is on.
+     *
+     *  Two tables have the same topology hash if they have the same number of
+     *  ranks and rank `i` of each runs on the same node (by name), for all
+     *  `i`. The hash is the same on every rank.
+     *
+     *  @return The hash of the topology.
+     *
+     *  @throw None No throw guarantee.
+     */
+    record_type::hash_type topology_hash() const noexcept;
+
+    /// Two tables are equal if they hold the same records
+    bool operator==(const ResourceSetTable& rhs) const noexcept;
+
+private:
+    /// Type of a RAM size and the number of ranks with it, (size, count)
+    using ram_count_type = std::pair<size_type, size_type>;
+
+    /// Assigns nodes and local ranks, then fills m_node_ranks_ and
+    /// m_ram_counts_ from m_records_
+    void build_index_();
+
+    /// The records, element `i` is for rank `i`
+    record_container m_records_;
+
+    /// Element `n` is the ranks on node `n`
+    std::vector<rank_container> m_node_ranks_;
+
+    /// Element `n` is the (size, count) of each RAM size on node `n`
+    std::vector<std::vector<ram_count_type>> m_ram_counts_;
+};
+
+// -----------------------------------------------------------------------------
+// -- Inline Implementations
+// -----------------------------------------------------------------------------
+
+inline ResourceSetTable::ResourceSetTable(const comm_type& comm) {
+    if(comm.size() == 0) return;
+    record_type mine;
+    mine.m_ram_size  = size_type(hardware::detail_::total_memory());
+    mine.m_node_hash = hash_node_name(processor_name());
+    m_records_ = comm.gather(record_container{mine});
+    build_index_();
+}
+
+inline ResourceSetTable::ResourceSetTable(record_container records) :
+  m_records_(std::move(records)) {
+    build_index_();
+}
+
+inline ResourceSetTable::size_type ResourceSetTable::count_ram(
+  size_type ram_size, size_type node) const noexcept {
+    if(node >= m_ram_counts_.size()) return 0;
+    // Ranks on a node normally see one size, so this is usually one compare
+    for(const auto& [size, count] : m_ram_counts_[node])
+        if(size == ram_size) return count;
+    return 0;
+}
+
+inline ResourceSetRecord::hash_type ResourceSetTable::topology_hash()
+  const noexcept {
+    const size_type n = size();
+    auto h            = fnv1a_hash(&n, sizeof(n));
+    for(const auto& record : m_records_)
+        h = fnv1a_hash(&record.m_node_hash, sizeof(record.m_node_hash), h);
+    return h;
+}
+
+inline bool ResourceSetTable::operator==(
+  const ResourceSetTable& rhs) const noexcept {
+    if(size() != rhs.size()) return false;
+    for(size_type i = 0; i < size(); ++i) {
+        const auto& lhs_i = m_records_[i];
+        const auto& rhs_i = rhs.m_records_[i];
+        if(lhs_i.m_ram_size != rhs_i.m_ram_size) return false;
+        if(lhs_i.m_node_hash != rhs_i.m_node_hash) return false;
+    }
+    return true;
+}
+
+inline void ResourceSetTable::build_index_() {
+    m_node_ranks_.clear();
+    m_ram_counts_.clear();
+
+    // Node hash to node index, nodes are numbered in order of appearance
+    std::map<record_type::hash_type, size_type> hash2node;
+    for(size_type rank = 0; rank < size(); ++rank) {
+        auto& record = m_records_[rank];
+        auto [itr, is_new] =
+          hash2node.emplace(record.m_node_hash, m_node_ranks_.size());
+        if(is_new) {
+            m_node_ranks_.emplace_back();
+            m_ram_counts_.emplace_back();
+        }
+
+        record.m_node       = itr->second;
+        record.m_local_rank = m_node_ranks_[record.m_node].size();
+        m_node_ranks_[record.m_node].push_back(rank);
+
+        auto& counts = m_ram_counts_[record.m_node];
+        auto count   = std::find_if(
+          counts.begin(), counts.end(),
+          [&](const auto& x) { return x.first == record.m_ram_size; });
+        if(count == counts.end())
+            counts.emplace_back(record.m_ram_size, 1);
+        else
+            ++count->second;
+    }
+}
+
+} // namespace parallelzone::runtime::detail_
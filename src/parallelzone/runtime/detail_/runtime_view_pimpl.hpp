@@ -15,9 +15,16 @@
  */
 
 #pragma once
+#include "progress_engine.hpp"
+#include "resource_set_table.hpp"
+#include "timer_registry.hpp"
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <parallelzone/runtime/runtime_view.hpp>
 #include <stack>
+#include <vector>
 
 namespace parallelzone::runtime::detail_ {
 
@@ -44,7 +51,19 @@ struct RuntimeViewPIMPL {
       parent_type::const_resource_set_reference;
 
     /// Type of the conatiner holding resource_set_type objects
-    using resource_set_container = std::map<size_type, resource_set_type>;
+    using resource_set_container = std::vector<resource_set_type>;
+
+    /// Type of the table holding the hardware metadata of every rank
+    using table_type = ResourceSetTable;
+
+    /// Type of a pointer to the (shared and read-only) metadata table
+    using table_pointer = std::shared_ptr<const table_type>;
+
+    /// Ultimately a typedef of RuntimeView::const_ram_reference
+    using const_ram_reference = parent_type::const_ram_reference;
+
+    /// Ultimately a typedef of RuntimeView::comm_cost_model_type
+    using comm_cost_model_type = parent_type::comm_cost_model_type;
 
     /// The type of our MPI Comm wrapper
     using comm_type = mpi_helpers::CommPP;
@@ -67,9 +86,28 @@ struct RuntimeViewPIMPL {
     /// Type of a callback function
     using callback_function_type = parent_type::callback_function_type;
 
+    /// Type of the object driving MPI progress in the background
+    using progress_engine_type = ProgressEngine;
+
+    /// Type of a pointer to the progress engine
+    using progress_engine_pointer = std::unique_ptr<progress_engine_type>;
+
+    /// Ultimately a typedef of RuntimeView::progress_interval_type
+    using progress_interval_type = parent_type::progress_interval_type;
+
+    /// Type of the object keeping the totals of the timed regions
+    using timer_registry_type = TimerRegistry;
+
+    /// Type of a pointer to the timer registry
+    using timer_registry_pointer = std::shared_ptr<timer_registry_type>;
+
+    /// Ultimately a typedef of RuntimeView::timer_report_type
+    using timer_report_type = parent_type::timer_report_type;
+
     /** @brief Initializes *this from the provided MPI communicator.
      *
-     *  Constructor for the RuntimeViewPIMPL class.
+     *  Constructor for the RuntimeViewPIMPL class. The ctor builds the table
+     *  of per-rank hardware metadata and is thus collective over @p comm.
      *
      *  @param[in] did_i_start_mpi True if *this should be responsible for
      *                             the lifetime of MPI  and false
@@ -101,6 +139,20 @@ struct RuntimeViewPIMPL {
      */
     const_resource_set_reference at(size_type rank) const;
 
+    /** @brief The number of ranks which can access @p ram.
+     *
+     *  This is a lookup in the metadata table and does not instantiate any
+     *  ResourceSet.
+     *
+     *  @param[in] ram The RAM of interest.
+     *
+     *  @return The number of ranks whose ResourceSet's RAM compares equal to
+     *          @p ram.
+     *
+     *  @throw None No throw guarantee.
+     */
+    size_type count(const_ram_reference ram) const noexcept;
+
     /** @brief Determines if *this is value equal to @p rhs.
      *
      *  Two RuntimeViewPIMPL instances are value equal if they both wrap the
@@ -131,6 +183,71 @@ struct RuntimeViewPIMPL {
      */
     void stack_callback(callback_function_type cb_func);
 
+    /** @brief Starts the background progress thread.
+     *
+     *  Stopping the thread is registered as a finalize callback. Since
+     *  callbacks are called LIFO, the thread is stopped before MPI is
+     *  finalized (if *this started MPI).
+     *
+     *  @param[in] interval How long the thread sleeps between polls.
+     *
+     *  @throw std::runtime_error if the thread was already started or if MPI
+     *                            does not support MPI_THREAD_MULTIPLE. Strong
+     *                            throw guarantee.
+     */
+    void start_progress_engine(progress_interval_type interval);
+
+    /** @brief Makes sure there are at least @p n duplicates of m_comm.
+     *
+     *  Missing duplicates are created, in index order, by MPI_Comm_dup, so
+     *  this method is collective over m_comm. The first time a duplicate is
+     *  created, freeing the duplicates is registered as a finalize callback.
+     *  This method is thread-safe.
+     *
+     *  @param[in] n The number of duplicates needed.
+     *
+     *  @throw std::bad_alloc if there is a problem storing the duplicates.
+     *                        Strong throw guarantee.
+     */
+    void reserve_thread_comms(size_type n);
+
+    /** @brief Returns the @p i-th duplicate of m_comm.
+     *
+     *  This method never creates a duplicate, so it is not collective. This
+     *  method is thread-safe.
+     *
+     *  @param[in] i The index of the duplicate.
+     *
+     *  @return The MPI communicator for index @p i.
+     *
+     *  @throw std::out_of_range if fewer than @p i + 1 duplicates were
+     *                           reserved. Strong throw guarantee.
+     */
+    MPI_Comm thread_comm(size_type i);
+
+    /** @brief Summarizes the timed regions over m_comm and logs the result.
+     *
+     *  The summary is made by TimerRegistry::summarize and, unless no region
+     *  was timed, is logged to m_plogger as an info message. This method is
+     *  collective over m_comm.
+     *
+     *  @return The summary.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the summary.
+     */
+    timer_report_type report_timers();
+
+    /** @brief Registers a finalize callback which calls report_timers.
+     *
+     *  The callback is registered at most once, no matter how many times this
+     *  method is called. Since callbacks are called LIFO, the report is made
+     *  (and logged) before the logger is flushed and before MPI is finalized.
+     *
+     *  @throw std::bad_alloc if there is a problem adding the callback.
+     *                        Strong throw guarantee.
+     */
+    void report_timers_at_finalize();
+
     /// Did this PIMPL start MPI?
     bool m_did_i_start_mpi;
 
@@ -140,6 +257,18 @@ struct RuntimeViewPIMPL {
     /// Pointer to the logger (pointer to allow logging with const ResourceSets)
     logger_pointer m_plogger;
 
+    /// The background progress thread (null if it was never started)
+    progress_engine_pointer m_progress_engine;
+
+    /// The hardware metadata of every rank in m_comm
+    table_pointer m_table;
+
+    /// The measured interconnect (unset until characterize is called)
+    std::optional<comm_cost_model_type> m_cost_model;
+
+    /// The totals of the regions timed on this rank
+    timer_registry_pointer m_timers;
+
 private:
     /** @brief Wraps the process of instantiating a ResourceSet.
      *
@@ -160,12 +289,11 @@ private:
 
     /** @brief The ResourceSets known to this RuntimeView
      *
-     *  In practice most MPI ranks are only going to care about their
-     *  ResourceSet. So instead of making an `n`-element vector where
-     *  element `i` is the resource set for rank `i` (`n` is the number of
-     *  ranks), we instead store them in a map. Conceptually, we think of the
-     *  map as storing all `n` resource sets, but some of them are stored
-     *  implicitly. By default we only populate the resource set for the
+     *  Element `i` is the ResourceSet for rank `i`. In practice most MPI
+     *  ranks are only going to care about their ResourceSet, so the elements
+     *  start out as (cheap) default-constructed handles and the ResourceSet
+     *  for rank `i` is only built, from m_table, the first time it is
+     *  requested. By default we only populate the resource set for the
      *  current rank.
      *
      *  This member is mutable so that if we need to explicitly instantiate a
@@ -173,6 +301,15 @@ private:
      */
     mutable resource_set_container m_resource_sets_;
 
+    /// Duplicates of m_comm made by reserve_thread_comms
+    std::vector<MPI_Comm> m_thread_comms_;
+
+    /// Serializes access to m_thread_comms_
+    std::mutex m_thread_comms_mutex_;
+
+    /// Has report_timers_at_finalize registered its callback?
+    bool m_report_timers_at_finalize_ = false;
+
     /// Stacks of initialize and finalize callback functions
     std::stack<callback_function_type> m_callbacks_final_;
 };
@@ -16,6 +16,9 @@
 
 #pragma once
 #include "resource_set_pimpl.hpp"
+#include <exception>
+#include <parallelzone/logging/logger_factory.hpp>
+#include <stdexcept>
 
 /** @file runtime_view_pimpl.ipp
  *
@@ -29,6 +32,63 @@ inline void RuntimeViewPIMPL::stack_callback(callback_function_type cb_func) {
     m_callbacks_final_.push(std::move(cb_func));
 }
 
+inline void RuntimeViewPIMPL::start_progress_engine(
+  progress_interval_type interval) {
+    if(m_progress_engine)
+        throw std::runtime_error("The MPI progress thread was already started");
+    auto p = std::make_unique<progress_engine_type>(interval);
+    stack_callback([this]() { m_progress_engine->stop(); });
+    m_progress_engine = std::move(p);
+}
+
+inline void RuntimeViewPIMPL::reserve_thread_comms(size_type n) {
+    std::lock_guard<std::mutex> lock(m_thread_comms_mutex_);
+    if(n <= m_thread_comms_.size()) return;
+
+    // Reserve first, so the push_backs below can not throw
+    m_thread_comms_.reserve(n);
+    if(m_thread_comms_.empty()) {
+        stack_callback([this]() {
+            for(auto& comm : m_thread_comms_) MPI_Comm_free(&comm);
+            m_thread_comms_.clear();
+        });
+    }
+    while(m_thread_comms_.size() < n) {
+        MPI_Comm dup;
+        MPI_Comm_dup(m_comm.comm(), &dup);
+        m_thread_comms_.push_back(dup);
+    }
+}
+
+inline MPI_Comm RuntimeViewPIMPL::thread_comm(size_type i) {
+    std::lock_guard<std::mutex> lock(m_thread_comms_mutex_);
+    if(i < m_thread_comms_.size()) return m_thread_comms_[i];
+    throw std::out_of_range("Thread communicator " + std::to_string(i) +
+                            " does not exist, only " +
+                            std::to_string(m_thread_comms_.size()) +
+                            " were reserved");
+}
+
+inline RuntimeViewPIMPL::timer_report_type RuntimeViewPIMPL::report_timers() {
+    auto report = timer_registry_type::summarize(m_comm, m_timers->records());
+    if(!report.empty())
+        m_plogger->info("Timer report over " + std::to_string(m_comm.size()) +
+                        " rank(s), times in seconds\n" + to_string(report));
+    return report;
+}
+
+inline void RuntimeViewPIMPL::report_timers_at_finalize() {
+    if(m_report_timers_at_finalize_) return;
+    stack_callback([this]() {
+        try {
+            report_timers();
+        } catch(...) {
+            // We're in the dtor, nothing can be done about it here
+        }
+    });
+    m_report_timers_at_finalize_ = true;
+}
+
 inline void mpi_finalize_wrapper() { MPI_Finalize(); }
 
 inline RuntimeViewPIMPL::RuntimeViewPIMPL(bool did_i_start_mpi, comm_type comm,
@@ -36,17 +96,36 @@ inline RuntimeViewPIMPL::RuntimeViewPIMPL(bool did_i_start_mpi, comm_type comm,
   m_did_i_start_mpi(did_i_start_mpi),
   m_comm(comm),
   m_plogger(std::make_shared<logger_type>(std::move(logger))),
-  m_resource_sets_() {
+  m_table(std::make_shared<const table_type>(m_comm)),
+  m_timers(std::make_shared<timer_registry_type>()),
+  m_resource_sets_(m_table->size()) {
     // Pre-populate the current rank's resource set.
-    instantiate_resource_set_(m_comm.me());
+    if(size_type(m_comm.me()) < m_resource_sets_.size())
+        instantiate_resource_set_(m_comm.me());
 
     /// Register the finalize callbacks
     if(m_did_i_start_mpi) {
         stack_callback(callback_function_type{&mpi_finalize_wrapper});
     }
+
+    // Callbacks run LIFO, so buffered messages are written before MPI stops.
+    // N.B. The logger is looked up when the callback runs, so a logger which
+    //      replaced the original one (e.g., an asynchronous one) is flushed
+    stack_callback([this]() {
+        try {
+            m_plogger->flush();
+        } catch(...) {
+            // We're in the dtor, nothing can be done about it here
+        }
+    });
 }
 
 inline RuntimeViewPIMPL::~RuntimeViewPIMPL() noexcept {
+    // The last view is going away while an exception propagates, i.e., the
+    // program is probably going down. Write out what led up to it before the
+    // callbacks flush the logger and finalize MPI.
+    if(std::uncaught_exceptions() > 0) LoggerFactory::dump_flight_recorders();
+
     /// call the initialize callback functions
     while(!m_callbacks_final_.empty()) {
         m_callbacks_final_.top()();
@@ -57,7 +136,13 @@ inline RuntimeViewPIMPL::~RuntimeViewPIMPL() noexcept {
 inline RuntimeViewPIMPL::const_resource_set_reference RuntimeViewPIMPL::at(
   size_type rank) const {
     instantiate_resource_set_(rank);
-    return m_resource_sets_.at(rank);
+    return m_resource_sets_[rank];
+}
+
+inline RuntimeViewPIMPL::size_type RuntimeViewPIMPL::count(
+  const_ram_reference ram) const noexcept {
+    if(ram.empty()) return 0;
+    return m_table->count_ram(ram.total_space(), ram.node());
 }
 
 inline bool RuntimeViewPIMPL::operator==(
@@ -68,15 +153,17 @@ inline bool RuntimeViewPIMPL::operator==(
     return *m_plogger == *rhs.m_plogger;
 }
 
-void RuntimeViewPIMPL::instantiate_resource_set_(size_type rank) const {
+inline void RuntimeViewPIMPL::instantiate_resource_set_(size_type rank) const {
     using rs_pimpl = detail_::ResourceSetPIMPL;
-    if(m_resource_sets_.count(rank)) return;
+    if(!m_resource_sets_[rank].null()) return;
 
     // Null loggers for now
     logger_type logger;
 
-    auto p = std::make_unique<rs_pimpl>(rank, m_comm, std::move(logger));
-    m_resource_sets_.emplace(rank, ResourceSet(std::move(p)));
+    const auto& record = (*m_table)[rank];
+    auto p = std::make_unique<rs_pimpl>(rank, record.m_ram_size, record.m_node,
+                                        m_comm, std::move(logger));
+    m_resource_sets_[rank] = ResourceSet(std::move(p));
 }
 
 } // namespace parallelzone::runtime::detail_
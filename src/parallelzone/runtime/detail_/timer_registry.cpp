@@ -0,0 +1,290 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_registry.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <parallelzone/mpi_helpers/traits/mpi_op.hpp>
+#include <time.h>
+
+namespace parallelzone::runtime::detail_ {
+namespace {
+
+// The number of events HardwareCounters knows about (the enumerators are
+// numbered from 0 and context_switches is the last one)
+constexpr std::size_t n_events =
+  std::size_t(hardware::HardwareCounters::event::context_switches) + 1;
+
+// Source of the values of TimerRegistry::m_generation_, process-wide so that
+// a registry made where a destroyed one lived does not look like it
+std::atomic<std::size_t> g_generation{0};
+
+// The hardware counters of the calling thread, shared by every registry.
+// They stay open until the thread exits or the events change
+struct ThreadCounters {
+    // The registry whose events were checked last
+    const void* owner = nullptr;
+
+    // The generation of owner's events when they were checked
+    std::size_t generation = 0;
+
+    // The events counters counts
+    hardware::HardwareCounters::event_container events;
+
+    // The counters, opened on the calling thread
+    hardware::HardwareCounters counters;
+
+    // Changes whenever counters is reopened
+    std::size_t id = 0;
+};
+
+ThreadCounters& thread_counters() noexcept {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+// Orders paths so that a region is followed by the regions nested in it,
+// i.e., "/" sorts before every other character
+bool path_less(const std::string& lhs, const std::string& rhs) {
+    auto key = [](char c) {
+        return c == '/' ? -1 : int(static_cast<unsigned char>(c));
+    };
+    return std::lexicographical_compare(
+      lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+      [&](char a, char b) { return key(a) < key(b); });
+}
+
+// Splits the newline-terminated paths in buffer, dropping duplicates
+std::vector<std::string> unique_paths(const std::string& buffer) {
+    std::vector<std::string> paths;
+    std::size_t begin = 0;
+    while(begin < buffer.size()) {
+        auto end = buffer.find('\n', begin);
+        if(end == std::string::npos) end = buffer.size();
+        paths.push_back(buffer.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    std::sort(paths.begin(), paths.end(), path_less);
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    return paths;
+}
+
+} // namespace
+
+std::pair<std::string, TimerRegistry::size_type> TimerRegistry::push(
+  const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    auto& stack      = m_stacks_[std::this_thread::get_id()];
+    auto path        = stack.empty() ? name : stack.back() + "/" + name;
+    const auto depth = stack.size();
+    stack.push_back(path);
+    return {std::move(path), depth};
+}
+
+void TimerRegistry::pop(const std::string& path, size_type depth,
+                        time_type wall, time_type cpu,
+                        const counter_deltas& counters) noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    auto stack = m_stacks_.find(std::this_thread::get_id());
+    if(stack != m_stacks_.end()) {
+        // Also drops children which were not stopped (e.g., leaked timers)
+        if(stack->second.size() > depth) stack->second.resize(depth);
+        if(stack->second.empty()) m_stacks_.erase(stack);
+    }
+    try {
+        auto& record = m_records_[path];
+        ++record.n_calls;
+        record.wall += wall;
+        record.cpu += cpu;
+        for(const auto& [e, count] : counters) record.counters[e] += count;
+    } catch(...) {
+        // Out of memory, the region's time (or counts) are lost
+    }
+}
+
+TimerRegistry::size_type TimerRegistry::start_counters(
+  size_type depth, counter_values& start) noexcept {
+    auto& mine = thread_counters();
+    try {
+        // Only outermost regions pick up new events, so the counts of the
+        // regions which are running stay consistent
+        const auto generation = m_generation_.load();
+        const bool stale = mine.owner != this || mine.generation != generation;
+        if(depth == 0 && stale) {
+            event_container events;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex_);
+                events = m_events_;
+            }
+            if(events != mine.events) {
+                mine.counters = events.empty() ?
+                                  hardware::HardwareCounters{} :
+                                  hardware::HardwareCounters(events);
+                mine.events   = std::move(events);
+                ++mine.id;
+            }
+            mine.owner      = this;
+            mine.generation = generation;
+        }
+        if(mine.events.empty()) return 0;
+        start = mine.counters.read();
+        return mine.id;
+    } catch(...) {
+        // The counters could not be opened or read, so don't count
+        mine.owner    = nullptr;
+        mine.counters = hardware::HardwareCounters{};
+        mine.events.clear();
+        ++mine.id;
+        return 0;
+    }
+}
+
+TimerRegistry::counter_deltas TimerRegistry::stop_counters(
+  size_type id, const counter_values& start) const noexcept {
+    const auto& mine = thread_counters();
+    if(id == 0 || id != mine.id) return {};
+    try {
+        const auto counts = mine.counters.read();
+        counter_deltas deltas;
+        for(size_type i = 0; i < mine.events.size(); ++i) {
+            const auto e = mine.events[i];
+            if(!mine.counters.supported(e)) continue;
+            // Repeated events are only reported once
+            auto is_e = [e](const auto& d) { return d.first == e; };
+            if(std::any_of(deltas.begin(), deltas.end(), is_e)) continue;
+            const auto delta =
+              counts[i] > start[i] ? counts[i] - start[i] : 0;
+            deltas.emplace_back(e, time_type(delta));
+        }
+        return deltas;
+    } catch(...) { return {}; }
+}
+
+TimerRegistry::record_map TimerRegistry::records() const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_records_;
+}
+
+void TimerRegistry::clear() noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_records_.clear();
+}
+
+void TimerRegistry::set_counter_events(event_container events) {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    m_events_ = std::move(events);
+    m_generation_.store(++g_generation);
+}
+
+TimerRegistry::event_container TimerRegistry::counter_events() const {
+    std::lock_guard<std::mutex> lock(m_mutex_);
+    return m_events_;
+}
+
+TimerRegistry::report_type TimerRegistry::summarize(
+  const mpi_helpers::CommPP& comm, const record_map& records) {
+    // Ranks may have timed different regions, so first agree on the paths
+    std::vector<char> my_paths;
+    for(const auto& [path, record] : records) {
+        my_paths.insert(my_paths.end(), path.begin(), path.end());
+        my_paths.push_back('\n');
+    }
+    const auto all_paths = comm.gatherv(std::move(my_paths));
+    const auto paths =
+      unique_paths(std::string(all_paths.begin(), all_paths.end()));
+
+    // Every rank has the same paths, so every rank returns (or reduces) here
+    const auto n = paths.size();
+    if(n == 0) return {};
+
+    // Laid out as [wall..., cpu..., calls..., entered..., counts...,
+    // counted...] with the counts of path i at 4 * n + i * n_events, and
+    // whether this rank counted them at 4 * n + n_counts + i * n_events
+    const auto n_counts = n * n_events;
+    std::vector<time_type> sums(4 * n + 2 * n_counts, 0.0);
+    for(size_type i = 0; i < n; ++i) {
+        auto itr = records.find(paths[i]);
+        if(itr == records.end()) continue;
+        sums[i]         = itr->second.wall;
+        sums[n + i]     = itr->second.cpu;
+        sums[2 * n + i] = time_type(itr->second.n_calls);
+        sums[3 * n + i] = 1.0;
+        for(const auto& [e, count] : itr->second.counters) {
+            const auto j               = i * n_events + size_type(e);
+            sums[4 * n + j]            = count;
+            sums[4 * n + n_counts + j] = 1.0;
+        }
+    }
+
+    // Laid out as [wall..., cpu..., counts...]. Ranks which did not time a
+    // region (or count an event in it) must not change its minimum or maximum
+    const auto no_min = std::numeric_limits<time_type>::max();
+    std::vector<time_type> lows(2 * n + n_counts, no_min);
+    std::vector<time_type> highs(2 * n + n_counts, 0.0);
+    for(size_type i = 0; i < n; ++i) {
+        if(sums[3 * n + i] == 0.0) continue;
+        for(auto k : {i, n + i}) lows[k] = highs[k] = sums[k];
+        for(size_type j = i * n_events; j < (i + 1) * n_events; ++j) {
+            if(sums[4 * n + n_counts + j] == 0.0) continue;
+            lows[2 * n + j] = highs[2 * n + j] = sums[4 * n + j];
+        }
+    }
+
+    using mpi_helpers::maximum;
+    using mpi_helpers::minimum;
+    const auto total = comm.reduce(sums, std::plus<time_type>());
+    const auto low   = comm.reduce(lows, minimum<time_type>());
+    const auto high  = comm.reduce(highs, maximum<time_type>());
+
+    // Every path was timed by at least one rank, so n_ranks is never 0
+    report_type report(n);
+    for(size_type i = 0; i < n; ++i) {
+        const auto n_ranks = total[3 * n + i];
+        auto& stats        = report[i];
+        stats.path         = paths[i];
+        stats.depth        = std::count(paths[i].begin(), paths[i].end(), '/');
+        stats.n_calls      = size_type(total[2 * n + i]);
+        stats.n_ranks      = size_type(n_ranks);
+        stats.wall_min     = low[i];
+        stats.wall_mean    = total[i] / n_ranks;
+        stats.wall_max     = high[i];
+        stats.cpu_min      = low[n + i];
+        stats.cpu_mean     = total[n + i] / n_ranks;
+        stats.cpu_max      = high[n + i];
+        for(size_type e = 0; e < n_events; ++e) {
+            const auto j          = i * n_events + e;
+            const auto n_counting = total[4 * n + n_counts + j];
+            if(n_counting == 0.0) continue;
+            CounterStatistics counter;
+            counter.event   = event_type(e);
+            counter.n_ranks = size_type(n_counting);
+            counter.min     = low[2 * n + j];
+            counter.mean    = total[4 * n + j] / n_counting;
+            counter.max     = high[2 * n + j];
+            stats.counters.push_back(counter);
+        }
+    }
+    return report;
+}
+
+TimerRegistry::time_type TimerRegistry::thread_cpu_time() noexcept {
+    timespec ts;
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0.0;
+    return time_type(ts.tv_sec) + time_type(ts.tv_nsec) * 1.0e-9;
+}
+
+} // namespace parallelzone::runtime::detail_
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <parallelzone/hardware/cpu/hardware_counters.hpp>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <parallelzone/runtime/region_timer.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallelzone::runtime::detail_ {
+
+/** @brief Keeps the totals of the regions timed on one rank.
+ *
+ *  Each RuntimeViewPIMPL owns a TimerRegistry, which is shared with the
+ *  RegionTimer objects made by RuntimeView::timer. The registry tracks which
+ *  regions are running on each thread (so that regions started while another
+ *  is running are nested in it) and accumulates the times of the regions
+ *  which ended. All members are thread-safe.
+ *
+ *  If hardware counters are enabled, each thread opens its counters the first
+ *  time it enters an outermost region and keeps them open until it exits (or
+ *  the events change), so a region only costs two reads of the counters.
+ *  The counters are thread-local and are read without holding the lock.
+ */
+class TimerRegistry {
+public:
+    /// Unsigned integral type used for counting
+    using size_type = std::size_t;
+
+    /// Type used for times, in seconds
+    using time_type = RegionStatistics::time_type;
+
+    /// Type of a hardware event
+    using event_type = RegionStatistics::event_type;
+
+    /// Type of a list of hardware events
+    using event_container = hardware::HardwareCounters::event_container;
+
+    /// Type of the readings of a thread's hardware counters
+    using counter_values = hardware::HardwareCounters::value_container;
+
+    /// Type of the events counted in a region and their counts
+    using counter_deltas = std::vector<std::pair<event_type, time_type>>;
+
+    /// The totals of one region on this rank
+    struct Record {
+        /// The number of times the region ended
+        size_type n_calls = 0;
+
+        /// The total wall time, in seconds
+        time_type wall = 0.0;
+
+        /// The total CPU time, in seconds
+        time_type cpu = 0.0;
+
+        /// The total count of each event which could be counted
+        std::map<event_type, time_type> counters = {};
+    };
+
+    /// Type of the totals of every region, keyed by path
+    using record_map = std::map<std::string, Record>;
+
+    /// Type of the summarized totals
+    using report_type = std::vector<RegionStatistics>;
+
+    /** @brief Marks the start of region @p name on the calling thread.
+     *
+     *  @param[in] name The name of the region.
+     *
+     *  @return The path of the region and its nesting depth, to be handed
+     *          back to pop when the region ends.
+     *
+     *  @throw std::bad_alloc if there is a problem recording the region.
+     *                        Strong throw guarantee.
+     */
+    std::pair<std::string, size_type> push(const std::string& name);
+
+    /** @brief Marks the end of the region @p path on the calling thread.
+     *
+     *  Regions nested in @p path which are still running on the calling
+     *  thread are no longer considered its children, i.e., regions started
+     *  after this call are not nested in them.
+     *
+     *  @param[in] path The path returned by push.
+     *  @param[in] depth The depth returned by push.
+     *  @param[in] wall The wall time spent in the region, in seconds.
+     *  @param[in] cpu The CPU time spent in the region, in seconds.
+     *  @param[in] counters The hardware events counted in the region, as
+     *                      returned by stop_counters.
+     *
+     *  @throw None No throw guarantee. If the totals can not be updated the
+     *              time is dropped.
+     */
+    void pop(const std::string& path, size_type depth, time_type wall,
+             time_type cpu, const counter_deltas& counters = {}) noexcept;
+
+    /** @brief Reads the calling thread's hardware counters at the start of a
+     *         region.
+     *
+     *  For an outermost region (@p depth is 0) the thread's counters are
+     *  first made to count the events set by set_counter_events, which
+     *  (re)opens them if the events changed. Nothing is locked unless the
+     *  events changed since the thread last checked.
+     *
+     *  @param[in] depth The depth returned by push.
+     *  @param[out] start The readings, to be handed to stop_counters.
+     *
+     *  @return An id of the thread's counters, to be handed to stop_counters.
+     *          0 if nothing is counted.
+     *
+     *  @throw None No throw guarantee. If the counters can not be opened or
+     *              read the region's events are not counted.
+     */
+    size_type start_counters(size_type depth, counter_values& start) noexcept;
+
+    /** @brief Reads the calling thread's hardware counters at the end of a
+     *         region.
+     *
+     *  @param[in] id The id returned by start_counters.
+     *  @param[in] start The readings made by start_counters.
+     *
+     *  @return The counts of the events since @p start, for the events the
+     *          thread could count. Empty if the thread's counters were
+     *          reopened since @p start was read.
+     *
+     *  @throw None No throw guarantee. If the counters can not be read the
+     *              result is empty.
+     */
+    counter_deltas stop_counters(size_type id,
+                                 const counter_values& start) const noexcept;
+
+    /** @brief A snapshot of the totals of the regions which ended so far.
+     *
+     *  @return The totals, keyed by path.
+     *
+     *  @throw std::bad_alloc if there is a problem copying the totals. Strong
+     *                        throw guarantee.
+     */
+    record_map records() const;
+
+    /// Forgets the totals (regions which are running are still nested)
+    void clear() noexcept;
+
+    /** @brief Sets the hardware events counted for each region.
+     *
+     *  The events are counted for the regions a thread starts after it next
+     *  enters an outermost region. Events which can not be counted on this
+     *  machine are skipped.
+     *
+     *  @param[in] events The events to count. Empty disables the counters.
+     *
+     *  @throw std::bad_alloc if there is a problem copying @p events. Strong
+     *                        throw guarantee.
+     */
+    void set_counter_events(event_container events);
+
+    /** @brief The hardware events counted for each region.
+     *
+     *  @return The events set by set_counter_events (initially none).
+     *
+     *  @throw std::bad_alloc if there is a problem copying the events. Strong
+     *                        throw guarantee.
+     */
+    event_container counter_events() const;
+
+    /** @brief Summarizes the totals of every rank in @p comm.
+     *
+     *  The paths of every rank are gathered first, so the ranks do not need
+     *  to have timed the same regions. The times, and the event counts, are
+     *  then combined with three reductions (sum, minimum, and maximum). The
+     *  statistics of an event only include the ranks which could count it,
+     *  i.e., the ranks with at least one record counting it. This function is
+     *  collective over @p comm.
+     *
+     *  @param[in] comm The ranks to summarize over.
+     *  @param[in] records The totals of the current rank.
+     *
+     *  @return One entry per region timed on any rank. Nested regions follow
+     *          their parent and siblings are sorted by name.
+     *
+     *  @throw std::bad_alloc if there is a problem allocating the results.
+     */
+    static report_type summarize(const mpi_helpers::CommPP& comm,
+                                 const record_map& records);
+
+    /** @brief The CPU time the calling thread has used.
+     *
+     *  @return The CPU time, in seconds, or 0 if it can not be determined.
+     *
+     *  @throw None No throw guarantee.
+     */
+    static time_type thread_cpu_time() noexcept;
+
+private:
+    /// Guards the members of *this
+    mutable std::mutex m_mutex_;
+
+    /// The paths of the regions running on each thread, innermost last
+    std::map<std::thread::id, std::vector<std::string>> m_stacks_;
+
+    /// The hardware events to count
+    event_container m_events_;
+
+    /// Changes (to a process-wide unique value) whenever m_events_ changes
+    std::atomic<size_type> m_generation_{0};
+
+    /// The totals of the regions which ended
+    record_map m_records_;
+};
+
+} // namespace parallelzone::runtime::detail_
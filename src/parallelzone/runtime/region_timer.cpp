@@ -0,0 +1,153 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detail_/timer_registry.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <parallelzone/runtime/region_timer.hpp>
+#include <sstream>
+
+namespace parallelzone::runtime {
+
+// -----------------------------------------------------------------------------
+// -- RegionStatistics
+// -----------------------------------------------------------------------------
+
+std::string RegionStatistics::name() const {
+    const auto slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::string to_string(const std::vector<RegionStatistics>& report) {
+    using event_type = RegionStatistics::event_type;
+
+    // Names are indented two spaces per level of nesting
+    std::size_t width = 6;
+    for(const auto& stats : report)
+        width = std::max(width, 2 * stats.depth + stats.name().size());
+
+    // One column per event counted in any region, in the order declared
+    std::vector<event_type> events;
+    bool have_flops = false;
+    for(const auto& stats : report) {
+        for(const auto& counter : stats.counters) {
+            if(std::find(events.begin(), events.end(), counter.event) ==
+               events.end())
+                events.push_back(counter.event);
+            have_flops = have_flops || counter.event == event_type::flops;
+        }
+    }
+    std::sort(events.begin(), events.end());
+    std::vector<std::string> names;
+    std::vector<std::size_t> widths;
+    for(auto e : events) {
+        names.push_back(hardware::HardwareCounters::name(e));
+        widths.push_back(std::max<std::size_t>(14, names.back().size() + 2));
+    }
+
+    std::ostringstream ss;
+    ss << std::left << std::setw(width) << "Region" << std::right
+       << std::setw(10) << "Calls" << std::setw(7) << "Ranks" << std::setw(12)
+       << "Wall min" << std::setw(12) << "Wall mean" << std::setw(12)
+       << "Wall max" << std::setw(8) << "Imbal." << std::setw(12)
+       << "CPU mean";
+    for(std::size_t i = 0; i < events.size(); ++i)
+        ss << std::setw(widths[i]) << names[i];
+    if(have_flops) ss << std::setw(10) << "GFLOP/s";
+    ss << std::fixed;
+    for(const auto& stats : report) {
+        const std::string name(2 * stats.depth, ' ');
+        ss << '\n'
+           << std::left << std::setw(width) << name + stats.name()
+           << std::right << std::setw(10) << stats.n_calls << std::setw(7)
+           << stats.n_ranks << std::setprecision(6) << std::setw(12)
+           << stats.wall_min << std::setw(12) << stats.wall_mean
+           << std::setw(12) << stats.wall_max << std::setprecision(2)
+           << std::setw(8) << stats.imbalance() << std::setprecision(6)
+           << std::setw(12) << stats.cpu_mean << std::setprecision(0);
+        for(std::size_t i = 0; i < events.size(); ++i) {
+            const auto* counter = stats.counter(events[i]);
+            ss << std::setw(widths[i]);
+            if(counter) ss << counter->mean;
+            else ss << "-";
+        }
+        if(have_flops)
+            ss << std::setprecision(3) << std::setw(10) << stats.gflops();
+    }
+    return ss.str();
+}
+
+// -----------------------------------------------------------------------------
+// -- RegionTimer
+// -----------------------------------------------------------------------------
+
+RegionTimer::RegionTimer() noexcept = default;
+
+RegionTimer::RegionTimer(registry_pointer registry, const std::string& name) {
+    auto [path, depth] = registry->push(name);
+    m_path_            = std::move(path);
+    m_depth_           = depth;
+    m_registry_        = std::move(registry);
+
+    m_counters_id_ = m_registry_->start_counters(m_depth_, m_counters_start_);
+
+    // Read the clocks last, so the bookkeeping above isn't timed
+    m_cpu_start_  = registry_type::thread_cpu_time();
+    m_wall_start_ = clock_type::now();
+}
+
+RegionTimer::RegionTimer(RegionTimer&& other) noexcept :
+  m_registry_(std::move(other.m_registry_)),
+  m_path_(std::move(other.m_path_)),
+  m_depth_(other.m_depth_),
+  m_wall_start_(other.m_wall_start_),
+  m_cpu_start_(other.m_cpu_start_),
+  m_counters_id_(other.m_counters_id_),
+  m_counters_start_(std::move(other.m_counters_start_)) {
+    other.m_registry_.reset();
+    other.m_path_.clear();
+}
+
+RegionTimer& RegionTimer::operator=(RegionTimer&& rhs) noexcept {
+    if(this == &rhs) return *this;
+    stop();
+    m_registry_       = std::move(rhs.m_registry_);
+    m_path_           = std::move(rhs.m_path_);
+    m_depth_          = rhs.m_depth_;
+    m_wall_start_     = rhs.m_wall_start_;
+    m_cpu_start_      = rhs.m_cpu_start_;
+    m_counters_id_    = rhs.m_counters_id_;
+    m_counters_start_ = std::move(rhs.m_counters_start_);
+    rhs.m_registry_.reset();
+    rhs.m_path_.clear();
+    return *this;
+}
+
+RegionTimer::~RegionTimer() noexcept { stop(); }
+
+void RegionTimer::stop() noexcept {
+    if(!running()) return;
+    using seconds   = std::chrono::duration<double>;
+    const auto wall = seconds(clock_type::now() - m_wall_start_).count();
+    const auto cpu  = registry_type::thread_cpu_time() - m_cpu_start_;
+    const auto counters =
+      m_registry_->stop_counters(m_counters_id_, m_counters_start_);
+    m_registry_->pop(m_path_, m_depth_, wall, cpu, counters);
+    m_registry_.reset();
+    m_path_.clear();
+}
+
+} // namespace parallelzone::runtime
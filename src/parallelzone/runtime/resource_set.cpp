@@ -62,6 +62,15 @@ ResourceSet::const_ram_reference ResourceSet::ram() const {
     throw std::out_of_range("ResourceSet has no RAM");
 }
 
+bool ResourceSet::has_cpu() const noexcept {
+    return has_pimpl_() && !null() && !m_pimpl_->m_cpu.empty();
+}
+
+ResourceSet::const_cpu_reference ResourceSet::cpu() const {
+    if(has_cpu()) return m_pimpl_->m_cpu;
+    throw std::out_of_range("ResourceSet has no CPU");
+}
+
 ResourceSet::logger_reference ResourceSet::logger() const {
     assert_pimpl_();
     return *m_pimpl_->m_plogger;
@@ -14,10 +14,14 @@
  * limitations under the License.
  */
 
+#include "../mpi_helpers/commpp/detail_/thread_comm_pimpl.hpp"
+#include "detail_/interconnect_probe.hpp"
 #include "detail_/resource_set_pimpl.hpp"
 #include "detail_/runtime_view_pimpl.hpp"
-#include <mpi.h>
 #include <parallelzone/logging/logger_factory.hpp>
+#include <exception>
+#include <parallelzone/mpi_helpers/mpi.hpp>
+#include <thread>
 
 // N.B. AFAIK the only way a RuntimeView can have no PIMPL is if an exception is
 //      thrown in the ctor, the user catches the exception, and uses the
@@ -28,12 +32,36 @@ namespace parallelzone::runtime {
 
 namespace {
 
+using thread_level = RuntimeView::thread_level;
+
+// Maps our thread levels to MPI's
+int to_mpi(thread_level level) {
+    switch(level) {
+        case thread_level::funneled: return MPI_THREAD_FUNNELED;
+        case thread_level::serialized: return MPI_THREAD_SERIALIZED;
+        case thread_level::multiple: return MPI_THREAD_MULTIPLE;
+        default: return MPI_THREAD_SINGLE;
+    }
+}
+
+// Maps MPI's thread levels to ours
+thread_level from_mpi(int level) {
+    if(level == MPI_THREAD_MULTIPLE) return thread_level::multiple;
+    if(level == MPI_THREAD_SERIALIZED) return thread_level::serialized;
+    if(level == MPI_THREAD_FUNNELED) return thread_level::funneled;
+    return thread_level::single;
+}
+
 // Basically a ternary statement dispatching on whether we need to initialize
 // MPI or not
-auto start_mpi(int argc, char** argv, const MPI_Comm& comm) {
+auto start_mpi(int argc, char** argv, const MPI_Comm& comm,
+               thread_level requested) {
     int mpi_initialized;
     MPI_Initialized(&(mpi_initialized));
-    if(!mpi_initialized) MPI_Init(&argc, &argv);
+    if(!mpi_initialized) {
+        int provided;
+        MPI_Init_thread(&argc, &argv, to_mpi(requested), &provided);
+    }
     mpi_helpers::CommPP commpp(comm);
 
     auto log         = LoggerFactory::default_global_logger(commpp.me());
@@ -42,6 +70,14 @@ auto start_mpi(int argc, char** argv, const MPI_Comm& comm) {
                                         std::move(log));
 }
 
+// Used when the caller already has a CommPP, MPI is left alone
+auto wrap_comm(mpi_helpers::CommPP comm) {
+    auto log         = LoggerFactory::default_global_logger(comm.me());
+    using pimpl_type = detail_::RuntimeViewPIMPL;
+    return std::make_shared<pimpl_type>(false, std::move(comm),
+                                        std::move(log));
+}
+
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -55,8 +91,19 @@ RuntimeView::RuntimeView(argc_type argc, argv_type argv) :
 
 RuntimeView::RuntimeView(mpi_comm_type comm) : RuntimeView(0, nullptr, comm) {}
 
+RuntimeView::RuntimeView(argc_type argc, argv_type argv,
+                         thread_level requested) :
+  RuntimeView(argc, argv, MPI_COMM_WORLD, requested) {}
+
 RuntimeView::RuntimeView(int argc, char** argv, mpi_comm_type comm) :
-  RuntimeView(start_mpi(argc, argv, comm)) {}
+  RuntimeView(argc, argv, comm, thread_level::single) {}
+
+RuntimeView::RuntimeView(argc_type argc, argv_type argv, mpi_comm_type comm,
+                         thread_level requested) :
+  RuntimeView(start_mpi(argc, argv, comm, requested)) {}
+
+RuntimeView::RuntimeView(comm_type comm) :
+  RuntimeView(wrap_comm(std::move(comm))) {}
 
 RuntimeView::RuntimeView(pimpl_pointer pimpl) noexcept :
   m_pimpl_(std::move(pimpl)) {}
@@ -90,6 +137,25 @@ bool RuntimeView::did_i_start_mpi() const noexcept {
     return !null() ? m_pimpl_->m_did_i_start_mpi : false;
 }
 
+RuntimeView::thread_level RuntimeView::provided_thread_level() const noexcept {
+    // N.B. Null and thread-backed runtimes don't need MPI, which may not be
+    //      running
+    if(mpi_comm() == MPI_COMM_NULL) return thread_level::single;
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    return from_mpi(provided);
+}
+
+void RuntimeView::reserve_thread_comms(size_type n) const {
+    needs_mpi_();
+    m_pimpl_->reserve_thread_comms(n);
+}
+
+RuntimeView::mpi_comm_type RuntimeView::thread_comm(size_type i) const {
+    needs_mpi_();
+    return m_pimpl_->thread_comm(i);
+}
+
 RuntimeView::const_resource_set_reference RuntimeView::at(size_type i) const {
     bounds_check_(i);
     return m_pimpl_->at(i);
@@ -105,17 +171,109 @@ RuntimeView::const_resource_set_reference RuntimeView::my_resource_set() const {
 }
 
 RuntimeView::size_type RuntimeView::count(const_ram_reference ram) const {
-    size_type count = 0;
-    for(size_type i = 0; i < size(); ++i) {
-        if(at(i).ram() == ram) ++count;
-    }
-    return count;
+    return !null() ? m_pimpl_->count(ram) : 0;
+}
+
+RuntimeView::size_type RuntimeView::n_nodes() const noexcept {
+    return !null() ? m_pimpl_->m_table->n_nodes() : 0;
+}
+
+RuntimeView::size_type RuntimeView::node_of(size_type rank) const {
+    bounds_check_(rank);
+    return (*m_pimpl_->m_table)[rank].m_node;
+}
+
+RuntimeView::const_rank_container_reference RuntimeView::ranks_on_node(
+  size_type node) const {
+    if(node >= n_nodes())
+        throw std::out_of_range("Node " + std::to_string(node) +
+                                " is not in the range [0, " +
+                                std::to_string(n_nodes()) + ").");
+    return m_pimpl_->m_table->ranks_on_node(node);
+}
+
+RuntimeView::size_type RuntimeView::local_rank() const {
+    const auto me = pimpl_().m_comm.me();
+    bounds_check_(me);
+    return (*m_pimpl_->m_table)[me].m_local_rank;
+}
+
+void RuntimeView::characterize_interconnect(const std::string& cache_dir,
+                                            bool reprobe) {
+    needs_mpi_();
+    auto& pimpl        = pimpl_();
+    pimpl.m_cost_model = detail_::load_or_probe_interconnect(
+      pimpl.m_comm.comm(), *pimpl.m_table, cache_dir, reprobe);
+}
+
+void RuntimeView::characterize_interconnect() {
+    characterize_interconnect(detail_::default_cache_dir());
+}
+
+bool RuntimeView::has_comm_cost_model() const noexcept {
+    return !null() && m_pimpl_->m_cost_model.has_value();
+}
+
+RuntimeView::const_comm_cost_model_reference RuntimeView::comm_cost_model()
+  const {
+    if(!has_comm_cost_model())
+        throw std::runtime_error("The interconnect has not been "
+                                 "characterized. Did you call "
+                                 "characterize_interconnect?");
+    return *m_pimpl_->m_cost_model;
+}
+
+RuntimeView::comm_time_type RuntimeView::comm_cost(size_type n_bytes,
+                                                   size_type src,
+                                                   size_type dst) const {
+    const auto& model = comm_cost_model();
+    bounds_check_(src);
+    bounds_check_(dst);
+
+    using level = comm_cost_model_type::level;
+    auto l      = level::inter_node;
+    if(src == dst)
+        l = level::self;
+    else if(node_of(src) == node_of(dst))
+        l = level::intra_node;
+    return model.cost(n_bytes, l);
 }
 
 RuntimeView::logger_reference RuntimeView::logger() const {
     return *pimpl_().m_plogger;
 }
 
+void RuntimeView::limit_logging(const log_limits_type& limits) {
+    const auto& rs = my_resource_set();
+    const auto me  = rs.mpi_rank();
+
+    // Make both before replacing either, for the strong throw guarantee
+    auto program_log = LoggerFactory::make_limited(logger(), me, limits);
+    auto rank_log    = LoggerFactory::make_limited(rs.logger(), me, limits);
+    logger().swap(program_log);
+    rs.logger().swap(rank_log);
+}
+
+RuntimeView::region_timer_type RuntimeView::timer(
+  const std::string& name) const {
+    return region_timer_type(pimpl_().m_timers, name);
+}
+
+RuntimeView::timer_report_type RuntimeView::report_timers() const {
+    not_null_();
+    return m_pimpl_->report_timers();
+}
+
+void RuntimeView::report_timers_at_finalize() {
+    pimpl_().report_timers_at_finalize();
+}
+
+void RuntimeView::clear_timers() { pimpl_().m_timers->clear(); }
+
+void RuntimeView::enable_hardware_counters(counter_event_container events) {
+    pimpl_().m_timers->set_counter_events(std::move(events));
+}
+
 // -----------------------------------------------------------------------------
 // -- Utility methods
 // -----------------------------------------------------------------------------
@@ -124,6 +282,24 @@ void RuntimeView::stack_callback(callback_function_type cb_func) {
     pimpl_().stack_callback(std::move(cb_func));
 }
 
+void RuntimeView::start_progress_thread(progress_interval_type interval) {
+    needs_mpi_();
+    pimpl_().start_progress_engine(interval);
+}
+
+bool RuntimeView::progress_thread_running() const noexcept {
+    if(null() || !m_pimpl_->m_progress_engine) return false;
+    return m_pimpl_->m_progress_engine->running();
+}
+
+RuntimeView::request_future_type RuntimeView::register_request(
+  mpi_request_type request) {
+    if(!progress_thread_running())
+        throw std::runtime_error("The MPI progress thread is not running. Did "
+                                 "you call start_progress_thread?");
+    return m_pimpl_->m_progress_engine->register_request(request);
+}
+
 void RuntimeView::swap(RuntimeView& other) noexcept {
     m_pimpl_.swap(other.m_pimpl_);
 }
@@ -134,12 +310,61 @@ bool RuntimeView::operator==(const RuntimeView& rhs) const {
     return *m_pimpl_ == *rhs.m_pimpl_;
 }
 
+void RuntimeView::run_threaded(size_type n_ranks,
+                               const rank_function_type& fxn) {
+    if(n_ranks == 0)
+        throw std::out_of_range("run_threaded needs at least one rank");
+
+    auto comms = comm_type::make_threaded(comm_type::size_type(n_ranks));
+
+    // A copy of rank 0's communicator, used to abort the team. Once a rank
+    // fails the other ranks' collectives throw TeamAborted instead of waiting
+    // forever, those exceptions are only rethrown if nothing else was thrown
+    const auto team = comms.front();
+    std::vector<std::exception_ptr> errors(n_ranks);
+    std::vector<std::exception_ptr> aborted(n_ranks);
+    std::vector<std::thread> threads;
+    threads.reserve(n_ranks);
+    try {
+        for(size_type i = 0; i < n_ranks; ++i) {
+            threads.emplace_back([&, i]() {
+                try {
+                    RuntimeView rt(std::move(comms[i]));
+                    fxn(rt);
+                } catch(const mpi_helpers::detail_::TeamAborted&) {
+                    aborted[i] = std::current_exception();
+                } catch(...) {
+                    errors[i] = std::current_exception();
+                    team.abort();
+                }
+            });
+        }
+    } catch(...) {
+        // Destroying a joinable thread terminates the program
+        team.abort();
+        for(auto& thread : threads) thread.join();
+        throw;
+    }
+    for(auto& thread : threads) thread.join();
+    for(auto& error : errors)
+        if(error) std::rethrow_exception(error);
+    for(auto& error : aborted)
+        if(error) std::rethrow_exception(error);
+}
+
 // -----------------------------------------------------------------------------
 // -- Private methods
 // -----------------------------------------------------------------------------
 
 mpi_helpers::CommPP RuntimeView::comm_() const {
-    return mpi_helpers::CommPP(mpi_comm());
+    return !null() ? m_pimpl_->m_comm : mpi_helpers::CommPP{};
+}
+
+void RuntimeView::needs_mpi_() const {
+    not_null_();
+    if(mpi_comm() != MPI_COMM_NULL) return;
+    throw std::runtime_error("This operation requires a RuntimeView backed by "
+                             "an MPI communicator.");
 }
 
 void RuntimeView::not_null_() const {
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../hardware.hpp"
+#include <parallelzone/hardware/cpu/cpu.hpp>
+#include <pybind11/operators.h>
+#include <pybind11/stl.h>
+
+namespace parallelzone::hardware {
+
+void export_cpu(pybind11::module_& m) {
+    using hardware::CPU;
+
+    pybind11::class_<CPU>(m, "CPU")
+      .def(pybind11::init<>())
+      .def("n_sockets", &CPU::n_sockets)
+      .def("n_cores", &CPU::n_cores)
+      .def("n_hardware_threads", &CPU::n_hardware_threads)
+      .def("hardware_threads", &CPU::hardware_threads)
+      .def("socket_of", &CPU::socket_of)
+      .def("core_of", &CPU::core_of)
+      .def("hardware_threads_on_socket", &CPU::hardware_threads_on_socket)
+      .def("n_numa_nodes", &CPU::n_numa_nodes)
+      .def("numa_nodes", &CPU::numa_nodes)
+      .def("numa_node_of", &CPU::numa_node_of)
+      .def("hardware_threads_on_numa_node",
+           &CPU::hardware_threads_on_numa_node)
+      .def("cache_size", &CPU::cache_size)
+      .def("cache_line_size", &CPU::cache_line_size)
+      .def("n_cache_levels", &CPU::n_cache_levels)
+      .def("affinity", &CPU::affinity)
+      .def("set_affinity", &CPU::set_affinity)
+      .def("pin_thread", &CPU::pin_thread)
+      .def("empty", &CPU::empty)
+      .def(pybind11::self == pybind11::self)
+      .def(pybind11::self != pybind11::self);
+}
+
+} // namespace parallelzone::hardware
@@ -19,10 +19,12 @@
 
 namespace parallelzone::hardware {
 
+void export_cpu(pybind11::module_& m);
 void export_ram(pybind11::module_& m);
 
 inline void export_hardware(pybind11::module_& m) {
     auto mhardware = m.def_submodule("hardware");
+    export_cpu(mhardware);
     export_ram(mhardware);
 }
 
@@ -23,9 +23,24 @@ namespace parallelzone::hardware {
 void export_ram(pybind11::module_& m) {
     using hardware::RAM;
 
+    pybind11::class_<AllocationTracker>(m, "AllocationTracker")
+      .def("live_bytes", &AllocationTracker::live_bytes)
+      .def("peak_bytes", &AllocationTracker::peak_bytes)
+      .def("n_allocations", &AllocationTracker::n_allocations)
+      .def("n_deallocations", &AllocationTracker::n_deallocations)
+      .def("reset_peak", &AllocationTracker::reset_peak)
+      .def("soft_limit", &AllocationTracker::soft_limit);
+
     pybind11::class_<RAM>(m, "RAM")
       .def(pybind11::init<>())
       .def("total_space", &RAM::total_space)
+      .def("node", &RAM::node)
+      .def("free_space", &RAM::free_space)
+      .def("used_space", &RAM::used_space)
+      .def("high_water_mark", &RAM::high_water_mark)
+      .def("numa_nodes", &RAM::numa_nodes)
+      .def("numa_node_space", &RAM::numa_node_space)
+      .def("tracker", &RAM::tracker, pybind11::return_value_policy::reference)
       .def("empty", &RAM::empty)
       .def(pybind11::self == pybind11::self)
       .def(pybind11::self != pybind11::self);
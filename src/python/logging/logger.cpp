@@ -38,6 +38,8 @@ void export_logger(pybind11::module_& m) {
       .def("critical", &Logger::critical)
       .def("log", static_cast<log0>(&Logger::log))
       .def("log", static_cast<log1>(&Logger::log))
+      .def("should_log", &Logger::should_log)
+      .def("flush", &Logger::flush)
       .def(pybind11::self == pybind11::self)
       .def(pybind11::self != pybind11::self);
 
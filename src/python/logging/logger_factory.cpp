@@ -16,13 +16,47 @@
 
 #include "logging.hpp"
 #include <parallelzone/logging/logger_factory.hpp>
+#include <pybind11/chrono.h>
+#include <pybind11/stl.h>
 
 namespace parallelzone {
 
 void export_logger_factory(pybind11::module_& m) {
-    pybind11::class_<LoggerFactory>(m, "LoggerFactory")
+    using pybind11::arg;
+    using log_limits = LoggerFactory::log_limits;
+    pybind11::class_<LoggerFactory> factory(m, "LoggerFactory");
+
+    pybind11::class_<log_limits>(factory, "log_limits")
       .def(pybind11::init<>())
-      .def("default_global_logger", &LoggerFactory::default_global_logger);
+      .def_readwrite("max_per_interval", &log_limits::max_per_interval)
+      .def_readwrite("interval", &log_limits::interval)
+      .def_readwrite("rank_stride", &log_limits::rank_stride)
+      .def_readwrite("ranks", &log_limits::ranks)
+      .def_readwrite("all_ranks_severity", &log_limits::all_ranks_severity);
+
+    factory.def(pybind11::init<>())
+      .def("default_global_logger", &LoggerFactory::default_global_logger)
+      .def("file_logger", &LoggerFactory::file_logger, arg("file_name"),
+           arg("max_size")  = 0,
+           arg("max_files") = LoggerFactory::default_max_files)
+      .def("rank_file_logger", &LoggerFactory::rank_file_logger, arg("rank"),
+           arg("directory") = ".",
+           arg("max_size")  = LoggerFactory::default_max_file_size,
+           arg("max_files") = LoggerFactory::default_max_files)
+      .def("binary_file_logger", &LoggerFactory::binary_file_logger,
+           arg("rank"), arg("directory") = ".")
+      .def_static(
+        "make_per_thread", &LoggerFactory::make_per_thread, arg("logger"),
+        arg("buffer_size") = LoggerFactory::default_thread_buffer_size)
+      .def_static("make_limited", &LoggerFactory::make_limited, arg("logger"),
+                  arg("rank"), arg("limits"))
+      .def_static(
+        "make_flight_recorder", &LoggerFactory::make_flight_recorder,
+        arg("sink"),
+        arg("n_records")     = LoggerFactory::default_flight_recorder_size,
+        arg("dump_severity") = Logger::severity::error)
+      .def_static("dump_flight_recorders",
+                  &LoggerFactory::dump_flight_recorders);
 }
 
 } // namespace parallelzone
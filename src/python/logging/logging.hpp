@@ -23,8 +23,10 @@ void export_logger_factory(pybind11::module_& m);
 void export_logger(pybind11::module_& m);
 
 inline void export_logging(pybind11::module_& m) {
-    export_logger_factory(m);
+    // The factory's default arguments use Logger::severity, so export the
+    // Logger first
     export_logger(m);
+    export_logger_factory(m);
 }
 
 } // namespace parallelzone
@@ -27,6 +27,8 @@ void export_resource_set(pybind11::module_& m) {
       .def("is_mine", &ResourceSet::is_mine)
       .def("has_ram", &ResourceSet::has_ram)
       .def("ram", &ResourceSet::ram)
+      .def("has_cpu", &ResourceSet::has_cpu)
+      .def("cpu", &ResourceSet::cpu)
       .def("logger", &ResourceSet::logger)
       .def("null", &ResourceSet::null)
       .def("empty", &ResourceSet::empty)
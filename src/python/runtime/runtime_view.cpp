@@ -18,6 +18,7 @@
 #include <parallelzone/runtime/runtime_view.hpp>
 #include <pybind11/functional.h>
 #include <pybind11/operators.h>
+#include <pybind11/stl.h>
 
 namespace parallelzone::runtime {
 
@@ -31,8 +32,21 @@ void export_runtime_view(pybind11::module_& m) {
       .def("has_me", &RuntimeView::has_me)
       .def("my_resource_set", &RuntimeView::my_resource_set)
       .def("count", &RuntimeView::count)
+      .def("n_nodes", &RuntimeView::n_nodes)
+      .def("node_of", &RuntimeView::node_of)
+      .def("ranks_on_node", &RuntimeView::ranks_on_node)
+      .def("local_rank", &RuntimeView::local_rank)
+      .def("characterize_interconnect",
+           pybind11::overload_cast<>(&RuntimeView::characterize_interconnect))
+      .def("characterize_interconnect",
+           pybind11::overload_cast<const std::string&, bool>(
+             &RuntimeView::characterize_interconnect),
+           pybind11::arg("cache_dir"), pybind11::arg("reprobe") = false)
+      .def("has_comm_cost_model", &RuntimeView::has_comm_cost_model)
+      .def("comm_cost", &RuntimeView::comm_cost)
       .def("logger", &RuntimeView::logger,
            pybind11::return_value_policy::reference_internal)
+      .def("limit_logging", &RuntimeView::limit_logging)
       .def("stack_callback", &RuntimeView::stack_callback)
       .def(pybind11::self == pybind11::self)
       .def(pybind11::self != pybind11::self);
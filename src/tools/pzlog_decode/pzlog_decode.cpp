@@ -0,0 +1,60 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <exception>
+#include <iostream>
+#include <parallelzone/logging/binary_log.hpp>
+#include <string>
+#include <vector>
+
+/** @file pzlog_decode.cpp
+ *
+ *  Merges the binary logs written by LoggerFactory::binary_file_logger and
+ *  prints them, in time stamp order, as text or JSON Lines:
+ *
+ *      pzlog_decode [--json] log.rank0.pzlog log.rank1.pzlog ...
+ */
+
+int main(int argc, char** argv) {
+    using parallelzone::binary_log_format;
+
+    auto format = binary_log_format::text;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if(arg == "--json") {
+            format = binary_log_format::json;
+        } else if(arg == "-h" || arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [--json] FILE..."
+                      << std::endl;
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if(files.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--json] FILE..." << std::endl;
+        return 1;
+    }
+
+    try {
+        parallelzone::decode_binary_logs(files, std::cout, format);
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
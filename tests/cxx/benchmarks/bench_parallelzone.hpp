@@ -0,0 +1,37 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "catch.hpp"
+#include <parallelzone/runtime/runtime_view.hpp>
+
+namespace benchmarking {
+
+/** @brief Struct representing the benchmarking environment
+ *
+ *  At the moment this struct just has the default runtime in it. MPI is
+ *  initialized with MPI_THREAD_MULTIPLE so that features which need a
+ *  thread-safe MPI can be measured.
+ */
+struct PZEnvironment {
+    static auto& comm_world() { return *pcomm_world; }
+
+    static parallelzone::runtime::RuntimeView* pcomm_world;
+};
+
+inline parallelzone::runtime::RuntimeView* PZEnvironment::pcomm_world = nullptr;
+
+} // namespace benchmarking
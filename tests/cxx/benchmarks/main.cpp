@@ -0,0 +1,29 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define CATCH_CONFIG_RUNNER
+#include "bench_parallelzone.hpp"
+
+int main(int argc, char* argv[]) {
+    using thread_level = parallelzone::runtime::RuntimeView::thread_level;
+    auto rt = parallelzone::runtime::RuntimeView(argc, argv,
+                                                 thread_level::multiple);
+    benchmarking::PZEnvironment::pcomm_world = &rt;
+
+    int res = Catch::Session().run(argc, argv);
+
+    return res;
+}
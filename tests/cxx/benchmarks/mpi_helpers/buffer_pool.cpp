@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../bench_parallelzone.hpp"
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <string>
+#include <vector>
+
+/* Benchmarking Notes
+ *
+ * These benchmarks measure what the BufferPool saves on the hot path of
+ * iterative communication. The first pair compares allocating a temporary
+ * with the system allocator against drawing it from the pool. The second pair
+ * runs the same small gathers with a warm pool and with a pool which is not
+ * allowed to cache anything (i.e., every buffer goes to the system
+ * allocator). On a single rank the gathers skip MPI, and the pool, entirely,
+ * so the second pair needs at least two ranks.
+ */
+
+using namespace parallelzone::mpi_helpers;
+
+TEST_CASE("BufferPool temporaries") {
+    const std::size_t n = 4096;
+
+    BENCHMARK("std::vector<std::byte>(n)") {
+        std::vector<std::byte> buffer(n);
+        return buffer.data();
+    };
+
+    BENCHMARK("BinaryBuffer(n)") {
+        BinaryBuffer buffer(n);
+        return buffer.data();
+    };
+}
+
+TEST_CASE("BufferPool gathers") {
+    auto rt    = benchmarking::PZEnvironment::comm_world();
+    auto& pool = BufferPool::default_pool();
+    CommPP comm(rt.mpi_comm());
+    if(comm.size() < 2) {
+        WARN("The gathers only use the pool with 2 or more ranks, skipping");
+        return;
+    }
+
+    std::vector<double> doubles(16, comm.me());
+    std::vector<std::string> strings{"Hello", "World"};
+
+    auto iteration = [&]() {
+        auto g  = comm.gather(doubles);
+        auto gv = comm.gatherv(strings);
+        return g.size() + gv.size();
+    };
+
+    // Warm the pool, then make sure the steady state really does not miss
+    iteration();
+    pool.reset_stats();
+    iteration();
+    REQUIRE(pool.stats().n_acquires > 0);
+    REQUIRE(pool.stats().n_misses == 0);
+
+    BENCHMARK("gathers, warm pool") { return iteration(); };
+
+    const auto old_max = pool.max_cached_bytes();
+    pool.set_max_cached_bytes(0);
+    BENCHMARK("gathers, no caching") { return iteration(); };
+    pool.set_max_cached_bytes(old_max);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../bench_parallelzone.hpp"
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <string>
+#include <vector>
+
+/* Benchmarking Notes
+ *
+ * On a single-rank communicator CommPP's gathers and reductions do not call
+ * MPI. These benchmarks run on MPI_COMM_SELF, which always has one rank, so
+ * they measure the fast path regardless of how many ranks the benchmarks are
+ * launched with. For reference, the first benchmarks time the raw MPI calls
+ * the fast path replaces (they do not include the allocations and the
+ * serialization CommPP would also have done).
+ */
+
+using namespace parallelzone::mpi_helpers;
+
+TEST_CASE("Single rank collectives") {
+    CommPP self(MPI_COMM_SELF);
+    const std::size_t n = 16;
+
+    std::vector<double> in(n, 1.0), out(n);
+
+    BENCHMARK("MPI_Allgather (reference)") {
+        MPI_Allgather(in.data(), n, MPI_DOUBLE, out.data(), n, MPI_DOUBLE,
+                      MPI_COMM_SELF);
+        return out[0];
+    };
+
+    BENCHMARK("MPI_Allreduce (reference)") {
+        MPI_Allreduce(in.data(), out.data(), n, MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_SELF);
+        return out[0];
+    };
+
+    // The input is moved in and the result is moved back out, so the
+    // benchmarks time CommPP rather than copying or freeing buffers
+    std::vector<double> doubles(n, 1.0);
+    std::vector<std::string> strings(n, "Hello World");
+
+    BENCHMARK("gather, trivially copyable") {
+        doubles = self.gather(std::move(doubles));
+        return doubles.data();
+    };
+
+    BENCHMARK("gatherv, trivially copyable") {
+        doubles = self.gatherv(std::move(doubles));
+        return doubles.data();
+    };
+
+    BENCHMARK("gather, needs serialized") {
+        strings = std::move(self.gather(std::move(strings))[0]);
+        return strings.data();
+    };
+
+    BENCHMARK("all reduce") {
+        doubles = self.reduce(std::move(doubles), std::plus<double>());
+        return doubles.data();
+    };
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../bench_parallelzone.hpp"
+#include <cmath>
+#include <vector>
+
+/* Benchmarking Notes
+ *
+ * These benchmarks measure how much of a large nonblocking all gather can be
+ * hidden behind computation. Each iteration starts an MPI_Iallgather, does a
+ * fixed amount of local work, and then waits on the gather. Without a progress
+ * thread many MPI implementations only move data when the wait is reached, so
+ * the time is roughly gather + compute. With the progress thread the gather
+ * advances during the compute, so the time approaches max(gather, compute).
+ */
+
+namespace {
+
+// Some floating-point work the compiler can not elide
+double compute(std::size_t n) {
+    double sum = 0.0;
+    for(std::size_t i = 0; i < n; ++i) sum += std::sqrt(double(i));
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("Progress thread overlap") {
+    using parallelzone::runtime::RuntimeView;
+    auto rt   = benchmarking::PZEnvironment::comm_world();
+    auto comm = rt.mpi_comm();
+    const int n_ranks = rt.size();
+
+    // 8 MiB from each rank
+    const int n_bytes = 8 * 1024 * 1024;
+    std::vector<std::byte> in(n_bytes);
+    std::vector<std::byte> out(std::size_t(n_bytes) * n_ranks);
+    const std::size_t n_work = 20'000'000;
+
+    BENCHMARK("compute only") { return compute(n_work); };
+
+    BENCHMARK("blocking all gather then compute") {
+        MPI_Allgather(in.data(), n_bytes, MPI_BYTE, out.data(), n_bytes,
+                      MPI_BYTE, comm);
+        return compute(n_work);
+    };
+
+    BENCHMARK("nonblocking all gather, no progress thread") {
+        MPI_Request request;
+        MPI_Iallgather(in.data(), n_bytes, MPI_BYTE, out.data(), n_bytes,
+                       MPI_BYTE, comm, &request);
+        auto rv = compute(n_work);
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        return rv;
+    };
+
+    // Uses a separate view so the thread is stopped when the test case ends
+    RuntimeView with_thread(comm);
+    int provided;
+    MPI_Query_thread(&provided);
+    if(provided != MPI_THREAD_MULTIPLE) {
+        WARN("MPI_THREAD_MULTIPLE is not available, skipping progress thread");
+        return;
+    }
+    with_thread.start_progress_thread();
+
+    BENCHMARK("nonblocking all gather, progress thread") {
+        MPI_Request request;
+        MPI_Iallgather(in.data(), n_bytes, MPI_BYTE, out.data(), n_bytes,
+                       MPI_BYTE, comm, &request);
+        auto f  = with_thread.register_request(request);
+        auto rv = compute(n_work);
+        f.wait();
+        return rv;
+    };
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include "../../test_sysfs.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <parallelzone/hardware/cpu/cpu.hpp>
+#include <parallelzone/hardware/cpu/detail_/cpu_pimpl.hpp>
+#include <thread>
+#include <unistd.h>
+
+using namespace parallelzone::hardware;
+
+/* Testing Strategy:
+ *
+ * The real topology depends on the machine running the tests, so the
+ * discovery is tested against a fake sysfs tree describing 2 sockets, each
+ * with 2 cores, each with 2 hardware threads (CPU 7 is offline). Each socket
+ * is a NUMA node (with ids 0 and 2, since ids need not be contiguous). The CPU
+ * class itself is tested with the topology of the current machine, but only
+ * with checks which hold for any machine.
+ */
+
+using testing::write_file;
+
+namespace {
+
+// Makes the fake tree, returns its root
+std::filesystem::path make_fake_sysfs() {
+    namespace fs = std::filesystem;
+    auto root    = fs::temp_directory_path() /
+                ("pz_fake_sysfs_" + std::to_string(::getpid()));
+    fs::remove_all(root);
+    write_file(root / "online", "0-6\n");
+    for(int i = 0; i < 8; ++i) {
+        auto cpu = root / ("cpu" + std::to_string(i));
+        // Package ids are 4 and 9 to check the renumbering
+        write_file(cpu / "topology/physical_package_id",
+                   i < 4 ? "4\n" : "9\n");
+        write_file(cpu / "topology/core_id",
+                   std::to_string((i % 4) / 2) + "\n");
+        // In the real sysfs nodeN is a symlink to the node's directory
+        write_file(cpu / (i < 4 ? "node0" : "node2") / "cpulist",
+                   i < 4 ? "0-3\n" : "4-7\n");
+    }
+    auto cache = root / "cpu0/cache";
+    write_file(cache / "index0/level", "1\n");
+    write_file(cache / "index0/type", "Data\n");
+    write_file(cache / "index0/size", "48K\n");
+    write_file(cache / "index0/coherency_line_size", "64\n");
+    write_file(cache / "index1/level", "1\n");
+    write_file(cache / "index1/type", "Instruction\n");
+    write_file(cache / "index1/size", "32K\n");
+    write_file(cache / "index2/level", "3\n");
+    write_file(cache / "index2/type", "Unified\n");
+    write_file(cache / "index2/size", "32M\n");
+    write_file(cache / "index3/level", "2\n");
+    write_file(cache / "index3/type", "Unified\n");
+    write_file(cache / "index3/size", "2048K\n");
+    return root;
+}
+
+} // namespace
+
+TEST_CASE("CPUPIMPL") {
+    using detail_::parse_cache_size;
+    using detail_::parse_cpu_list;
+    using id_container = CPU::id_container;
+
+    SECTION("parse_cpu_list") {
+        REQUIRE(parse_cpu_list("0") == id_container{0});
+        REQUIRE(parse_cpu_list("0-3") == id_container{0, 1, 2, 3});
+        REQUIRE(parse_cpu_list("8,0-1,10-11\n") ==
+                id_container{0, 1, 8, 10, 11});
+        REQUIRE(parse_cpu_list("") == id_container{});
+        REQUIRE_THROWS_AS(parse_cpu_list("a-b"), std::runtime_error);
+        REQUIRE_THROWS_AS(parse_cpu_list("3-1"), std::runtime_error);
+    }
+
+    SECTION("parse_cache_size") {
+        REQUIRE(parse_cache_size("512") == 512);
+        REQUIRE(parse_cache_size("32K") == 32 * 1024);
+        REQUIRE(parse_cache_size("2M") == 2 * 1024 * 1024);
+        REQUIRE(parse_cache_size("garbage") == 0);
+    }
+
+    SECTION("discover_cpu") {
+        auto root = make_fake_sysfs();
+        CPU cpu(detail_::discover_cpu(root.string()));
+        std::filesystem::remove_all(root);
+
+        REQUIRE(cpu.n_sockets() == 2);
+        REQUIRE(cpu.n_cores() == 4);
+        REQUIRE(cpu.n_hardware_threads() == 7);
+        REQUIRE(cpu.hardware_threads() == id_container{0, 1, 2, 3, 4, 5, 6});
+        REQUIRE(cpu.socket_of(0) == 0);
+        REQUIRE(cpu.socket_of(5) == 1);
+        REQUIRE(cpu.core_of(1) == 0);
+        REQUIRE(cpu.core_of(2) == 1);
+        REQUIRE(cpu.core_of(6) == 3);
+        REQUIRE_THROWS_AS(cpu.socket_of(7), std::out_of_range);
+        REQUIRE(cpu.hardware_threads_on_socket(1) == id_container{4, 5, 6});
+
+        REQUIRE(cpu.n_numa_nodes() == 2);
+        REQUIRE(cpu.numa_nodes() == id_container{0, 2});
+        REQUIRE(cpu.numa_node_of(3) == 0);
+        REQUIRE(cpu.numa_node_of(4) == 2);
+        REQUIRE(cpu.hardware_threads_on_numa_node(2) ==
+                id_container{4, 5, 6});
+        REQUIRE_THROWS_AS(cpu.hardware_threads_on_numa_node(1),
+                          std::out_of_range);
+
+        REQUIRE(cpu.n_cache_levels() == 3);
+        REQUIRE(cpu.cache_size(1) == 48 * 1024);
+        REQUIRE(cpu.cache_size(2) == 2048 * 1024);
+        REQUIRE(cpu.cache_size(3) == 32 * 1024 * 1024);
+        REQUIRE(cpu.cache_size(4) == 0);
+        REQUIRE(cpu.cache_line_size() == 64);
+    }
+
+    SECTION("discover_cpu with no sysfs") {
+        CPU cpu(detail_::discover_cpu("/this/does/not/exist"));
+        REQUIRE(cpu.n_sockets() == 1);
+        REQUIRE(cpu.n_hardware_threads() ==
+                std::max(std::thread::hardware_concurrency(), 1u));
+        REQUIRE(cpu.n_cores() == cpu.n_hardware_threads());
+        REQUIRE(cpu.n_cache_levels() == 0);
+        REQUIRE(cpu.numa_nodes() == id_container{0});
+    }
+}
+
+TEST_CASE("CPU") {
+    using id_container = CPU::id_container;
+    const auto& run    = testing::PZEnvironment::comm_world();
+    const auto& rs     = run.my_resource_set();
+
+    CPU defaulted;
+    CPU has_value = rs.cpu();
+
+    SECTION("Ctors") {
+        SECTION("Default") {
+            REQUIRE(defaulted.empty());
+            REQUIRE(defaulted.n_sockets() == 0);
+            REQUIRE(defaulted.n_cores() == 0);
+            REQUIRE(defaulted.n_hardware_threads() == 0);
+        }
+
+        SECTION("Value") {
+            REQUIRE_FALSE(has_value.empty());
+            REQUIRE(has_value.n_sockets() > 0);
+            REQUIRE(has_value.n_cores() >= has_value.n_sockets());
+            REQUIRE(has_value.n_hardware_threads() >= has_value.n_cores());
+        }
+
+        SECTION("copy") {
+            CPU defaulted_copy(defaulted);
+            REQUIRE(defaulted_copy == defaulted);
+
+            CPU has_value_copy(has_value);
+            REQUIRE(has_value_copy == has_value);
+        }
+
+        SECTION("move") {
+            CPU has_value_copy(has_value);
+            CPU has_value_move(std::move(has_value));
+            REQUIRE(has_value_copy == has_value_move);
+        }
+
+        SECTION("copy assignment") {
+            CPU has_value_copy;
+            auto phas_value_copy = &(has_value_copy = has_value);
+            REQUIRE(phas_value_copy == &has_value_copy);
+            REQUIRE(has_value_copy == has_value);
+        }
+
+        SECTION("move assignment") {
+            CPU has_value_copy(has_value);
+            CPU has_value_move;
+            auto phas_value_move = &(has_value_move = std::move(has_value));
+            REQUIRE(phas_value_move == &has_value_move);
+            REQUIRE(has_value_copy == has_value_move);
+        }
+    }
+
+    SECTION("hardware_threads") {
+        REQUIRE(defaulted.hardware_threads() == id_container{});
+        auto ids = has_value.hardware_threads();
+        REQUIRE(ids.size() == has_value.n_hardware_threads());
+        for(auto id : ids) REQUIRE(has_value.socket_of(id) < has_value.n_sockets());
+        for(auto id : ids) REQUIRE(has_value.core_of(id) < has_value.n_cores());
+        REQUIRE_THROWS_AS(defaulted.socket_of(0), std::runtime_error);
+        REQUIRE_THROWS_AS(has_value.hardware_threads_on_socket(
+                            has_value.n_sockets()),
+                          std::out_of_range);
+    }
+
+    SECTION("NUMA nodes") {
+        REQUIRE(defaulted.n_numa_nodes() == 0);
+        REQUIRE(defaulted.numa_nodes() == id_container{});
+        REQUIRE_THROWS_AS(defaulted.numa_node_of(0), std::runtime_error);
+
+        auto nodes = has_value.numa_nodes();
+        REQUIRE(nodes.size() == has_value.n_numa_nodes());
+        REQUIRE(nodes.size() > 0);
+        std::size_t n_threads = 0;
+        for(auto node : nodes)
+            n_threads += has_value.hardware_threads_on_numa_node(node).size();
+        REQUIRE(n_threads == has_value.n_hardware_threads());
+        for(auto id : has_value.hardware_threads()) {
+            const auto node = has_value.numa_node_of(id);
+            REQUIRE(std::count(nodes.begin(), nodes.end(), node) == 1);
+        }
+    }
+
+    SECTION("affinity") {
+        REQUIRE_THROWS_AS(defaulted.affinity(), std::runtime_error);
+
+        auto original = has_value.affinity();
+        REQUIRE_FALSE(original.empty());
+
+        // Pin a new thread so the test's thread is unaffected
+        id_container pinned;
+        std::thread t([&]() {
+            has_value.pin_thread(original.front());
+            pinned = has_value.affinity();
+        });
+        t.join();
+        REQUIRE(pinned == id_container{original.front()});
+        REQUIRE(has_value.affinity() == original);
+
+        REQUIRE_THROWS_AS(has_value.set_affinity({}), std::runtime_error);
+        REQUIRE_THROWS_AS(has_value.pin_thread(100000), std::out_of_range);
+    }
+
+    SECTION("counters") {
+        using event = HardwareCounters::event;
+        REQUIRE_THROWS_AS(defaulted.counters({event::cycles}),
+                          std::runtime_error);
+
+        auto counters =
+          has_value.counters({event::cycles, event::page_faults});
+        REQUIRE(counters.events().size() == 2);
+        REQUIRE(counters.supported(event::page_faults));
+        REQUIRE(counters.read().size() == 2);
+    }
+
+    SECTION("empty") {
+        REQUIRE(defaulted.empty());
+        REQUIRE_FALSE(has_value.empty());
+    }
+
+    SECTION("swap") {
+        CPU defaulted_copy(defaulted);
+        CPU has_value_copy(has_value);
+
+        defaulted.swap(has_value);
+        REQUIRE(defaulted == has_value_copy);
+        REQUIRE(has_value == defaulted_copy);
+    }
+
+    SECTION("operator==/operator!=") {
+        REQUIRE(defaulted == CPU());
+        REQUIRE_FALSE(defaulted != CPU());
+
+        REQUIRE(defaulted != has_value);
+        REQUIRE_FALSE(defaulted == has_value);
+    }
+}
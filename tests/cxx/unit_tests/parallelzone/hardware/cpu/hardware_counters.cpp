@@ -0,0 +1,151 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../catch.hpp"
+#include <parallelzone/hardware/cpu/detail_/counter_sources.hpp>
+#include <parallelzone/hardware/cpu/hardware_counters.hpp>
+#include <vector>
+
+using namespace parallelzone::hardware;
+
+/* Testing Strategy:
+ *
+ * Which events can be counted depends on the machine (and on whether PAPI
+ * was built and perf_event_open is allowed), so the checks below hold
+ * whatever the sources are. The exception is getrusage, which is always
+ * available and always counts page faults and context switches.
+ */
+
+namespace {
+
+// Touches 64 MiB of memory, which should cause page faults. The size exceeds
+// malloc's largest mmap threshold, so the pages are fresh
+void touch_pages() {
+    std::vector<char> buffer(std::size_t(1) << 26);
+    for(std::size_t i = 0; i < buffer.size(); i += 4096) buffer[i] = 1;
+    volatile char sink = buffer.back();
+    (void)sink;
+}
+
+} // namespace
+
+TEST_CASE("CounterSource") {
+    using event      = HardwareCounters::event;
+    using value_type = HardwareCounters::value_type;
+
+    SECTION("rusage") {
+        auto source = detail_::make_rusage_source();
+        REQUIRE(source->type() == HardwareCounters::source::rusage);
+        REQUIRE_FALSE(source->add(event::cycles));
+        REQUIRE_FALSE(source->add(event::flops));
+        REQUIRE(source->add(event::page_faults));
+        REQUIRE(source->add(event::context_switches));
+        source->start();
+        touch_pages();
+        value_type values[2] = {0, 0};
+        source->read(values);
+        REQUIRE(values[0] > 0);
+    }
+
+    SECTION("perf_event") {
+        auto source = detail_::make_perf_event_source();
+#ifdef __linux__
+        REQUIRE(source->type() == HardwareCounters::source::perf_event);
+        // There is no generic perf event for floating-point operations
+        REQUIRE_FALSE(source->add(event::flops));
+#else
+        REQUIRE(source == nullptr);
+#endif
+    }
+
+    SECTION("papi") {
+        auto source = detail_::make_papi_source();
+        if(!HardwareCounters::have_papi()) REQUIRE(source == nullptr);
+    }
+}
+
+TEST_CASE("HardwareCounters") {
+    using event           = HardwareCounters::event;
+    using source          = HardwareCounters::source;
+    using event_container = HardwareCounters::event_container;
+
+    event_container events{event::cycles, event::instructions, event::flops,
+                           event::page_faults, event::context_switches,
+                           event::page_faults};
+
+    SECTION("Default") {
+        HardwareCounters counters;
+        REQUIRE(counters.events().empty());
+        REQUIRE(counters.read().empty());
+        REQUIRE(counters.source_of(event::cycles) == source::none);
+        REQUIRE_FALSE(counters.supported(event::page_faults));
+    }
+
+    SECTION("Value") {
+        HardwareCounters counters(events);
+        REQUIRE(counters.events() == events);
+
+        // getrusage is the fallback for the software events
+        REQUIRE(counters.supported(event::page_faults));
+        REQUIRE(counters.supported(event::context_switches));
+
+        // Only PAPI counts floating-point operations
+        if(!HardwareCounters::have_papi())
+            REQUIRE(counters.source_of(event::flops) == source::none);
+
+        // Not asked for
+        REQUIRE(counters.source_of(event::cache_misses) == source::none);
+    }
+
+    SECTION("read") {
+        HardwareCounters counters(events);
+        const auto before = counters.read();
+        touch_pages();
+        const auto after = counters.read();
+        REQUIRE(after.size() == events.size());
+        for(std::size_t i = 0; i < events.size(); ++i) {
+            if(!counters.supported(events[i])) REQUIRE(after[i] == 0);
+            else REQUIRE(after[i] >= before[i]);
+        }
+        REQUIRE(after[3] > before[3]);
+        // Repeated events are read once
+        REQUIRE(after[5] == after[3]);
+    }
+
+    SECTION("move ctor") {
+        HardwareCounters counters(events);
+        const auto src = counters.source_of(event::page_faults);
+        HardwareCounters moved(std::move(counters));
+        REQUIRE(moved.events() == events);
+        REQUIRE(moved.source_of(event::page_faults) == src);
+        REQUIRE(counters.events().empty());
+    }
+
+    SECTION("move assignment") {
+        HardwareCounters counters(events);
+        HardwareCounters moved;
+        auto pmoved = &(moved = std::move(counters));
+        REQUIRE(pmoved == &moved);
+        REQUIRE(moved.events() == events);
+        REQUIRE(counters.events().empty());
+    }
+
+    SECTION("name") {
+        REQUIRE(HardwareCounters::name(event::cycles) == "cycles");
+        REQUIRE(HardwareCounters::name(event::cache_misses) == "cache_misses");
+        REQUIRE(HardwareCounters::name(event::flops) == "flops");
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../../test_parallelzone.hpp"
+#include "../../../test_sysfs.hpp"
+#include <filesystem>
+#include <parallelzone/hardware/ram/detail_/memory_info.hpp>
+#include <unistd.h>
+
+using namespace parallelzone::hardware::detail_;
+
+/* Testing Strategy:
+ *
+ * The parsers and the cgroup queries are tested with fake files. The queries
+ * of the real system can only be checked for self-consistency.
+ */
+
+using testing::write_file;
+
+TEST_CASE("memory_info") {
+    namespace fs = std::filesystem;
+    const memory_size_type kb = 1024;
+
+    SECTION("parse_proc_entry") {
+        std::string meminfo = "MemTotal:       16000 kB\n"
+                              "MemFree:         2000 kB\n"
+                              "MemAvailable:    8000 kB\n"
+                              "HugePages_Total:    4\n";
+        REQUIRE(parse_proc_entry(meminfo, "MemTotal") == 16000 * kb);
+        REQUIRE(parse_proc_entry(meminfo, "MemAvailable") == 8000 * kb);
+        REQUIRE(parse_proc_entry(meminfo, "HugePages_Total") == 4);
+        REQUIRE_FALSE(parse_proc_entry(meminfo, "Mem").has_value());
+        REQUIRE_FALSE(parse_proc_entry(meminfo, "Cached").has_value());
+    }
+
+    SECTION("read_proc_entry") {
+        REQUIRE_FALSE(read_proc_entry("/not/a/file", "MemTotal").has_value());
+        REQUIRE(read_proc_entry("/proc/meminfo", "MemTotal").has_value());
+    }
+
+    SECTION("cgroup") {
+        auto root = fs::temp_directory_path() /
+                    ("pz_fake_cgroup_" + std::to_string(::getpid()));
+        fs::remove_all(root);
+
+        SECTION("no cgroup") {
+            REQUIRE_FALSE(cgroup_limit(root.string()).has_value());
+            REQUIRE_FALSE(cgroup_usage(root.string()).has_value());
+        }
+
+        SECTION("v2") {
+            write_file(root / "memory.max", "1048576\n");
+            write_file(root / "memory.current", "4096\n");
+            REQUIRE(cgroup_limit(root.string()) == 1048576);
+            REQUIRE(cgroup_usage(root.string()) == 4096);
+        }
+
+        SECTION("v2, no limit") {
+            write_file(root / "memory.max", "max\n");
+            REQUIRE_FALSE(cgroup_limit(root.string()).has_value());
+        }
+
+        SECTION("v1") {
+            write_file(root / "memory/memory.limit_in_bytes", "2097152\n");
+            write_file(root / "memory/memory.usage_in_bytes", "8192\n");
+            REQUIRE(cgroup_limit(root.string()) == 2097152);
+            REQUIRE(cgroup_usage(root.string()) == 8192);
+        }
+
+        SECTION("v1, no limit") {
+            write_file(root / "memory/memory.limit_in_bytes",
+                       "9223372036854771712\n");
+            REQUIRE_FALSE(cgroup_limit(root.string()).has_value());
+        }
+        SECTION("v2, nested limit") {
+            // Slurm-like job cgroup, the job's limit is tighter than the
+            // user's limit, and the step has no limit of its own
+            const auto proc = (root / "proc_cgroup").string();
+            write_file(proc, "0::/slurm/job_42/step_0\n");
+            write_file(root / "slurm/memory.max", "8388608\n");
+            write_file(root / "slurm/memory.current", "65536\n");
+            write_file(root / "slurm/job_42/memory.max", "4194304\n");
+            write_file(root / "slurm/job_42/memory.current", "16384\n");
+            write_file(root / "slurm/job_42/step_0/memory.max", "max\n");
+            write_file(root / "slurm/job_42/step_0/memory.current", "4096\n");
+            REQUIRE(cgroup_limit(root.string(), proc) == 4194304);
+            REQUIRE(cgroup_usage(root.string(), proc) == 16384);
+
+            const auto [limit, usage] = cgroup_memory(root.string(), proc);
+            REQUIRE(limit == 4194304);
+            REQUIRE(usage == 16384);
+
+            // The parent's limit applies if it is tighter
+            write_file(root / "slurm/memory.max", "2097152\n");
+            REQUIRE(cgroup_limit(root.string(), proc) == 2097152);
+            REQUIRE(cgroup_usage(root.string(), proc) == 65536);
+        }
+
+        SECTION("v2, cgroup not under root") {
+            // e.g., a container which only sees its own cgroup
+            const auto proc = (root / "proc_cgroup").string();
+            write_file(proc, "0::/docker/abc\n");
+            write_file(root / "memory.max", "1048576\n");
+            REQUIRE(cgroup_limit(root.string(), proc) == 1048576);
+        }
+
+        SECTION("v1, nested limit") {
+            const auto proc = (root / "proc_cgroup").string();
+            write_file(proc, "5:cpu,cpuacct:/other\n4:memory:/job_7\n");
+            write_file(root / "memory/job_7/memory.limit_in_bytes", "524288\n");
+            write_file(root / "memory/job_7/memory.usage_in_bytes", "1024\n");
+            write_file(root / "memory/memory.limit_in_bytes",
+                       "9223372036854771712\n");
+            REQUIRE(cgroup_limit(root.string(), proc) == 524288);
+            REQUIRE(cgroup_usage(root.string(), proc) == 1024);
+        }
+        fs::remove_all(root);
+    }
+
+    SECTION("parse_proc_cgroup") {
+        const std::string v1 = "12:memory:/job\n3:cpu,cpuacct:/cpu_job\n";
+        REQUIRE(parse_proc_cgroup(v1, "memory") == "/job");
+        REQUIRE(parse_proc_cgroup(v1, "cpuacct") == "/cpu_job");
+        REQUIRE_FALSE(parse_proc_cgroup(v1, "").has_value());
+        REQUIRE(parse_proc_cgroup("0::/user.slice\n", "") == "/user.slice");
+        REQUIRE_FALSE(parse_proc_cgroup("garbage", "").has_value());
+    }
+
+    SECTION("system queries") {
+        REQUIRE(physical_memory() > 0);
+        REQUIRE(total_memory() > 0);
+        REQUIRE(total_memory() <= physical_memory());
+        REQUIRE(cgroup_memory().limit == cgroup_limit());
+        REQUIRE(available_memory() <= physical_memory());
+        REQUIRE(process_resident_memory() > 0);
+        REQUIRE(process_resident_memory() <= process_peak_memory());
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../../test_parallelzone.hpp"
+#include "../../../test_sysfs.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <parallelzone/hardware/ram/detail_/numa.hpp>
+#include <unistd.h>
+#include <vector>
+
+using namespace parallelzone::hardware::detail_;
+
+/* Testing Strategy:
+ *
+ * The sysfs parsing is tested with a fake tree. The system call wrappers can
+ * only be checked for consistency, since the tests may run on a machine with
+ * one NUMA node (or in a container which forbids the calls).
+ */
+
+using testing::write_file;
+
+TEST_CASE("numa") {
+    namespace fs = std::filesystem;
+    using node_container = numa_node_container;
+
+    SECTION("online_numa_nodes") {
+        auto root = fs::temp_directory_path() /
+                    ("pz_fake_node_" + std::to_string(::getpid()));
+        write_file(root / "online", "0,2-3\n");
+        REQUIRE(online_numa_nodes(root.string()) == node_container{0, 2, 3});
+
+        write_file(root / "online", "garbage");
+        REQUIRE(online_numa_nodes(root.string()) == node_container{0});
+        fs::remove_all(root);
+
+        REQUIRE(online_numa_nodes("/not/a/dir") == node_container{0});
+        REQUIRE(online_numa_nodes().size() > 0);
+    }
+
+    SECTION("numa_node_memory") {
+        auto root = fs::temp_directory_path() /
+                    ("pz_fake_node_" + std::to_string(::getpid()));
+        write_file(root / "node2/meminfo", "Node 2 MemTotal:  2048 kB\n"
+                                           "Node 2 MemFree:   1024 kB\n");
+        REQUIRE(numa_node_memory(2, root.string()) == 2048 * 1024);
+        REQUIRE_FALSE(numa_node_memory(0, root.string()).has_value());
+        fs::remove_all(root);
+    }
+
+    SECTION("numa_make_mask") {
+        REQUIRE(numa_make_mask({}) == 0);
+        REQUIRE(numa_make_mask({0, 3}) == 0b1001);
+        REQUIRE(numa_make_mask({64}) == 0);
+    }
+
+    SECTION("numa_node_of_address") {
+        std::vector<double> data(1024, 1.0);
+        auto node  = numa_node_of_address(data.data());
+        auto nodes = online_numa_nodes();
+        if(node.has_value())
+            REQUIRE(std::count(nodes.begin(), nodes.end(), *node) == 1);
+    }
+}
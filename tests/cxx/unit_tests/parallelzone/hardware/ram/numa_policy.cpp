@@ -0,0 +1,156 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <cstring>
+#include <parallelzone/hardware/ram/numa_policy.hpp>
+#include <parallelzone/hardware/ram/ram.hpp>
+#include <vector>
+
+using namespace parallelzone::hardware;
+
+/* Testing Strategy:
+ *
+ * Whether memory actually lands on a given node depends on the machine (and
+ * on single node machines policies are ignored). We therefore check that
+ * allocations work under every policy, and that memory bound to a node is on
+ * that node whenever the operating system can tell us.
+ */
+
+TEST_CASE("NUMAPolicy") {
+    using kind_type      = NUMAPolicy::kind_type;
+    using node_container = NUMAPolicy::node_container;
+
+    const auto& run = testing::PZEnvironment::comm_world();
+    const auto& ram = run.my_resource_set().ram();
+    const auto page = NUMAPolicy::page_size();
+
+    NUMAPolicy defaulted;
+    auto all         = NUMAPolicy::interleave();
+    auto interleaved = NUMAPolicy::interleave({0, 1});
+    auto bound       = NUMAPolicy::bind(0);
+
+    SECTION("Ctors") {
+        REQUIRE(defaulted.kind() == kind_type::local);
+        REQUIRE(defaulted.nodes() == node_container{});
+        REQUIRE(NUMAPolicy::local() == defaulted);
+
+        REQUIRE(all.kind() == kind_type::interleave);
+        REQUIRE(all.nodes() == node_container{});
+
+        REQUIRE(interleaved.kind() == kind_type::interleave);
+        REQUIRE(interleaved.nodes() == node_container{0, 1});
+
+        REQUIRE(bound.kind() == kind_type::bind);
+        REQUIRE(bound.nodes() == node_container{0});
+        REQUIRE(NUMAPolicy::bind({3, 1}).nodes() == node_container{1, 3});
+
+        REQUIRE_THROWS_AS(NUMAPolicy::bind(NUMAPolicy::max_nodes),
+                          std::out_of_range);
+        REQUIRE_THROWS_AS(NUMAPolicy::interleave(node_container{}),
+                          std::runtime_error);
+    }
+
+    SECTION("page_size") {
+        REQUIRE(page > 0);
+        REQUIRE((page & (page - 1)) == 0);
+    }
+
+    SECTION("allocate/deallocate") {
+        for(const auto& policy : {defaulted, all, interleaved, bound}) {
+            for(std::size_t n : {std::size_t(8), 4 * page + 3}) {
+                auto* p = policy.allocate(n, alignof(double));
+                REQUIRE(p != nullptr);
+                std::memset(p, 1, n);
+                policy.deallocate(p, n, alignof(double));
+            }
+        }
+    }
+
+    SECTION("is_placed") {
+        const bool multi_node = ram.numa_nodes().size() > 1;
+        REQUIRE(bound.is_placed(2 * page, 8) == multi_node);
+        REQUIRE(all.is_placed(page, page) == multi_node);
+        REQUIRE_FALSE(defaulted.is_placed(2 * page, 8));
+        REQUIRE_FALSE(bound.is_placed(page - 1, 8));
+        REQUIRE_FALSE(bound.is_placed(2 * page, 2 * page));
+    }
+
+    SECTION("Placed memory is page aligned") {
+        if(bound.is_placed(2 * page, 8)) {
+            auto* p = bound.allocate(2 * page, 8);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(p) % page == 0);
+            bound.deallocate(p, 2 * page, 8);
+        }
+    }
+
+    SECTION("Single node machines use operator new") {
+        // Memory which is not placed must be releasable with operator delete
+        if(!bound.is_placed(2 * page, 8)) {
+            auto* p = bound.allocate(2 * page, 8);
+            std::memset(p, 1, 2 * page);
+            ::operator delete(p, 2 * page);
+        }
+    }
+
+    SECTION("Bound memory is on the node") {
+        const auto n = 4 * page;
+        auto* p      = static_cast<char*>(bound.allocate(n, 8));
+        std::memset(p, 0, n);
+        auto node = ram.numa_node_of(p);
+        if(node.has_value()) REQUIRE(*node == 0);
+        bound.deallocate(p, n, 8);
+    }
+
+    SECTION("apply_to_thread") {
+        // Can only be applied if there's more than one node
+        const bool multi_node = ram.numa_nodes().size() > 1;
+        if(!multi_node) REQUIRE_FALSE(bound.apply_to_thread());
+        bound.apply_to_thread();
+        std::vector<double> data(page, 1.0);
+        REQUIRE(data.back() == 1.0);
+        defaulted.apply_to_thread();
+    }
+
+    SECTION("Comparisons") {
+        REQUIRE(defaulted == NUMAPolicy{});
+        REQUIRE(bound == NUMAPolicy::bind(0));
+        REQUIRE(bound != NUMAPolicy::bind(1));
+        REQUIRE(bound != NUMAPolicy::interleave({0}));
+        REQUIRE(all != interleaved);
+    }
+
+    SECTION("With RAM allocators") {
+        using allocator_type = RAM::allocator_type<double>;
+        auto alloc           = ram.allocator<double>(bound);
+        REQUIRE(alloc.policy() == bound);
+        REQUIRE(alloc != ram.allocator<double>());
+
+        const auto live = ram.tracker().live_bytes();
+        {
+            std::vector<double, allocator_type> v(page, 1.0, alloc);
+            REQUIRE(ram.tracker().live_bytes() ==
+                    live + page * sizeof(double));
+            auto node = ram.numa_node_of(v.data());
+            if(node.has_value()) REQUIRE(*node == 0);
+
+            // Rebinding keeps the policy
+            RAM::allocator_type<int> rebound(alloc);
+            REQUIRE(rebound.policy() == bound);
+        }
+        REQUIRE(ram.tracker().live_bytes() == live);
+    }
+}
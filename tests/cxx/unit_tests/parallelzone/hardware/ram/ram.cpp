@@ -15,6 +15,8 @@
  */
 
 #include "../../test_parallelzone.hpp"
+#include <algorithm>
+#include <parallelzone/hardware/ram/detail_/ram_pimpl.hpp>
 #include <parallelzone/hardware/ram/ram.hpp>
 
 using namespace parallelzone::hardware;
@@ -97,6 +99,73 @@ TEST_CASE("RAM") {
         REQUIRE(has_value.total_space() > 0);
     }
 
+    SECTION("node") {
+        REQUIRE(defaulted.node() == zero);
+        REQUIRE(has_value.node() == run.node_of(rs.mpi_rank()));
+    }
+
+    SECTION("free_space") {
+        REQUIRE(defaulted.free_space() == zero);
+        REQUIRE(has_value.free_space() > 0);
+        REQUIRE(has_value.free_space() <= has_value.total_space());
+
+        // Only the RAM of the current process can be queried
+        if(run.size() > 1) {
+            const auto other = (run.my_resource_set().mpi_rank() + 1) %
+                               run.size();
+            REQUIRE_THROWS_AS(run.at(other).ram().free_space(),
+                              std::runtime_error);
+        }
+    }
+
+    SECTION("used_space") {
+        REQUIRE(defaulted.used_space() == zero);
+        REQUIRE(has_value.used_space() > 0);
+        REQUIRE(has_value.used_space() <= has_value.high_water_mark());
+    }
+
+    SECTION("high_water_mark") {
+        REQUIRE(defaulted.high_water_mark() == zero);
+
+        // Touch 64 MiB so the peak is at least that large
+        const size_type n = 64 * 1024 * 1024;
+        std::vector<char> buffer(n, 1);
+        REQUIRE(has_value.high_water_mark() >= n);
+        REQUIRE(buffer.back() == 1);
+    }
+
+    SECTION("NUMA topology") {
+        using node_container = ram_type::numa_node_container;
+        REQUIRE(defaulted.numa_nodes() == node_container{});
+        REQUIRE_THROWS_AS(defaulted.numa_node_space(0), std::runtime_error);
+        REQUIRE_THROWS_AS(defaulted.numa_node_of(&zero), std::runtime_error);
+
+        auto nodes = has_value.numa_nodes();
+        REQUIRE(nodes.size() > 0);
+        size_type sum = 0;
+        for(auto node : nodes) sum += has_value.numa_node_space(node);
+        REQUIRE(sum > 0);
+        REQUIRE_THROWS_AS(has_value.numa_node_space(nodes.back() + 1),
+                          std::out_of_range);
+
+        auto node = has_value.numa_node_of(&zero);
+        if(node.has_value())
+            REQUIRE(std::count(nodes.begin(), nodes.end(), *node) == 1);
+    }
+
+    SECTION("buffer_pool") {
+        using parallelzone::mpi_helpers::BufferPool;
+        REQUIRE_THROWS_AS(defaulted.buffer_pool(), std::runtime_error);
+        REQUIRE(&has_value.buffer_pool() == &BufferPool::default_pool());
+
+        if(run.size() > 1) {
+            const auto other = (run.my_resource_set().mpi_rank() + 1) %
+                               run.size();
+            REQUIRE_THROWS_AS(run.at(other).ram().buffer_pool(),
+                              std::runtime_error);
+        }
+    }
+
     SECTION("gather") {
         using data_type = std::vector<std::string>;
         data_type local_data(3, "Hello");
@@ -147,5 +216,12 @@ TEST_CASE("RAM") {
         // Defaulted != non-default
         REQUIRE(defaulted != has_value);
         REQUIRE_FALSE(defaulted == has_value);
+
+        // RAM is identified by node and size
+        using detail_::make_ram;
+        const auto size = has_value.total_space();
+        REQUIRE(make_ram(size, 0, {}, 1) == make_ram(size, 2, {}, 1));
+        REQUIRE(make_ram(size, 0, {}, 0) != make_ram(size, 0, {}, 1));
+        REQUIRE(make_ram(size, 0, {}, 1) != make_ram(size + 1, 0, {}, 1));
     }
 }
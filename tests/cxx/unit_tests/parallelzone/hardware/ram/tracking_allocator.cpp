@@ -0,0 +1,156 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <map>
+#include <parallelzone/hardware/ram/ram.hpp>
+#include <parallelzone/hardware/ram/tracking_allocator.hpp>
+#include <thread>
+#include <vector>
+
+using namespace parallelzone::hardware;
+
+TEST_CASE("AllocationTracker") {
+    using size_type = AllocationTracker::size_type;
+    AllocationTracker tracker;
+
+    SECTION("Default") {
+        REQUIRE(tracker.live_bytes() == 0);
+        REQUIRE(tracker.peak_bytes() == 0);
+        REQUIRE(tracker.n_allocations() == 0);
+        REQUIRE(tracker.n_deallocations() == 0);
+        REQUIRE(tracker.soft_limit() == 0);
+    }
+
+    SECTION("record") {
+        tracker.record_allocation(100);
+        tracker.record_allocation(50);
+        tracker.record_deallocation(100);
+        REQUIRE(tracker.live_bytes() == 50);
+        REQUIRE(tracker.peak_bytes() == 150);
+        REQUIRE(tracker.n_allocations() == 2);
+        REQUIRE(tracker.n_deallocations() == 1);
+
+        tracker.reset_peak();
+        REQUIRE(tracker.peak_bytes() == 50);
+    }
+
+    SECTION("soft limit") {
+        std::vector<std::pair<size_type, size_type>> calls;
+        tracker.set_soft_limit(100, [&](size_type live, size_type limit) {
+            calls.emplace_back(live, limit);
+        });
+        REQUIRE(tracker.soft_limit() == 100);
+
+        tracker.record_allocation(60);
+        REQUIRE(calls.empty());
+        tracker.record_allocation(60); // Crosses
+        tracker.record_allocation(10); // Already above, no call
+        using pair_type = std::pair<size_type, size_type>;
+        REQUIRE(calls == std::vector<pair_type>{{120, 100}});
+
+        // Dropping below re-arms the callback
+        tracker.record_deallocation(70);
+        tracker.record_allocation(50);
+        REQUIRE(calls == std::vector<pair_type>{{120, 100}, {110, 100}});
+
+        tracker.clear_soft_limit();
+        tracker.record_deallocation(110);
+        tracker.record_allocation(200);
+        REQUIRE(calls.size() == 2);
+    }
+}
+
+TEST_CASE("TrackingAllocator") {
+    const auto& run = testing::PZEnvironment::comm_world();
+    RAM ram         = run.my_resource_set().ram();
+    auto& tracker   = ram.tracker();
+    const auto live = tracker.live_bytes();
+    const auto n    = tracker.n_allocations();
+
+    SECTION("null tracker") {
+        using alloc_type = TrackingAllocator<int>;
+        REQUIRE_THROWS_AS(alloc_type(nullptr), std::runtime_error);
+    }
+
+    SECTION("vector") {
+        {
+            std::vector<double, RAM::allocator_type<double>> v(
+              100, 1.0, ram.allocator<double>());
+            REQUIRE(tracker.live_bytes() == live + 100 * sizeof(double));
+            REQUIRE(tracker.n_allocations() == n + 1);
+        }
+        REQUIRE(tracker.live_bytes() == live);
+        REQUIRE(tracker.peak_bytes() >= live + 100 * sizeof(double));
+    }
+
+    SECTION("node-based container (rebinding)") {
+        using value_type = std::pair<const int, int>;
+        using alloc_type = RAM::allocator_type<value_type>;
+        {
+            std::map<int, int, std::less<int>, alloc_type> m(
+              ram.allocator<value_type>());
+            for(int i = 0; i < 10; ++i) m[i] = i;
+            REQUIRE(tracker.n_allocations() == n + 10);
+            REQUIRE(tracker.live_bytes() > live);
+        }
+        REQUIRE(tracker.live_bytes() == live);
+    }
+
+    SECTION("over-aligned type") {
+        struct alignas(64) Aligned {
+            double x;
+        };
+        std::vector<Aligned, RAM::allocator_type<Aligned>> v(
+          3, Aligned{}, ram.allocator<Aligned>());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0);
+        REQUIRE(tracker.live_bytes() == live + 3 * sizeof(Aligned));
+    }
+
+    SECTION("copies share the tracker") {
+        RAM copy(ram);
+        REQUIRE(&copy.tracker() == &tracker);
+        REQUIRE(copy.allocator<int>() == ram.allocator<double>());
+        REQUIRE_THROWS_AS(RAM{}.allocator<int>(), std::runtime_error);
+    }
+
+    SECTION("many threads") {
+        auto fxn = [&]() {
+            for(int i = 0; i < 100; ++i) {
+                std::vector<int, RAM::allocator_type<int>> v(
+                  10, 0, ram.allocator<int>());
+            }
+        };
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; ++i) threads.emplace_back(fxn);
+        for(auto& t : threads) t.join();
+        REQUIRE(tracker.live_bytes() == live);
+        REQUIRE(tracker.n_allocations() == n + 400);
+        REQUIRE(tracker.n_deallocations() >= 400);
+    }
+
+    SECTION("throwing callback") {
+        tracker.set_soft_limit(live + 1, [](auto, auto) {
+            throw std::runtime_error("Over the limit");
+        });
+        auto alloc = ram.allocator<char>();
+        REQUIRE_THROWS_AS(alloc.allocate(10), std::runtime_error);
+        tracker.clear_soft_limit();
+        // The failed allocation was recorded, but released again
+        REQUIRE(tracker.live_bytes() == live);
+        REQUIRE(tracker.n_allocations() == n + 1);
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../test_parallelzone.hpp"
+#include "../test_logging.hpp"
+#include <filesystem>
+#include <fstream>
+#include <parallelzone/logging/binary_log.hpp>
+#include <parallelzone/logging/logger_factory.hpp>
+#include <sstream>
+
+using namespace parallelzone;
+using severity = Logger::severity;
+using testing::lines;
+
+/* Testing Strategy:
+ *
+ * We write binary logs with LoggerFactory::binary_file_logger for two fake
+ * ranks, alternating between them so that the merged order is known, and
+ * then decode them. The text format starts with a time stamp of fixed width,
+ * which we strip before comparing.
+ */
+TEST_CASE("decode_binary_logs") {
+    namespace fs = std::filesystem;
+
+    const auto dir = testing::per_rank_temp_dir("pz_binary_log");
+
+    const auto file0 = (dir / "log.rank0.pzlog").string();
+    const auto file1 = (dir / "log.rank1.pzlog").string();
+    {
+        auto log0 = LoggerFactory::binary_file_logger(0, dir.string());
+        auto log1 = LoggerFactory::binary_file_logger(1, dir.string());
+        log0.set_severity(severity::trace);
+        log0.log(severity::trace, "x = {}, y = {}", 1, 2.5);
+        log1.log(severity::info, "Plain \"text\"");
+        log0.log(severity::warn, "{} {}", true, "str");
+        log1.log(severity::error, "x = {}, y = {}", -3, 'c');
+        log0.log(severity::critical, "x = {}, y = {}", 4u, "z");
+    }
+
+    std::stringstream ss;
+
+    SECTION("text") {
+        decode_binary_logs({file0, file1}, ss);
+        // Strip "[YYYY-MM-DD HH:MM:SS.nnnnnnnnn] "
+        std::vector<std::string> corr{
+          "[Rank 0] [trace] x = 1, y = 2.5",
+          "[Rank 1] [info] Plain \"text\"",
+          "[Rank 0] [warning] 1 str",
+          "[Rank 1] [error] x = -3, y = c",
+          "[Rank 0] [critical] x = 4, y = z"};
+        REQUIRE(lines(ss.str(), 32) == corr);
+    }
+
+    SECTION("json") {
+        decode_binary_logs({file1, file0}, ss, binary_log_format::json);
+        auto out = lines(ss.str());
+        REQUIRE(out.size() == 5);
+
+        // Strip {"time_ns":<digits>,
+        for(auto& line : out) line = line.substr(line.find(',') + 1);
+        REQUIRE(out[0] == "\"rank\":0,\"severity\":\"trace\",\"message\":"
+                          "\"x = 1, y = 2.5\",\"template\":\"x = {}, y = {}\","
+                          "\"args\":[1,2.5]}");
+        REQUIRE(out[1] == "\"rank\":1,\"severity\":\"info\",\"message\":"
+                          "\"Plain \\\"text\\\"\"}");
+        REQUIRE(out[2] == "\"rank\":0,\"severity\":\"warning\",\"message\":"
+                          "\"1 str\",\"template\":\"{} {}\","
+                          "\"args\":[true,\"str\"]}");
+        REQUIRE(out[3] == "\"rank\":1,\"severity\":\"error\",\"message\":"
+                          "\"x = -3, y = c\",\"template\":\"x = {}, y = {}\","
+                          "\"args\":[-3,\"c\"]}");
+    }
+
+    SECTION("Truncated file") {
+        // Drop the last byte, which is part of the last record
+        fs::resize_file(file0, fs::file_size(file0) - 1);
+        decode_binary_logs({file0}, ss);
+        REQUIRE(lines(ss.str()).size() == 2);
+    }
+
+    SECTION("Not a binary log") {
+        const auto bad = (dir / "bad.pzlog").string();
+        std::ofstream(bad) << "Not a binary log";
+        using except_t = std::runtime_error;
+        REQUIRE_THROWS_AS(decode_binary_logs({bad}, ss), except_t);
+        REQUIRE_THROWS_AS(decode_binary_logs({bad + ".none"}, ss), except_t);
+    }
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../test_parallelzone.hpp"
+#include "../../../test_logging.hpp"
+#include <algorithm>
+#include <parallelzone/logging/detail_/aggregating/aggregating.hpp>
+#include <sstream>
+#include <thread>
+
+using namespace parallelzone;
+using namespace parallelzone::detail_;
+using comm_type = mpi_helpers::CommPP;
+using severity  = Logger::severity;
+using testing::lines;
+using testing::make_sink;
+
+/* Testing Strategy:
+ *
+ * Flushing an AggregatingLoggerPIMPL is collective. The MPI test runs on
+ * however many ranks the tests were launched with, and since the ranks log
+ * concurrently it only checks which messages arrive. The ordering is tested
+ * with a thread-backed communicator, whose ranks log from the main thread one
+ * after the other, so their time stamps are known. Catch2's assertions are
+ * not thread-safe, so the threads only record results.
+ */
+TEST_CASE("AggregatingLoggerPIMPL") {
+    auto& world = testing::PZEnvironment::comm_world();
+    comm_type comm(world.mpi_comm());
+    const auto me = comm.me();
+    const auto n  = comm.size();
+
+    std::stringstream ss;
+
+    SECTION("Invalid root") {
+        using except_t = std::out_of_range;
+        REQUIRE_THROWS_AS(AggregatingLoggerPIMPL(comm, make_sink(ss), n),
+                          except_t);
+        REQUIRE_THROWS_AS(AggregatingLoggerPIMPL(comm, make_sink(ss), -1),
+                          except_t);
+    }
+
+    SECTION("Buffers until flushed") {
+        AggregatingLoggerPIMPL log(comm, make_sink(ss), 0);
+        log.log(severity::info, "Hello");
+        log.log(severity::debug, "Not logged");
+        REQUIRE(log.n_buffered() == 1);
+        REQUIRE(ss.str().empty());
+
+        log.flush();
+        REQUIRE(log.n_buffered() == 0);
+        if(me == 0) {
+            auto out = lines(ss.str());
+            std::sort(out.begin(), out.end());
+            std::vector<std::string> corr;
+            for(int r = 0; r < n; ++r)
+                corr.push_back("[info] [Rank " + std::to_string(r) +
+                               "] Hello");
+            std::sort(corr.begin(), corr.end());
+            REQUIRE(out == corr);
+        } else {
+            REQUIRE(ss.str().empty());
+        }
+    }
+
+    SECTION("Non-zero root") {
+        const auto root = n - 1;
+        AggregatingLoggerPIMPL log(comm, make_sink(ss), root);
+        log.set_severity(severity::debug);
+        log.log(severity::debug, "Hello");
+        log.flush();
+        if(me == root) {
+            REQUIRE(lines(ss.str()).size() == std::size_t(n));
+        } else {
+            REQUIRE(ss.str().empty());
+        }
+    }
+
+    SECTION("Nothing to flush") {
+        AggregatingLoggerPIMPL log(comm, make_sink(ss), 0);
+        log.flush();
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("Null sink") {
+        AggregatingLoggerPIMPL log(comm, nullptr, 0);
+        log.log(severity::info, "Hello");
+        REQUIRE_NOTHROW(log.flush());
+    }
+
+    SECTION("clone/are_equal") {
+        AggregatingLoggerPIMPL log(comm, make_sink(ss), 0);
+        auto copy = log.clone();
+        REQUIRE(copy->are_equal(log));
+
+        // Copies share the buffer
+        copy->log(severity::info, "Hello");
+        REQUIRE(log.n_buffered() == 1);
+        log.flush();
+
+        AggregatingLoggerPIMPL other(comm, make_sink(ss), 0);
+        REQUIRE_FALSE(other.are_equal(log));
+        REQUIRE_FALSE(log.are_equal(*make_sink(ss)));
+    }
+}
+
+TEST_CASE("AggregatingLoggerPIMPL (threaded)") {
+    const int n = 4;
+    auto comms  = comm_type::make_threaded(n);
+
+    std::stringstream ss;
+    std::vector<std::unique_ptr<AggregatingLoggerPIMPL>> logs;
+    for(int r = 0; r < n; ++r)
+        logs.emplace_back(
+          std::make_unique<AggregatingLoggerPIMPL>(comms[r], make_sink(ss), 0));
+
+    // Log from the last rank to the first, so time order is reverse rank order
+    for(int r = n - 1; r >= 0; --r) {
+        logs[r]->log(severity::warn, "Message " + std::to_string(r));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    logs[1]->log(severity::error, "Last");
+
+    std::vector<std::thread> threads;
+    for(int r = 0; r < n; ++r)
+        threads.emplace_back([&, r]() { logs[r]->flush(); });
+    for(auto& t : threads) t.join();
+
+    std::stringstream corr;
+    corr << "[warning] [Rank 3] Message 3" << std::endl;
+    corr << "[warning] [Rank 2] Message 2" << std::endl;
+    corr << "[warning] [Rank 1] Message 1" << std::endl;
+    corr << "[warning] [Rank 0] Message 0" << std::endl;
+    corr << "[error] [Rank 1] Last" << std::endl;
+    REQUIRE(ss.str() == corr.str());
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../catch.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <parallelzone/logging/detail_/async/async.hpp>
+#include <parallelzone/logging/detail_/spdlog/spdlog.hpp>
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace parallelzone::detail_;
+using policy_type = AsyncLoggerPIMPL::policy_type;
+using severity    = parallelzone::Logger::severity;
+
+namespace {
+
+/* A sink which records the messages it is given. While the gate is closed
+ * the background thread blocks in log_, which lets the tests fill the queue.
+ */
+struct GateState {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_open = true;
+    std::vector<std::string> m_msgs;
+    std::size_t m_n_flushes = 0;
+
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = false;
+    }
+
+    void open() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_open = true;
+        }
+        m_cv.notify_all();
+    }
+};
+
+class GatedSink : public LoggerPIMPL {
+public:
+    explicit GatedSink(std::shared_ptr<GateState> state) :
+      m_state_(std::move(state)) {}
+
+protected:
+    GatedSink(const GatedSink&) = default;
+
+    pimpl_ptr clone_() const override {
+        return std::unique_ptr<GatedSink>(new GatedSink(*this));
+    }
+    void set_severity_(severity_type) override {}
+    bool should_log_(severity_type) const noexcept override { return true; }
+    void log_(severity_type, const_string_reference msg) override {
+        std::unique_lock<std::mutex> lock(m_state_->m_mutex);
+        m_state_->m_cv.wait(lock, [this]() { return m_state_->m_open; });
+        m_state_->m_msgs.push_back(msg);
+    }
+    void flush_() override {
+        std::lock_guard<std::mutex> lock(m_state_->m_mutex);
+        ++m_state_->m_n_flushes;
+    }
+    bool are_equal_(const LoggerPIMPL& other) const noexcept override {
+        auto p = dynamic_cast<const GatedSink*>(&other);
+        return p != nullptr && p->m_state_ == m_state_;
+    }
+
+private:
+    std::shared_ptr<GateState> m_state_;
+};
+
+// Makes an async logger around a GatedSink using state
+auto make_gated(std::shared_ptr<GateState> state, std::size_t queue_size,
+                policy_type policy) {
+    auto sink = std::make_unique<GatedSink>(std::move(state));
+    return AsyncLoggerPIMPL(std::move(sink), queue_size, policy);
+}
+
+// The strings "0", "1", ..., "n-1"
+auto numbers(std::size_t begin, std::size_t end) {
+    std::vector<std::string> rv;
+    for(auto i = begin; i < end; ++i) rv.push_back(std::to_string(i));
+    return rv;
+}
+
+} // namespace
+
+/* Testing Strategy:
+ *
+ * Logging to an AsyncLoggerPIMPL returns before the message is written, so
+ * every test flushes (or destroys the logger) before looking at the sink.
+ * The overflow policies are tested by closing the gate on the sink, so that
+ * the background thread is stuck writing one message while the queue fills.
+ */
+TEST_CASE("AsyncLoggerPIMPL") {
+    auto state = std::make_shared<GateState>();
+
+    SECTION("writes through spdlog") {
+        std::stringstream ss;
+        auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+        auto spdlog_log = spdlog::logger("ss_log", sink);
+        spdlog_log.set_pattern("[%n] [%l] %v");
+        auto pimpl = std::make_unique<SpdlogPIMPL>(spdlog_log);
+
+        AsyncLoggerPIMPL log(std::move(pimpl), 8, policy_type::block);
+        log.log(severity::info, "Hello");
+        log.log(severity::debug, "Not logged");
+        log.set_severity(severity::debug);
+        log.log(severity::debug, "World");
+        log.flush();
+        REQUIRE(ss.str() == "[ss_log] [info] Hello\n[ss_log] [debug] World\n");
+    }
+
+    SECTION("flush") {
+        auto log = make_gated(state, 8, policy_type::block);
+        log.flush(); // Nothing to write
+        for(const auto& msg : numbers(0, 100)) log.log(severity::info, msg);
+        log.flush();
+        REQUIRE(state->m_msgs == numbers(0, 100));
+        REQUIRE(state->m_n_flushes == 1);
+    }
+
+    SECTION("dtor writes queued messages") {
+        {
+            auto log = make_gated(state, 64, policy_type::block);
+            for(const auto& msg : numbers(0, 50)) log.log(severity::warn, msg);
+        }
+        REQUIRE(state->m_msgs == numbers(0, 50));
+        REQUIRE(state->m_n_flushes == 1);
+    }
+
+    SECTION("many threads") {
+        auto log = make_gated(state, 4, policy_type::block);
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                for(const auto& msg : numbers(0, 250))
+                    log.log(severity::info, msg);
+            });
+        }
+        for(auto& t : threads) t.join();
+        log.flush();
+        REQUIRE(state->m_msgs.size() == 1000);
+        REQUIRE(log.n_dropped() == 0);
+    }
+
+    SECTION("block") {
+        auto log = make_gated(state, 2, policy_type::block);
+        state->close();
+        // Background thread takes "0" and blocks, "1" and "2" fill the queue
+        std::thread producer([&]() {
+            for(const auto& msg : numbers(0, 10)) log.log(severity::info, msg);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        state->open();
+        producer.join();
+        log.flush();
+        REQUIRE(state->m_msgs == numbers(0, 10));
+        REQUIRE(log.n_dropped() == 0);
+    }
+
+    SECTION("drop") {
+        auto log = make_gated(state, 2, policy_type::drop);
+        state->close();
+        log.log(severity::info, "0");
+        // Give the background thread time to take "0" off of the queue
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        for(const auto& msg : numbers(1, 10)) log.log(severity::info, msg);
+        state->open();
+        log.flush();
+        REQUIRE(state->m_msgs == numbers(0, 3));
+        REQUIRE(log.n_dropped() == 7);
+    }
+
+    SECTION("overwrite") {
+        auto log = make_gated(state, 2, policy_type::overwrite);
+        state->close();
+        log.log(severity::info, "0");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        for(const auto& msg : numbers(1, 10)) log.log(severity::info, msg);
+        state->open();
+        log.flush();
+        REQUIRE(state->m_msgs == std::vector<std::string>{"0", "8", "9"});
+        REQUIRE(log.n_dropped() == 7);
+    }
+
+    SECTION("clone/are_equal") {
+        auto log  = make_gated(state, 2, policy_type::block);
+        auto copy = log.clone();
+        REQUIRE(copy->are_equal(log));
+
+        // Different backend
+        auto other = make_gated(state, 2, policy_type::block);
+        REQUIRE_FALSE(other.are_equal(log));
+
+        // Not an AsyncLoggerPIMPL
+        GatedSink sink(state);
+        REQUIRE_FALSE(log.are_equal(sink));
+    }
+}
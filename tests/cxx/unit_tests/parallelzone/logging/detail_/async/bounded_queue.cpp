@@ -0,0 +1,127 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../catch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <parallelzone/logging/detail_/async/bounded_queue.hpp>
+#include <thread>
+#include <vector>
+
+using namespace parallelzone::detail_;
+
+/* Testing Strategy:
+ *
+ * The single-threaded tests check the queue's bookkeeping. The multi-threaded
+ * test has several producers and consumers hammer on a small queue and checks
+ * that every element comes out exactly once. Catch2's assertions are not
+ * thread-safe, so the threads only record what they pop.
+ */
+
+TEST_CASE("BoundedQueue") {
+    using queue_type = BoundedQueue<int>;
+
+    SECTION("capacity") {
+        REQUIRE(queue_type(0).capacity() == 2);
+        REQUIRE(queue_type(2).capacity() == 2);
+        REQUIRE(queue_type(3).capacity() == 4);
+        REQUIRE(queue_type(1000).capacity() == 1024);
+    }
+
+    SECTION("push/pop") {
+        queue_type q(4);
+        REQUIRE(q.empty());
+        REQUIRE(q.n_pushed() == 0);
+
+        int value = 0;
+        REQUIRE_FALSE(q.try_pop(value));
+
+        for(int i = 0; i < 4; ++i) {
+            int x = i + 1;
+            REQUIRE(q.try_push(x));
+        }
+        REQUIRE_FALSE(q.empty());
+        REQUIRE(q.n_pushed() == 4);
+
+        // Full, the value isn't consumed
+        int x = 42;
+        REQUIRE_FALSE(q.try_push(x));
+        REQUIRE(x == 42);
+
+        // First in, first out
+        for(int i = 0; i < 4; ++i) {
+            REQUIRE(q.try_pop(value));
+            REQUIRE(value == i + 1);
+        }
+        REQUIRE(q.empty());
+
+        // Wraps around
+        REQUIRE(q.try_push(x));
+        REQUIRE(q.try_pop(value));
+        REQUIRE(value == 42);
+        REQUIRE(q.n_pushed() == 5);
+    }
+
+    SECTION("concurrent producers and consumers") {
+        const int n_producers = 4;
+        const int n_consumers = 3;
+        const int n_per       = 10000;
+        queue_type q(16);
+
+        std::vector<std::vector<int>> popped(n_consumers);
+        std::vector<std::thread> threads;
+        for(int p = 0; p < n_producers; ++p) {
+            threads.emplace_back([&, p]() {
+                for(int i = 0; i < n_per; ++i) {
+                    int x = p * n_per + i;
+                    while(!q.try_push(x)) std::this_thread::yield();
+                }
+            });
+        }
+        std::atomic<int> n_popped{0};
+        for(int c = 0; c < n_consumers; ++c) {
+            threads.emplace_back([&, c]() {
+                int x;
+                while(n_popped.load() < n_producers * n_per) {
+                    if(q.try_pop(x)) {
+                        popped[c].push_back(x);
+                        ++n_popped;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for(auto& t : threads) t.join();
+
+        std::vector<int> all;
+        for(const auto& v : popped) all.insert(all.end(), v.begin(), v.end());
+        std::sort(all.begin(), all.end());
+        std::vector<int> corr(n_producers * n_per);
+        for(int i = 0; i < n_producers * n_per; ++i) corr[i] = i;
+        REQUIRE(all == corr);
+
+        // Each producer's elements come out in the order they went in
+        for(const auto& v : popped) {
+            std::vector<int> last(n_producers, -1);
+            bool in_order = true;
+            for(auto x : v) {
+                in_order = in_order && x > last[x / n_per];
+                last[x / n_per] = x;
+            }
+            REQUIRE(in_order);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../test_parallelzone.hpp"
+#include <filesystem>
+#include <fstream>
+#include <parallelzone/logging/detail_/binary/binary_file.hpp>
+#include <parallelzone/logging/detail_/binary/binary_format.hpp>
+#include <parallelzone/logging/detail_/spdlog/stdout.hpp>
+
+using namespace parallelzone;
+using namespace parallelzone::detail_;
+using severity = Logger::severity;
+
+namespace {
+
+// Reads the bytes of file_name
+std::string read_file(const std::string& file_name) {
+    std::ifstream is(file_name, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(is), {});
+}
+
+} // namespace
+
+/* Testing Strategy:
+ *
+ * The records are decoded (and hence tested more thoroughly) by the tests of
+ * decode_binary_logs. Here we check the header, that templates are only
+ * written once, and the LoggerPIMPL API.
+ */
+TEST_CASE("BinaryFilePIMPL") {
+    namespace fs = std::filesystem;
+
+    // Every rank runs this test, so each needs its own file
+    auto& world     = testing::PZEnvironment::comm_world();
+    const auto me   = mpi_helpers::CommPP(world.mpi_comm()).me();
+    const auto file = (fs::temp_directory_path() /
+                       ("pz_binary_file_" + std::to_string(me) + ".pzlog"))
+                        .string();
+
+    SECTION("Header") {
+        { BinaryFilePIMPL log(file, 42); }
+        const auto bytes = read_file(file);
+        REQUIRE(bytes.size() == 8 + 4 + 8);
+        REQUIRE(bytes.substr(0, 8) == "PZBINLOG");
+        std::uint64_t rank;
+        std::memcpy(&rank, bytes.data() + 12, sizeof(rank));
+        REQUIRE(rank == 42);
+    }
+
+    SECTION("Templates are written once") {
+        {
+            Logger log(std::make_unique<BinaryFilePIMPL>(file, 0));
+            for(int i = 0; i < 100; ++i)
+                log.log(severity::info, "A long message template {}", i);
+        }
+        const auto bytes = read_file(file);
+        std::string fmt("A long message template {}");
+        REQUIRE(bytes.find(fmt) != std::string::npos);
+        REQUIRE(bytes.find(fmt, bytes.find(fmt) + 1) == std::string::npos);
+    }
+
+    SECTION("Threshold") {
+        {
+            BinaryFilePIMPL log(file, 0);
+            REQUIRE(log.should_log(severity::info));
+            REQUIRE_FALSE(log.should_log(severity::debug));
+            log.log(severity::debug, "Not logged");
+            log.set_severity(severity::trace);
+            REQUIRE(log.should_log(severity::trace));
+        }
+        REQUIRE(read_file(file).size() == 8 + 4 + 8);
+    }
+
+    SECTION("clone/are_equal") {
+        BinaryFilePIMPL log(file, 0);
+        REQUIRE(log.clone()->are_equal(log));
+
+        const auto file2 = file + ".2";
+        {
+            BinaryFilePIMPL other(file2, 0);
+            REQUIRE_FALSE(other.are_equal(log));
+        }
+        fs::remove(file2);
+
+        StdoutSpdlog stdout_log("stdout");
+        REQUIRE_FALSE(log.are_equal(stdout_log));
+    }
+
+    SECTION("Can't open the file") {
+        const auto bad = (fs::temp_directory_path() / "not_a_dir" / "a")
+                           .string();
+        REQUIRE_THROWS_AS(BinaryFilePIMPL(bad, 0), std::runtime_error);
+    }
+
+    fs::remove(file);
+}
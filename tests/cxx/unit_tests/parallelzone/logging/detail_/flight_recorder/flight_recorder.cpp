@@ -0,0 +1,199 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../catch.hpp"
+#include "../../../test_logging.hpp"
+#include <atomic>
+#include <csignal>
+#include <parallelzone/logging/detail_/flight_recorder/flight_recorder.hpp>
+#include <signal.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace parallelzone::detail_;
+using severity = parallelzone::Logger::severity;
+using testing::make_sink;
+
+/* Testing Strategy:
+ *
+ * The threads in the "Per-thread rings" section log one after the other, so
+ * the numbers the recorder gives them are known. Catch2's assertions are not
+ * thread-safe, so the threads only log.
+ *
+ * The signal handler writes to standard error, which we do not capture. We
+ * only check that raising a handled, non-fatal signal returns and leaves the
+ * kept messages alone.
+ */
+TEST_CASE("FlightRecorderPIMPL") {
+    std::stringstream ss;
+    const std::string tag = "[Flight recorder, thread 0] ";
+
+    SECTION("Ctor") {
+        using except_t = std::out_of_range;
+        REQUIRE_THROWS_AS(FlightRecorderPIMPL(make_sink(ss), 0, severity::info),
+                          except_t);
+
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        REQUIRE(log.n_records() == 3);
+        REQUIRE(log.n_kept() == 0);
+        REQUIRE(log.should_log(severity::trace));
+    }
+
+    SECTION("Keeps the most recent messages") {
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        for(int i = 0; i < 5; ++i)
+            log.log(severity::trace, "Message " + std::to_string(i));
+        REQUIRE(log.n_kept() == 3);
+        REQUIRE(ss.str().empty());
+
+        log.dump();
+        REQUIRE(log.n_kept() == 0);
+        std::stringstream corr;
+        for(int i = 2; i < 5; ++i)
+            corr << "[trace] " << tag << "Message " << i << std::endl;
+        REQUIRE(ss.str() == corr.str());
+    }
+
+    SECTION("Severe messages dump") {
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::warn);
+        log.log(severity::debug, "Before");
+        log.log(severity::warn, "Oops");
+        REQUIRE(log.n_kept() == 0);
+
+        std::stringstream corr;
+        corr << "[debug] " << tag << "Before" << std::endl;
+        corr << "[warning] " << tag << "Oops" << std::endl;
+        REQUIRE(ss.str() == corr.str());
+    }
+
+    SECTION("Threshold") {
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        log.set_severity(severity::info);
+        REQUIRE_FALSE(log.should_log(severity::debug));
+        log.log(severity::debug, "Not kept");
+        REQUIRE(log.n_kept() == 0);
+        log.log(severity::info, "Kept");
+        REQUIRE(log.n_kept() == 1);
+    }
+
+    SECTION("flush") {
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        log.log(severity::info, "Hello");
+        log.flush();
+        REQUIRE(ss.str().empty());
+        REQUIRE(log.n_kept() == 1);
+
+        log.dump();
+        REQUIRE(ss.str() == "[info] " + tag + "Hello\n");
+    }
+
+    SECTION("Per-thread rings") {
+        FlightRecorderPIMPL log(make_sink(ss), 2, severity::critical);
+        log.log(severity::info, "Main 0");
+
+        // The threads stay alive until both logged, so their ids differ
+        std::atomic<int> n_done = 0;
+        std::atomic<bool> done  = false;
+        std::vector<std::thread> threads;
+        for(int t = 1; t < 3; ++t) {
+            threads.emplace_back([&, t]() {
+                for(int i = 0; i < 3; ++i)
+                    log.log(severity::info, "Thread " + std::to_string(t));
+                ++n_done;
+                while(!done) std::this_thread::yield();
+            });
+            while(n_done < t) std::this_thread::yield();
+        }
+        done = true;
+        for(auto& thread : threads) thread.join();
+        log.log(severity::info, "Main 1");
+        REQUIRE(log.n_kept() == 6);
+
+        log.dump();
+        std::stringstream corr;
+        corr << "[info] " << tag << "Main 0" << std::endl;
+        for(int t = 1; t < 3; ++t)
+            for(int i = 0; i < 2; ++i)
+                corr << "[info] [Flight recorder, thread " << t << "] Thread "
+                     << t << std::endl;
+        corr << "[info] " << tag << "Main 1" << std::endl;
+        REQUIRE(ss.str() == corr.str());
+    }
+
+    SECTION("Rings of exited threads are reused") {
+        FlightRecorderPIMPL log(make_sink(ss), 2, severity::critical);
+        auto log_from_thread = [&](const std::string& msg) {
+            std::thread([&]() { log.log(severity::info, msg); }).join();
+        };
+
+        // The first ring still holds a message, so the second thread gets a
+        // new one. Once dumped, the first ring is free again.
+        log_from_thread("First");
+        log_from_thread("Second");
+        log.dump();
+        log_from_thread("Third");
+        log.dump();
+        REQUIRE(ss.str() == "[info] [Flight recorder, thread 0] First\n"
+                            "[info] [Flight recorder, thread 1] Second\n"
+                            "[info] [Flight recorder, thread 0] Third\n");
+    }
+
+    SECTION("Null sink") {
+        FlightRecorderPIMPL log(nullptr, 3, severity::error);
+        log.log(severity::info, "Goes to standard error");
+        REQUIRE_NOTHROW(log.dump());
+        REQUIRE(log.n_kept() == 0);
+    }
+
+    SECTION("dump_all") {
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        log.log(severity::info, "Hello");
+        FlightRecorderPIMPL::dump_all();
+        REQUIRE(ss.str() == "[info] " + tag + "Hello\n");
+    }
+
+    SECTION("install_signal_handler") {
+        struct sigaction old {};
+        sigaction(SIGUSR1, nullptr, &old);
+
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        log.log(severity::info, "Hello");
+        FlightRecorderPIMPL::install_signal_handler(SIGUSR1);
+        std::raise(SIGUSR1);
+        REQUIRE(log.n_kept() == 1);
+        REQUIRE(ss.str().empty());
+
+        sigaction(SIGUSR1, &old, nullptr);
+        REQUIRE_THROWS_AS(FlightRecorderPIMPL::install_signal_handler(-1),
+                          std::runtime_error);
+    }
+
+    SECTION("clone/are_equal") {
+        FlightRecorderPIMPL log(make_sink(ss), 3, severity::error);
+        auto copy = log.clone();
+        REQUIRE(copy->are_equal(log));
+
+        // Copies share the rings, but not the threshold
+        copy->set_severity(severity::info);
+        REQUIRE(log.should_log(severity::trace));
+        copy->log(severity::info, "Hello");
+        REQUIRE(log.n_kept() == 1);
+
+        FlightRecorderPIMPL other(make_sink(ss), 3, severity::error);
+        REQUIRE_FALSE(other.are_equal(log));
+        REQUIRE_FALSE(log.are_equal(*make_sink(ss)));
+    }
+}
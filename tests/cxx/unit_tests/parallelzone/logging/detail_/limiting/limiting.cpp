@@ -0,0 +1,174 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../catch.hpp"
+#include "../../../test_logging.hpp"
+#include <chrono>
+#include <parallelzone/logging/detail_/limiting/limiting.hpp>
+#include <sstream>
+#include <thread>
+
+using namespace parallelzone::detail_;
+using limits_type = LimitingLoggerPIMPL::limits_type;
+using severity    = parallelzone::Logger::severity;
+using testing::make_sink;
+
+namespace {
+
+// Limits allowing n messages per site per hour
+limits_type per_hour(std::size_t n) {
+    limits_type limits;
+    limits.max_per_interval = n;
+    limits.interval         = std::chrono::hours(1);
+    return limits;
+}
+
+} // namespace
+
+TEST_CASE("LimitingLoggerPIMPL") {
+    std::stringstream ss;
+
+    SECTION("Ctor") {
+        limits_type limits;
+        limits.rank_stride = 0;
+        using except_t     = std::out_of_range;
+        REQUIRE_THROWS_AS(LimitingLoggerPIMPL(make_sink(ss), 0, limits),
+                          except_t);
+
+        // Takes the sink's threshold (spdlog's default is info)
+        LimitingLoggerPIMPL log(make_sink(ss), 0, limits_type{});
+        REQUIRE(log.sampled());
+        REQUIRE(log.should_log(severity::info));
+        REQUIRE_FALSE(log.should_log(severity::debug));
+    }
+
+    SECTION("No limits") {
+        LimitingLoggerPIMPL log(make_sink(ss), 3, limits_type{});
+        for(int i = 0; i < 3; ++i) log.log(severity::info, "Hello");
+        log.log(severity::debug, "Not logged");
+        REQUIRE(ss.str() == "[info] Hello\n[info] Hello\n[info] Hello\n");
+        REQUIRE(log.n_suppressed() == 0);
+    }
+
+    SECTION("Rank stride") {
+        limits_type limits;
+        limits.rank_stride = 2;
+        REQUIRE(LimitingLoggerPIMPL(make_sink(ss), 4, limits).sampled());
+
+        LimitingLoggerPIMPL log(make_sink(ss), 3, limits);
+        REQUIRE_FALSE(log.sampled());
+        log.log(severity::info, "Hello");
+        log.log(severity::warn, "World");
+        REQUIRE(ss.str().empty());
+        REQUIRE(log.n_suppressed() == 2);
+
+        log.flush();
+        REQUIRE(ss.str() ==
+                "[warning] Suppressed 2 messages, rank 3 is not sampled\n");
+        REQUIRE(log.n_suppressed() == 0);
+    }
+
+    SECTION("Rank set") {
+        limits_type limits;
+        limits.rank_stride = 2;
+        limits.ranks       = {1, 3};
+        REQUIRE(LimitingLoggerPIMPL(make_sink(ss), 3, limits).sampled());
+        REQUIRE_FALSE(LimitingLoggerPIMPL(make_sink(ss), 2, limits).sampled());
+    }
+
+    SECTION("Severe messages are written by every rank") {
+        limits_type limits;
+        limits.rank_stride = 2;
+        LimitingLoggerPIMPL log(make_sink(ss), 3, limits);
+        log.log(severity::warn, "Hidden");
+        log.log(severity::error, "Failed");
+        log.log(severity::critical, "Aborting");
+        REQUIRE(ss.str() == "[error] Failed\n[critical] Aborting\n");
+        REQUIRE(log.n_suppressed() == 1);
+
+        // The threshold is configurable, and severe messages are still rate
+        // limited
+        ss.str("");
+        limits.all_ranks_severity = severity::warn;
+        limits.max_per_interval   = 1;
+        limits.interval           = std::chrono::hours(1);
+        LimitingLoggerPIMPL log2(make_sink(ss), 3, limits);
+        log2.log(severity::info, "Hidden");
+        log2.log(severity::warn, "Shown");
+        log2.log(severity::warn, "Shown");
+        REQUIRE(ss.str() == "[warning] Shown\n");
+        REQUIRE(log2.n_suppressed() == 2);
+    }
+
+    SECTION("Rate limit") {
+        LimitingLoggerPIMPL log(make_sink(ss), 0, per_hour(2));
+        for(int i = 0; i < 5; ++i) log.log(severity::info, "Same");
+        log.log(severity::info, "Other");
+        REQUIRE(ss.str() == "[info] Same\n[info] Same\n[info] Other\n");
+        REQUIRE(log.n_suppressed() == 3);
+
+        ss.str("");
+        log.flush();
+        REQUIRE(ss.str() == "[info] Suppressed 3 messages like: Same\n");
+
+        // Still in the same window
+        ss.str("");
+        log.log(severity::info, "Same");
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("Templates are call sites") {
+        LimitingLoggerPIMPL log(make_sink(ss), 0, per_hour(1));
+        for(int i = 0; i < 3; ++i) {
+            PackedArgs args;
+            args.push_back(i);
+            log.log(i == 2 ? severity::error : severity::info, "Step {}",
+                    args);
+        }
+        REQUIRE(ss.str() == "[info] Step 0\n");
+
+        ss.str("");
+        log.flush();
+        REQUIRE(ss.str() == "[error] Suppressed 2 messages like: Step {}\n");
+    }
+
+    SECTION("Windows reset") {
+        limits_type limits;
+        limits.max_per_interval = 1;
+        limits.interval         = std::chrono::milliseconds(1);
+        LimitingLoggerPIMPL log(make_sink(ss), 0, limits);
+        log.log(severity::info, "Hello");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        log.log(severity::info, "Hello");
+        REQUIRE(ss.str() == "[info] Hello\n[info] Hello\n");
+    }
+
+    SECTION("clone/are_equal") {
+        LimitingLoggerPIMPL log(make_sink(ss), 0, per_hour(1));
+        auto copy = log.clone();
+        REQUIRE(copy->are_equal(log));
+
+        // Copies share the counts, but not the threshold
+        copy->set_severity(severity::trace);
+        REQUIRE_FALSE(log.should_log(severity::trace));
+        log.log(severity::info, "Hello");
+        copy->log(severity::info, "Hello");
+        REQUIRE(log.n_suppressed() == 1);
+
+        LimitingLoggerPIMPL other(make_sink(ss), 0, per_hour(1));
+        REQUIRE_FALSE(other.are_equal(log));
+        REQUIRE_FALSE(log.are_equal(*make_sink(ss)));
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../catch.hpp"
+#include <parallelzone/logging/detail_/packed_args.hpp>
+#include <variant>
+
+using namespace parallelzone::detail_;
+
+namespace {
+
+// A type which is only printable with operator<<
+struct Point {
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& os, const Point& p) {
+    return os << "(" << p.x << ", " << p.y << ")";
+}
+
+} // namespace
+
+TEST_CASE("PackedArgs") {
+    PackedArgs args;
+
+    SECTION("Empty") {
+        REQUIRE(args.size() == 0);
+        REQUIRE(args.data().empty());
+        REQUIRE(args.format("Hello {}") == "Hello {}");
+    }
+
+    SECTION("push_back/visit") {
+        using value_type = std::variant<std::int64_t, std::uint64_t, double,
+                                        bool, char, std::string>;
+        args.push_back(-1);
+        args.push_back(2u);
+        args.push_back(3.5f);
+        args.push_back(true);
+        args.push_back('c');
+        args.push_back("literal");
+        args.push_back(std::string("string"));
+        args.push_back(Point{1, 2});
+        REQUIRE(args.size() == 8);
+
+        std::vector<value_type> values;
+        const auto* begin = args.data().data();
+        PackedArgs::visit(begin, begin + args.data().size(),
+                          [&](const auto& value) {
+                              using T = std::decay_t<decltype(value)>;
+                              if constexpr(std::is_same_v<T, std::string_view>)
+                                  values.emplace_back(std::string(value));
+                              else
+                                  values.emplace_back(value);
+                          });
+        std::vector<value_type> corr{std::int64_t(-1), std::uint64_t(2),
+                                     3.5,              true,
+                                     'c',              std::string("literal"),
+                                     std::string("string"),
+                                     std::string("(1, 2)")};
+        REQUIRE(values == corr);
+    }
+
+    SECTION("format") {
+        args.push_back(1);
+        args.push_back(2.5);
+        args.push_back("three");
+        REQUIRE(args.format("{} {} {}") == "1 2.5 three");
+        REQUIRE(args.format("{}, {}, {}, {}") == "1, 2.5, three, {}");
+        REQUIRE(args.format("{} only") == "1 only");
+        REQUIRE(args.format("none") == "none");
+    }
+
+    SECTION("Corrupted") {
+        args.push_back(std::string("Hello"));
+        const auto* begin = args.data().data();
+        const auto* end   = begin + args.data().size();
+        using except_t    = std::runtime_error;
+
+        // Truncated
+        REQUIRE_THROWS_AS(PackedArgs::format("{}", begin, end - 1), except_t);
+
+        // Unknown tag
+        std::byte bad[] = {std::byte(255)};
+        REQUIRE_THROWS_AS(PackedArgs::format("{}", bad, bad + 1), except_t);
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../catch.hpp"
+#include "../../../test_logging.hpp"
+#include <algorithm>
+#include <parallelzone/logging/detail_/per_thread/per_thread.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace parallelzone::detail_;
+using severity = parallelzone::Logger::severity;
+using testing::lines;
+using testing::make_sink;
+
+/* Testing Strategy:
+ *
+ * The background thread may write at any time, so the tests only look at
+ * the output after a flush. Catch2's assertions are not thread-safe, so the
+ * threads only log.
+ */
+TEST_CASE("PerThreadLoggerPIMPL") {
+    std::stringstream ss;
+
+    SECTION("Threshold") {
+        PerThreadLoggerPIMPL log(make_sink(ss), 4);
+        REQUIRE(log.should_log(severity::info));
+        REQUIRE_FALSE(log.should_log(severity::debug));
+        log.set_severity(severity::debug);
+        REQUIRE(log.should_log(severity::debug));
+    }
+
+    SECTION("Logs on flush") {
+        PerThreadLoggerPIMPL log(make_sink(ss), 4);
+        log.log(severity::info, "Hello");
+        log.log(severity::debug, "Not logged");
+        log.log(severity::warn, "World");
+        log.flush();
+        REQUIRE(ss.str() == "[info] Hello\n[warning] World\n");
+        REQUIRE(log.backend().n_buffered() == 0);
+        REQUIRE(log.backend().n_buffers() == 1);
+    }
+
+    SECTION("Full buffers wait for the consumer") {
+        PerThreadLoggerPIMPL log(make_sink(ss), 2);
+        for(int i = 0; i < 100; ++i)
+            log.log(severity::info, std::to_string(i));
+        log.flush();
+        std::vector<std::string> corr;
+        for(int i = 0; i < 100; ++i)
+            corr.push_back("[info] " + std::to_string(i));
+        REQUIRE(lines(ss.str()) == corr);
+    }
+
+    SECTION("Many threads") {
+        const int n_threads = 4;
+        const int n_per     = 500;
+        PerThreadLoggerPIMPL log(make_sink(ss), 16);
+        std::vector<std::thread> threads;
+        for(int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for(int i = 0; i < n_per; ++i)
+                    log.log(severity::info, std::to_string(t * n_per + i));
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        log.flush();
+
+        auto out = lines(ss.str());
+        REQUIRE(out.size() == std::size_t(n_threads * n_per));
+
+        // Every message arrives once, and each thread's arrive in order
+        std::vector<int> last(n_threads, -1);
+        std::vector<int> all;
+        bool in_order = true;
+        for(const auto& line : out) {
+            const auto x    = std::stoi(line.substr(7));
+            in_order        = in_order && x > last[x / n_per];
+            last[x / n_per] = x;
+            all.push_back(x);
+        }
+        REQUIRE(in_order);
+        std::sort(all.begin(), all.end());
+        std::vector<int> corr(n_threads * n_per);
+        for(int i = 0; i < n_threads * n_per; ++i) corr[i] = i;
+        REQUIRE(all == corr);
+    }
+
+    SECTION("Buffers of exited threads are reused") {
+        PerThreadLoggerPIMPL log(make_sink(ss), 4);
+        for(int t = 0; t < 3; ++t) {
+            std::thread([&, t]() {
+                log.log(severity::info, std::to_string(t));
+            }).join();
+        }
+        log.flush();
+        REQUIRE(ss.str() == "[info] 0\n[info] 1\n[info] 2\n");
+        REQUIRE(log.backend().n_buffers() == 1);
+    }
+
+    SECTION("Written when destroyed") {
+        {
+            PerThreadLoggerPIMPL log(make_sink(ss), 4);
+            log.log(severity::info, "Hello");
+        }
+        REQUIRE(ss.str() == "[info] Hello\n");
+    }
+
+    SECTION("clone/are_equal") {
+        PerThreadLoggerPIMPL log(make_sink(ss), 4);
+        auto copy = log.clone();
+        REQUIRE(copy->are_equal(log));
+
+        // Copies share the buffers, but not the threshold
+        copy->set_severity(severity::trace);
+        REQUIRE_FALSE(log.should_log(severity::trace));
+        copy->log(severity::trace, "Hello");
+        log.flush();
+        REQUIRE(ss.str() == "[trace] Hello\n");
+
+        PerThreadLoggerPIMPL other(make_sink(ss), 4);
+        REQUIRE_FALSE(other.are_equal(log));
+        REQUIRE_FALSE(log.are_equal(*make_sink(ss)));
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../catch.hpp"
+#include <parallelzone/logging/detail_/per_thread/spsc_ring.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace parallelzone::detail_;
+
+/* Testing Strategy:
+ *
+ * The single-threaded tests check the ring's bookkeeping and that elements
+ * are swapped, not copied. The multi-threaded test has one producer and one
+ * consumer hammer on a small ring and checks that the elements come out in
+ * order. Catch2's assertions are not thread-safe, so the consumer only
+ * records what it pops.
+ */
+
+TEST_CASE("SpscRing") {
+    using ring_type = SpscRing<int>;
+
+    SECTION("capacity") {
+        REQUIRE(ring_type(0).capacity() == 2);
+        REQUIRE(ring_type(2).capacity() == 2);
+        REQUIRE(ring_type(3).capacity() == 4);
+        REQUIRE(ring_type(1000).capacity() == 1024);
+    }
+
+    SECTION("push/pop") {
+        ring_type q(4);
+        REQUIRE(q.empty());
+
+        int value = 0;
+        REQUIRE_FALSE(q.try_pop(value));
+
+        for(int i = 0; i < 4; ++i) {
+            int x = i + 1;
+            REQUIRE(q.try_push(x));
+        }
+        REQUIRE(q.size() == 4);
+
+        // Full, the value isn't consumed
+        int x = 42;
+        REQUIRE_FALSE(q.try_push(x));
+        REQUIRE(x == 42);
+
+        // First in, first out
+        for(int i = 0; i < 4; ++i) {
+            REQUIRE(q.try_pop(value));
+            REQUIRE(value == i + 1);
+        }
+        REQUIRE(q.empty());
+
+        // Wraps around
+        REQUIRE(q.try_push(x));
+        REQUIRE(q.try_pop(value));
+        REQUIRE(value == 42);
+    }
+
+    SECTION("elements are swapped") {
+        SpscRing<std::string> q(2);
+        std::string value = "Hello";
+        REQUIRE(q.try_push(value));
+        REQUIRE(value.empty()); // The cell's default value
+
+        value = "Stale";
+        REQUIRE(q.try_pop(value));
+        REQUIRE(value == "Hello");
+
+        // The popped cell now holds "Stale", which the next lap gets back
+        value = "World";
+        REQUIRE(q.try_push(value));
+        REQUIRE(q.try_pop(value));
+        value = "Again";
+        REQUIRE(q.try_push(value));
+        REQUIRE(value == "Stale");
+    }
+
+    SECTION("concurrent producer and consumer") {
+        const int n = 100000;
+        ring_type q(16);
+
+        std::thread producer([&]() {
+            for(int i = 0; i < n; ++i) {
+                int x = i;
+                while(!q.try_push(x)) std::this_thread::yield();
+            }
+        });
+
+        std::vector<int> popped;
+        popped.reserve(n);
+        int x;
+        while(int(popped.size()) < n) {
+            if(q.try_pop(x)) {
+                popped.push_back(x);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        std::vector<int> corr(n);
+        for(int i = 0; i < n; ++i) corr[i] = i;
+        REQUIRE(popped == corr);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../test_logging.hpp"
+#include <filesystem>
+#include <parallelzone/logging/detail_/spdlog/file.hpp>
+#include <parallelzone/logging/detail_/spdlog/rotating_file.hpp>
+
+using namespace parallelzone::detail_;
+
+using severity = parallelzone::Logger::severity;
+
+TEST_CASE("RotatingFileSpdlog") {
+    namespace fs = std::filesystem;
+
+    const auto dir = testing::per_rank_temp_dir("pz_rotating_file");
+    fs::create_directories(dir);
+    const auto file = (dir / "log.txt").string();
+
+    {
+        RotatingFileSpdlog log("log", file, 256, 2);
+
+        SECTION("clone") { REQUIRE(log.clone()->are_equal(log)); }
+
+        SECTION("are_equal") {
+            // Same
+            REQUIRE(log.are_equal(RotatingFileSpdlog("log", file, 256, 2)));
+
+            // Different names
+            RotatingFileSpdlog log2("2", file, 256, 2);
+            REQUIRE_FALSE(log.are_equal(log2));
+
+            // Different files
+            const auto file2 = (dir / "log2.txt").string();
+            RotatingFileSpdlog log3("log", file2, 256, 2);
+            REQUIRE_FALSE(log.are_equal(log3));
+
+            // Different derived class
+            FileSpdlog other("log", file);
+            REQUIRE_FALSE(log.are_equal(other));
+            REQUIRE_FALSE(other.are_equal(log));
+        }
+
+        SECTION("rotates") {
+            const std::string msg(100, 'x');
+            for(int i = 0; i < 20; ++i) log.log(severity::info, msg);
+            log.flush();
+
+            REQUIRE(fs::exists(dir / "log.txt"));
+            REQUIRE(fs::exists(dir / "log.1.txt"));
+            REQUIRE(fs::exists(dir / "log.2.txt"));
+            REQUIRE_FALSE(fs::exists(dir / "log.3.txt"));
+            REQUIRE(fs::file_size(dir / "log.txt") <= 256);
+            REQUIRE(fs::file_size(dir / "log.1.txt") <= 256);
+        }
+    }
+    fs::remove_all(dir);
+}
@@ -25,6 +25,19 @@ using namespace parallelzone;
 using pimpl_type = detail_::SpdlogPIMPL;
 using severity   = Logger::severity;
 
+namespace {
+
+// Counts how many times it's printed
+struct PrintCounter {
+    int* m_n_printed;
+};
+
+std::ostream& operator<<(std::ostream& os, const PrintCounter& c) {
+    return os << ++(*c.m_n_printed);
+}
+
+} // namespace
+
 /* Testing Strategy:
  *
  * The Logger class has a lot of ways to log the same message. Rather than
@@ -234,6 +247,40 @@ TEST_CASE("Logger") {
         }
     }
 
+    SECTION("should_log") {
+        REQUIRE(log.should_log(severity::trace));
+        log.set_severity(severity::warn);
+        REQUIRE_FALSE(log.should_log(severity::info));
+        REQUIRE(log.should_log(severity::warn));
+        REQUIRE(log.should_log(severity::critical));
+        REQUIRE_FALSE(null.should_log(severity::critical));
+    }
+
+    SECTION("log (format)") {
+        int n_printed = 0;
+        auto plog = &(log.log(severity::info, "{} + {} = {}", 1, 2.5, "3.5"));
+        REQUIRE(plog == &log);
+        log.log(severity::info, "{}{} too few", 'a');
+        log.log(severity::info, "too many {}", 1, 2);
+        log.set_severity(severity::warn);
+        log.log(severity::info, "{}", PrintCounter{&n_printed});
+        REQUIRE_NOTHROW(null.log(severity::info, "{}", 1));
+
+        std::stringstream corr;
+        corr << "[ss_log] [info] 1 + 2.5 = 3.5" << std::endl;
+        corr << "[ss_log] [info] a{} too few" << std::endl;
+        corr << "[ss_log] [info] too many 1" << std::endl;
+        REQUIRE(ss.str() == corr.str());
+        REQUIRE(n_printed == 0); // Filtered messages aren't formatted
+    }
+
+    SECTION("flush") {
+        log.info("Hello");
+        REQUIRE_NOTHROW(log.flush());
+        REQUIRE(ss.str() == "[ss_log] [info] Hello\n");
+        REQUIRE_NOTHROW(null.flush());
+    }
+
     SECTION("swap") {
         Logger copy(log);
         log.swap(null);
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../test_logging.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <parallelzone/logging/detail_/spdlog/spdlog.hpp>
+#include <parallelzone/logging/logger_factory.hpp>
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+#include <thread>
+
+using namespace parallelzone;
+using policy_type = LoggerFactory::overflow_policy;
+
+TEST_CASE("LoggerFactory file loggers") {
+    namespace fs = std::filesystem;
+
+    const auto dir = testing::per_rank_temp_dir("pz_logger_factory");
+
+    SECTION("file_logger") {
+        fs::create_directories(dir);
+        const auto file = (dir / "log.txt").string();
+        {
+            auto log = LoggerFactory::file_logger(file);
+            REQUIRE(log != Logger());
+            log.info("Hello");
+        }
+        REQUIRE(fs::file_size(file) > 0);
+    }
+
+    SECTION("rank_file_logger") {
+        // Makes the directory
+        const auto sub_dir = (dir / "logs").string();
+        {
+            auto log = LoggerFactory::rank_file_logger(7, sub_dir, 128, 1);
+            for(int i = 0; i < 10; ++i) log.info(std::string(50, 'x'));
+        }
+        REQUIRE(fs::exists(dir / "logs" / "log.rank7.txt"));
+        REQUIRE(fs::exists(dir / "logs" / "log.rank7.1.txt"));
+        REQUIRE_FALSE(fs::exists(dir / "logs" / "log.rank7.2.txt"));
+    }
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("LoggerFactory::make_async") {
+    std::stringstream ss;
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%n] [%l] %v");
+    Logger log(std::make_unique<detail_::SpdlogPIMPL>(spdlog_log));
+
+    SECTION("Logs asynchronously") {
+        auto async = LoggerFactory::make_async(log);
+        REQUIRE(async != Logger());
+        REQUIRE(async != log);
+        async.info("Hello").debug("Not logged");
+        async.flush();
+        REQUIRE(ss.str() == "[ss_log] [info] Hello\n");
+    }
+
+    SECTION("Copies share the queue") {
+        auto async = LoggerFactory::make_async(log, 16, policy_type::drop);
+        Logger copy(async);
+        REQUIRE(copy == async);
+    }
+
+    SECTION("Null logger") {
+        REQUIRE(LoggerFactory::make_async(Logger()) == Logger());
+    }
+
+    SECTION("Throws if the queue can not hold anything") {
+        using except_t = std::out_of_range;
+        REQUIRE_THROWS_AS(LoggerFactory::make_async(log, 0), except_t);
+    }
+}
+
+TEST_CASE("LoggerFactory::make_per_thread") {
+    std::stringstream ss;
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%l] %v");
+    Logger log(std::make_unique<detail_::SpdlogPIMPL>(spdlog_log));
+
+    SECTION("Logs through per-thread buffers") {
+        auto per_thread = LoggerFactory::make_per_thread(log);
+        REQUIRE(per_thread != Logger());
+        std::thread t([&]() { per_thread.info("Hello"); });
+        t.join();
+        per_thread.flush();
+        REQUIRE(ss.str() == "[info] Hello\n");
+    }
+
+    SECTION("Null logger") {
+        REQUIRE(LoggerFactory::make_per_thread(Logger()) == Logger());
+    }
+
+    SECTION("Throws if the buffers can not hold anything") {
+        using except_t = std::out_of_range;
+        REQUIRE_THROWS_AS(LoggerFactory::make_per_thread(log, 0), except_t);
+    }
+}
+
+TEST_CASE("LoggerFactory::make_aggregating") {
+    auto& world = testing::PZEnvironment::comm_world();
+    mpi_helpers::CommPP comm(world.mpi_comm());
+    const auto me = comm.me();
+    const auto n  = comm.size();
+
+    std::stringstream ss;
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%l] %v");
+    Logger log(std::make_unique<detail_::SpdlogPIMPL>(spdlog_log));
+
+    SECTION("Aggregates on the root") {
+        auto agg = LoggerFactory::make_aggregating(comm, log);
+        REQUIRE(agg != Logger());
+        agg.debug("Not logged").info("Hello");
+        agg.flush();
+        const auto out     = ss.str();
+        const auto n_lines = std::count(out.begin(), out.end(), '\n');
+        REQUIRE(n_lines == (me == 0 ? n : 0));
+    }
+
+    SECTION("Throws if root is not in comm") {
+        using except_t = std::out_of_range;
+        REQUIRE_THROWS_AS(LoggerFactory::make_aggregating(comm, log, n),
+                          except_t);
+    }
+}
+
+TEST_CASE("LoggerFactory::make_limited") {
+    std::stringstream ss;
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%l] %v");
+    Logger log(std::make_unique<detail_::SpdlogPIMPL>(spdlog_log));
+
+    LoggerFactory::log_limits limits;
+    limits.max_per_interval = 1;
+    limits.interval         = std::chrono::hours(1);
+
+    SECTION("Rate limits") {
+        auto limited = LoggerFactory::make_limited(log, 0, limits);
+        REQUIRE(limited != Logger());
+        limited.info("Hello").info("Hello");
+        REQUIRE(ss.str() == "[info] Hello\n");
+        limited.flush();
+        REQUIRE(ss.str() ==
+                "[info] Hello\n[info] Suppressed 1 messages like: Hello\n");
+    }
+
+    SECTION("Samples ranks") {
+        limits.ranks = {1};
+        auto limited = LoggerFactory::make_limited(log, 0, limits);
+        limited.info("Hello");
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("Null logger") {
+        REQUIRE(LoggerFactory::make_limited(Logger(), 0, limits) == Logger());
+    }
+
+    SECTION("Throws if the stride is 0") {
+        limits.rank_stride = 0;
+        using except_t     = std::out_of_range;
+        REQUIRE_THROWS_AS(LoggerFactory::make_limited(log, 0, limits),
+                          except_t);
+        REQUIRE_THROWS_AS(LoggerFactory::make_limited(Logger(), 0, limits),
+                          except_t);
+    }
+}
+
+TEST_CASE("LoggerFactory::make_flight_recorder") {
+    std::stringstream ss;
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%l] %v");
+    Logger log(std::make_unique<detail_::SpdlogPIMPL>(spdlog_log));
+
+    const std::string tag = "[Flight recorder, thread 0] ";
+
+    SECTION("Dumps on error") {
+        auto fr = LoggerFactory::make_flight_recorder(log, 2);
+        REQUIRE(fr != Logger());
+        fr.trace("Dropped").trace("First").debug("Second");
+        REQUIRE(ss.str().empty());
+
+        fr.error("Oops");
+        std::stringstream corr;
+        corr << "[debug] " << tag << "Second" << std::endl;
+        corr << "[error] " << tag << "Oops" << std::endl;
+        REQUIRE(ss.str() == corr.str());
+    }
+
+    SECTION("Dump severity") {
+        auto fr = LoggerFactory::make_flight_recorder(log, 2,
+                                                      Logger::severity::warn);
+        fr.warn("Oops");
+        REQUIRE(ss.str() == "[warning] " + tag + "Oops\n");
+    }
+
+    SECTION("dump_flight_recorders") {
+        auto fr = LoggerFactory::make_flight_recorder(log);
+        fr.info("Hello");
+        LoggerFactory::dump_flight_recorders();
+        REQUIRE(ss.str() == "[info] " + tag + "Hello\n");
+    }
+
+    SECTION("Throws if no messages are kept") {
+        using except_t = std::out_of_range;
+        REQUIRE_THROWS_AS(LoggerFactory::make_flight_recorder(log, 0),
+                          except_t);
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/* Testing Notes
+ *
+ * To test that the macros compile away, this file raises the minimum level to
+ * warn before including macros.hpp. Nothing else included here may include
+ * macros.hpp first.
+ */
+#undef PARALLELZONE_MIN_LOG_LEVEL
+#define PARALLELZONE_MIN_LOG_LEVEL 3
+
+#include "../catch.hpp"
+#include <parallelzone/logging/detail_/spdlog/spdlog.hpp>
+#include <parallelzone/logging/macros.hpp>
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+
+using namespace parallelzone;
+using severity = Logger::severity;
+
+TEST_CASE("PZ_LOG_* macros") {
+    std::stringstream ss;
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%n] [%l] %v");
+    Logger log(std::make_unique<detail_::SpdlogPIMPL>(spdlog_log));
+    log.set_severity(severity::trace);
+
+    // Counts how many times the macro arguments are evaluated
+    int n_evaluated = 0;
+    auto next       = [&]() { return ++n_evaluated; };
+
+    SECTION("Compiled away below the minimum level") {
+        PZ_LOG_TRACE(log, "{}", next());
+        PZ_LOG_DEBUG(log, "{}", next());
+        PZ_LOG_INFO(log, "{}", next());
+        REQUIRE(n_evaluated == 0);
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("Filtered at runtime") {
+        log.set_severity(severity::critical);
+        PZ_LOG_WARN(log, "{}", next());
+        PZ_LOG_ERROR(log, "{}", next());
+        REQUIRE(n_evaluated == 0);
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("Logged") {
+        PZ_LOG_WARN(log, "Hello");
+        PZ_LOG_ERROR(log, "{} {}", "Hello", next());
+        PZ_LOG_CRITICAL(log, "{}", next());
+        REQUIRE(n_evaluated == 2);
+
+        std::stringstream corr;
+        corr << "[ss_log] [warning] Hello" << std::endl;
+        corr << "[ss_log] [error] Hello 1" << std::endl;
+        corr << "[ss_log] [critical] 2" << std::endl;
+        REQUIRE(ss.str() == corr.str());
+    }
+
+    SECTION("Null logger") {
+        Logger null;
+        PZ_LOG_CRITICAL(null, "{}", next());
+        REQUIRE(n_evaluated == 0);
+    }
+}
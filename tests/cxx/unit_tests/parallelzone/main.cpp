@@ -18,7 +18,10 @@
 #include "test_parallelzone.hpp"
 
 int main(int argc, char* argv[]) {
-    auto rt = parallelzone::runtime::RuntimeView(argc, argv);
+    // Some features (e.g., the progress thread) need a thread-safe MPI
+    using thread_level = parallelzone::runtime::RuntimeView::thread_level;
+    auto rt = parallelzone::runtime::RuntimeView(argc, argv,
+                                                 thread_level::multiple);
     testing::PZEnvironment::pcomm_world = &rt;
 
     int res = Catch::Session().run(argc, argv);
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <parallelzone/mpi_helpers/binary_buffer/binary_buffer.hpp>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+using namespace parallelzone::mpi_helpers;
+
+namespace {
+
+// Calls the calling thread made to the global operator new. Per thread, so
+// the background threads of other components are not counted.
+thread_local std::size_t t_n_allocations = 0;
+
+} // namespace
+
+// Counts allocations which bypass the pool, the stats can not see those
+void* operator new(std::size_t n) {
+    ++t_n_allocations;
+    if(auto* p = std::malloc(n == 0 ? 1 : n)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/* Testing Strategy:
+ *
+ * Apart from the "default pool" test case, the tests use their own pool so
+ * that the counters are not perturbed by other buffers in the program.
+ *
+ * Whether something is pooled is checked by counting the calls to the global
+ * operator new, which is replaced above for the whole test program.
+ */
+
+TEST_CASE("BufferPool") {
+    using size_type = BufferPool::size_type;
+    BufferPool pool;
+
+    SECTION("block_size") {
+        const auto min = BufferPool::min_block_size;
+        REQUIRE(BufferPool::block_size(0) == min);
+        REQUIRE(BufferPool::block_size(1) == min);
+        REQUIRE(BufferPool::block_size(min) == min);
+        REQUIRE(BufferPool::block_size(min + 1) == 2 * min);
+        REQUIRE(BufferPool::block_size(1000) == 1024);
+        const auto max = BufferPool::max_block_size;
+        REQUIRE(BufferPool::block_size(max) == max);
+        REQUIRE(BufferPool::block_size(max + 1) == max + 1);
+    }
+
+    SECTION("Initial state") {
+        auto stats = pool.stats();
+        REQUIRE(stats.n_acquires == 0);
+        REQUIRE(stats.n_hits == 0);
+        REQUIRE(stats.n_misses == 0);
+        REQUIRE(stats.n_releases == 0);
+        REQUIRE(stats.bytes_in_use == 0);
+        REQUIRE(stats.bytes_cached == 0);
+        REQUIRE(stats.peak_bytes_in_use == 0);
+        const auto max_cached = BufferPool::default_max_cached_bytes;
+        REQUIRE(pool.max_cached_bytes() == max_cached);
+    }
+
+    SECTION("acquire/release") {
+        auto p = pool.acquire(100);
+        REQUIRE(p != nullptr);
+        auto stats = pool.stats();
+        REQUIRE(stats.n_acquires == 1);
+        REQUIRE(stats.n_misses == 1);
+        REQUIRE(stats.bytes_in_use == 128);
+
+        pool.release(p, 100);
+        stats = pool.stats();
+        REQUIRE(stats.n_releases == 1);
+        REQUIRE(stats.bytes_in_use == 0);
+        REQUIRE(stats.bytes_cached == 128);
+        REQUIRE(stats.peak_bytes_in_use == 128);
+
+        // Same size class reuses the block
+        auto p2 = pool.acquire(128);
+        REQUIRE(p2 == p);
+        stats = pool.stats();
+        REQUIRE(stats.n_hits == 1);
+        REQUIRE(stats.n_misses == 1);
+        REQUIRE(stats.bytes_cached == 0);
+
+        // Different size class does not
+        auto p3 = pool.acquire(129);
+        REQUIRE(p3 != p2);
+        REQUIRE(pool.stats().n_misses == 2);
+
+        pool.release(p2, 128);
+        pool.release(p3, 129);
+        pool.release(nullptr, 10);
+        REQUIRE(pool.stats().n_releases == 3);
+    }
+
+    SECTION("Blocks larger than max_block_size are not cached") {
+        const auto n = BufferPool::max_block_size + 1;
+        auto p       = pool.acquire(n);
+        REQUIRE(pool.stats().bytes_in_use == n);
+        pool.release(p, n);
+        REQUIRE(pool.stats().bytes_cached == 0);
+    }
+
+    SECTION("Steady state has no misses") {
+        for(size_type i = 0; i < 3; ++i) {
+            if(i == 1) pool.reset_stats();
+            auto p0 = pool.acquire(1000);
+            auto p1 = pool.acquire(10);
+            pool.release(p0, 1000);
+            pool.release(p1, 10);
+        }
+        auto stats = pool.stats();
+        REQUIRE(stats.n_acquires == 4);
+        REQUIRE(stats.n_hits == 4);
+        REQUIRE(stats.n_misses == 0);
+    }
+
+    SECTION("trim") {
+        pool.release(pool.acquire(64), 64);
+        pool.release(pool.acquire(4096), 4096);
+        REQUIRE(pool.stats().bytes_cached == 64 + 4096);
+        pool.trim();
+        REQUIRE(pool.stats().bytes_cached == 0);
+    }
+
+    SECTION("max_cached_bytes") {
+        auto p0 = pool.acquire(64);
+        auto p1 = pool.acquire(64);
+        pool.set_max_cached_bytes(64);
+        REQUIRE(pool.max_cached_bytes() == 64);
+        pool.release(p0, 64);
+        pool.release(p1, 64);
+        REQUIRE(pool.stats().bytes_cached == 64);
+
+        pool.set_max_cached_bytes(0);
+        REQUIRE(pool.stats().bytes_cached == 0);
+    }
+
+    SECTION("miss hook") {
+        std::vector<size_type> misses;
+        pool.set_miss_hook([&](size_type n) { misses.push_back(n); });
+        pool.release(pool.acquire(100), 100);
+        pool.release(pool.acquire(100), 100);
+        REQUIRE(misses == std::vector<size_type>{128});
+
+        // Hook exceptions propagate, and the block is not lost
+        pool.set_miss_hook([](size_type) { throw std::runtime_error("miss"); });
+        REQUIRE_THROWS_AS(pool.acquire(5000), std::runtime_error);
+        REQUIRE(pool.stats().bytes_in_use == 0);
+
+        pool.set_miss_hook(BufferPool::hook_type{});
+        pool.release(pool.acquire(1 << 20), 1 << 20);
+        REQUIRE(misses.size() == 1);
+    }
+
+    SECTION("Threads") {
+        // Each thread caches its blocks, and gives them back when it exits
+        auto work = [&]() {
+            for(size_type i = 0; i < 100; ++i) {
+                auto p0 = pool.acquire(64);
+                auto p1 = pool.acquire(4096);
+                pool.release(p0, 64);
+                pool.release(p1, 4096);
+            }
+        };
+        std::vector<std::thread> threads;
+        for(size_type i = 0; i < 4; ++i) threads.emplace_back(work);
+        for(auto& t : threads) t.join();
+
+        auto stats = pool.stats();
+        REQUIRE(stats.n_acquires == 800);
+        REQUIRE(stats.n_releases == 800);
+        REQUIRE(stats.n_hits + stats.n_misses == 800);
+        REQUIRE(stats.n_misses <= 8);
+        REQUIRE(stats.bytes_in_use == 0);
+        REQUIRE(stats.bytes_cached == stats.n_misses / 2 * (64 + 4096));
+
+        // The blocks the threads cached are now shared
+        pool.reset_stats();
+        work();
+        REQUIRE(pool.stats().n_misses == 0);
+        pool.trim();
+        REQUIRE(pool.stats().bytes_cached == 0);
+    }
+}
+
+TEST_CASE("BufferPool default pool") {
+    auto& pool = BufferPool::default_pool();
+    REQUIRE(&pool == &BufferPool::default_pool());
+
+    auto& world = testing::PZEnvironment::comm_world();
+    CommPP comm(world.mpi_comm());
+    std::vector<double> data(100, comm.me());
+    std::vector<std::string> strings{"Hello", "World"};
+
+    // One iteration of typical communication
+    auto iteration = [&]() {
+        BinaryBuffer bb(1024);
+        auto copy = bb;
+        auto s    = make_binary_buffer(strings);
+        auto g    = comm.gather(strings);
+        auto gv   = comm.gatherv(strings, 0);
+        return g.size() + s.size() + copy.size();
+    };
+
+    // First iteration primes the pool, afterwards nothing should miss
+    iteration();
+    pool.reset_stats();
+    iteration();
+    iteration();
+    auto stats = pool.stats();
+    REQUIRE(stats.n_acquires > 0);
+    REQUIRE(stats.n_misses == 0);
+    REQUIRE(stats.n_hits == stats.n_acquires);
+}
+
+TEST_CASE("BufferPool steady state allocations") {
+    auto& world = testing::PZEnvironment::comm_world();
+    CommPP comm(world.mpi_comm());
+    std::vector<double> data(100, comm.me());
+    std::vector<std::string> strings{"Hello", "World"};
+
+    // Counts the allocations made by fxn after it primed the pool
+    auto n_allocations = [](auto&& fxn) {
+        fxn();
+        const auto n0 = t_n_allocations;
+        fxn();
+        return t_n_allocations - n0;
+    };
+
+    SECTION("BinaryBuffer") {
+        REQUIRE(n_allocations([]() {
+                    BinaryBuffer bb(1024);
+                    auto copy  = bb;
+                    auto moved = std::move(copy);
+                    return moved.size();
+                }) == 0);
+        REQUIRE(n_allocations([&]() {
+                    return make_binary_buffer(strings).size();
+                }) == 0);
+    }
+
+    // Only the std::vector<double> returned to the caller is allocated
+    SECTION("gather") {
+        REQUIRE(n_allocations([&]() { return comm.gather(data).size(); }) ==
+                1);
+    }
+
+    // With more than one rank, the per-rank sizes are allocated too
+    SECTION("gatherv") {
+        const std::size_t corr = comm.size() > 1 ? 2 : 1;
+        REQUIRE(n_allocations([&]() { return comm.gatherv(data).size(); }) ==
+                corr);
+    }
+}
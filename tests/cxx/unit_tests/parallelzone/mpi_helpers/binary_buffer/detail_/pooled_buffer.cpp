@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../../catch.hpp"
+#include <cstring>
+#include <ostream>
+#include <parallelzone/mpi_helpers/binary_buffer/detail_/pooled_buffer.hpp>
+
+using namespace parallelzone::mpi_helpers;
+using namespace parallelzone::mpi_helpers::detail_;
+
+TEST_CASE("PooledBuffer") {
+    BufferPool pool;
+
+    PooledBuffer defaulted;
+    PooledBuffer empty(0, pool);
+    PooledBuffer non_empty(3, pool);
+    std::memcpy(non_empty.data(), "abc", 3);
+
+    SECTION("Ctors") {
+        REQUIRE(defaulted.data() == nullptr);
+        REQUIRE(defaulted.size() == 0);
+        REQUIRE(defaulted.capacity() == 0);
+
+        REQUIRE(empty.data() == nullptr);
+        REQUIRE(empty.size() == 0);
+
+        REQUIRE(non_empty.data() != nullptr);
+        REQUIRE(non_empty.size() == 3);
+        REQUIRE(non_empty.capacity() == BufferPool::min_block_size);
+        REQUIRE(pool.stats().bytes_in_use == BufferPool::min_block_size);
+    }
+
+    SECTION("Copy") {
+        PooledBuffer copy(non_empty);
+        REQUIRE(copy.size() == 3);
+        REQUIRE(copy.data() != non_empty.data());
+        REQUIRE(std::memcmp(copy.data(), "abc", 3) == 0);
+        REQUIRE(pool.stats().n_acquires == 2);
+    }
+
+    SECTION("Move") {
+        auto* p = non_empty.data();
+        PooledBuffer moved(std::move(non_empty));
+        REQUIRE(moved.data() == p);
+        REQUIRE(moved.size() == 3);
+        REQUIRE(non_empty.data() == nullptr);
+    }
+
+    SECTION("Assignment") {
+        defaulted = non_empty;
+        REQUIRE(defaulted.size() == 3);
+        REQUIRE(std::memcmp(defaulted.data(), "abc", 3) == 0);
+    }
+
+    SECTION("resize") {
+        auto* p = non_empty.data();
+        non_empty.resize(10);
+        REQUIRE(non_empty.data() == p);
+        REQUIRE(non_empty.size() == 10);
+
+        non_empty.resize(1000);
+        REQUIRE(non_empty.size() == 1000);
+        REQUIRE(non_empty.capacity() == 1024);
+        REQUIRE(std::memcmp(non_empty.data(), "abc", 3) == 0);
+    }
+
+    SECTION("Dtor returns memory") {
+        { PooledBuffer temp(100, pool); }
+        auto stats = pool.stats();
+        REQUIRE(stats.bytes_in_use == BufferPool::min_block_size);
+        REQUIRE(stats.bytes_cached == 128);
+    }
+}
+
+TEST_CASE("PooledStreamBuffer") {
+    BufferPool pool;
+    PooledStreamBuffer sb(pool);
+
+    SECTION("Empty") {
+        auto buffer = sb.release();
+        REQUIRE(buffer.size() == 0);
+    }
+
+    SECTION("Writes") {
+        std::string long_string(1000, 'x');
+        {
+            std::ostream os(&sb);
+            os.put('a');
+            os.write("bc", 2);
+            os << long_string;
+        }
+        auto buffer = sb.release();
+        REQUIRE(buffer.size() == 1003);
+        REQUIRE(std::memcmp(buffer.data(), "abc", 3) == 0);
+        REQUIRE(std::memcmp(buffer.data() + 3, long_string.data(), 1000) == 0);
+    }
+}
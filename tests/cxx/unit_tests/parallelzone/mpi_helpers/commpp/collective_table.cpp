@@ -0,0 +1,329 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <parallelzone/mpi_helpers/commpp/collective_table.hpp>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <unistd.h>
+
+using namespace parallelzone::mpi_helpers;
+
+using ctype = collective_type;
+using alg   = collective_algorithm;
+
+namespace {
+
+// Restores the default table when it goes out of scope
+struct DefaultTableGuard {
+    DefaultTableGuard() : m_saved(CollectiveTable::default_table()) {}
+    ~DefaultTableGuard() { CollectiveTable::default_table() = m_saved; }
+    CollectiveTable m_saved;
+};
+
+// Makes CommPP use @p a for every message size of @p c on @p n_ranks ranks
+void force(ctype c, alg a, std::size_t n_ranks) {
+    auto& table = CollectiveTable::default_table();
+    for(std::size_t b = 0; b < 64; ++b) table.set(c, n_ranks, b, a);
+}
+
+} // namespace
+
+TEST_CASE("to_string(collective_type)") {
+    REQUIRE(to_string(ctype::gather) == "gather");
+    REQUIRE(to_string(ctype::allgather) == "allgather");
+    REQUIRE(to_string(ctype::allgatherv) == "allgatherv");
+    REQUIRE(to_string(ctype::allreduce) == "allreduce");
+}
+
+TEST_CASE("to_string(collective_algorithm)") {
+    REQUIRE(to_string(alg::vendor) == "vendor");
+    REQUIRE(to_string(alg::ring) == "ring");
+    REQUIRE(to_string(alg::recursive_doubling) == "recursive_doubling");
+    REQUIRE(to_string(alg::binomial) == "binomial");
+    REQUIRE(to_string(alg::hierarchical) == "hierarchical");
+}
+
+TEST_CASE("is_applicable") {
+    for(auto c : {ctype::gather, ctype::allgather, ctype::allgatherv,
+                  ctype::allreduce})
+        REQUIRE(is_applicable(c, alg::vendor, 3));
+
+    REQUIRE(is_applicable(ctype::gather, alg::binomial, 3));
+    REQUIRE_FALSE(is_applicable(ctype::gather, alg::ring, 4));
+
+    REQUIRE(is_applicable(ctype::allgather, alg::ring, 3));
+    REQUIRE(is_applicable(ctype::allgather, alg::recursive_doubling, 4));
+    REQUIRE_FALSE(is_applicable(ctype::allgather, alg::recursive_doubling, 3));
+    REQUIRE_FALSE(is_applicable(ctype::allgatherv, alg::binomial, 4));
+
+    REQUIRE(is_applicable(ctype::allreduce, alg::hierarchical, 3));
+    REQUIRE(is_applicable(ctype::allreduce, alg::recursive_doubling, 8));
+    REQUIRE_FALSE(is_applicable(ctype::allreduce, alg::recursive_doubling, 6));
+}
+
+TEST_CASE("CollectiveTable") {
+    CollectiveTable defaulted;
+    CollectiveTable has_value;
+    has_value.set(ctype::allreduce, 4, 3, alg::ring);
+    has_value.set(ctype::gather, 3, 0, alg::binomial);
+
+    SECTION("CTors") {
+        SECTION("Default") { REQUIRE(defaulted.size() == 0); }
+        SECTION("Copy") {
+            CollectiveTable copy(has_value);
+            REQUIRE(copy == has_value);
+        }
+        SECTION("Copy assignment") {
+            CollectiveTable copy;
+            auto pcopy = &(copy = has_value);
+            REQUIRE(pcopy == &copy);
+            REQUIRE(copy == has_value);
+        }
+    }
+
+    SECTION("bucket") {
+        REQUIRE(CollectiveTable::bucket(0) == 0);
+        REQUIRE(CollectiveTable::bucket(1) == 0);
+        REQUIRE(CollectiveTable::bucket(2) == 1);
+        REQUIRE(CollectiveTable::bucket(3) == 1);
+        REQUIRE(CollectiveTable::bucket(8) == 3);
+        REQUIRE(CollectiveTable::bucket(15) == 3);
+        REQUIRE(CollectiveTable::bucket(1024) == 10);
+    }
+
+    SECTION("select") {
+        REQUIRE(defaulted.select(ctype::allreduce, 4, 8) == alg::vendor);
+        REQUIRE(has_value.select(ctype::allreduce, 4, 8) == alg::ring);
+        REQUIRE(has_value.select(ctype::allreduce, 4, 15) == alg::ring);
+        REQUIRE(has_value.select(ctype::allreduce, 4, 16) == alg::vendor);
+        REQUIRE(has_value.select(ctype::allreduce, 2, 8) == alg::vendor);
+        REQUIRE(has_value.select(ctype::allgather, 4, 8) == alg::vendor);
+        REQUIRE(has_value.select(ctype::gather, 3, 1) == alg::binomial);
+    }
+
+    SECTION("set") {
+        defaulted.set(ctype::allgather, 2, 5, alg::recursive_doubling);
+        REQUIRE(defaulted.size() == 1);
+        REQUIRE(defaulted.select(ctype::allgather, 2, 32) ==
+                alg::recursive_doubling);
+
+        // Replaces
+        defaulted.set(ctype::allgather, 2, 5, alg::ring);
+        REQUIRE(defaulted.size() == 1);
+        REQUIRE(defaulted.select(ctype::allgather, 2, 32) == alg::ring);
+
+        // Not applicable
+        REQUIRE_THROWS_AS(
+          defaulted.set(ctype::allgather, 3, 5, alg::recursive_doubling),
+          std::runtime_error);
+        REQUIRE(defaulted.size() == 1);
+    }
+
+    SECTION("merge") {
+        CollectiveTable other;
+        other.set(ctype::allreduce, 4, 3, alg::hierarchical);
+        other.set(ctype::allgather, 4, 3, alg::ring);
+        has_value.merge(other);
+        REQUIRE(has_value.size() == 3);
+        REQUIRE(has_value.select(ctype::allreduce, 4, 8) == alg::hierarchical);
+        REQUIRE(has_value.select(ctype::allgather, 4, 8) == alg::ring);
+        REQUIRE(has_value.select(ctype::gather, 3, 1) == alg::binomial);
+    }
+
+    SECTION("size") {
+        REQUIRE(defaulted.size() == 0);
+        REQUIRE(has_value.size() == 2);
+    }
+
+    SECTION("clear") {
+        has_value.clear();
+        REQUIRE(has_value == defaulted);
+    }
+
+    SECTION("save/load") {
+        namespace fs    = std::filesystem;
+        const auto path = (fs::temp_directory_path() /
+                           ("pz_collective_table_" +
+                            std::to_string(::getpid()) + ".txt"))
+                            .string();
+
+        // Missing file
+        REQUIRE_FALSE(CollectiveTable::load(path).has_value());
+
+        REQUIRE(has_value.save(path));
+        auto loaded = CollectiveTable::load(path);
+        REQUIRE(loaded.has_value());
+        REQUIRE(*loaded == has_value);
+
+        REQUIRE(defaulted.save(path));
+        loaded = CollectiveTable::load(path);
+        REQUIRE(loaded.has_value());
+        REQUIRE(*loaded == defaulted);
+
+        // Garbage
+        {
+            std::ofstream file(path);
+            file << "not a table\n";
+        }
+        REQUIRE_FALSE(CollectiveTable::load(path).has_value());
+
+        // Inapplicable entry
+        {
+            std::ofstream file(path);
+            file << "parallelzone-collective-table 1\n"
+                 << "gather 4 3 ring\n";
+        }
+        REQUIRE_FALSE(CollectiveTable::load(path).has_value());
+
+        fs::remove(path);
+    }
+
+    SECTION("default_table") {
+        auto& table = CollectiveTable::default_table();
+        REQUIRE(&table == &CollectiveTable::default_table());
+    }
+
+    SECTION("comparisons") {
+        REQUIRE(defaulted == CollectiveTable{});
+        REQUIRE_FALSE(defaulted != CollectiveTable{});
+        REQUIRE(defaulted != has_value);
+
+        CollectiveTable other;
+        other.set(ctype::allreduce, 4, 3, alg::ring);
+        other.set(ctype::gather, 3, 0, alg::vendor);
+        REQUIRE(other != has_value);
+    }
+}
+
+TEST_CASE("tune_collectives") {
+    auto& world = testing::PZEnvironment::comm_world();
+    CommPP comm(world.mpi_comm());
+    const auto n_ranks = std::size_t(comm.size());
+
+    TuneSettings settings;
+    settings.max_bytes    = 64;
+    settings.n_warmup     = 1;
+    settings.n_iterations = 2;
+
+    SECTION("null comm") {
+        REQUIRE_THROWS_AS(tune_collectives(CommPP{}, settings),
+                          std::runtime_error);
+    }
+
+    SECTION("value") {
+        auto table = tune_collectives(comm, settings);
+
+        // Four collectives times buckets 0 through 6
+        REQUIRE(table.size() == 4 * 7);
+
+        // Every rank must have picked the same algorithms
+        const auto root = CommPP::size_type(0);
+        namespace fs    = std::filesystem;
+        const auto path = (fs::temp_directory_path() /
+                           ("pz_tuned_table_" +
+                            std::to_string(::getpid()) + ".txt"))
+                            .string();
+        REQUIRE(table.save(path));
+        std::ifstream file(path);
+        std::vector<char> text((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+        fs::remove(path);
+        auto texts = comm.gatherv(text, root);
+        if(texts.has_value()) {
+            std::vector<char> corr;
+            for(std::size_t r = 0; r < n_ranks; ++r)
+                corr.insert(corr.end(), text.begin(), text.end());
+            REQUIRE(*texts == corr);
+        }
+
+        for(std::size_t b = 0; b < 7; ++b) {
+            for(auto c : {ctype::gather, ctype::allgather, ctype::allgatherv,
+                          ctype::allreduce}) {
+                const auto a = table.select(c, n_ranks, std::size_t(1) << b);
+                REQUIRE(is_applicable(c, a, n_ranks));
+            }
+        }
+    }
+}
+
+TEST_CASE("CommPP uses the CollectiveTable") {
+    auto& world = testing::PZEnvironment::comm_world();
+    CommPP comm(world.mpi_comm());
+    const auto n_ranks = std::size_t(comm.size());
+    const auto me      = std::size_t(comm.me());
+
+    DefaultTableGuard guard;
+
+    const std::vector<alg> all_algs{alg::vendor, alg::ring,
+                                    alg::recursive_doubling, alg::binomial,
+                                    alg::hierarchical};
+
+    for(auto a : all_algs) {
+        const auto a_str = " " + to_string(a);
+
+        SECTION("gather" + a_str) {
+            if(!is_applicable(ctype::gather, a, n_ranks)) continue;
+            force(ctype::gather, a, n_ranks);
+            for(std::size_t root = 0; root < n_ranks; ++root) {
+                std::vector<double> in{double(me), 2.0 * me};
+                auto rv = comm.gather(in, root);
+                REQUIRE(rv.has_value() == (me == root));
+                if(me != root) continue;
+                for(std::size_t r = 0; r < n_ranks; ++r) {
+                    REQUIRE((*rv)[2 * r] == double(r));
+                    REQUIRE((*rv)[2 * r + 1] == 2.0 * r);
+                }
+            }
+        }
+
+        SECTION("all gather" + a_str) {
+            if(!is_applicable(ctype::allgather, a, n_ranks)) continue;
+            force(ctype::allgather, a, n_ranks);
+            std::vector<int> in(5, int(me));
+            auto rv = comm.gather(in);
+            REQUIRE(rv.size() == 5 * n_ranks);
+            for(std::size_t i = 0; i < rv.size(); ++i)
+                REQUIRE(rv[i] == int(i / 5));
+        }
+
+        SECTION("all gatherv" + a_str) {
+            if(!is_applicable(ctype::allgatherv, a, n_ranks)) continue;
+            force(ctype::allgatherv, a, n_ranks);
+            // Rank r sends r + 1 copies of r
+            std::vector<int> in(me + 1, int(me));
+            auto rv = comm.gatherv(in);
+            std::vector<int> corr;
+            for(std::size_t r = 0; r < n_ranks; ++r)
+                corr.insert(corr.end(), r + 1, int(r));
+            REQUIRE(rv == corr);
+        }
+
+        SECTION("all reduce" + a_str) {
+            if(!is_applicable(ctype::allreduce, a, n_ranks)) continue;
+            force(ctype::allreduce, a, n_ranks);
+            std::vector<int> in(7);
+            std::iota(in.begin(), in.end(), int(me));
+            auto rv = comm.reduce(in, std::plus<int>());
+            std::vector<int> corr(7);
+            const int sum_me = int(n_ranks * (n_ranks - 1) / 2);
+            for(int i = 0; i < 7; ++i) corr[i] = int(n_ranks) * i + sum_me;
+            REQUIRE(rv == corr);
+        }
+    }
+}
@@ -17,6 +17,7 @@
 #include "../../test_parallelzone.hpp"
 #include <numeric>
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <thread>
 
 using namespace parallelzone::mpi_helpers;
 using size_type     = std::size_t;
@@ -330,3 +331,207 @@ TEST_CASE("CommPP") {
         }
     }
 }
+
+/* Testing Notes
+ *
+ * When the communicator only has one rank CommPP skips MPI entirely. With
+ * the exception of moves being honored, the results must be the same as if
+ * MPI had been called, so the loops above already cover correctness when run
+ * on one rank. Here we use MPI_COMM_SELF (which always has one rank) to check
+ * that rvalue inputs are moved into the result, i.e., that the buffers are
+ * not copied and that objects needing serialization are never serialized.
+ */
+TEST_CASE("CommPP single rank") {
+    CommPP self(MPI_COMM_SELF);
+    REQUIRE(self.size() == 1);
+
+    using strings_type = std::vector<std::string>;
+    using doubles_type = std::vector<double>;
+
+    SECTION("gather") {
+        SECTION("needs serialized") {
+            strings_type data{"Hello", "World"};
+            const auto* pdata = data.data();
+            auto rv           = self.gather(std::move(data), 0);
+            REQUIRE(rv.has_value());
+            REQUIRE(rv->size() == 1);
+            REQUIRE((*rv)[0] == strings_type{"Hello", "World"});
+            REQUIRE((*rv)[0].data() == pdata);
+        }
+        SECTION("doesn't need serialized") {
+            doubles_type data{1.0, 2.0, 3.0};
+            const auto* pdata = data.data();
+            auto rv           = self.gather(std::move(data), 0);
+            REQUIRE(rv.has_value());
+            REQUIRE(*rv == doubles_type{1.0, 2.0, 3.0});
+            REQUIRE(rv->data() == pdata);
+        }
+        SECTION("copies lvalues") {
+            doubles_type data{1.0, 2.0, 3.0};
+            auto rv = self.gather(data);
+            REQUIRE(rv == data);
+            REQUIRE(rv.data() != data.data());
+        }
+    }
+
+    SECTION("all gather") {
+        strings_type data{"Hello"};
+        const auto* pdata = data.data();
+        auto rv           = self.gather(std::move(data));
+        REQUIRE(rv == std::vector<strings_type>{strings_type{"Hello"}});
+        REQUIRE(rv[0].data() == pdata);
+    }
+
+    SECTION("gatherv") {
+        doubles_type data{1.0, 2.0};
+        const auto* pdata = data.data();
+        auto rv           = self.gatherv(std::move(data), 0);
+        REQUIRE(rv.has_value());
+        REQUIRE(*rv == doubles_type{1.0, 2.0});
+        REQUIRE(rv->data() == pdata);
+    }
+
+    SECTION("all gatherv") {
+        strings_type data{"Hello", "World"};
+        const auto* pdata = data.data();
+        auto rv           = self.gatherv(std::move(data));
+        REQUIRE(rv.size() == 1);
+        REQUIRE(rv[0].data() == pdata);
+    }
+
+    SECTION("reduce") {
+        doubles_type data{1.0, 2.0};
+        const auto* pdata = data.data();
+        auto rv = self.reduce(std::move(data), std::plus<double>(), 0);
+        REQUIRE(rv.has_value());
+        REQUIRE(*rv == doubles_type{1.0, 2.0});
+        REQUIRE(rv->data() == pdata);
+    }
+
+    SECTION("all reduce") {
+        doubles_type data{1.0, 2.0};
+        const auto* pdata = data.data();
+        auto rv           = self.reduce(std::move(data), std::plus<double>());
+        REQUIRE(rv == doubles_type{1.0, 2.0});
+        REQUIRE(rv.data() == pdata);
+    }
+}
+
+/* Testing Notes
+ *
+ * CommPP::make_threaded makes communicators whose ranks are threads. The
+ * collectives are run from one thread per rank, which only records the
+ * results, since Catch2's assertions are not thread-safe.
+ */
+TEST_CASE("CommPP::make_threaded") {
+    using strings_type = std::vector<std::string>;
+    using doubles_type = std::vector<double>;
+    const int n        = 4;
+
+    auto comms = CommPP::make_threaded(n);
+
+    // Runs fxn(comms[i]) on the i-th of n threads
+    auto run = [&](auto&& fxn) {
+        std::vector<std::thread> threads;
+        for(int i = 0; i < n; ++i)
+            threads.emplace_back([&, i]() { fxn(comms[i]); });
+        for(auto& t : threads) t.join();
+    };
+
+    SECTION("Invalid number of ranks") {
+        REQUIRE_THROWS_AS(CommPP::make_threaded(0), std::out_of_range);
+    }
+
+    SECTION("State") {
+        REQUIRE(comms.size() == n);
+        for(int i = 0; i < n; ++i) {
+            REQUIRE(comms[i].comm() == MPI_COMM_NULL);
+            REQUIRE(comms[i].size() == n);
+            REQUIRE(comms[i].me() == i);
+        }
+    }
+
+    SECTION("Copy") {
+        CommPP copy(comms[2]);
+        REQUIRE(copy == comms[2]);
+        REQUIRE(copy.me() == 2);
+    }
+
+    SECTION("Comparisons") {
+        REQUIRE(comms[0] == comms[1]);
+        REQUIRE(comms[0] != CommPP::make_threaded(n)[0]);
+        REQUIRE(comms[0] != CommPP{});
+        REQUIRE(comms[0] != CommPP(MPI_COMM_SELF));
+    }
+
+    SECTION("gather") {
+        std::vector<std::optional<std::vector<strings_type>>> results(n);
+        run([&](CommPP& c) {
+            strings_type data{"Rank", std::to_string(c.me())};
+            results[c.me()] = c.gather(std::move(data), 1);
+        });
+        std::vector<strings_type> corr;
+        for(int i = 0; i < n; ++i)
+            corr.push_back(strings_type{"Rank", std::to_string(i)});
+        for(int i = 0; i < n; ++i) {
+            REQUIRE(results[i].has_value() == (i == 1));
+            if(i == 1) REQUIRE(*results[i] == corr);
+        }
+    }
+
+    SECTION("all gather") {
+        std::vector<doubles_type> results(n);
+        run([&](CommPP& c) {
+            results[c.me()] = c.gather(doubles_type{double(c.me())});
+        });
+        doubles_type corr(n);
+        std::iota(corr.begin(), corr.end(), 0.0);
+        for(const auto& result : results) REQUIRE(result == corr);
+    }
+
+    SECTION("all gatherv") {
+        std::vector<doubles_type> results(n);
+        run([&](CommPP& c) {
+            results[c.me()] = c.gatherv(doubles_type(c.me(), c.me()));
+        });
+        doubles_type corr;
+        for(int i = 0; i < n; ++i) corr.insert(corr.end(), i, i);
+        for(const auto& result : results) REQUIRE(result == corr);
+    }
+
+    SECTION("reduce") {
+        std::vector<std::optional<doubles_type>> results(n);
+        run([&](CommPP& c) {
+            doubles_type data{1.0, double(c.me())};
+            results[c.me()] = c.reduce(data, std::plus<double>(), 0);
+        });
+        REQUIRE(*results[0] == doubles_type{n, n * (n - 1) / 2.0});
+        for(int i = 1; i < n; ++i) REQUIRE_FALSE(results[i].has_value());
+    }
+
+    SECTION("all reduce") {
+        std::vector<doubles_type> results(n);
+        run([&](CommPP& c) {
+            doubles_type data{2.0, double(c.me() + 1)};
+            results[c.me()] = c.reduce(data, std::multiplies<double>());
+        });
+        for(const auto& result : results)
+            REQUIRE(result == doubles_type{16.0, 24.0});
+    }
+
+    SECTION("abort") {
+        // Rank 0 fails before the gather, the others must not wait for it
+        std::vector<bool> threw(n, false);
+        run([&](CommPP& c) {
+            if(c.me() == 0) return c.abort();
+            try {
+                c.gather(doubles_type{double(c.me())});
+            } catch(const std::runtime_error&) { threw[c.me()] = true; }
+        });
+        for(int i = 1; i < n; ++i) REQUIRE(threw[i]);
+
+        // No-ops for the other communicators
+        REQUIRE_NOTHROW(CommPP{}.abort());
+        REQUIRE_NOTHROW(CommPP(MPI_COMM_SELF).abort());
+    }
+}
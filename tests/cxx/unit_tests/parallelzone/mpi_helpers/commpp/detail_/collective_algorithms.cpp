@@ -0,0 +1,158 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../../test_parallelzone.hpp"
+#include <numeric>
+#include <parallelzone/mpi_helpers/commpp/detail_/collective_algorithms.hpp>
+#include <vector>
+
+using namespace parallelzone::mpi_helpers;
+using namespace parallelzone::mpi_helpers::detail_;
+
+/* Testing Notes
+ *
+ * Each algorithm is compared against the vendor's implementation. The byte
+ * counts are chosen so that they do not evenly divide by the number of
+ * ranks, which exercises the uneven segments of the ring algorithms.
+ */
+
+namespace {
+
+// Rank r's n bytes are (r * 31 + i) % 251
+std::vector<char> make_block(int r, int n) {
+    std::vector<char> rv(n);
+    for(int i = 0; i < n; ++i) rv[i] = char((r * 31 + i) % 251);
+    return rv;
+}
+
+} // namespace
+
+TEST_CASE("collective_algorithms") {
+    auto& world = testing::PZEnvironment::comm_world();
+    MPI_Comm comm = world.mpi_comm();
+
+    int n_ranks = 0, me = 0;
+    MPI_Comm_size(comm, &n_ranks);
+    MPI_Comm_rank(comm, &me);
+    const bool pow2 = is_power_of_two(n_ranks);
+
+    SECTION("is_power_of_two") {
+        REQUIRE_FALSE(is_power_of_two(0));
+        REQUIRE(is_power_of_two(1));
+        REQUIRE(is_power_of_two(2));
+        REQUIRE_FALSE(is_power_of_two(3));
+        REQUIRE(is_power_of_two(4));
+        REQUIRE_FALSE(is_power_of_two(6));
+    }
+
+    for(int n : {0, 1, 7, 1000}) {
+        const auto n_str = " n = " + std::to_string(n);
+        const auto in    = make_block(me, n);
+
+        std::vector<char> corr(std::size_t(n) * n_ranks);
+        MPI_Allgather(in.data(), n, MPI_BYTE, corr.data(), n, MPI_BYTE, comm);
+
+        SECTION("binomial_gather" + n_str) {
+            for(int root = 0; root < n_ranks; ++root) {
+                std::vector<char> out(me == root ? corr.size() : 0);
+                binomial_gather(in.data(), n, out.data(), root, comm);
+                if(me == root) REQUIRE(out == corr);
+            }
+        }
+
+        SECTION("ring_allgather" + n_str) {
+            std::vector<char> out(corr.size());
+            ring_allgather(in.data(), n, out.data(), comm);
+            REQUIRE(out == corr);
+        }
+
+        SECTION("recursive_doubling_allgather" + n_str) {
+            if(pow2) {
+                std::vector<char> out(corr.size());
+                recursive_doubling_allgather(in.data(), n, out.data(), comm);
+                REQUIRE(out == corr);
+            }
+        }
+
+        // Rank r sends n + r bytes
+        const int my_n = n + me;
+        const auto vin = make_block(me, my_n);
+        std::vector<int> sizes(n_ranks), disps(n_ranks);
+        int total = 0;
+        for(int r = 0; r < n_ranks; ++r) {
+            sizes[r] = n + r;
+            disps[r] = total;
+            total += sizes[r];
+        }
+        std::vector<char> vcorr(total);
+        MPI_Allgatherv(vin.data(), my_n, MPI_BYTE, vcorr.data(), sizes.data(),
+                       disps.data(), MPI_BYTE, comm);
+
+        SECTION("ring_allgatherv" + n_str) {
+            std::vector<char> out(total);
+            ring_allgatherv(vin.data(), sizes.data(), disps.data(),
+                            out.data(), comm);
+            REQUIRE(out == vcorr);
+        }
+
+        SECTION("recursive_doubling_allgatherv" + n_str) {
+            if(pow2) {
+                std::vector<char> out(total);
+                recursive_doubling_allgatherv(vin.data(), sizes.data(),
+                                              disps.data(), out.data(), comm);
+                REQUIRE(out == vcorr);
+            }
+        }
+
+        // Integer sums are exact, so results must match bit for bit
+        std::vector<int> rin(n);
+        std::iota(rin.begin(), rin.end(), me);
+        std::vector<int> rcorr(n);
+        MPI_Allreduce(rin.data(), rcorr.data(), n, MPI_INT, MPI_SUM, comm);
+
+        SECTION("ring_allreduce" + n_str) {
+            std::vector<int> out(n);
+            ring_allreduce(rin.data(), out.data(), n, MPI_INT, MPI_SUM, comm);
+            REQUIRE(out == rcorr);
+        }
+
+        SECTION("recursive_doubling_allreduce" + n_str) {
+            if(pow2) {
+                std::vector<int> out(n);
+                recursive_doubling_allreduce(rin.data(), out.data(), n,
+                                             MPI_INT, MPI_SUM, comm);
+                REQUIRE(out == rcorr);
+            }
+        }
+
+        SECTION("hierarchical_allreduce" + n_str) {
+            std::vector<int> out(n);
+            hierarchical_allreduce(rin.data(), out.data(), n, MPI_INT, MPI_SUM,
+                                   comm);
+            REQUIRE(out == rcorr);
+        }
+    }
+
+    SECTION("run_* reject inapplicable algorithms") {
+        char c = 0;
+        REQUIRE_THROWS_AS(run_gather(collective_algorithm::ring, &c, 1, &c, 0,
+                                     comm),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(run_allgather(collective_algorithm::hierarchical, &c,
+                                        1, &c, comm),
+                          std::runtime_error);
+    }
+}
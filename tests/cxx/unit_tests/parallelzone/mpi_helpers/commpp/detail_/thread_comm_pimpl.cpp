@@ -0,0 +1,262 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../../../test_parallelzone.hpp"
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <parallelzone/mpi_helpers/commpp/detail_/thread_comm_pimpl.hpp>
+#include <thread>
+
+using namespace parallelzone::mpi_helpers;
+
+using team_type  = detail_::ThreadTeam;
+using pimpl_type = detail_::ThreadCommPPPIMPL;
+using base_type  = detail_::CommPPPIMPL;
+
+/* Testing Notes
+ *
+ * Catch2's assertions are not thread-safe, so the kernels run on the team's
+ * threads only record what they see. The assertions are made on the main
+ * thread after the threads are joined.
+ */
+
+namespace {
+
+// Runs fxn(comm) on each of n threads, where comm is that thread's rank
+template<typename Fxn>
+void run_on_team(int n, Fxn&& fxn) {
+    auto team = std::make_shared<team_type>(n);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < n; ++i) {
+        threads.emplace_back([&, i]() {
+            pimpl_type comm(team, i);
+            fxn(comm);
+        });
+    }
+    for(auto& t : threads) t.join();
+}
+
+// Local reduction used in place of MPI_SUM for int
+void sum_ints(const void* const* inputs, std::size_t n_inputs, void* output,
+              std::size_t count) {
+    auto* out = static_cast<int*>(output);
+    for(std::size_t j = 0; j < count; ++j) out[j] = 0;
+    for(std::size_t i = 0; i < n_inputs; ++i) {
+        auto* in = static_cast<const int*>(inputs[i]);
+        for(std::size_t j = 0; j < count; ++j) out[j] += in[j];
+    }
+}
+
+} // namespace
+
+TEST_CASE("ThreadTeam") {
+    const int n = 4;
+    team_type team(n);
+
+    SECTION("size") { REQUIRE(team.size() == n); }
+
+    SECTION("barrier") {
+        std::atomic<int> n_arrived{0};
+        std::vector<int> seen(n);
+        std::vector<std::thread> threads;
+        for(int i = 0; i < n; ++i) {
+            threads.emplace_back([&, i]() {
+                // Reuse the barrier a few times to check generations work
+                for(int j = 0; j < 3; ++j) {
+                    ++n_arrived;
+                    team.barrier();
+                    seen[i] = n_arrived.load();
+                    team.barrier();
+                }
+            });
+        }
+        for(auto& t : threads) t.join();
+        // Nobody passes the barrier until everyone has arrived
+        for(int i = 0; i < n; ++i) REQUIRE(seen[i] == 3 * n);
+    }
+
+    SECTION("abort") {
+        REQUIRE_FALSE(team.aborted());
+        std::vector<bool> threw(n, false);
+        std::vector<std::thread> threads;
+        for(int i = 1; i < n; ++i) {
+            threads.emplace_back([&, i]() {
+                try {
+                    team.barrier();
+                } catch(const detail_::TeamAborted&) { threw[i] = true; }
+            });
+        }
+        // Rank 0 never arrives, so the others are released by the abort
+        team.abort();
+        for(auto& t : threads) t.join();
+        for(int i = 1; i < n; ++i) REQUIRE(threw[i]);
+        REQUIRE(team.aborted());
+        REQUIRE_THROWS_AS(team.barrier(), detail_::TeamAborted);
+    }
+
+    SECTION("post/slot") {
+        int x = 42;
+        team.post(2, &x, sizeof(x));
+        REQUIRE(team.slot(2).data == &x);
+        REQUIRE(team.slot(2).nbytes == sizeof(x));
+        REQUIRE(team.slot(0).data == nullptr);
+        REQUIRE(team.slot(0).nbytes == 0);
+    }
+}
+
+TEST_CASE("ThreadCommPPPIMPL") {
+    const int n = 4;
+    using binary_type = pimpl_type::binary_type;
+    using cref        = pimpl_type::const_binary_reference;
+    using ref         = pimpl_type::binary_reference;
+    using root_type   = pimpl_type::opt_root_t;
+
+    auto team = std::make_shared<team_type>(n);
+    pimpl_type comm1(team, 1);
+
+    SECTION("CTor") {
+        REQUIRE(comm1.me() == 1);
+        REQUIRE(comm1.size() == n);
+        REQUIRE(comm1.comm() == MPI_COMM_NULL);
+    }
+
+    SECTION("clone") {
+        auto pcopy = comm1.clone();
+        REQUIRE(*pcopy == comm1);
+        REQUIRE(pcopy->me() == 1);
+    }
+
+    SECTION("gather") {
+        for(root_type root : {root_type{}, root_type{2}}) {
+            std::vector<std::vector<int>> results(n);
+            run_on_team(n, [&](pimpl_type& comm) {
+                std::vector<int> data{comm.me(), 10 * comm.me()};
+                auto rv = comm.gather(cref(data.data(), data.size()), root);
+                if(!rv.has_value()) return;
+                auto* p = reinterpret_cast<const int*>(rv->data());
+                results[comm.me()].assign(p, p + rv->size() / sizeof(int));
+            });
+            std::vector<int> corr;
+            for(int i = 0; i < n; ++i) corr.insert(corr.end(), {i, 10 * i});
+            for(int i = 0; i < n; ++i) {
+                if(!root.has_value() || *root == i)
+                    REQUIRE(results[i] == corr);
+                else
+                    REQUIRE(results[i].empty());
+            }
+        }
+    }
+
+    SECTION("gather into a buffer") {
+        std::vector<std::vector<int>> results(n, std::vector<int>(n));
+        run_on_team(n, [&](pimpl_type& comm) {
+            int data = comm.me();
+            auto& out = results[comm.me()];
+            comm.gather(cref(&data, 1), ref(out.data(), out.size()));
+        });
+        std::vector<int> corr(n);
+        std::iota(corr.begin(), corr.end(), 0);
+        for(const auto& result : results) REQUIRE(result == corr);
+    }
+
+    SECTION("gather buffer too small") {
+        pimpl_type solo(std::make_shared<team_type>(1), 0);
+        int data = 0;
+        binary_type out(1);
+        ref pout(out.data(), out.size());
+        REQUIRE_THROWS_AS(solo.gather(cref(&data, 1), pout),
+                          std::runtime_error);
+    }
+
+    SECTION("gather buffer too small on the root") {
+        // Only the root checks the buffer, the others must not hang
+        std::vector<bool> threw(n, false), aborted(n, false);
+        run_on_team(n, [&](pimpl_type& comm) {
+            int data = comm.me();
+            binary_type out(comm.me() == 0 ? 1 : 0);
+            try {
+                comm.gather(cref(&data, 1), ref(out.data(), out.size()), 0);
+            } catch(const detail_::TeamAborted&) {
+                aborted[comm.me()] = true;
+            } catch(const std::runtime_error&) { threw[comm.me()] = true; }
+        });
+        REQUIRE(threw[0]);
+        for(int i = 1; i < n; ++i) REQUIRE(aborted[i]);
+    }
+
+    SECTION("gatherv") {
+        for(root_type root : {root_type{}, root_type{0}}) {
+            std::vector<std::vector<int>> results(n);
+            std::vector<std::vector<int>> sizes(n);
+            run_on_team(n, [&](pimpl_type& comm) {
+                // Rank i sends i copies of i (so rank 0 sends nothing)
+                std::vector<int> data(comm.me(), comm.me());
+                auto rv = comm.gatherv(cref(data.data(), data.size()), root);
+                if(!rv.has_value()) return;
+                auto* p = reinterpret_cast<const int*>(rv->first.data());
+                auto n_out = rv->first.size() / sizeof(int);
+                results[comm.me()].assign(p, p + n_out);
+                sizes[comm.me()] = rv->second;
+            });
+            std::vector<int> corr, corr_sizes;
+            for(int i = 0; i < n; ++i) {
+                corr.insert(corr.end(), i, i);
+                corr_sizes.push_back(i * sizeof(int));
+            }
+            for(int i = 0; i < n; ++i) {
+                if(!root.has_value() || *root == i) {
+                    REQUIRE(results[i] == corr);
+                    REQUIRE(sizes[i] == corr_sizes);
+                } else {
+                    REQUIRE(results[i].empty());
+                }
+            }
+        }
+    }
+
+    SECTION("reduce") {
+        for(root_type root : {root_type{}, root_type{3}}) {
+            std::vector<std::vector<int>> results(n, std::vector<int>(2, -1));
+            run_on_team(n, [&](pimpl_type& comm) {
+                std::vector<int> data{1, comm.me()};
+                auto& out = results[comm.me()];
+                comm.reduce(data.data(), out.data(), 2, MPI_INT, MPI_SUM,
+                            &sum_ints, root);
+            });
+            std::vector<int> corr{n, n * (n - 1) / 2};
+            for(int i = 0; i < n; ++i) {
+                if(!root.has_value() || *root == i)
+                    REQUIRE(results[i] == corr);
+                else
+                    REQUIRE(results[i] == std::vector<int>(2, -1));
+            }
+        }
+    }
+
+    SECTION("operator==") {
+        // Same team, different rank
+        REQUIRE(comm1 == pimpl_type(team, 2));
+
+        // Different team
+        auto other_team = std::make_shared<team_type>(n);
+        REQUIRE_FALSE(comm1 == pimpl_type(other_team, 1));
+
+        // Different backend
+        base_type self(MPI_COMM_SELF);
+        REQUIRE_FALSE(comm1 == self);
+        REQUIRE_FALSE(self == comm1);
+    }
+}
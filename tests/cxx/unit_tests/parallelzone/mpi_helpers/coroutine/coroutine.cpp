@@ -0,0 +1,203 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <parallelzone/mpi_helpers/coroutine/coroutine.hpp>
+
+/* Testing Notes
+ *
+ * The coroutine layer only exists when the unit tests are compiled as C++20
+ * (or later). Under older standards this file contains no tests. The
+ * test_unit_parallelzone_cxx20 target (BUILD_CXX20_TESTS) compiles this file
+ * as C++20 and defines PARALLELZONE_TEST_COROUTINES, so that the tests can not
+ * silently disappear there.
+ */
+#if defined(PARALLELZONE_TEST_COROUTINES) && \
+  !defined(PARALLELZONE_HAS_COROUTINES)
+#error "The compiler does not support the C++20 coroutine layer"
+#endif
+#ifdef PARALLELZONE_HAS_COROUTINES
+#include <numeric>
+
+using namespace parallelzone::mpi_helpers;
+using namespace parallelzone::mpi_helpers::coroutine;
+
+namespace {
+
+Task<int> barrier_then_return(const CommPP& comm, RequestExecutor& ex) {
+    co_await async_barrier(comm, ex);
+    co_return 42;
+}
+
+Task<std::vector<double>> two_stage_gather(const CommPP& comm,
+                                           RequestExecutor& ex) {
+    const auto n = comm.size();
+    std::vector<double> stage0(1, comm.me());
+    std::vector<double> buffer0(n);
+    co_await async_gather(comm, ConstBinaryView(stage0.data(), 1),
+                          BinaryView(buffer0.data(), n), ex);
+
+    // Second stage consumes the first stage's result
+    std::vector<double> stage1(1, std::accumulate(buffer0.begin(),
+                                                  buffer0.end(), 0.0));
+    std::vector<double> buffer1(n);
+    co_await async_gather(comm, ConstBinaryView(stage1.data(), 1),
+                          BinaryView(buffer1.data(), n), ex);
+    co_return buffer1;
+}
+
+Task<> nested(const CommPP& comm, RequestExecutor& ex, int& result) {
+    result = co_await barrier_then_return(comm, ex);
+}
+
+Task<> gather_to_root(const CommPP& comm, RequestExecutor& ex,
+                      const std::vector<int>& in, std::vector<int>& out) {
+    co_await async_gather(comm, ConstBinaryView(in.data(), in.size()),
+                          BinaryView(out.data(), out.size()), ex, 0);
+}
+
+Task<> all_reduce(const CommPP& comm, RequestExecutor& ex,
+                  const std::vector<double>& in, std::vector<double>& out) {
+    co_await async_reduce(comm, in, out, std::plus<double>(), ex);
+}
+
+Task<> reduce_to_root(const CommPP& comm, RequestExecutor& ex,
+                      const std::vector<double>& in, std::vector<double>& out) {
+    co_await async_reduce(comm, in, out, std::plus<double>(), ex, 0);
+}
+
+Task<int> never_resumed() {
+    co_await std::suspend_always{};
+    co_return 1;
+}
+
+Task<> throws(const CommPP& comm, RequestExecutor& ex) {
+    co_await async_barrier(comm, ex);
+    throw std::runtime_error("Thrown from a coroutine");
+}
+
+} // namespace
+
+TEST_CASE("coroutine") {
+    auto& world = testing::PZEnvironment::comm_world();
+    CommPP comm(world.mpi_comm());
+    RequestExecutor ex;
+
+    const auto n  = comm.size();
+    const auto me = comm.me();
+
+    SECTION("RequestExecutor") {
+        REQUIRE(ex.empty());
+        REQUIRE(ex.size() == 0);
+        REQUIRE(ex.progress() == 0);
+    }
+
+    SECTION("barrier") {
+        auto task = barrier_then_return(comm, ex);
+        ex.run(task);
+        REQUIRE(task.done());
+        REQUIRE(ex.empty());
+        REQUIRE(task.get() == 42);
+    }
+
+    SECTION("pipelined gathers") {
+        auto task = two_stage_gather(comm, ex);
+        ex.run(task);
+        const double sum = n * (n - 1) / 2.0;
+        REQUIRE(task.get() == std::vector<double>(n, sum));
+    }
+
+    SECTION("rooted gather") {
+        std::vector<int> in(2, me);
+        std::vector<int> out(me == 0 ? 2 * n : 0);
+        auto p = gather_to_root(comm, ex, in, out);
+        ex.run(p);
+        if(me == 0) {
+            for(int i = 0; i < n; ++i) {
+                REQUIRE(out[2 * i] == i);
+                REQUIRE(out[2 * i + 1] == i);
+            }
+        }
+    }
+
+    SECTION("all reduce") {
+        std::vector<double> in{1.0, double(me)};
+        std::vector<double> out(2);
+        auto p = all_reduce(comm, ex, in, out);
+        ex.run(p);
+        REQUIRE(out == std::vector<double>{double(n), n * (n - 1) / 2.0});
+    }
+
+    SECTION("reduce buffer too small") {
+        std::vector<double> in{1.0, 2.0};
+        std::vector<double> out(1);
+        REQUIRE_THROWS_AS(async_reduce(comm, in, out, std::plus<double>(), ex),
+                          std::runtime_error);
+        REQUIRE(ex.empty());
+    }
+
+    SECTION("rooted reduce") {
+        // Only the root needs room for the result
+        std::vector<double> in{1.0, double(me)};
+        std::vector<double> out(me == 0 ? 2 : 0);
+        auto p = reduce_to_root(comm, ex, in, out);
+        ex.run(p);
+        if(me == 0)
+            REQUIRE(out == std::vector<double>{double(n), n * (n - 1) / 2.0});
+    }
+
+    SECTION("many tasks on one executor") {
+        std::vector<Task<int>> tasks;
+        for(int i = 0; i < 4; ++i)
+            tasks.emplace_back(barrier_then_return(comm, ex));
+        ex.drain();
+        for(auto& t : tasks) REQUIRE(t.get() == 42);
+    }
+
+    SECTION("nested tasks") {
+        int result = 0;
+        auto task  = nested(comm, ex, result);
+        ex.run(task);
+        REQUIRE(result == 42);
+    }
+
+    SECTION("exceptions propagate") {
+        auto task = throws(comm, ex);
+        ex.run(task);
+        REQUIRE_THROWS_AS(task.get(), std::runtime_error);
+    }
+
+    SECTION("thread-backed communicators are rejected") {
+        auto threaded = CommPP::make_threaded(1).front();
+        std::vector<double> in(1), out(1);
+        ConstBinaryView cin(in.data(), in.size());
+        BinaryView bout(out.data(), out.size());
+        REQUIRE_THROWS_AS(async_barrier(threaded, ex), std::runtime_error);
+        REQUIRE_THROWS_AS(async_gather(threaded, cin, bout, ex),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(
+          async_reduce(threaded, in, out, std::plus<double>(), ex),
+          std::runtime_error);
+        REQUIRE(ex.empty());
+    }
+
+    SECTION("get before done throws") {
+        auto task = never_resumed();
+        REQUIRE_FALSE(task.done());
+        REQUIRE_THROWS_AS(task.get(), std::runtime_error);
+    }
+}
+#endif
@@ -0,0 +1,211 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <parallelzone/mpi_helpers/mpi.hpp>
+
+/* Testing Notes
+ *
+ * The stand-in for MPI is only used when ParallelZone is built with
+ * BUILD_WITHOUT_MPI. Otherwise this file contains no tests. The rest of the
+ * unit tests exercise the stand-in through ParallelZone's normal APIs, so
+ * these tests focus on the behavior particular to it.
+ */
+#ifdef PARALLELZONE_WITHOUT_MPI
+#include <thread>
+#include <vector>
+
+namespace {
+
+int n_deleted = 0;
+
+int count_deletes(MPI_Comm, int, void*, void*) {
+    ++n_deleted;
+    return MPI_SUCCESS;
+}
+
+} // namespace
+
+TEST_CASE("serial_mpi") {
+    SECTION("environment") {
+        int flag = 0;
+        MPI_Initialized(&flag);
+        REQUIRE(flag);
+        MPI_Finalized(&flag);
+        REQUIRE_FALSE(flag);
+
+        int provided = 0;
+        MPI_Query_thread(&provided);
+        REQUIRE(provided == MPI_THREAD_MULTIPLE);
+
+        // Can't initialize twice
+        REQUIRE(MPI_Init(nullptr, nullptr) != MPI_SUCCESS);
+
+        char name[MPI_MAX_PROCESSOR_NAME];
+        int len = 0;
+        MPI_Get_processor_name(name, &len);
+        REQUIRE(len > 0);
+    }
+
+    SECTION("communicators") {
+        for(auto comm : {MPI_COMM_WORLD, MPI_COMM_SELF}) {
+            int size = 0, rank = -1;
+            REQUIRE(MPI_Comm_size(comm, &size) == MPI_SUCCESS);
+            REQUIRE(MPI_Comm_rank(comm, &rank) == MPI_SUCCESS);
+            REQUIRE(size == 1);
+            REQUIRE(rank == 0);
+        }
+
+        int size = 0;
+        REQUIRE(MPI_Comm_size(MPI_COMM_NULL, &size) == MPI_ERR_COMM);
+
+        MPI_Comm dup;
+        MPI_Comm_dup(MPI_COMM_WORLD, &dup);
+        int result = MPI_UNEQUAL;
+        MPI_Comm_compare(dup, dup, &result);
+        REQUIRE(result == MPI_IDENT);
+        MPI_Comm_compare(dup, MPI_COMM_WORLD, &result);
+        REQUIRE(result == MPI_CONGRUENT);
+
+        REQUIRE(MPI_Comm_free(&dup) == MPI_SUCCESS);
+        REQUIRE(dup == MPI_COMM_NULL);
+
+        MPI_Comm world = MPI_COMM_WORLD;
+        REQUIRE(MPI_Comm_free(&world) == MPI_ERR_COMM);
+
+        MPI_Comm split;
+        MPI_Comm_split(MPI_COMM_WORLD, MPI_UNDEFINED, 0, &split);
+        REQUIRE(split == MPI_COMM_NULL);
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                            MPI_INFO_NULL, &split);
+        REQUIRE(split != MPI_COMM_NULL);
+        MPI_Comm_free(&split);
+    }
+
+    SECTION("attributes") {
+        int keyval = MPI_KEYVAL_INVALID;
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, count_deletes, &keyval,
+                               nullptr);
+        MPI_Comm comm;
+        MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+
+        int value    = 42;
+        void* pvalue = nullptr;
+        int flag     = 1;
+        MPI_Comm_get_attr(comm, keyval, &pvalue, &flag);
+        REQUIRE_FALSE(flag);
+
+        MPI_Comm_set_attr(comm, keyval, &value);
+        MPI_Comm_get_attr(comm, keyval, &pvalue, &flag);
+        REQUIRE(flag);
+        REQUIRE(pvalue == &value);
+
+        // Attributes are not copied and are deleted with the communicator
+        MPI_Comm dup;
+        MPI_Comm_dup(comm, &dup);
+        MPI_Comm_get_attr(dup, keyval, &pvalue, &flag);
+        REQUIRE_FALSE(flag);
+
+        n_deleted = 0;
+        MPI_Comm_free(&comm);
+        REQUIRE(n_deleted == 1);
+
+        MPI_Comm_free(&dup);
+        MPI_Comm_free_keyval(&keyval);
+        REQUIRE(keyval == MPI_KEYVAL_INVALID);
+    }
+
+    SECTION("point-to-point") {
+        std::vector<int> in{1, 2, 3}, out(3);
+        MPI_Send(in.data(), 3, MPI_INT, 0, 7, MPI_COMM_WORLD);
+        MPI_Status status;
+        REQUIRE(MPI_Recv(out.data(), 3, MPI_INT, MPI_ANY_SOURCE, MPI_ANY_TAG,
+                         MPI_COMM_WORLD, &status) == MPI_SUCCESS);
+        REQUIRE(out == in);
+        REQUIRE(status.MPI_SOURCE == 0);
+        REQUIRE(status.MPI_TAG == 7);
+
+        // Messages are matched by communicator
+        MPI_Send(in.data(), 3, MPI_INT, 0, 0, MPI_COMM_SELF);
+        std::thread sender([&]() {
+            MPI_Send(in.data(), 3, MPI_INT, 0, 1, MPI_COMM_WORLD);
+        });
+        std::vector<int> out2(3);
+        MPI_Recv(out2.data(), 3, MPI_INT, 0, 1, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        sender.join();
+        REQUIRE(out2 == in);
+        MPI_Recv(out2.data(), 3, MPI_INT, 0, 0, MPI_COMM_SELF,
+                 MPI_STATUS_IGNORE);
+
+        // Too small a buffer
+        MPI_Send(in.data(), 3, MPI_INT, 0, 0, MPI_COMM_WORLD);
+        REQUIRE(MPI_Recv(out.data(), 2, MPI_INT, 0, 0, MPI_COMM_WORLD,
+                         MPI_STATUS_IGNORE) == MPI_ERR_TRUNCATE);
+        MPI_Recv(out.data(), 3, MPI_INT, 0, 0, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+
+        REQUIRE(MPI_Send(in.data(), 3, MPI_INT, 1, 0, MPI_COMM_WORLD) ==
+                MPI_ERR_RANK);
+        REQUIRE(MPI_Send(in.data(), 3, MPI_INT, MPI_PROC_NULL, 0,
+                         MPI_COMM_WORLD) == MPI_SUCCESS);
+    }
+
+    SECTION("collectives") {
+        std::vector<double> in{1.0, 2.0}, out(2);
+        MPI_Allreduce(in.data(), out.data(), 2, MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_WORLD);
+        REQUIRE(out == in);
+
+        std::vector<char> vout(5, 'x');
+        int count = 2, displ = 3;
+        MPI_Allgatherv("ab", 2, MPI_CHAR, vout.data(), &count, &displ,
+                       MPI_CHAR, MPI_COMM_WORLD);
+        REQUIRE(vout == std::vector<char>{'x', 'x', 'x', 'a', 'b'});
+
+        REQUIRE(MPI_Gather(in.data(), 2, MPI_DOUBLE, out.data(), 2,
+                           MPI_DOUBLE, 1, MPI_COMM_WORLD) == MPI_ERR_ROOT);
+    }
+
+    SECTION("MPI_Reduce_local") {
+        std::vector<int> in{1, 6}, inout{3, 4};
+        MPI_Reduce_local(in.data(), inout.data(), 2, MPI_INT, MPI_SUM);
+        REQUIRE(inout == std::vector<int>{4, 10});
+        MPI_Reduce_local(in.data(), inout.data(), 2, MPI_INT, MPI_MAX);
+        REQUIRE(inout == std::vector<int>{4, 10});
+        MPI_Reduce_local(in.data(), inout.data(), 2, MPI_INT, MPI_BXOR);
+        REQUIRE(inout == std::vector<int>{5, 12});
+
+        std::vector<double> d{1.0};
+        REQUIRE(MPI_Reduce_local(d.data(), d.data(), 1, MPI_DOUBLE,
+                                 MPI_BAND) == MPI_ERR_OP);
+    }
+
+    SECTION("nonblocking") {
+        MPI_Request requests[2];
+        MPI_Ibarrier(MPI_COMM_WORLD, requests);
+        requests[1] = MPI_REQUEST_NULL;
+        int outcount = 0, indices[2];
+        MPI_Testsome(2, requests, &outcount, indices, MPI_STATUSES_IGNORE);
+        REQUIRE(outcount == 1);
+        REQUIRE(indices[0] == 0);
+        REQUIRE(requests[0] == MPI_REQUEST_NULL);
+
+        MPI_Testsome(2, requests, &outcount, indices, MPI_STATUSES_IGNORE);
+        REQUIRE(outcount == MPI_UNDEFINED);
+    }
+}
+#endif
@@ -43,4 +43,18 @@ TEMPLATE_LIST_TEST_CASE("MPIOp", "", test_types) {
 
     STATIC_REQUIRE(has_mpi_op_v<std::bit_xor<T>>);
     REQUIRE(mpi_op_v<std::bit_xor<T>> == MPI_BXOR);
+
+    STATIC_REQUIRE(has_mpi_op_v<minimum<T>>);
+    REQUIRE(mpi_op_v<minimum<T>> == MPI_MIN);
+
+    STATIC_REQUIRE(has_mpi_op_v<maximum<T>>);
+    REQUIRE(mpi_op_v<maximum<T>> == MPI_MAX);
+}
+
+TEMPLATE_LIST_TEST_CASE("minimum/maximum", "", test_types) {
+    using T = TestType;
+    REQUIRE(minimum<T>{}(T{1}, T{2}) == T{1});
+    REQUIRE(minimum<T>{}(T{2}, T{1}) == T{1});
+    REQUIRE(maximum<T>{}(T{1}, T{2}) == T{2});
+    REQUIRE(maximum<T>{}(T{2}, T{1}) == T{2});
 }
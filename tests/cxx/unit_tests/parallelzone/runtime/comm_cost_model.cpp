@@ -0,0 +1,93 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../catch.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <parallelzone/runtime/comm_cost_model.hpp>
+#include <unistd.h>
+
+using namespace parallelzone::runtime;
+
+TEST_CASE("CommCostModel") {
+    using model_type = CommCostModel;
+    using level      = model_type::level;
+    using link_type  = model_type::LinkParameters;
+
+    link_type intra{1.0e-6, 1.0e-10};
+    link_type inter{2.0e-6, 3.0e-10};
+
+    model_type defaulted;
+    model_type has_value(intra, inter);
+
+    SECTION("CTors") {
+        REQUIRE(defaulted.parameters(level::intra_node) == link_type{});
+        REQUIRE(defaulted.parameters(level::inter_node) == link_type{});
+
+        REQUIRE(has_value.parameters(level::intra_node) == intra);
+        REQUIRE(has_value.parameters(level::inter_node) == inter);
+        REQUIRE(has_value.parameters(level::self) == link_type{});
+    }
+
+    SECTION("cost") {
+        REQUIRE(defaulted.cost(1024, level::inter_node) == 0.0);
+        REQUIRE(has_value.cost(1024, level::self) == 0.0);
+        REQUIRE(has_value.cost(0, level::intra_node) == intra.alpha);
+        REQUIRE(has_value.cost(1000, level::intra_node) ==
+                Approx(intra.alpha + 1000 * intra.beta));
+        REQUIRE(has_value.cost(1000, level::inter_node) ==
+                Approx(inter.alpha + 1000 * inter.beta));
+    }
+
+    SECTION("save/load") {
+        namespace fs = std::filesystem;
+        const auto path =
+          (fs::temp_directory_path() /
+           ("pz_comm_cost_model_" + std::to_string(::getpid()) + ".txt"))
+            .string();
+
+        // Missing file
+        REQUIRE_FALSE(model_type::load(path, 42).has_value());
+
+        REQUIRE(has_value.save(path, 42));
+        auto loaded = model_type::load(path, 42);
+        REQUIRE(loaded.has_value());
+        REQUIRE(*loaded == has_value);
+
+        // Wrong topology
+        REQUIRE_FALSE(model_type::load(path, 43).has_value());
+
+        // Garbage
+        {
+            std::ofstream file(path, std::ios::trunc);
+            file << "not a model\n";
+        }
+        REQUIRE_FALSE(model_type::load(path, 42).has_value());
+        std::remove(path.c_str());
+
+        // Unwritable
+        REQUIRE_FALSE(has_value.save("/this/does/not/exist/model.txt", 42));
+    }
+
+    SECTION("operator==/operator!=") {
+        REQUIRE(defaulted == model_type{});
+        REQUIRE(has_value == model_type(intra, inter));
+        REQUIRE(has_value != defaulted);
+        REQUIRE(has_value != model_type(inter, intra));
+        REQUIRE_FALSE(has_value == model_type(intra, intra));
+    }
+}
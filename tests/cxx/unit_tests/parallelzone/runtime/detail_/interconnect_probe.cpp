@@ -0,0 +1,146 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <parallelzone/runtime/detail_/interconnect_probe.hpp>
+#include <unistd.h>
+
+using namespace parallelzone::runtime;
+using namespace parallelzone::runtime::detail_;
+
+/* Testing Notes
+ *
+ * Measured times are machine dependent, so we only check that the results are
+ * sane and that every rank gets the same answer. Small repetition counts keep
+ * the tests fast.
+ */
+
+namespace {
+
+// True if every rank of comm has the same model as rank 0
+bool same_everywhere(const ResourceSetTable::comm_type& comm,
+                     const CommCostModel& model) {
+    using level = CommCostModel::level;
+    std::vector<double> mine{model.parameters(level::intra_node).alpha,
+                             model.parameters(level::intra_node).beta,
+                             model.parameters(level::inter_node).alpha,
+                             model.parameters(level::inter_node).beta};
+    auto all = comm.gather(mine);
+    for(std::size_t i = 0; i < all.size(); ++i)
+        if(all[i] != mine[i % 4]) return false;
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("interconnect_probe") {
+    using level = CommCostModel::level;
+
+    auto& rt = testing::PZEnvironment::comm_world();
+    ResourceSetTable::comm_type comm(rt.mpi_comm());
+    ResourceSetTable table(comm);
+
+    ProbeSettings settings;
+    settings.large_message = 1 << 16;
+    settings.n_warmup      = 1;
+    settings.n_small       = 5;
+    settings.n_large       = 2;
+
+    SECTION("measure_link") {
+        if(comm.size() > 1) {
+            auto link = measure_link(comm.comm(), 0, 1, settings);
+            REQUIRE(link.alpha > 0.0);
+            REQUIRE(link.beta >= 0.0);
+            CommCostModel model(link, link);
+            REQUIRE(same_everywhere(comm, model));
+        }
+    }
+
+    SECTION("probe_interconnect") {
+        auto model = probe_interconnect(comm.comm(), table, settings);
+        REQUIRE(same_everywhere(comm, model));
+
+        if(comm.size() == 1) {
+            REQUIRE(model == CommCostModel{});
+        } else {
+            REQUIRE(model.parameters(level::intra_node).alpha > 0.0);
+            REQUIRE(model.parameters(level::inter_node).alpha > 0.0);
+        }
+        if(table.n_nodes() == 1) {
+            REQUIRE(model.parameters(level::intra_node) ==
+                    model.parameters(level::inter_node));
+        }
+    }
+
+    SECTION("default_cache_dir") {
+        const char* old = std::getenv("PARALLELZONE_CACHE_DIR");
+        const std::string saved = old ? old : "";
+
+        ::setenv("PARALLELZONE_CACHE_DIR", "/some/dir", 1);
+        REQUIRE(default_cache_dir() == "/some/dir");
+
+        if(old)
+            ::setenv("PARALLELZONE_CACHE_DIR", saved.c_str(), 1);
+        else
+            ::unsetenv("PARALLELZONE_CACHE_DIR");
+    }
+
+    SECTION("cost_model_cache_file") {
+        auto file = cost_model_cache_file("/some/dir", 0xabc);
+        REQUIRE(file == "/some/dir/comm_cost_model_abc.txt");
+        REQUIRE(cost_model_cache_file("/some/dir", 0xabd) != file);
+    }
+
+    SECTION("load_or_probe_interconnect") {
+        namespace fs   = std::filesystem;
+        const auto dir = fs::temp_directory_path() /
+                         ("pz_cache_" + std::to_string(::getpid()));
+        const auto key  = table.topology_hash();
+        const auto path = cost_model_cache_file(dir.string(), key);
+
+        // No caching
+        auto uncached =
+          load_or_probe_interconnect(comm.comm(), table, "", false);
+        REQUIRE(same_everywhere(comm, uncached));
+
+        // Probes and writes the cache
+        auto probed =
+          load_or_probe_interconnect(comm.comm(), table, dir.string(), false);
+        REQUIRE(same_everywhere(comm, probed));
+        if(comm.me() == 0) {
+            REQUIRE(fs::exists(path));
+            REQUIRE(*CommCostModel::load(path, key) == probed);
+        }
+
+        // Reads the cache (rank 0's file is what counts)
+        auto loaded =
+          load_or_probe_interconnect(comm.comm(), table, dir.string(), false);
+        REQUIRE(same_everywhere(comm, loaded));
+        if(comm.me() == 0) REQUIRE(loaded == probed);
+
+        // Reprobing overwrites the cache
+        auto reprobed =
+          load_or_probe_interconnect(comm.comm(), table, dir.string(), true);
+        if(comm.me() == 0) {
+            REQUIRE(*CommCostModel::load(path, key) == reprobed);
+        }
+
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+}
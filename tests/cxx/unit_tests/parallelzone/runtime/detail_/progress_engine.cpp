@@ -0,0 +1,145 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <parallelzone/runtime/detail_/progress_engine.hpp>
+#include <parallelzone/runtime/detail_/runtime_view_pimpl.hpp>
+
+using namespace parallelzone::runtime::detail_;
+
+/* Testing Notes
+ *
+ * The progress engine requires MPI to have been initialized with
+ * MPI_THREAD_MULTIPLE. If the unit tests were launched with a lower thread
+ * level we can only check that the engine refuses to start.
+ */
+
+TEST_CASE("ProgressEngine") {
+    using interval_type = ProgressEngine::interval_type;
+
+    auto& rt = testing::PZEnvironment::comm_world();
+    auto comm = rt.mpi_comm();
+    interval_type interval{50};
+
+    int provided;
+    MPI_Query_thread(&provided);
+
+    if(provided != MPI_THREAD_MULTIPLE) {
+        REQUIRE_THROWS_AS(ProgressEngine(interval), std::runtime_error);
+        return;
+    }
+
+    ProgressEngine engine(interval);
+
+    SECTION("CTor") {
+        REQUIRE(engine.running());
+        REQUIRE(engine.interval() == interval);
+        REQUIRE(engine.n_pending() == 0);
+    }
+
+    SECTION("register_request") {
+        SECTION("Null request") {
+            auto f = engine.register_request(MPI_REQUEST_NULL);
+            f.get();
+            REQUIRE(engine.n_pending() == 0);
+        }
+
+        SECTION("Barrier") {
+            MPI_Request request;
+            MPI_Ibarrier(comm, &request);
+            auto f = engine.register_request(request);
+            f.get();
+            REQUIRE(engine.n_pending() == 0);
+        }
+
+        SECTION("Many all gathers") {
+            int n_ranks, me;
+            MPI_Comm_size(comm, &n_ranks);
+            MPI_Comm_rank(comm, &me);
+
+            const int n = 4;
+            std::vector<int> in(n, me);
+            std::vector<std::vector<int>> out(n, std::vector<int>(n_ranks));
+            std::vector<ProgressEngine::future_type> futures;
+            for(int i = 0; i < n; ++i) {
+                MPI_Request request;
+                MPI_Iallgather(&in[i], 1, MPI_INT, out[i].data(), 1, MPI_INT,
+                               comm, &request);
+                futures.emplace_back(engine.register_request(request));
+            }
+            for(auto& f : futures) f.get();
+
+            std::vector<int> corr(n_ranks);
+            for(int i = 0; i < n_ranks; ++i) corr[i] = i;
+            for(const auto& x : out) REQUIRE(x == corr);
+        }
+    }
+
+    SECTION("stop") {
+        MPI_Request request;
+        MPI_Ibarrier(comm, &request);
+        auto f = engine.register_request(request);
+
+        // Outstanding requests are finished by stop
+        engine.stop();
+        REQUIRE_FALSE(engine.running());
+        REQUIRE(f.wait_for(interval_type{0}) == std::future_status::ready);
+        REQUIRE(engine.n_pending() == 0);
+
+        REQUIRE_THROWS_AS(engine.register_request(MPI_REQUEST_NULL),
+                          std::runtime_error);
+
+        // Calling it again is a no-op
+        engine.stop();
+        REQUIRE_FALSE(engine.running());
+    }
+}
+
+TEST_CASE("RuntimeViewPIMPL::start_progress_engine") {
+    auto& rt = testing::PZEnvironment::comm_world();
+    RuntimeViewPIMPL::comm_type comm(rt.mpi_comm());
+    parallelzone::Logger log;
+    ProgressEngine::interval_type interval{50};
+
+    int provided;
+    MPI_Query_thread(&provided);
+
+    RuntimeViewPIMPL pimpl(false, comm, log);
+    REQUIRE(pimpl.m_progress_engine == nullptr);
+
+    if(provided != MPI_THREAD_MULTIPLE) {
+        REQUIRE_THROWS_AS(pimpl.start_progress_engine(interval),
+                          std::runtime_error);
+        REQUIRE(pimpl.m_progress_engine == nullptr);
+        return;
+    }
+
+    ProgressEngine::future_type f;
+    {
+        RuntimeViewPIMPL falls_off(false, comm, log);
+        falls_off.start_progress_engine(interval);
+        REQUIRE(falls_off.m_progress_engine->running());
+        REQUIRE_THROWS_AS(falls_off.start_progress_engine(interval),
+                          std::runtime_error);
+
+        MPI_Request request;
+        MPI_Ibarrier(comm.comm(), &request);
+        f = falls_off.m_progress_engine->register_request(request);
+    }
+    // The finalize callback stopped the engine, which finished the barrier
+    REQUIRE(f.wait_for(ProgressEngine::interval_type{0}) ==
+            std::future_status::ready);
+}
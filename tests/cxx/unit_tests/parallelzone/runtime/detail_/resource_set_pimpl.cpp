@@ -47,6 +47,16 @@ TEST_CASE("ResourceSetPIMPL") {
 
         REQUIRE(*rank0.m_plogger == log);
         REQUIRE(*rank1.m_plogger == log);
+
+        // Known RAM size
+        ResourceSetPIMPL known(1, 42, 3, comm, log);
+        REQUIRE(known.m_rank == 1);
+        REQUIRE(known.m_ram == make_ram(42, 1, comm, 3));
+        REQUIRE(known.m_my_mpi == comm);
+        REQUIRE(*known.m_plogger == log);
+        REQUIRE(ResourceSetPIMPL(0, get_ram_size(), 0, comm, log) == rank0);
+        REQUIRE_FALSE(ResourceSetPIMPL(0, get_ram_size(), 1, comm, log) ==
+                      rank0);
     }
 
     SECTION("clone") {
@@ -74,7 +84,11 @@ TEST_CASE("ResourceSetPIMPL") {
     }
 }
 
-TEST_CASE("get_ram_size") { REQUIRE(get_ram_size() == 10); }
+TEST_CASE("get_ram_size") {
+    using namespace parallelzone::hardware::detail_;
+    REQUIRE(get_ram_size() > 0);
+    REQUIRE(get_ram_size() == total_memory());
+}
 
 TEST_CASE("make_resource_set") {
     using comm_type = ResourceSetPIMPL::mpi_comm_type;
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../test_parallelzone.hpp"
+#include <parallelzone/runtime/detail_/resource_set_table.hpp>
+
+using namespace parallelzone::runtime::detail_;
+
+TEST_CASE("ResourceSetTable") {
+    using table_type  = ResourceSetTable;
+    using record_type = table_type::record_type;
+
+    auto& rt = testing::PZEnvironment::comm_world();
+    table_type::comm_type comm(rt.mpi_comm());
+
+    table_type defaulted;
+    table_type from_comm(comm);
+    // Ranks 0 and 2 share a node, rank 1 is on a node with less RAM
+    table_type from_records(
+      {record_type{1, 7}, record_type{2, 3}, record_type{1, 7}});
+
+    SECTION("CTors") {
+        REQUIRE(defaulted.size() == 0);
+
+        REQUIRE(from_comm.size() == comm.size());
+        using parallelzone::hardware::detail_::total_memory;
+        REQUIRE(from_comm[comm.me()].m_ram_size == total_memory());
+
+        REQUIRE(table_type(table_type::comm_type{}).size() == 0);
+
+        REQUIRE(from_records.size() == 3);
+        REQUIRE(from_records[0].m_ram_size == 1);
+        REQUIRE(from_records[1].m_ram_size == 2);
+        REQUIRE(from_records[2].m_ram_size == 1);
+        REQUIRE(from_records[0].m_node_hash == 7);
+        REQUIRE(from_records[1].m_node_hash == 3);
+    }
+
+    SECTION("node map") {
+        REQUIRE(defaulted.n_nodes() == 0);
+
+        REQUIRE(from_records.n_nodes() == 2);
+        REQUIRE(from_records[0].m_node == 0);
+        REQUIRE(from_records[1].m_node == 1);
+        REQUIRE(from_records[2].m_node == 0);
+        REQUIRE(from_records[0].m_local_rank == 0);
+        REQUIRE(from_records[1].m_local_rank == 0);
+        REQUIRE(from_records[2].m_local_rank == 1);
+        using rank_container = table_type::rank_container;
+        REQUIRE(from_records.ranks_on_node(0) == rank_container{0, 2});
+        REQUIRE(from_records.ranks_on_node(1) == rank_container{1});
+
+        // Node and local rank are computed, not taken from the input
+        record_type bogus{1, 7, 5, 5};
+        table_type recomputed({bogus});
+        REQUIRE(recomputed[0].m_node == 0);
+        REQUIRE(recomputed[0].m_local_rank == 0);
+
+        // Every rank is on exactly one node and rank 0 is on node 0
+        REQUIRE(from_comm.n_nodes() >= 1);
+        REQUIRE(from_comm[0].m_node == 0);
+        table_type::size_type n = 0;
+        for(table_type::size_type i = 0; i < from_comm.n_nodes(); ++i) {
+            const auto& ranks = from_comm.ranks_on_node(i);
+            for(table_type::size_type j = 0; j < ranks.size(); ++j) {
+                REQUIRE(from_comm[ranks[j]].m_node == i);
+                REQUIRE(from_comm[ranks[j]].m_local_rank == j);
+            }
+            n += ranks.size();
+        }
+        REQUIRE(n == from_comm.size());
+        const auto my_hash = hash_node_name(processor_name());
+        REQUIRE(from_comm[comm.me()].m_node_hash == my_hash);
+    }
+
+    SECTION("count_ram") {
+        REQUIRE(defaulted.count_ram(1, 0) == 0);
+
+        REQUIRE(from_records.count_ram(0, 0) == 0);
+        REQUIRE(from_records.count_ram(1, 0) == 2);
+        REQUIRE(from_records.count_ram(2, 1) == 1);
+
+        // Same size, different node
+        REQUIRE(from_records.count_ram(2, 0) == 0);
+        REQUIRE(from_records.count_ram(1, 1) == 0);
+
+        // No such node
+        REQUIRE(from_records.count_ram(1, 2) == 0);
+
+        // Ranks on one node seeing different sizes (e.g., cgroup limits)
+        table_type mixed({record_type{1, 7}, record_type{2, 7},
+                          record_type{1, 7}});
+        REQUIRE(mixed.count_ram(1, 0) == 2);
+        REQUIRE(mixed.count_ram(2, 0) == 1);
+
+        const auto& mine = from_comm[comm.me()];
+        const auto n     = from_comm.ranks_on_node(mine.m_node).size();
+        REQUIRE(from_comm.count_ram(mine.m_ram_size, mine.m_node) == n);
+    }
+
+    SECTION("topology_hash") {
+        REQUIRE(from_comm.topology_hash() == table_type(comm).topology_hash());
+
+        // Only the node of each rank matters
+        auto h = from_records.topology_hash();
+        REQUIRE(table_type({{9, 7}, {9, 3}, {9, 7}}).topology_hash() == h);
+        REQUIRE(table_type({{1, 7}, {2, 7}, {1, 7}}).topology_hash() != h);
+        REQUIRE(table_type({{1, 7}, {2, 3}}).topology_hash() != h);
+        REQUIRE(defaulted.topology_hash() != h);
+    }
+
+    SECTION("hash_node_name") {
+        REQUIRE(hash_node_name("") == 14695981039346656037ull);
+        REQUIRE(hash_node_name("node0") == hash_node_name("node0"));
+        REQUIRE(hash_node_name("node0") != hash_node_name("node1"));
+    }
+
+    SECTION("operator==") {
+        REQUIRE(defaulted == table_type{});
+        REQUIRE(from_comm == table_type(comm));
+        REQUIRE(from_records == table_type({{1, 7}, {2, 3}, {1, 7}}));
+        REQUIRE_FALSE(from_records == table_type({{1, 7}, {2, 3}, {2, 7}}));
+        REQUIRE_FALSE(from_records == table_type({{1, 7}, {2, 3}, {1, 3}}));
+        REQUIRE_FALSE(from_records == defaulted);
+    }
+}
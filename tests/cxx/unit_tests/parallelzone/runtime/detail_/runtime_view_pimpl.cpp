@@ -44,14 +44,29 @@ TEST_CASE("RuntimeViewPIMPL") {
     SECTION("CTor") {
         REQUIRE_FALSE(pimpl.m_did_i_start_mpi);
         REQUIRE(pimpl.m_comm == comm);
+        REQUIRE(*pimpl.m_table == ResourceSetTable(comm));
     }
 
     SECTION("at") {
-        REQUIRE(pimpl.at(0) == make_resource_set(0, comm, log));
+        // The ResourceSets are built from the table
+        auto corr = [&](RuntimeViewPIMPL::size_type rank) {
+            const auto& record = (*pimpl.m_table)[rank];
+            auto p             = std::make_unique<ResourceSetPIMPL>(
+              rank, record.m_ram_size, record.m_node, comm, log);
+            return ResourceSet(std::move(p));
+        };
+        REQUIRE(pimpl.at(0) == corr(0));
+
+        if(comm.size() > 1) { REQUIRE(pimpl.at(1) == corr(1)); }
+    }
 
-        if(comm.size() > 1) {
-            REQUIRE(pimpl.at(1) == make_resource_set(1, comm, log));
-        }
+    SECTION("count") {
+        const auto& my_ram = pimpl.at(comm.me()).ram();
+        RuntimeViewPIMPL::size_type n = 0;
+        for(RuntimeViewPIMPL::size_type i = 0; i < comm.size(); ++i)
+            if(pimpl.at(i).ram() == my_ram) ++n;
+        REQUIRE(pimpl.count(my_ram) == n);
+        REQUIRE(pimpl.count(parallelzone::hardware::RAM{}) == 0);
     }
 
     SECTION("operator==") {
@@ -0,0 +1,284 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../../catch.hpp"
+#include <parallelzone/runtime/detail_/timer_registry.hpp>
+#include <thread>
+
+using namespace parallelzone;
+using namespace parallelzone::runtime::detail_;
+
+/* Testing Notes
+ *
+ * summarize is tested with the communicators made by CommPP::make_threaded,
+ * so the number of ranks, and what each rank timed, is under our control.
+ * Each rank stores its result and the assertions are made after the threads
+ * are joined.
+ */
+
+TEST_CASE("TimerRegistry") {
+    using report_type = TimerRegistry::report_type;
+
+    TimerRegistry registry;
+
+    SECTION("push/pop") {
+        auto [outer, outer_depth] = registry.push("outer");
+        REQUIRE(outer == "outer");
+        REQUIRE(outer_depth == 0);
+
+        auto [inner, inner_depth] = registry.push("inner");
+        REQUIRE(inner == "outer/inner");
+        REQUIRE(inner_depth == 1);
+
+        registry.pop(inner, inner_depth, 1.0, 0.5);
+        registry.pop(outer, outer_depth, 2.0, 1.5);
+
+        auto records = registry.records();
+        REQUIRE(records.size() == 2);
+        REQUIRE(records["outer"].n_calls == 1);
+        REQUIRE(records["outer"].wall == 2.0);
+        REQUIRE(records["outer"].cpu == 1.5);
+        REQUIRE(records["outer/inner"].wall == 1.0);
+
+        // Not nested anymore
+        auto [again, again_depth] = registry.push("inner");
+        REQUIRE(again == "inner");
+        REQUIRE(again_depth == 0);
+        registry.pop(again, again_depth, 1.0, 1.0);
+    }
+
+    SECTION("totals accumulate") {
+        for(int i = 0; i < 3; ++i) {
+            auto [path, depth] = registry.push("loop");
+            registry.pop(path, depth, 1.0, 0.25);
+        }
+        auto records = registry.records();
+        REQUIRE(records["loop"].n_calls == 3);
+        REQUIRE(records["loop"].wall == 3.0);
+        REQUIRE(records["loop"].cpu == 0.75);
+    }
+
+    SECTION("ending a parent drops unfinished children") {
+        auto [outer, outer_depth] = registry.push("outer");
+        registry.push("leaked");
+        registry.pop(outer, outer_depth, 1.0, 1.0);
+        auto [next, next_depth] = registry.push("next");
+        REQUIRE(next == "next");
+        REQUIRE(next_depth == 0);
+    }
+
+    SECTION("threads nest independently") {
+        auto [outer, outer_depth] = registry.push("outer");
+        std::string other;
+        std::thread t([&]() { other = registry.push("other").first; });
+        t.join();
+        REQUIRE(other == "other");
+        registry.pop(outer, outer_depth, 1.0, 1.0);
+    }
+
+    SECTION("pop with counters") {
+        using event = TimerRegistry::event_type;
+        auto [path, depth] = registry.push("region");
+        registry.pop(path, depth, 1.0, 1.0, {{event::cycles, 10.0}});
+        auto [again, again_depth] = registry.push("region");
+        registry.pop(again, again_depth, 1.0, 1.0, {{event::cycles, 5.0}});
+        REQUIRE(registry.records()["region"].counters[event::cycles] == 15.0);
+    }
+
+    SECTION("hardware counters") {
+        using event          = TimerRegistry::event_type;
+        using counter_values = TimerRegistry::counter_values;
+        REQUIRE(registry.counter_events().empty());
+
+        // Nothing is counted until events are set
+        counter_values start;
+        REQUIRE(registry.start_counters(0, start) == 0);
+        REQUIRE(registry.stop_counters(0, start).empty());
+
+        registry.set_counter_events(
+          {event::page_faults, event::flops, event::page_faults});
+        REQUIRE(registry.counter_events().size() == 3);
+
+        const auto id = registry.start_counters(0, start);
+        REQUIRE(id != 0);
+        REQUIRE(start.size() == 3);
+
+        // Nested regions reuse the thread's counters
+        counter_values nested_start;
+        REQUIRE(registry.start_counters(1, nested_start) == id);
+
+        // Bigger than malloc's largest mmap threshold, so pages are fresh
+        std::vector<char> buffer(1 << 26, 1);
+        volatile char sink = buffer.back();
+        (void)sink;
+
+        // getrusage can always count page faults, only PAPI counts flops.
+        // Repeated events are reported once
+        const auto deltas = registry.stop_counters(id, start);
+        REQUIRE(deltas.size() ==
+                (parallelzone::hardware::HardwareCounters::have_papi() ? 2 :
+                                                                         1));
+        REQUIRE(deltas[0].first == event::page_faults);
+        REQUIRE(deltas[0].second > 0.0);
+
+        // Outermost regions with the same events keep the counters open
+        REQUIRE(registry.start_counters(0, start) == id);
+
+        // New events reopen them, so older readings are no longer valid
+        registry.set_counter_events({event::context_switches});
+        const auto new_id = registry.start_counters(0, start);
+        REQUIRE(new_id != id);
+        REQUIRE(registry.stop_counters(id, nested_start).empty());
+        REQUIRE(registry.stop_counters(new_id, start).size() == 1);
+
+        // Other threads have their own counters
+        std::size_t other_id = 0;
+        bool foreign_id_ignored = false;
+        std::thread t([&]() {
+            counter_values other;
+            other_id           = registry.start_counters(0, other);
+            foreign_id_ignored = registry.stop_counters(new_id, other).empty();
+        });
+        t.join();
+        REQUIRE(other_id != 0);
+        REQUIRE(foreign_id_ignored);
+
+        registry.set_counter_events({});
+        REQUIRE(registry.start_counters(0, start) == 0);
+    }
+
+    SECTION("clear") {
+        auto [path, depth] = registry.push("region");
+        registry.pop(path, depth, 1.0, 1.0);
+        registry.clear();
+        REQUIRE(registry.records().empty());
+    }
+
+    SECTION("summarize") {
+        const std::size_t n = 4;
+        auto comms          = mpi_helpers::CommPP::make_threaded(int(n));
+        std::vector<report_type> reports(n);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < n; ++i) {
+            threads.emplace_back([&, i]() {
+                // Rank i spends i + 1 seconds in "work", and only ranks 0
+                // and 1 do "io" (nested in "work")
+                TimerRegistry::record_map records;
+                records["work"] = {1, double(i + 1), double(i + 1) / 2.0};
+                if(i < 2) records["work/io"] = {2, 1.0 + 2 * i, 0.5};
+                reports[i] = TimerRegistry::summarize(comms[i], records);
+            });
+        }
+        for(auto& thread : threads) thread.join();
+
+        for(const auto& report : reports) REQUIRE(report == reports[0]);
+        const auto& report = reports[0];
+        REQUIRE(report.size() == 2);
+
+        const auto& work = report[0];
+        REQUIRE(work.path == "work");
+        REQUIRE(work.depth == 0);
+        REQUIRE(work.n_ranks == n);
+        REQUIRE(work.n_calls == n);
+        REQUIRE(work.wall_min == 1.0);
+        REQUIRE(work.wall_mean == Approx(2.5));
+        REQUIRE(work.wall_max == 4.0);
+        REQUIRE(work.cpu_min == 0.5);
+        REQUIRE(work.cpu_mean == Approx(1.25));
+        REQUIRE(work.cpu_max == 2.0);
+        REQUIRE(work.imbalance() == Approx(1.6));
+
+        const auto& io = report[1];
+        REQUIRE(io.path == "work/io");
+        REQUIRE(io.depth == 1);
+        // The ranks which did not do "io" are left out of the statistics
+        REQUIRE(io.n_ranks == 2);
+        REQUIRE(io.n_calls == 4);
+        REQUIRE(io.wall_min == 1.0);
+        REQUIRE(io.wall_mean == Approx(2.0));
+        REQUIRE(io.wall_max == 3.0);
+        REQUIRE(io.cpu_min == 0.5);
+        REQUIRE(io.cpu_mean == Approx(0.5));
+        REQUIRE(io.cpu_max == 0.5);
+        REQUIRE(io.imbalance() == Approx(1.5));
+    }
+
+    SECTION("summarize hardware counters") {
+        using event         = TimerRegistry::event_type;
+        const std::size_t n = 3;
+        auto comms          = mpi_helpers::CommPP::make_threaded(int(n));
+        std::vector<report_type> reports(n);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < n; ++i) {
+            threads.emplace_back([&, i]() {
+                // Rank i has i + 1 cache misses in "work", rank 2 can not
+                // count cache misses, and only rank 0 enters "io"
+                TimerRegistry::record_map records;
+                records["work"] = {1, 1.0, 1.0};
+                if(i < 2)
+                    records["work"].counters[event::cache_misses] = i + 1.0;
+                if(i == 0) {
+                    records["work/io"] = {1, 1.0, 1.0};
+                    records["work/io"].counters[event::cache_misses] = 0.5;
+                }
+                reports[i] = TimerRegistry::summarize(comms[i], records);
+            });
+        }
+        for(auto& thread : threads) thread.join();
+
+        for(const auto& report : reports) REQUIRE(report == reports[0]);
+        const auto& report = reports[0];
+        REQUIRE(report.size() == 2);
+
+        const auto& work = report[0];
+        REQUIRE(work.counters.size() == 1);
+        const auto& misses = work.counters[0];
+        REQUIRE(misses.event == event::cache_misses);
+        REQUIRE(misses.n_ranks == 2);
+        REQUIRE(misses.min == 1.0);
+        REQUIRE(misses.mean == Approx(1.5));
+        REQUIRE(misses.max == 2.0);
+        REQUIRE(work.counter(event::flops) == nullptr);
+
+        // Rank 1 counted cache misses, but did not enter "io"
+        const auto* io = report[1].counter(event::cache_misses);
+        REQUIRE(io != nullptr);
+        REQUIRE(io->n_ranks == 1);
+        REQUIRE(io->min == 0.5);
+        REQUIRE(io->mean == Approx(0.5));
+        REQUIRE(io->max == 0.5);
+    }
+
+    SECTION("summarize with nothing timed") {
+        auto comms = mpi_helpers::CommPP::make_threaded(2);
+        std::vector<report_type> reports(2, report_type(1));
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < 2; ++i) {
+            threads.emplace_back([&, i]() {
+                reports[i] = TimerRegistry::summarize(comms[i], {});
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        for(const auto& report : reports) REQUIRE(report.empty());
+    }
+
+    SECTION("thread_cpu_time") {
+        const auto start = TimerRegistry::thread_cpu_time();
+        volatile double x = 0.0;
+        for(int i = 0; i < 1000000; ++i) x = x + 1.0;
+        REQUIRE(TimerRegistry::thread_cpu_time() >= start);
+    }
+}
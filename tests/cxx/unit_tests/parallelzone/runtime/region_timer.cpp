@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../catch.hpp"
+#include <algorithm>
+#include <parallelzone/runtime/detail_/timer_registry.hpp>
+#include <parallelzone/runtime/region_timer.hpp>
+#include <thread>
+
+using namespace parallelzone::runtime;
+
+TEST_CASE("RegionStatistics") {
+    RegionStatistics stats;
+    stats.path      = "scf/fock_build";
+    stats.depth     = 1;
+    stats.wall_mean = 2.0;
+    stats.wall_max  = 3.0;
+
+    SECTION("name") {
+        REQUIRE(stats.name() == "fock_build");
+        REQUIRE(RegionStatistics{}.name() == "");
+    }
+
+    SECTION("imbalance") {
+        REQUIRE(stats.imbalance() == 1.5);
+        REQUIRE(RegionStatistics{}.imbalance() == 1.0);
+    }
+
+    SECTION("counter") {
+        using event = RegionStatistics::event_type;
+        REQUIRE(stats.counter(event::flops) == nullptr);
+        REQUIRE(stats.gflops() == 0.0);
+
+        CounterStatistics flops;
+        flops.event = event::flops;
+        flops.mean  = 4.0e9;
+        stats.counters.push_back(flops);
+        REQUIRE(stats.counter(event::flops) == &stats.counters[0]);
+        REQUIRE(stats.gflops() == Approx(2.0));
+    }
+
+    SECTION("comparisons") {
+        auto copy = stats;
+        REQUIRE(copy == stats);
+        copy.n_calls = 2;
+        REQUIRE(copy != stats);
+
+        copy = stats;
+        copy.counters.emplace_back();
+        REQUIRE(copy != stats);
+    }
+
+    SECTION("to_string") {
+        RegionStatistics scf;
+        scf.path = "scf";
+        auto table = to_string({scf, stats});
+
+        // Header plus one line per region
+        REQUIRE(std::count(table.begin(), table.end(), '\n') == 2);
+        REQUIRE(table.find("Region") == 0);
+        REQUIRE(table.find("\nscf ") != std::string::npos);
+        REQUIRE(table.find("\n  fock_build ") != std::string::npos);
+        REQUIRE(table.find("1.50") != std::string::npos);
+        REQUIRE(table.find("GFLOP/s") == std::string::npos);
+    }
+
+    SECTION("to_string with counters") {
+        CounterStatistics flops;
+        flops.event = RegionStatistics::event_type::flops;
+        flops.mean  = 6.0e9;
+        stats.counters.push_back(flops);
+        auto table = to_string({stats});
+
+        REQUIRE(table.find("flops") != std::string::npos);
+        REQUIRE(table.find("GFLOP/s") != std::string::npos);
+        REQUIRE(table.find("6000000000") != std::string::npos);
+        REQUIRE(table.find("3.000") != std::string::npos);
+    }
+}
+
+TEST_CASE("RegionTimer") {
+    using registry_type = RegionTimer::registry_type;
+    auto registry       = std::make_shared<registry_type>();
+
+    SECTION("Default") {
+        RegionTimer t;
+        REQUIRE_FALSE(t.running());
+        REQUIRE(t.path() == "");
+        t.stop(); // No-op
+    }
+
+    SECTION("Scoped") {
+        {
+            RegionTimer t(registry, "region");
+            REQUIRE(t.running());
+            REQUIRE(t.path() == "region");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        auto records = registry->records();
+        REQUIRE(records.size() == 1);
+        REQUIRE(records["region"].n_calls == 1);
+        REQUIRE(records["region"].wall >= 0.01);
+        // Sleeping should use (much) less CPU time than wall time
+        REQUIRE(records["region"].cpu >= 0.0);
+        REQUIRE(records["region"].cpu < records["region"].wall);
+    }
+
+    SECTION("Nesting") {
+        RegionTimer outer(registry, "outer");
+        {
+            RegionTimer inner(registry, "inner");
+            REQUIRE(inner.path() == "outer/inner");
+        }
+        outer.stop();
+        REQUIRE_FALSE(outer.running());
+        outer.stop(); // Only counted once
+
+        auto records = registry->records();
+        REQUIRE(records["outer"].n_calls == 1);
+        REQUIRE(records["outer/inner"].n_calls == 1);
+        REQUIRE(records["outer"].wall >= records["outer/inner"].wall);
+    }
+
+    SECTION("move ctor") {
+        RegionTimer t(registry, "region");
+        RegionTimer moved(std::move(t));
+        REQUIRE_FALSE(t.running());
+        REQUIRE(moved.running());
+        REQUIRE(moved.path() == "region");
+        t.stop();
+        REQUIRE(registry->records().empty());
+        moved.stop();
+        REQUIRE(registry->records()["region"].n_calls == 1);
+    }
+
+    SECTION("move assignment") {
+        RegionTimer t(registry, "first");
+        t = RegionTimer(registry, "second");
+        REQUIRE(t.path() == "first/second");
+        REQUIRE(registry->records()["first"].n_calls == 1);
+        t.stop();
+        REQUIRE(registry->records()["first/second"].n_calls == 1);
+    }
+}
@@ -134,6 +134,22 @@ TEST_CASE("ResourceSet") {
         REQUIRE_NOTHROW(rs.ram());
     }
 
+    SECTION("has_cpu") {
+        REQUIRE_FALSE(defaulted.has_cpu());
+        REQUIRE_FALSE(null.has_cpu());
+        REQUIRE(rs.has_cpu());
+
+        // Only the local ResourceSet knows its CPU
+        for(size_type i = 0; i < world.size(); ++i)
+            REQUIRE(world.at(i).has_cpu() == world.at(i).is_mine());
+    }
+
+    SECTION("cpu") {
+        REQUIRE_THROWS_AS(defaulted.cpu(), std::out_of_range);
+        REQUIRE_THROWS_AS(null.cpu(), std::out_of_range);
+        REQUIRE(rs.cpu().n_hardware_threads() > 0);
+    }
+
     SECTION("logger") {
         REQUIRE_THROWS_AS(defaulted.logger(), std::runtime_error);
         REQUIRE(rs.logger() == log);
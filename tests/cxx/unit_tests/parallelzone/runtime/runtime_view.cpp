@@ -16,10 +16,13 @@
 
 #include "../test_parallelzone.hpp"
 #include <iostream>
+#include <parallelzone/logging/detail_/spdlog/spdlog.hpp>
 #include <parallelzone/logging/logger_factory.hpp>
 #include <parallelzone/mpi_helpers/commpp/commpp.hpp>
 #include <parallelzone/runtime/detail_/resource_set_pimpl.hpp>
+#include <spdlog/sinks/ostream_sink.h>
 #include <sstream>
+#include <thread>
 
 using namespace parallelzone;
 using namespace runtime;
@@ -51,6 +54,24 @@ TEST_CASE("RuntimeView") {
             REQUIRE(defaulted.mpi_comm() == MPI_COMM_WORLD);
             REQUIRE_FALSE(defaulted.did_i_start_mpi());
         }
+
+        SECTION("thread level") {
+            using thread_level = RuntimeView::thread_level;
+            // MPI is already running, so the request is ignored
+            RuntimeView rt(0, nullptr, thread_level::multiple);
+            REQUIRE(rt == defaulted);
+            REQUIRE_FALSE(rt.did_i_start_mpi());
+
+            RuntimeView rt2(0, nullptr, comm.comm(), thread_level::funneled);
+            REQUIRE(rt2 == defaulted);
+        }
+        SECTION("CommPP") {
+            RuntimeView rt(comm);
+            REQUIRE(rt.mpi_comm() == MPI_COMM_WORLD);
+            REQUIRE(rt.size() == defaulted.size());
+            REQUIRE_FALSE(rt.did_i_start_mpi());
+        }
+
         SECTION("argc and argv") {
             REQUIRE(argc_argv.size() > 0);
             REQUIRE(argc_argv.mpi_comm() == MPI_COMM_WORLD);
@@ -160,6 +181,63 @@ TEST_CASE("RuntimeView") {
         REQUIRE(argc_argv.did_i_start_mpi());
     }
 
+    SECTION("provided_thread_level") {
+        using thread_level = RuntimeView::thread_level;
+        REQUIRE(null.provided_thread_level() == thread_level::single);
+
+        int provided;
+        MPI_Query_thread(&provided);
+        auto corr = thread_level::single;
+        if(provided == MPI_THREAD_FUNNELED) corr = thread_level::funneled;
+        if(provided == MPI_THREAD_SERIALIZED) corr = thread_level::serialized;
+        if(provided == MPI_THREAD_MULTIPLE) corr = thread_level::multiple;
+        REQUIRE(defaulted.provided_thread_level() == corr);
+        REQUIRE(argc_argv.provided_thread_level() == corr);
+    }
+
+    SECTION("thread_comm") {
+        REQUIRE_THROWS_AS(null.thread_comm(0), std::runtime_error);
+        REQUIRE_THROWS_AS(null.reserve_thread_comms(1), std::runtime_error);
+
+        // Creates 0 and 1, asking for fewer does nothing
+        defaulted.reserve_thread_comms(2);
+        auto comm1 = defaulted.thread_comm(1);
+        auto comm0 = defaulted.thread_comm(0);
+        defaulted.reserve_thread_comms(1);
+        REQUIRE(defaulted.thread_comm(1) == comm1);
+
+        // thread_comm never creates a communicator
+        REQUIRE_THROWS_AS(defaulted.thread_comm(2), std::out_of_range);
+
+        int result;
+        MPI_Comm_compare(comm0, defaulted.mpi_comm(), &result);
+        REQUIRE(result == MPI_CONGRUENT);
+        MPI_Comm_compare(comm0, comm1, &result);
+        REQUIRE(result == MPI_CONGRUENT);
+
+        // Copies share the duplicates
+        RuntimeView copy(defaulted);
+        REQUIRE(copy.thread_comm(0) == comm0);
+
+        if(defaulted.provided_thread_level() ==
+           RuntimeView::thread_level::multiple) {
+            // Concurrent collectives, one per thread
+            std::vector<int> sums(2, 0);
+            auto fxn = [&](std::size_t i) {
+                int me = comm.me();
+                MPI_Allreduce(&me, &sums[i], 1, MPI_INT, MPI_SUM,
+                              defaulted.thread_comm(i));
+            };
+            std::thread t0(fxn, 0);
+            std::thread t1(fxn, 1);
+            t0.join();
+            t1.join();
+            const int n    = defaulted.size();
+            const int corr = n * (n - 1) / 2;
+            REQUIRE(sums == std::vector<int>(2, corr));
+        }
+    }
+
     SECTION("at()") {
         REQUIRE_THROWS_AS(null.at(0), std::out_of_range);
         auto n_resource_sets = defaulted.size();
@@ -198,6 +276,77 @@ TEST_CASE("RuntimeView") {
 
         REQUIRE(argc_argv.count(ram) == 0);
         REQUIRE(argc_argv.count(rank0_ram) >= 1);
+
+        // Agrees with checking every ResourceSet, and counts whole nodes
+        RuntimeView::size_type n = 0;
+        for(RuntimeView::size_type i = 0; i < defaulted.size(); ++i)
+            if(defaulted.at(i).ram() == rank0_ram) ++n;
+        REQUIRE(defaulted.count(rank0_ram) == n);
+        REQUIRE(n == defaulted.ranks_on_node(0).size());
+    }
+
+    SECTION("node map") {
+        REQUIRE(null.n_nodes() == 0);
+        REQUIRE_THROWS_AS(null.node_of(0), std::out_of_range);
+        REQUIRE_THROWS_AS(null.ranks_on_node(0), std::out_of_range);
+        REQUIRE_THROWS_AS(null.local_rank(), std::runtime_error);
+
+        const auto n_nodes = defaulted.n_nodes();
+        REQUIRE(n_nodes >= 1);
+        REQUIRE(n_nodes <= defaulted.size());
+        REQUIRE(defaulted.node_of(0) == 0);
+        REQUIRE_THROWS_AS(defaulted.node_of(defaulted.size()),
+                          std::out_of_range);
+        REQUIRE_THROWS_AS(defaulted.ranks_on_node(n_nodes), std::out_of_range);
+
+        for(RuntimeView::size_type node = 0; node < n_nodes; ++node) {
+            for(auto rank : defaulted.ranks_on_node(node)) {
+                REQUIRE(defaulted.node_of(rank) == node);
+                REQUIRE(defaulted.at(rank).ram().node() == node);
+            }
+        }
+
+        const auto me     = defaulted.my_resource_set().mpi_rank();
+        const auto& ranks = defaulted.ranks_on_node(defaulted.node_of(me));
+        REQUIRE(ranks.at(defaulted.local_rank()) == me);
+
+        REQUIRE(argc_argv.n_nodes() == n_nodes);
+        REQUIRE(argc_argv.local_rank() == defaulted.local_rank());
+    }
+
+    SECTION("comm cost model") {
+        REQUIRE_FALSE(null.has_comm_cost_model());
+        REQUIRE_THROWS_AS(null.characterize_interconnect(""),
+                          std::runtime_error);
+
+        REQUIRE_FALSE(defaulted.has_comm_cost_model());
+        REQUIRE_THROWS_AS(defaulted.comm_cost_model(), std::runtime_error);
+        REQUIRE_THROWS_AS(defaulted.comm_cost(8, 0, 0), std::runtime_error);
+
+        // Empty cache directory means no caching
+        defaulted.characterize_interconnect("");
+        REQUIRE(defaulted.has_comm_cost_model());
+
+        // Shared by copies
+        RuntimeView copy(defaulted);
+        REQUIRE(copy.comm_cost_model() == defaulted.comm_cost_model());
+
+        const auto n = defaulted.size();
+        REQUIRE_THROWS_AS(defaulted.comm_cost(8, n, 0), std::out_of_range);
+        REQUIRE_THROWS_AS(defaulted.comm_cost(8, 0, n), std::out_of_range);
+
+        using level       = RuntimeView::comm_cost_model_type::level;
+        const auto& model = defaulted.comm_cost_model();
+        REQUIRE(defaulted.comm_cost(1024, 0, 0) == 0.0);
+        for(RuntimeView::size_type dst = 1; dst < n; ++dst) {
+            const auto l = defaulted.node_of(dst) == defaulted.node_of(0) ?
+                             level::intra_node :
+                             level::inter_node;
+            REQUIRE(defaulted.comm_cost(1024, 0, dst) == model.cost(1024, l));
+            REQUIRE(defaulted.comm_cost(1024, 0, dst) > 0.0);
+            REQUIRE(defaulted.comm_cost(1 << 20, 0, dst) >=
+                    defaulted.comm_cost(1024, 0, dst));
+        }
     }
 
     SECTION("logger") {
@@ -208,6 +357,91 @@ TEST_CASE("RuntimeView") {
         }
     }
 
+    SECTION("limit_logging") {
+        const auto me   = defaulted.my_resource_set().mpi_rank();
+        const auto log0 = defaulted.logger();
+        RuntimeView::log_limits_type limits;
+        limits.rank_stride = 0;
+        REQUIRE_THROWS_AS(defaulted.limit_logging(limits), std::out_of_range);
+        REQUIRE(defaulted.logger() == log0);
+
+        limits.rank_stride = 1;
+        defaulted.limit_logging(limits);
+        // Only rank 0 has a program-wide logger to wrap
+        if(me == 0) {
+            REQUIRE(defaulted.logger() != log0);
+        } else {
+            REQUIRE(defaulted.logger() == Logger());
+        }
+        REQUIRE(defaulted.my_resource_set().logger() == Logger());
+        REQUIRE_THROWS_AS(null.limit_logging(limits), std::runtime_error);
+    }
+
+    SECTION("timers") {
+        defaulted.clear_timers();
+        {
+            auto outer = defaulted.timer("outer");
+            auto inner = defaulted.timer("inner");
+            REQUIRE(inner.path() == "outer/inner");
+        }
+        // Copies share the totals
+        RuntimeView copy(defaulted);
+        copy.timer("other").stop();
+
+        auto report = defaulted.report_timers();
+        REQUIRE(report.size() == 3);
+        REQUIRE(report[0].path == "other");
+        REQUIRE(report[1].path == "outer");
+        REQUIRE(report[2].path == "outer/inner");
+        for(const auto& stats : report) {
+            REQUIRE(stats.n_ranks == defaulted.size());
+            REQUIRE(stats.n_calls == defaulted.size());
+            REQUIRE(stats.wall_min <= stats.wall_mean);
+            REQUIRE(stats.wall_mean <= stats.wall_max);
+        }
+
+        defaulted.clear_timers();
+        REQUIRE(defaulted.report_timers().empty());
+
+        REQUIRE_THROWS_AS(null.timer("region"), std::runtime_error);
+        REQUIRE_THROWS_AS(null.report_timers(), std::runtime_error);
+        REQUIRE_THROWS_AS(null.report_timers_at_finalize(), std::runtime_error);
+        REQUIRE_THROWS_AS(null.clear_timers(), std::runtime_error);
+    }
+
+    SECTION("enable_hardware_counters") {
+        using event = hardware::HardwareCounters::event;
+        defaulted.clear_timers();
+        defaulted.enable_hardware_counters({event::page_faults, event::flops});
+        {
+            auto t = defaulted.timer("region");
+            // Bigger than malloc's largest mmap threshold, so pages are fresh
+            std::vector<char> buffer(1 << 26, 1);
+            volatile char sink = buffer.back();
+            (void)sink;
+        }
+        defaulted.enable_hardware_counters({});
+
+        auto report = defaulted.report_timers();
+        REQUIRE(report.size() == 1);
+        // getrusage can always count page faults
+        const auto* faults = report[0].counter(event::page_faults);
+        REQUIRE(faults != nullptr);
+        REQUIRE(faults->n_ranks == defaulted.size());
+        REQUIRE(faults->max > 0.0);
+        if(!hardware::HardwareCounters::have_papi())
+            REQUIRE(report[0].counter(event::flops) == nullptr);
+
+        // Disabled again
+        defaulted.clear_timers();
+        defaulted.timer("region").stop();
+        REQUIRE(defaulted.report_timers()[0].counters.empty());
+        defaulted.clear_timers();
+
+        REQUIRE_THROWS_AS(null.enable_hardware_counters({}),
+                          std::runtime_error);
+    }
+
     SECTION("stack_callback I") {
         // Simulate initialization
         bool is_running = true;
@@ -241,6 +475,86 @@ TEST_CASE("RuntimeView") {
         REQUIRE(func_no == 3);
     }
 
+    SECTION("dtor dumps flight recorders during unwinding") {
+        std::stringstream ss;
+        auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+        auto spdlog_log = spdlog::logger("ss_log", sink);
+        spdlog_log.set_pattern("%v");
+        using sink_type = parallelzone::detail_::SpdlogPIMPL;
+        Logger log(std::make_unique<sink_type>(spdlog_log));
+        auto fr = LoggerFactory::make_flight_recorder(log);
+
+        {
+            RuntimeView rt;
+            fr.info("Not unwinding");
+        }
+        REQUIRE(ss.str().empty());
+
+        try {
+            RuntimeView rt;
+            fr.info("Unwinding");
+            throw std::runtime_error("Oops");
+        } catch(const std::runtime_error&) {}
+        REQUIRE(ss.str() == "[Flight recorder, thread 0] Not unwinding\n"
+                            "[Flight recorder, thread 0] Unwinding\n");
+
+        // Only destroying the last copy dumps
+        ss.str("");
+        RuntimeView survivor;
+        try {
+            RuntimeView copy(survivor);
+            fr.info("Copy unwinding");
+            throw std::runtime_error("Oops");
+        } catch(const std::runtime_error&) {}
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("clean teardown does not dump the logger's flight recorder") {
+        std::stringstream ss;
+        auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+        auto spdlog_log = spdlog::logger("ss_log", sink);
+        spdlog_log.set_pattern("%v");
+        using sink_type = parallelzone::detail_::SpdlogPIMPL;
+        Logger log(std::make_unique<sink_type>(spdlog_log));
+
+        {
+            RuntimeView rt;
+            rt.logger() = LoggerFactory::make_flight_recorder(log);
+            rt.logger().info("Not dumped");
+        }
+        REQUIRE(ss.str().empty());
+    }
+
+    SECTION("progress thread") {
+        REQUIRE_FALSE(null.progress_thread_running());
+        REQUIRE_THROWS_AS(null.start_progress_thread(), std::runtime_error);
+        REQUIRE_FALSE(defaulted.progress_thread_running());
+
+        MPI_Request request;
+        MPI_Ibarrier(comm.comm(), &request);
+        REQUIRE_THROWS_AS(defaulted.register_request(request),
+                          std::runtime_error);
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+        int provided;
+        MPI_Query_thread(&provided);
+        if(provided == MPI_THREAD_MULTIPLE) {
+            defaulted.start_progress_thread();
+            REQUIRE(defaulted.progress_thread_running());
+            REQUIRE_THROWS_AS(defaulted.start_progress_thread(),
+                              std::runtime_error);
+
+            MPI_Ibarrier(comm.comm(), &request);
+            auto f = defaulted.register_request(request);
+            f.wait();
+            REQUIRE(f.valid());
+        } else {
+            REQUIRE_THROWS_AS(defaulted.start_progress_thread(),
+                              std::runtime_error);
+            REQUIRE_FALSE(defaulted.progress_thread_running());
+        }
+    }
+
     SECTION("gather") {
         using data_type = std::vector<std::string>;
         data_type local_data(3, "Hello");
@@ -290,3 +604,147 @@ TEST_CASE("RuntimeView") {
         REQUIRE_FALSE(defaulted == argc_argv);
     }
 }
+
+/* Testing notes
+ *
+ * run_threaded calls the provided function from several threads. Since
+ * Catch2's assertions are not thread-safe the function only records what each
+ * rank sees, and the assertions are made after run_threaded returns.
+ */
+TEST_CASE("RuntimeView::run_threaded") {
+    using thread_level = RuntimeView::thread_level;
+    const std::size_t n = 4;
+
+    SECTION("No ranks") {
+        auto fxn = [](RuntimeView&) {};
+        REQUIRE_THROWS_AS(RuntimeView::run_threaded(0, fxn), std::out_of_range);
+    }
+
+    SECTION("State") {
+        std::vector<std::size_t> sizes(n), n_calls(n), n_nodes(n);
+        std::vector<int> is_null_comm(n), is_single(n), n_throws(n);
+        RuntimeView::run_threaded(n, [&](RuntimeView& rt) {
+            const auto me    = rt.my_resource_set().mpi_rank();
+            const auto level = rt.provided_thread_level();
+            sizes[me]        = rt.size();
+            n_nodes[me]      = rt.n_nodes();
+            is_null_comm[me] = rt.mpi_comm() == MPI_COMM_NULL;
+            is_single[me]    = level == thread_level::single;
+            ++n_calls[me];
+
+            // The MPI-specific features are unavailable
+            try {
+                rt.thread_comm(0);
+            } catch(const std::runtime_error&) { ++n_throws[me]; }
+            try {
+                rt.start_progress_thread();
+            } catch(const std::runtime_error&) { ++n_throws[me]; }
+            try {
+                rt.characterize_interconnect("");
+            } catch(const std::runtime_error&) { ++n_throws[me]; }
+        });
+        for(std::size_t i = 0; i < n; ++i) {
+            REQUIRE(sizes[i] == n);
+            REQUIRE(n_calls[i] == 1);
+            REQUIRE(n_nodes[i] == 1);
+            REQUIRE(is_null_comm[i]);
+            REQUIRE(is_single[i]);
+            REQUIRE(n_throws[i] == 3);
+        }
+    }
+
+    SECTION("gather") {
+        using data_type = std::vector<std::string>;
+        std::vector<std::vector<data_type>> results(n);
+        RuntimeView::run_threaded(n, [&](RuntimeView& rt) {
+            const auto me = rt.my_resource_set().mpi_rank();
+            results[me]   = rt.gather(data_type(3, "Hello"));
+        });
+        std::vector<data_type> corr(n, data_type(3, "Hello"));
+        for(const auto& result : results) REQUIRE(result == corr);
+    }
+
+    SECTION("gatherv") {
+        using data_type = std::vector<std::string>;
+        std::vector<std::vector<data_type>> results(n);
+        RuntimeView::run_threaded(n, [&](RuntimeView& rt) {
+            const auto me = rt.my_resource_set().mpi_rank();
+            results[me]   = rt.gatherv(data_type(me, "Hello"));
+        });
+        std::vector<data_type> corr;
+        for(std::size_t i = 0; i < n; ++i) corr.emplace_back(i, "Hello");
+        for(const auto& result : results) REQUIRE(result == corr);
+    }
+
+    SECTION("reduce") {
+        using data_type = std::vector<double>;
+        std::vector<data_type> results(n);
+        RuntimeView::run_threaded(n, [&](RuntimeView& rt) {
+            const auto me = rt.my_resource_set().mpi_rank();
+            results[me]   = rt.reduce(data_type(3, 1.0), std::plus<double>());
+        });
+        for(const auto& result : results) REQUIRE(result == data_type(3, n));
+    }
+
+    SECTION("timers") {
+        std::stringstream ss;
+        auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+        auto spdlog_log = spdlog::logger("timer_log", sink);
+        spdlog_log.set_pattern("%v");
+        using sink_type = parallelzone::detail_::SpdlogPIMPL;
+
+        std::vector<RuntimeView::timer_report_type> reports(n);
+        RuntimeView::run_threaded(n, [&](RuntimeView& rt) {
+            const auto me = rt.my_resource_set().mpi_rank();
+            // Only rank 0 has a program-wide logger
+            if(me == 0) {
+                Logger log(std::make_unique<sink_type>(spdlog_log));
+                rt.logger().swap(log);
+            }
+
+            // Only rank 0 times "io"
+            {
+                auto work = rt.timer("work");
+                if(me == 0) rt.timer("io").stop();
+            }
+            rt.report_timers_at_finalize();
+            rt.report_timers_at_finalize(); // Only reported once
+            reports[me] = rt.report_timers();
+        });
+        for(const auto& report : reports) REQUIRE(report == reports[0]);
+        REQUIRE(reports[0].size() == 2);
+        REQUIRE(reports[0][0].path == "work");
+        REQUIRE(reports[0][0].n_ranks == n);
+        REQUIRE(reports[0][1].path == "work/io");
+        REQUIRE(reports[0][1].n_ranks == 1);
+
+        // Only the rank which timed "io" contributes to its statistics
+        REQUIRE(reports[0][1].wall_min > 0.0);
+        REQUIRE(reports[0][1].wall_min == reports[0][1].wall_max);
+
+        // Once on demand and once when the runtime was finalized
+        const auto log = ss.str();
+        std::size_t n_reports = 0;
+        for(auto i = log.find("Timer report"); i != std::string::npos;
+            i      = log.find("Timer report", i + 1))
+            ++n_reports;
+        REQUIRE(n_reports == 2);
+        REQUIRE(log.find("  io") != std::string::npos);
+    }
+
+    SECTION("exceptions are rethrown") {
+        auto fxn = [](RuntimeView&) { throw std::logic_error("Oops"); };
+        REQUIRE_THROWS_AS(RuntimeView::run_threaded(n, fxn), std::logic_error);
+    }
+
+    SECTION("a rank throwing does not hang the others") {
+        // Rank 0 throws before the gather the other ranks are waiting in, the
+        // original exception (not the other ranks') is rethrown
+        auto fxn = [](RuntimeView& rt) {
+            if(rt.my_resource_set().mpi_rank() == 0)
+                throw std::logic_error("Oops");
+            rt.gather(rt.my_resource_set().mpi_rank());
+        };
+        REQUIRE_THROWS_AS(RuntimeView::run_threaded(n, fxn), std::logic_error);
+    }
+}
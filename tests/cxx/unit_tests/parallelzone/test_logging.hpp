@@ -0,0 +1,63 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "test_parallelzone.hpp"
+#include <filesystem>
+#include <memory>
+#include <parallelzone/logging/detail_/spdlog/spdlog.hpp>
+#include <parallelzone/mpi_helpers/commpp/commpp.hpp>
+#include <spdlog/sinks/ostream_sink.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/** @file test_logging.hpp
+ *
+ *  Helpers shared by the tests of the logger backends, which need a sink
+ *  whose output can be inspected or a directory to write log files to.
+ */
+
+namespace testing {
+
+/// Makes a SpdlogPIMPL which writes "[level] msg" lines to @p ss
+inline auto make_sink(std::stringstream& ss) {
+    auto sink       = std::make_shared<spdlog::sinks::ostream_sink_mt>(ss);
+    auto spdlog_log = spdlog::logger("ss_log", sink);
+    spdlog_log.set_pattern("[%l] %v");
+    return std::make_unique<parallelzone::detail_::SpdlogPIMPL>(spdlog_log);
+}
+
+/// Splits @p s into lines, removing the first @p n characters of each
+inline auto lines(const std::string& s, std::size_t n = 0) {
+    std::vector<std::string> rv;
+    std::istringstream is(s);
+    for(std::string line; std::getline(is, line);) rv.push_back(line.substr(n));
+    return rv;
+}
+
+/// Removes, then returns, the temporary directory @p name + "_" + rank.
+/// Every rank runs the tests, so each needs its own directory.
+inline auto per_rank_temp_dir(const std::string& name) {
+    auto& world    = PZEnvironment::comm_world();
+    const auto me  = parallelzone::mpi_helpers::CommPP(world.mpi_comm()).me();
+    const auto dir = std::filesystem::temp_directory_path() /
+                     (name + "_" + std::to_string(me));
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+} // namespace testing
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2022 NWChemEx-Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/** @file test_sysfs.hpp
+ *
+ *  Helpers shared by the tests of the hardware queries, which read fake
+ *  /sys and /proc trees made in a temporary directory.
+ */
+
+namespace testing {
+
+/// Writes @p value to @p path, creating the missing parent directories
+inline void write_file(const std::filesystem::path& path,
+                       const std::string& value) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path) << value;
+}
+
+} // namespace testing
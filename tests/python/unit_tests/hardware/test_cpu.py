@@ -0,0 +1,64 @@
+#
+# Copyright 2023 NWChemEx-Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import parallelzone as pz
+import unittest
+
+
+class CPUTestCase(unittest.TestCase):
+
+    def setUp(self):
+        """
+        For unit testing purposes we "create" two CPU instances:
+
+        1. defaulted is a default constructed CPU instance.
+        2. has_value is the process local CPU instance
+        """
+
+        self.defaulted = pz.hardware.CPU()
+        self.rv = pz.runtime.RuntimeView()
+        self.rs = self.rv.my_resource_set()
+        self.has_value = self.rs.cpu()
+
+    def test_default_ctor(self):
+        self.assertTrue(self.defaulted.empty())
+        self.assertEqual(self.defaulted.n_sockets(), 0)
+        self.assertEqual(self.defaulted.n_hardware_threads(), 0)
+
+    def test_value_ctor(self):
+        self.assertFalse(self.has_value.empty())
+        self.assertGreater(self.has_value.n_sockets(), 0)
+        self.assertGreaterEqual(self.has_value.n_cores(),
+                                self.has_value.n_sockets())
+        self.assertGreaterEqual(self.has_value.n_hardware_threads(),
+                                self.has_value.n_cores())
+
+    def test_numa_nodes(self):
+        self.assertEqual(self.defaulted.n_numa_nodes(), 0)
+        nodes = self.has_value.numa_nodes()
+        self.assertEqual(len(nodes), self.has_value.n_numa_nodes())
+        cpu = self.has_value.hardware_threads()[0]
+        node = self.has_value.numa_node_of(cpu)
+        self.assertIn(node, nodes)
+        self.assertIn(cpu, self.has_value.hardware_threads_on_numa_node(node))
+
+    def test_affinity(self):
+        self.assertGreater(len(self.has_value.affinity()), 0)
+
+    def test_comparisons(self):
+        other_default = pz.hardware.CPU()
+        self.assertEqual(self.defaulted, other_default)
+        self.assertEqual(self.has_value, self.rv.my_resource_set().cpu())
+        self.assertTrue(self.defaulted != self.has_value)
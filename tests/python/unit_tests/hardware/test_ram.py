@@ -44,6 +44,28 @@ class RAMTestCase(unittest.TestCase):
         self.assertEqual(self.defaulted.total_space(), 0)
         self.assertGreater(self.has_value.total_space(), 0)
 
+    def test_node(self):
+        self.assertEqual(self.defaulted.node(), 0)
+        self.assertLess(self.has_value.node(), self.rv.n_nodes())
+
+    def test_free_space(self):
+        self.assertEqual(self.defaulted.free_space(), 0)
+        self.assertGreater(self.has_value.free_space(), 0)
+        self.assertLessEqual(self.has_value.free_space(),
+                             self.has_value.total_space())
+
+    def test_used_space(self):
+        self.assertEqual(self.defaulted.used_space(), 0)
+        self.assertGreater(self.has_value.used_space(), 0)
+        self.assertLessEqual(self.has_value.used_space(),
+                             self.has_value.high_water_mark())
+
+    def test_numa_nodes(self):
+        self.assertEqual(self.defaulted.numa_nodes(), [])
+        nodes = self.has_value.numa_nodes()
+        self.assertGreater(len(nodes), 0)
+        self.assertGreater(self.has_value.numa_node_space(nodes[0]), 0)
+
     def test_empty(self):
         self.assertTrue(self.defaulted.empty())
         self.assertFalse(self.has_value.empty())
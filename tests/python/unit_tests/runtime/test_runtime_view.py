@@ -75,6 +75,34 @@ class RuntimeViewTestCase(unittest.TestCase):
         self.assertEqual(self.defaulted.count(default_ram), 0)
         self.assertEqual(self.defaulted.count(ram), 1)
 
+    def test_nodes(self):
+        self.assertGreater(self.defaulted.n_nodes(), 0)
+        self.assertEqual(self.defaulted.node_of(0), 0)
+        self.assertRaises(IndexError, self.defaulted.node_of,
+                          self.defaulted.size())
+
+        ranks = self.defaulted.ranks_on_node(0)
+        self.assertEqual(ranks[0], 0)
+        self.assertRaises(IndexError, self.defaulted.ranks_on_node,
+                          self.defaulted.n_nodes())
+
+        me = self.defaulted.my_resource_set().mpi_rank()
+        my_node = self.defaulted.node_of(me)
+        local_rank = self.defaulted.local_rank()
+        self.assertEqual(self.defaulted.ranks_on_node(my_node)[local_rank], me)
+
+    def test_comm_cost(self):
+        self.assertFalse(self.defaulted.has_comm_cost_model())
+        self.assertRaises(RuntimeError, self.defaulted.comm_cost, 8, 0, 0)
+
+        self.defaulted.characterize_interconnect("")
+        self.assertTrue(self.defaulted.has_comm_cost_model())
+        self.assertEqual(self.defaulted.comm_cost(8, 0, 0), 0.0)
+        self.assertRaises(IndexError, self.defaulted.comm_cost, 8,
+                          self.defaulted.size(), 0)
+        if self.defaulted.size() > 1:
+            self.assertGreater(self.defaulted.comm_cost(8, 0, 1), 0.0)
+
     def test_logger(self):
         self.assertIsNotNone(self.defaulted.logger())
         self.defaulted.logger().log("Hello").log("world")
@@ -112,6 +112,18 @@ class LoggerTestCase(unittest.TestCase):
             self.defaulted.log(level, "Hello").log(level, "World!")
             self.log.log(level, "Hello").log(level, "World!")
 
+    def test_should_log(self):
+        self.assertFalse(self.defaulted.should_log(pz.Logger.severity.critical))
+        self.log.set_severity(pz.Logger.severity.warn)
+        self.assertFalse(self.log.should_log(pz.Logger.severity.info))
+        self.assertTrue(self.log.should_log(pz.Logger.severity.warn))
+
+    def test_flush(self):
+        self.defaulted.info("Hello")
+        self.defaulted.flush()
+        self.log.info("Hello")
+        self.log.flush()
+
     def test_comparisons(self):
         self.assertEqual(self.defaulted, pz.Logger())
         self.assertFalse(self.defaulted != pz.Logger())